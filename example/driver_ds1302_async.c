@@ -0,0 +1,255 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1302_async.c
+ * @brief     driver ds1302 async source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds1302_async.h"
+
+static ds1302_handle_t gs_handle;                  /**< ds1302 handle */
+static uint32_t gs_tick_hz;                        /**< timer rate */
+static void (*gs_done)(uint8_t res);               /**< user done callback */
+static volatile uint8_t gs_busy;                   /**< busy flag */
+
+/**
+ * @brief timer tick
+ * @note  one sclk edge per tick on DS1302_TRANSPORT_GPIO, one byte per tick on DS1302_TRANSPORT_BYTE
+ */
+static void a_ds1302_async_tick(void)
+{
+    (void)ds1302_xfer_step(&gs_handle);
+}
+
+/**
+ * @brief     transfer done callback
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] res transfer result
+ * @note      it runs from the last tick
+ */
+static void a_ds1302_async_done(ds1302_handle_t *handle, uint8_t res)
+{
+    void (*done)(uint8_t res);
+    
+    /* stop the ticks */
+    (void)ds1302_interface_timer_stop();
+    
+    /* clear busy before done so done can submit again */
+    done = gs_done;
+    gs_done = NULL;
+    gs_busy = 0;
+    if (done != NULL)
+    {
+        done(res);
+    }
+}
+
+/**
+ * @brief     async example init
+ * @param[in] bit_rate sclk rate in bit/s
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      on DS1302_TRANSPORT_GPIO the timer ticks at twice the bit rate, one sclk edge per tick,
+ *            on DS1302_TRANSPORT_BYTE it ticks once per byte time, one transport byte per tick
+ */
+uint8_t ds1302_async_init(uint32_t bit_rate)
+{
+    uint8_t res;
+    ds1302_transport_t transport;
+    
+    /* check the bit rate */
+    if ((bit_rate == 0) || (bit_rate > DS1302_ASYNC_MAX_BIT_RATE))
+    {
+        ds1302_interface_debug_print("ds1302: bit rate is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* link functions */
+    DRIVER_DS1302_LINK_INIT(&gs_handle, ds1302_handle_t);
+    DRIVER_DS1302_LINK_CE_GPIO_INIT(&gs_handle, ds1302_interface_ce_gpio_init);
+    DRIVER_DS1302_LINK_CE_GPIO_DEINIT(&gs_handle, ds1302_interface_ce_gpio_deinit);
+    DRIVER_DS1302_LINK_CE_GPIO_WRITE(&gs_handle, ds1302_interface_ce_gpio_write);
+    DRIVER_DS1302_LINK_SCLK_GPIO_INIT(&gs_handle, ds1302_interface_sclk_gpio_init);
+    DRIVER_DS1302_LINK_SCLK_GPIO_DEINIT(&gs_handle, ds1302_interface_sclk_gpio_deinit);
+    DRIVER_DS1302_LINK_SCLK_GPIO_WRITE(&gs_handle, ds1302_interface_sclk_gpio_write);
+    DRIVER_DS1302_LINK_IO_GPIO_INIT(&gs_handle, ds1302_interface_io_gpio_init);
+    DRIVER_DS1302_LINK_IO_GPIO_DEINIT(&gs_handle, ds1302_interface_io_gpio_deinit);
+    DRIVER_DS1302_LINK_IO_GPIO_WRITE(&gs_handle, ds1302_interface_io_gpio_write);
+    DRIVER_DS1302_LINK_IO_GPIO_READ(&gs_handle, ds1302_interface_io_gpio_read);
+    DRIVER_DS1302_LINK_IO_GPIO_SET_DIRECTION(&gs_handle, ds1302_interface_io_gpio_set_direction);
+    DRIVER_DS1302_LINK_TRANSPORT_BEGIN(&gs_handle, ds1302_interface_transport_begin);
+    DRIVER_DS1302_LINK_TRANSPORT_WRITE_BYTES(&gs_handle, ds1302_interface_transport_write_bytes);
+    DRIVER_DS1302_LINK_TRANSPORT_READ_BYTES(&gs_handle, ds1302_interface_transport_read_bytes);
+    DRIVER_DS1302_LINK_DELAY_US(&gs_handle, ds1302_interface_delay_us);
+    DRIVER_DS1302_LINK_DELAY_MS(&gs_handle, ds1302_interface_delay_ms);
+    DRIVER_DS1302_LINK_DEBUG_PRINT(&gs_handle, ds1302_interface_debug_print);
+    DRIVER_DS1302_LINK_TIMESTAMP_US(&gs_handle, ds1302_interface_timestamp_us);
+    
+    /* init ds1302 */
+    res = ds1302_init(&gs_handle);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* set oscillator */
+    res = ds1302_set_oscillator(&gs_handle, DS1302_BOOL_TRUE);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: set oscillator failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* disable write protect */
+    res = ds1302_set_write_protect(&gs_handle, DS1302_BOOL_FALSE);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: set write protect failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* get the transport */
+    res = ds1302_get_transport(&gs_handle, &transport);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: get transport failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    if (transport == DS1302_TRANSPORT_BYTE)
+    {
+        /* one byte per tick, the byte takes eight bit times */
+        gs_tick_hz = (bit_rate + 7) / 8;
+    }
+    else
+    {
+        /* two edges per bit */
+        gs_tick_hz = bit_rate * 2;
+    }
+    gs_done = NULL;
+    gs_busy = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief  async example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   a pending transfer is aborted
+ */
+uint8_t ds1302_async_deinit(void)
+{
+    /* stop the ticks and drop a pending transfer */
+    (void)ds1302_interface_timer_stop();
+    if (gs_busy != 0)
+    {
+        gs_done = NULL;
+        (void)ds1302_xfer_abort(&gs_handle);
+    }
+    
+    if (ds1302_deinit(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     async example submit a transfer
+ * @param[in] op transfer operation
+ * @param[in] *buf pointer to a data buffer, it must stay valid until done runs
+ * @param[in] len data buffer length
+ * @param[in] *done pointer to a done callback, res is 0 on success, it can be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      it returns at once, the timer interrupt clocks the transfer and runs done
+ *            from the interrupt when the burst finishes
+ */
+uint8_t ds1302_async_submit(ds1302_xfer_op_t op, uint8_t *buf, uint8_t len, void (*done)(uint8_t res))
+{
+    /* check busy */
+    if (gs_busy != 0)
+    {
+        return 1;
+    }
+    
+    /* queue the transfer */
+    gs_done = done;
+    gs_busy = 1;
+    if (ds1302_xfer_submit(&gs_handle, op, buf, len, a_ds1302_async_done) != 0)
+    {
+        gs_done = NULL;
+        gs_busy = 0;
+        
+        return 1;
+    }
+    
+    /* start the ticks */
+    if (ds1302_interface_timer_start(gs_tick_hz, a_ds1302_async_tick) != 0)
+    {
+        ds1302_interface_debug_print("ds1302: timer start failed.\n");
+        gs_done = NULL;
+        (void)ds1302_xfer_abort(&gs_handle);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      async example get the transfer status
+ * @param[out] *busy pointer to a busy buffer
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t ds1302_async_get_busy(ds1302_bool_t *busy)
+{
+    *busy = (gs_busy != 0) ? DS1302_BOOL_TRUE : DS1302_BOOL_FALSE;
+    
+    return 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1302_async.h
+ * @brief     driver ds1302 async header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_DS1302_ASYNC_H
+#define DRIVER_DS1302_ASYNC_H
+
+#include "driver_ds1302_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup ds1302_example_driver
+ * @{
+ */
+
+/**
+ * @brief ds1302 async example default definition
+ */
+#define DS1302_ASYNC_DEFAULT_BIT_RATE        100000        /**< 100 kbit/s */
+#define DS1302_ASYNC_MAX_BIT_RATE            500000        /**< max sclk rate at 2V */
+
+/**
+ * @brief     async example init
+ * @param[in] bit_rate sclk rate in bit/s
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      on DS1302_TRANSPORT_GPIO the timer ticks at twice the bit rate, one sclk edge per tick,
+ *            on DS1302_TRANSPORT_BYTE it ticks once per byte time, one transport byte per tick
+ */
+uint8_t ds1302_async_init(uint32_t bit_rate);
+
+/**
+ * @brief  async example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   a pending transfer is aborted
+ */
+uint8_t ds1302_async_deinit(void);
+
+/**
+ * @brief     async example submit a transfer
+ * @param[in] op transfer operation
+ * @param[in] *buf pointer to a data buffer, it must stay valid until done runs
+ * @param[in] len data buffer length
+ * @param[in] *done pointer to a done callback, res is 0 on success, it can be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      it returns at once, the timer interrupt clocks the transfer and runs done
+ *            from the interrupt when the burst finishes
+ */
+uint8_t ds1302_async_submit(ds1302_xfer_op_t op, uint8_t *buf, uint8_t len, void (*done)(uint8_t res));
+
+/**
+ * @brief      async example get the transfer status
+ * @param[out] *busy pointer to a busy buffer
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t ds1302_async_get_busy(ds1302_bool_t *busy);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -62,9 +62,14 @@ uint8_t ds1302_basic_init(void)
     DRIVER_DS1302_LINK_IO_GPIO_DEINIT(&gs_handle, ds1302_interface_io_gpio_deinit);
     DRIVER_DS1302_LINK_IO_GPIO_WRITE(&gs_handle, ds1302_interface_io_gpio_write);
     DRIVER_DS1302_LINK_IO_GPIO_READ(&gs_handle, ds1302_interface_io_gpio_read);
+    DRIVER_DS1302_LINK_IO_GPIO_SET_DIRECTION(&gs_handle, ds1302_interface_io_gpio_set_direction);
+    DRIVER_DS1302_LINK_TRANSPORT_BEGIN(&gs_handle, ds1302_interface_transport_begin);
+    DRIVER_DS1302_LINK_TRANSPORT_WRITE_BYTES(&gs_handle, ds1302_interface_transport_write_bytes);
+    DRIVER_DS1302_LINK_TRANSPORT_READ_BYTES(&gs_handle, ds1302_interface_transport_read_bytes);
     DRIVER_DS1302_LINK_DELAY_US(&gs_handle, ds1302_interface_delay_us);
     DRIVER_DS1302_LINK_DELAY_MS(&gs_handle, ds1302_interface_delay_ms);
     DRIVER_DS1302_LINK_DEBUG_PRINT(&gs_handle, ds1302_interface_debug_print);
+    DRIVER_DS1302_LINK_TIMESTAMP_US(&gs_handle, ds1302_interface_timestamp_us);
 
     /* init ds1302 */
     res = ds1302_init(&gs_handle);
@@ -145,27 +150,17 @@ uint8_t ds1302_basic_set_time(ds1302_time_t *t)
 uint8_t ds1302_basic_set_timestamp(time_t timestamp)
 {
     ds1302_time_t t;
-    struct tm *timeptr;
 
     /* convert times */
     timestamp += (time_t)(gs_time_zone * 3600);
-    timeptr = localtime(&timestamp);
-    t.am_pm = DS1302_AM;
-    t.date = (uint8_t)timeptr->tm_mday;
-    t.format = DS1302_FORMAT_24H;
-    t.hour = (uint8_t)timeptr->tm_hour;
-    t.minute = (uint8_t)timeptr->tm_min;
-    t.month = (uint8_t)timeptr->tm_mon + 1;
-    t.second = (uint8_t)timeptr->tm_sec;
-    if (timeptr->tm_wday == 0)
+    if ((timestamp < 0) || ((int64_t)timestamp > (int64_t)0xFFFFFFFFU))
     {
-        t.week  = 7;
+        return 1;
     }
-    else
+    if (ds1302_unix_to_time((uint32_t)timestamp, DS1302_FORMAT_24H, &t) != 0)
     {
-        t.week = (uint8_t)timeptr->tm_wday;
+        return 1;
     }
-    t.year = (uint16_t)(timeptr->tm_year + 1900);
 
     /* set time */
     if (ds1302_set_time(&gs_handle, &t) != 0)
@@ -220,30 +215,20 @@ uint8_t ds1302_basic_get_time(ds1302_time_t *t)
 uint8_t ds1302_basic_get_timestamp(time_t *timestamp)
 {
     ds1302_time_t t;
-    struct tm timeptr;
+    uint32_t unix_time;
 
     /* get time */
     if (ds1302_get_time(&gs_handle, &t) != 0)
     {
         return 1;
     }
-    timeptr.tm_year = t.year - 1900;
-    timeptr.tm_mon = t.month - 1;
-    timeptr.tm_wday = t.week;
-    timeptr.tm_mday = t.date;
-    if (t.format == DS1302_FORMAT_24H)
-    {
-        timeptr.tm_hour = t.hour;
-    }
-    else
-    {
-        timeptr.tm_hour = t.hour % 12 + t.am_pm * 12;
-    }
-    timeptr.tm_min = t.minute;
-    timeptr.tm_sec = t.second;
 
     /* make time */
-    *timestamp = mktime(&timeptr) - gs_time_zone * 3600;
+    if (ds1302_time_to_unix(&t, &unix_time) != 0)
+    {
+        return 1;
+    }
+    *timestamp = (time_t)unix_time - gs_time_zone * 3600;
 
     return 0;
 }
@@ -37,125 +37,221 @@
 #include "driver_ds1302_interface.h"
 
 /**
- * @brief  interface ce gpio init
- * @return status code
- *         - 0 success
- *         - 1 ce gpio init failed
- * @note   none
+ * @brief     interface ce gpio init
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 ce gpio init failed
+ * @note      none
  */
-uint8_t ds1302_interface_ce_gpio_init(void)
+uint8_t ds1302_interface_ce_gpio_init(void *ctx)
 {
     return 0;
 }
 
 /**
- * @brief  interface ce gpio deinit
- * @return status code
- *         - 0 success
- *         - 1 ce gpio deinit failed
- * @note   none
+ * @brief     interface ce gpio deinit
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 ce gpio deinit failed
+ * @note      none
  */
-uint8_t ds1302_interface_ce_gpio_deinit(void)
+uint8_t ds1302_interface_ce_gpio_deinit(void *ctx)
 {
     return 0;
 }
 
 /**
  * @brief     interface ce gpio write
+ * @param[in] *ctx pointer to a chip context
  * @param[in] value set level
  * @return    status code
  *            - 0 success
  *            - 1 ce gpio write failed
  * @note      none
  */
-uint8_t ds1302_interface_ce_gpio_write(uint8_t value)
+uint8_t ds1302_interface_ce_gpio_write(void *ctx, uint8_t value)
 {
     return 0;
 }
 
 /**
- * @brief  interface sclk gpio init
- * @return status code
- *         - 0 success
- *         - 1 sclk gpio init failed
- * @note   none
+ * @brief     interface sclk gpio init
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 sclk gpio init failed
+ * @note      none
  */
-uint8_t ds1302_interface_sclk_gpio_init(void)
+uint8_t ds1302_interface_sclk_gpio_init(void *ctx)
 {
     return 0;
 }
 
 /**
- * @brief  interface sclk gpio deinit
- * @return status code
- *         - 0 success
- *         - 1 sclk gpio deinit failed
- * @note   none
+ * @brief     interface sclk gpio deinit
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 sclk gpio deinit failed
+ * @note      none
  */
-uint8_t ds1302_interface_sclk_gpio_deinit(void)
+uint8_t ds1302_interface_sclk_gpio_deinit(void *ctx)
 {
     return 0;
 }
 
 /**
  * @brief     interface sclk gpio write
+ * @param[in] *ctx pointer to a chip context
  * @param[in] value set level
  * @return    status code
  *            - 0 success
  *            - 1 sclk gpio write failed
  * @note      none
  */
-uint8_t ds1302_interface_sclk_gpio_write(uint8_t value)
+uint8_t ds1302_interface_sclk_gpio_write(void *ctx, uint8_t value)
 {
     return 0;
 }
 
 /**
- * @brief  interface io gpio init
- * @return status code
- *         - 0 success
- *         - 1 io gpio init failed
- * @note   none
+ * @brief     interface io gpio init
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 io gpio init failed
+ * @note      none
  */
-uint8_t ds1302_interface_io_gpio_init(void)
+uint8_t ds1302_interface_io_gpio_init(void *ctx)
 {
     return 0;
 }
 
 /**
- * @brief  interface io gpio deinit
- * @return status code
- *         - 0 success
- *         - 1 io gpio deinit failed
- * @note   none
+ * @brief     interface io gpio deinit
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 io gpio deinit failed
+ * @note      none
  */
-uint8_t ds1302_interface_io_gpio_deinit(void)
+uint8_t ds1302_interface_io_gpio_deinit(void *ctx)
 {
     return 0;
 }
 
 /**
  * @brief     interface io gpio write
+ * @param[in] *ctx pointer to a chip context
  * @param[in] value set level
  * @return    status code
  *            - 0 success
  *            - 1 io gpio write failed
  * @note      none
  */
-uint8_t ds1302_interface_io_gpio_write(uint8_t value)
+uint8_t ds1302_interface_io_gpio_write(void *ctx, uint8_t value)
 {
     return 0;
 }
 
 /**
  * @brief      interface io gpio read
+ * @param[in]  *ctx pointer to a chip context
  * @param[out] *value pointer to a value buffer
  * @return     status code
  *             - 0 success
  *             - 1 io gpio read failed
  * @note       none
  */
-uint8_t ds1302_interface_io_gpio_read(uint8_t *value)
+uint8_t ds1302_interface_io_gpio_read(void *ctx, uint8_t *value)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface io gpio set direction
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] output direction, 0 is input and 1 is output
+ * @return    status code
+ *            - 0 success
+ *            - 1 io gpio set direction failed
+ * @note      called once per command/data turnaround
+ */
+uint8_t ds1302_interface_io_gpio_set_direction(void *ctx, uint8_t output)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface transport begin
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] ce ce level
+ * @return    status code
+ *            - 0 success
+ *            - 1 transport begin failed
+ * @note      only used when the transport is DS1302_TRANSPORT_BYTE
+ */
+uint8_t ds1302_interface_transport_begin(void *ctx, uint8_t ce)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface transport write bytes
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 transport write bytes failed
+ * @note      only used when the transport is DS1302_TRANSPORT_BYTE,
+ *            bytes are shifted out lsb first
+ */
+uint8_t ds1302_interface_transport_write_bytes(void *ctx, uint8_t *buf, uint8_t len)
+{
+    return 0;
+}
+
+/**
+ * @brief      interface transport read bytes
+ * @param[in]  *ctx pointer to a chip context
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 transport read bytes failed
+ * @note       only used when the transport is DS1302_TRANSPORT_BYTE,
+ *             bytes are shifted in lsb first
+ */
+uint8_t ds1302_interface_transport_read_bytes(void *ctx, uint8_t *buf, uint8_t len)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface timer start
+ * @param[in] hz tick rate
+ * @param[in] *tick pointer to a tick function, it runs from the timer interrupt
+ * @return    status code
+ *            - 0 success
+ *            - 1 timer start failed
+ * @note      it may be called again while running to restart at a new rate
+ */
+uint8_t ds1302_interface_timer_start(uint32_t hz, void (*tick)(void))
+{
+    return 0;
+}
+
+/**
+ * @brief  interface timer stop
+ * @return status code
+ *         - 0 success
+ *         - 1 timer stop failed
+ * @note   it may be called from the tick function
+ */
+uint8_t ds1302_interface_timer_stop(void)
 {
     return 0;
 }
@@ -180,6 +276,16 @@ void ds1302_interface_delay_us(uint32_t us)
 
 }
 
+/**
+ * @brief  interface timestamp us
+ * @return free running microsecond counter
+ * @note   only differences are used, wrapping is fine
+ */
+uint32_t ds1302_interface_timestamp_us(void)
+{
+    return 0;
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
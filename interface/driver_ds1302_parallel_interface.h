@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1302_parallel_interface.h
+ * @brief     driver ds1302 parallel interface header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_DS1302_PARALLEL_INTERFACE_H
+#define DRIVER_DS1302_PARALLEL_INTERFACE_H
+
+#include "driver_ds1302_parallel.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ds1302_parallel_interface_driver ds1302 parallel interface driver function
+ * @brief    ds1302 parallel interface driver modules
+ * @ingroup  ds1302_driver
+ * @{
+ */
+
+/**
+ * @brief     interface lane init
+ * @param[in] *ctx pointer to a lane context
+ * @return    status code
+ *            - 0 success
+ *            - 1 lane init failed
+ * @note      inits the shared ce and sclk lines and the io pins of all lanes
+ */
+uint8_t ds1302_interface_lane_init(void *ctx);
+
+/**
+ * @brief     interface lane deinit
+ * @param[in] *ctx pointer to a lane context
+ * @return    status code
+ *            - 0 success
+ *            - 1 lane deinit failed
+ * @note      none
+ */
+uint8_t ds1302_interface_lane_deinit(void *ctx);
+
+/**
+ * @brief     interface lane ce write
+ * @param[in] *ctx pointer to a lane context
+ * @param[in] value set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 lane ce write failed
+ * @note      the ce line is shared by all lanes
+ */
+uint8_t ds1302_interface_lane_ce_write(void *ctx, uint8_t value);
+
+/**
+ * @brief     interface lane sclk write
+ * @param[in] *ctx pointer to a lane context
+ * @param[in] value set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 lane sclk write failed
+ * @note      the sclk line is shared by all lanes
+ */
+uint8_t ds1302_interface_lane_sclk_write(void *ctx, uint8_t value);
+
+/**
+ * @brief     interface lane io write
+ * @param[in] *ctx pointer to a lane context
+ * @param[in] mask port pins to drive
+ * @param[in] value port pin levels
+ * @return    status code
+ *            - 0 success
+ *            - 1 lane io write failed
+ * @note      one port wide write, such as a single BSRR store
+ */
+uint8_t ds1302_interface_lane_io_write(void *ctx, uint32_t mask, uint32_t value);
+
+/**
+ * @brief      interface lane io read
+ * @param[in]  *ctx pointer to a lane context
+ * @param[out] *value pointer to a port word buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 lane io read failed
+ * @note       one port wide read, such as a single IDR or GPLEV load
+ */
+uint8_t ds1302_interface_lane_io_read(void *ctx, uint32_t *value);
+
+/**
+ * @brief     interface lane io set direction
+ * @param[in] *ctx pointer to a lane context
+ * @param[in] mask port pins to change
+ * @param[in] output direction, 0 is input and 1 is output
+ * @return    status code
+ *            - 0 success
+ *            - 1 lane io set direction failed
+ * @note      none
+ */
+uint8_t ds1302_interface_lane_io_set_direction(void *ctx, uint32_t mask, uint8_t output);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -35,133 +35,781 @@
  */
 
 #include "driver_ds1302_interface.h"
+#include "driver_ds1302_parallel_interface.h"
 #include "wire.h"
+#include "delay.h"
+#include "spi.h"
 #include <stdarg.h>
 
 /**
- * @brief  interface ce gpio init
- * @return status code
- *         - 0 success
- *         - 1 ce gpio init failed
- * @note   none
+ * @brief latency measurement definition
+ */
+#define LATENCY_MEASURE_LOOPS 64        /**< gpio calls measured at init */
+
+/**
+ * @brief     get the chip index
+ * @param[in] *ctx pointer to a chip context
+ * @return    chip index
+ * @note      a NULL ctx is chip 0, otherwise ctx points to the uint8_t chip index
  */
-uint8_t ds1302_interface_ce_gpio_init(void)
+static inline uint8_t a_ds1302_interface_chip(void *ctx)
 {
-    return wire_cs_init();
+    return (ctx == NULL) ? 0 : *(uint8_t *)ctx;
 }
 
+#if defined(DS1302_SPIDEV)
+
 /**
- * @brief  interface ce gpio deinit
- * @return status code
- *         - 0 success
- *         - 1 ce gpio deinit failed
- * @note   none
+ * @brief spidev definition
+ */
+#define SPI_DEVICE_NUM  2                        /**< one spi device per hardware ce */
+#define SPI_DEVICE_FREQ 1000000                  /**< 1MHz sclk, below the 2MHz limit at 5V */
+
+/**
+ * @brief spidev var definition
+ */
+static char *const gsc_spi_name[SPI_DEVICE_NUM] =
+{
+    "/dev/spidev0.0", "/dev/spidev0.1",
+};                                               /**< spi device names */
+static int gs_spi_fd[SPI_DEVICE_NUM];            /**< spi device handles */
+static uint8_t gs_spi_buf[SPI_MAX_LEN];          /**< command and write data of the open transaction */
+static uint8_t gs_spi_len;                       /**< buffered length */
+static uint8_t gs_spi_sent;                      /**< transaction already sent */
+static uint8_t gs_spi_rx[SPI_MAX_LEN];           /**< data of the sent read message */
+static uint8_t gs_spi_rx_len;                    /**< read message length */
+static uint8_t gs_spi_rx_index;                  /**< next byte handed out */
+
+/**
+ * @brief     interface ce gpio init
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 ce gpio init failed
+ * @note      ce, sclk and io are the spi0 ce, sclk and mosi pins, ce is driven active high,
+ *            chip 0 sits on ce0 and chip 1 on ce1
  */
-uint8_t ds1302_interface_ce_gpio_deinit(void)
+uint8_t ds1302_interface_ce_gpio_init(void *ctx)
 {
-    return wire_cs_deinit();
+    uint8_t chip;
+    
+    chip = a_ds1302_interface_chip(ctx);
+    if (chip >= SPI_DEVICE_NUM)
+    {
+        return 1;
+    }
+    
+    return spi_init(gsc_spi_name[chip], &gs_spi_fd[chip], SPI_DEVICE_FREQ);
+}
+
+/**
+ * @brief     interface ce gpio deinit
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 ce gpio deinit failed
+ * @note      none
+ */
+uint8_t ds1302_interface_ce_gpio_deinit(void *ctx)
+{
+    uint8_t chip;
+    
+    chip = a_ds1302_interface_chip(ctx);
+    if (chip >= SPI_DEVICE_NUM)
+    {
+        return 1;
+    }
+    
+    return spi_deinit(gs_spi_fd[chip]);
 }
 
 /**
  * @brief     interface ce gpio write
+ * @param[in] *ctx pointer to a chip context
  * @param[in] value set level
  * @return    status code
  *            - 0 success
  *            - 1 ce gpio write failed
+ * @note      the bus runs on spidev, set DS1302_TRANSPORT_BYTE
+ */
+uint8_t ds1302_interface_ce_gpio_write(void *ctx, uint8_t value)
+{
+    return 1;
+}
+
+/**
+ * @brief     interface sclk gpio init
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 sclk gpio init failed
+ * @note      the sclk line is set up with the ce by spi_init
+ */
+uint8_t ds1302_interface_sclk_gpio_init(void *ctx)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface sclk gpio deinit
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 sclk gpio deinit failed
+ * @note      the sclk line is released with the ce by spi_deinit
+ */
+uint8_t ds1302_interface_sclk_gpio_deinit(void *ctx)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface sclk gpio write
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] value set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 sclk gpio write failed
+ * @note      the bus runs on spidev, set DS1302_TRANSPORT_BYTE
+ */
+uint8_t ds1302_interface_sclk_gpio_write(void *ctx, uint8_t value)
+{
+    return 1;
+}
+
+/**
+ * @brief     interface io gpio init
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 io gpio init failed
+ * @note      the io line is set up with the ce by spi_init
+ */
+uint8_t ds1302_interface_io_gpio_init(void *ctx)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface io gpio deinit
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 io gpio deinit failed
+ * @note      the io line is released with the ce by spi_deinit
+ */
+uint8_t ds1302_interface_io_gpio_deinit(void *ctx)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface io gpio write
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] value set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 io gpio write failed
+ * @note      the bus runs on spidev, set DS1302_TRANSPORT_BYTE
+ */
+uint8_t ds1302_interface_io_gpio_write(void *ctx, uint8_t value)
+{
+    return 1;
+}
+
+/**
+ * @brief      interface io gpio read
+ * @param[in]  *ctx pointer to a chip context
+ * @param[out] *value pointer to a value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 io gpio read failed
+ * @note       the bus runs on spidev, set DS1302_TRANSPORT_BYTE
+ */
+uint8_t ds1302_interface_io_gpio_read(void *ctx, uint8_t *value)
+{
+    return 1;
+}
+
+/**
+ * @brief     interface io gpio set direction
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] output direction, 0 is input and 1 is output
+ * @return    status code
+ *            - 0 success
+ *            - 1 io gpio set direction failed
+ * @note      the bus runs on spidev, set DS1302_TRANSPORT_BYTE
+ */
+uint8_t ds1302_interface_io_gpio_set_direction(void *ctx, uint8_t output)
+{
+    return 1;
+}
+
+/**
+ * @brief     get the read message length of a command
+ * @param[in] command command byte
+ * @return    read length
+ * @note      a burst reads the whole clock or ram block, a single register reads one byte
+ */
+static uint8_t a_ds1302_interface_read_len(uint8_t command)
+{
+    if (((command >> 1) & 0x1F) == 0x1F)
+    {
+        return ((command & (1 << 6)) != 0) ? 31 : 8;
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     interface transport begin
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] ce ce level
+ * @return    status code
+ *            - 0 success
+ *            - 1 transport begin failed
+ * @note      only used when the transport is DS1302_TRANSPORT_BYTE,
+ *            a write transaction is sent as one message when ce drops
+ */
+uint8_t ds1302_interface_transport_begin(void *ctx, uint8_t ce)
+{
+    uint8_t res;
+    
+    res = 0;
+    if ((ce == 0) && (gs_spi_sent == 0) && (gs_spi_len != 0))
+    {
+        /* command and data in one ioctl */
+        res = spi_write(gs_spi_fd[a_ds1302_interface_chip(ctx)], gs_spi_buf, 1, &gs_spi_buf[1], gs_spi_len - 1);
+    }
+    
+    /* start a new transaction */
+    gs_spi_len = 0;
+    gs_spi_sent = 0;
+    gs_spi_rx_len = 0;
+    gs_spi_rx_index = 0;
+    
+    return res;
+}
+
+/**
+ * @brief     interface transport write bytes
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 transport write bytes failed
+ * @note      only used when the transport is DS1302_TRANSPORT_BYTE,
+ *            the bytes are kept until the transaction ends
+ */
+uint8_t ds1302_interface_transport_write_bytes(void *ctx, uint8_t *buf, uint8_t len)
+{
+    /* a sent transaction can not be extended */
+    if ((gs_spi_sent != 0) || (gs_spi_len + len > SPI_MAX_LEN))
+    {
+        return 1;
+    }
+    
+    /* keep the bytes */
+    memcpy(&gs_spi_buf[gs_spi_len], buf, len);
+    gs_spi_len += len;
+    
+    return 0;
+}
+
+/**
+ * @brief      interface transport read bytes
+ * @param[in]  *ctx pointer to a chip context
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 transport read bytes failed
+ * @note       only used when the transport is DS1302_TRANSPORT_BYTE,
+ *             the first read sends the command and the whole burst in one message,
+ *             later reads of the same transaction take the kept bytes so a burst can be read in steps
+ */
+uint8_t ds1302_interface_transport_read_bytes(void *ctx, uint8_t *buf, uint8_t len)
+{
+    /* send the read message once */
+    if (gs_spi_sent == 0)
+    {
+        if (gs_spi_len == 0)
+        {
+            return 1;
+        }
+        gs_spi_rx_len = a_ds1302_interface_read_len(gs_spi_buf[0]);
+        if (gs_spi_rx_len < len)
+        {
+            gs_spi_rx_len = len;
+        }
+        if (gs_spi_rx_len > SPI_MAX_LEN)
+        {
+            return 1;
+        }
+        gs_spi_rx_index = 0;
+        gs_spi_sent = 1;
+        
+        /* command and data in one ioctl */
+        if (spi_write_read(gs_spi_fd[a_ds1302_interface_chip(ctx)], gs_spi_buf, gs_spi_len, gs_spi_rx, gs_spi_rx_len) != 0)
+        {
+            gs_spi_rx_len = 0;
+            
+            return 1;
+        }
+    }
+    
+    /* hand out the kept bytes */
+    if (gs_spi_rx_index + len > gs_spi_rx_len)
+    {
+        return 1;
+    }
+    memcpy(buf, &gs_spi_rx[gs_spi_rx_index], len);
+    gs_spi_rx_index += len;
+    
+    return 0;
+}
+
+#else
+
+/**
+ * @brief     interface ce gpio init
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 ce gpio init failed
+ * @note      each chip drives its own cs line, see WIRE_CS_NUM
+ */
+uint8_t ds1302_interface_ce_gpio_init(void *ctx)
+{
+    return wire_cs_init(a_ds1302_interface_chip(ctx));
+}
+
+/**
+ * @brief     interface ce gpio deinit
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 ce gpio deinit failed
  * @note      none
  */
-uint8_t ds1302_interface_ce_gpio_write(uint8_t value)
+uint8_t ds1302_interface_ce_gpio_deinit(void *ctx)
 {
-    return wire_cs_write(value);
+    return wire_cs_deinit(a_ds1302_interface_chip(ctx));
 }
 
 /**
- * @brief  interface sclk gpio init
- * @return status code
- *         - 0 success
- *         - 1 sclk gpio init failed
- * @note   none
+ * @brief     interface ce gpio write
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] value set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 ce gpio write failed
+ * @note      none
  */
-uint8_t ds1302_interface_sclk_gpio_init(void)
+uint8_t ds1302_interface_ce_gpio_write(void *ctx, uint8_t value)
 {
-    return wire_clock_init();
+    return wire_cs_write(a_ds1302_interface_chip(ctx), value);
 }
 
 /**
- * @brief  interface sclk gpio deinit
- * @return status code
- *         - 0 success
- *         - 1 sclk gpio deinit failed
- * @note   none
+ * @brief     interface sclk gpio init
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 sclk gpio init failed
+ * @note      also calibrates the us delay and measures the gpio call latency,
+ *            the delay is skipped when one gpio call already exceeds tCH/tCL
  */
-uint8_t ds1302_interface_sclk_gpio_deinit(void)
+uint8_t ds1302_interface_sclk_gpio_init(void *ctx)
+{
+    uint64_t start;
+    uint64_t stop;
+    uint32_t i;
+    
+    /* init the clock line */
+    if (wire_clock_init() != 0)
+    {
+        return 1;
+    }
+    
+    /* calibrate the delay */
+    if (delay_init() != 0)
+    {
+        (void)wire_clock_deinit();
+        
+        return 1;
+    }
+    
+    /* measure the gpio latency with the clock held low */
+    start = delay_get_ns();
+    for (i = 0; i < LATENCY_MEASURE_LOOPS; i++)
+    {
+        if (wire_clock_write(0) != 0)
+        {
+            (void)wire_clock_deinit();
+            
+            return 1;
+        }
+    }
+    stop = delay_get_ns();
+    delay_set_bus_latency((uint32_t)((stop - start) / LATENCY_MEASURE_LOOPS));
+    
+    /* enable the skip mode */
+    delay_set_skip(1);
+    
+    return 0;
+}
+
+/**
+ * @brief     interface sclk gpio deinit
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 sclk gpio deinit failed
+ * @note      none
+ */
+uint8_t ds1302_interface_sclk_gpio_deinit(void *ctx)
 {
     return wire_clock_deinit();
 }
 
 /**
  * @brief     interface sclk gpio write
+ * @param[in] *ctx pointer to a chip context
  * @param[in] value set level
  * @return    status code
  *            - 0 success
  *            - 1 sclk gpio write failed
  * @note      none
  */
-uint8_t ds1302_interface_sclk_gpio_write(uint8_t value)
+uint8_t ds1302_interface_sclk_gpio_write(void *ctx, uint8_t value)
 {
     return wire_clock_write(value);
 }
 
 /**
- * @brief  interface io gpio init
- * @return status code
- *         - 0 success
- *         - 1 io gpio init failed
- * @note   none
+ * @brief     interface io gpio init
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 io gpio init failed
+ * @note      none
  */
-uint8_t ds1302_interface_io_gpio_init(void)
+uint8_t ds1302_interface_io_gpio_init(void *ctx)
 {
     return wire_init();
 }
 
 /**
- * @brief  interface io gpio deinit
- * @return status code
- *         - 0 success
- *         - 1 io gpio deinit failed
- * @note   none
+ * @brief     interface io gpio deinit
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 io gpio deinit failed
+ * @note      none
  */
-uint8_t ds1302_interface_io_gpio_deinit(void)
+uint8_t ds1302_interface_io_gpio_deinit(void *ctx)
 {
     return wire_deinit();
 }
 
 /**
  * @brief     interface io gpio write
+ * @param[in] *ctx pointer to a chip context
  * @param[in] value set level
  * @return    status code
  *            - 0 success
  *            - 1 io gpio write failed
  * @note      none
  */
-uint8_t ds1302_interface_io_gpio_write(uint8_t value)
+uint8_t ds1302_interface_io_gpio_write(void *ctx, uint8_t value)
 {
     return wire_write(value);
 }
 
 /**
  * @brief      interface io gpio read
+ * @param[in]  *ctx pointer to a chip context
  * @param[out] *value pointer to a value buffer
  * @return     status code
  *             - 0 success
  *             - 1 io gpio read failed
  * @note       none
  */
-uint8_t ds1302_interface_io_gpio_read(uint8_t *value)
+uint8_t ds1302_interface_io_gpio_read(void *ctx, uint8_t *value)
 {
     return wire_read(value);
 }
 
+/**
+ * @brief     interface io gpio set direction
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] output direction, 0 is input and 1 is output
+ * @return    status code
+ *            - 0 success
+ *            - 1 io gpio set direction failed
+ * @note      called once per command/data turnaround
+ */
+uint8_t ds1302_interface_io_gpio_set_direction(void *ctx, uint8_t output)
+{
+    return wire_set_direction(output);
+}
+
+/**
+ * @brief     interface transport begin
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] ce ce level
+ * @return    status code
+ *            - 0 success
+ *            - 1 transport begin failed
+ * @note      only used when the transport is DS1302_TRANSPORT_BYTE
+ */
+uint8_t ds1302_interface_transport_begin(void *ctx, uint8_t ce)
+{
+    if (ce != 0)
+    {
+        return wire_cs_write(a_ds1302_interface_chip(ctx), 1);
+    }
+    else
+    {
+        /* drop ce and io together */
+        return wire_cs_data_write(a_ds1302_interface_chip(ctx), 0, 0);
+    }
+}
+
+/**
+ * @brief     interface transport write bytes
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 transport write bytes failed
+ * @note      only used when the transport is DS1302_TRANSPORT_BYTE,
+ *            bytes are shifted out lsb first
+ */
+uint8_t ds1302_interface_transport_write_bytes(void *ctx, uint8_t *buf, uint8_t len)
+{
+    uint8_t i;
+    uint8_t j;
+    uint8_t temp;
+    
+    /* drive the line */
+    if (wire_set_direction(1) != 0)
+    {
+        return 1;
+    }
+    
+    for (j = 0; j < len; j++)
+    {
+        temp = buf[j];
+        for (i = 0; i < 8; i++)
+        {
+            /* drop the clock and set the data bit */
+            if (wire_data_clock_write(temp & 0x01, 0) != 0)
+            {
+                return 1;
+            }
+            temp = temp >> 1;
+            
+            /* clock the bit */
+            ds1302_interface_delay_us(1);
+            if (wire_clock_write(1) != 0)
+            {
+                return 1;
+            }
+            ds1302_interface_delay_us(1);
+        }
+    }
+    
+    /* end with the clock low */
+    return wire_clock_write(0);
+}
+
+/**
+ * @brief      interface transport read bytes
+ * @param[in]  *ctx pointer to a chip context
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 transport read bytes failed
+ * @note       only used when the transport is DS1302_TRANSPORT_BYTE,
+ *             bytes are shifted in lsb first
+ */
+uint8_t ds1302_interface_transport_read_bytes(void *ctx, uint8_t *buf, uint8_t len)
+{
+    uint8_t i;
+    uint8_t j;
+    uint8_t temp;
+    uint8_t level;
+    
+    /* release the line */
+    if (wire_set_direction(0) != 0)
+    {
+        return 1;
+    }
+    
+    for (j = 0; j < len; j++)
+    {
+        temp = 0;
+        for (i = 0; i < 8; i++)
+        {
+            /* sample the data bit */
+            if (wire_read(&level) != 0)
+            {
+                return 1;
+            }
+            temp = (uint8_t)((temp >> 1) | ((level != 0) ? 0x80 : 0x00));
+            
+            /* clock the next bit */
+            if (wire_clock_write(1) != 0)
+            {
+                return 1;
+            }
+            ds1302_interface_delay_us(1);
+            if (wire_clock_write(0) != 0)
+            {
+                return 1;
+            }
+        }
+        buf[j] = temp;
+    }
+    
+    return 0;
+}
+
+#endif
+
+#if defined(WIRE_MMAP)
+
+/**
+ * @brief     interface lane init
+ * @param[in] *ctx pointer to a lane context
+ * @return    status code
+ *            - 0 success
+ *            - 1 lane init failed
+ * @note      ce and sclk are GPIO22 and GPIO27, lane pins are bcm pins of GPLEV0
+ */
+uint8_t ds1302_interface_lane_init(void *ctx)
+{
+    return wire_lane_init();
+}
+
+/**
+ * @brief     interface lane deinit
+ * @param[in] *ctx pointer to a lane context
+ * @return    status code
+ *            - 0 success
+ *            - 1 lane deinit failed
+ * @note      none
+ */
+uint8_t ds1302_interface_lane_deinit(void *ctx)
+{
+    return wire_lane_deinit();
+}
+
+/**
+ * @brief     interface lane ce write
+ * @param[in] *ctx pointer to a lane context
+ * @param[in] value set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 lane ce write failed
+ * @note      the ce line is shared by all lanes
+ */
+uint8_t ds1302_interface_lane_ce_write(void *ctx, uint8_t value)
+{
+    return wire_cs_write(0, value);
+}
+
+/**
+ * @brief     interface lane sclk write
+ * @param[in] *ctx pointer to a lane context
+ * @param[in] value set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 lane sclk write failed
+ * @note      the sclk line is shared by all lanes
+ */
+uint8_t ds1302_interface_lane_sclk_write(void *ctx, uint8_t value)
+{
+    return wire_clock_write(value);
+}
+
+/**
+ * @brief     interface lane io write
+ * @param[in] *ctx pointer to a lane context
+ * @param[in] mask port pins to drive
+ * @param[in] value port pin levels
+ * @return    status code
+ *            - 0 success
+ *            - 1 lane io write failed
+ * @note      one GPSET0 and one GPCLR0 store
+ */
+uint8_t ds1302_interface_lane_io_write(void *ctx, uint32_t mask, uint32_t value)
+{
+    return wire_lane_write(mask, value);
+}
+
+/**
+ * @brief      interface lane io read
+ * @param[in]  *ctx pointer to a lane context
+ * @param[out] *value pointer to a port word buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 lane io read failed
+ * @note       one GPLEV0 load
+ */
+uint8_t ds1302_interface_lane_io_read(void *ctx, uint32_t *value)
+{
+    return wire_lane_read(value);
+}
+
+/**
+ * @brief     interface lane io set direction
+ * @param[in] *ctx pointer to a lane context
+ * @param[in] mask port pins to change
+ * @param[in] output direction, 0 is input and 1 is output
+ * @return    status code
+ *            - 0 success
+ *            - 1 lane io set direction failed
+ * @note      none
+ */
+uint8_t ds1302_interface_lane_io_set_direction(void *ctx, uint32_t mask, uint8_t output)
+{
+    return wire_lane_set_direction(mask, output);
+}
+
+#endif
+
+/**
+ * @brief     interface timer start
+ * @param[in] hz tick rate
+ * @param[in] *tick pointer to a tick function, it runs from the timer interrupt
+ * @return    status code
+ *            - 0 success
+ *            - 1 timer start failed
+ * @note      linux offers no microsecond timer interrupt to user space, step the transfer from a thread instead
+ */
+uint8_t ds1302_interface_timer_start(uint32_t hz, void (*tick)(void))
+{
+    return 1;
+}
+
+/**
+ * @brief  interface timer stop
+ * @return status code
+ *         - 0 success
+ *         - 1 timer stop failed
+ * @note   none
+ */
+uint8_t ds1302_interface_timer_stop(void)
+{
+    return 1;
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -169,17 +817,27 @@ uint8_t ds1302_interface_io_gpio_read(uint8_t *value)
  */
 void ds1302_interface_delay_ms(uint32_t ms)
 {
-    usleep(1000 * ms);
+    delay_ms(ms);
 }
 
 /**
  * @brief     interface delay us
  * @param[in] us time
- * @note      none
+ * @note      calibrated busy wait, usleep would sleep for a whole scheduler tick
  */
 void ds1302_interface_delay_us(uint32_t us)
 {
-    usleep(us);
+    delay_us(us);
+}
+
+/**
+ * @brief  interface timestamp us
+ * @return free running microsecond counter
+ * @note   only differences are used, wrapping is fine
+ */
+uint32_t ds1302_interface_timestamp_us(void)
+{
+    return (uint32_t)(delay_get_ns() / 1000);
 }
 
 /**
@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      spi.h
+ * @brief     spi header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SPI_H
+#define SPI_H
+
+#include <unistd.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup spi spi function
+ * @brief    spi function modules
+ * @{
+ */
+
+/**
+ * @brief spi max length definition
+ */
+#define SPI_MAX_LEN        64        /**< max bytes in one transfer */
+
+/**
+ * @brief      spi bus init in the 3-wire mode, lsb first and cs active high
+ * @param[in]  *name pointer to a spi device name buffer
+ * @param[out] *fd pointer to a spi device handle buffer
+ * @param[in]  freq clock frequency in hz
+ * @return     status code
+ *             - 0 success
+ *             - 1 init failed
+ * @note       controllers without lsb first, like the bcm2835, fall back to reversing the bits in software
+ */
+uint8_t spi_init(char *name, int *fd, uint32_t freq);
+
+/**
+ * @brief     spi bus deinit
+ * @param[in] fd spi device handle
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
+ */
+uint8_t spi_deinit(int fd);
+
+/**
+ * @brief     spi bus write a command and its data in one message
+ * @param[in] fd spi device handle
+ * @param[in] *cmd pointer to a command buffer
+ * @param[in] cmd_len command length
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      one ioctl with two transfers, cs stays active between them
+ */
+uint8_t spi_write(int fd, uint8_t *cmd, uint32_t cmd_len, uint8_t *buf, uint32_t len);
+
+/**
+ * @brief      spi bus write a command and read its data in one message
+ * @param[in]  fd spi device handle
+ * @param[in]  *in_buf pointer to a command buffer
+ * @param[in]  in_len command length
+ * @param[out] *out_buf pointer to a data buffer
+ * @param[in]  out_len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 write read failed
+ * @note       one ioctl with two transfers, the line turns around between them
+ */
+uint8_t spi_write_read(int fd, uint8_t *in_buf, uint32_t in_len, uint8_t *out_buf, uint32_t out_len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -45,6 +45,17 @@
  extern "C" {
 #endif
 
+/**
+ * @brief cs line number definition
+ * @note  one cs line per chip on the shared io and clock lines, bcm 22, 23, 24 and 25 in order
+ */
+#ifndef WIRE_CS_NUM
+    #define WIRE_CS_NUM 1        /**< cs line number */
+#endif
+#if (WIRE_CS_NUM < 1) || (WIRE_CS_NUM > 4)
+    #error "WIRE_CS_NUM must be 1 to 4."
+#endif
+
 /**
  * @defgroup wire wire function
  * @brief    wire function modules
@@ -68,13 +79,23 @@ uint8_t wire_init(void);
  */
 uint8_t wire_deinit(void);
 
+/**
+ * @brief     wire bus set the direction
+ * @param[in] output direction, 0 is input and 1 is output
+ * @return    status code
+ *            - 0 success
+ *            - 1 set direction failed
+ * @note      the line is only reconfigured when the direction really changes
+ */
+uint8_t wire_set_direction(uint8_t output);
+
 /**
  * @brief      wire bus read data
  * @param[out] *value pointer to a data buffer
  * @return     status code
  *             - 0 success
  *             - 1 read failed
- * @note       none
+ * @note       the line must be set as input with wire_set_direction
  */
 uint8_t wire_read(uint8_t *value);
 
@@ -84,10 +105,33 @@ uint8_t wire_read(uint8_t *value);
  * @return    status code
  *            - 0 success
  *             - 1 write failed
- * @note      none
+ * @note      the line must be set as output with wire_set_direction
  */
 uint8_t wire_write(uint8_t value);
 
+/**
+ * @brief     wire bus write data and clock together
+ * @param[in] value write data
+ * @param[in] clock clock level
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      one ioctl for both lines, the data is only driven when the line is output
+ */
+uint8_t wire_data_clock_write(uint8_t value, uint8_t clock);
+
+/**
+ * @brief     wire bus write cs and data together
+ * @param[in] index cs line index
+ * @param[in] cs cs level
+ * @param[in] value write data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      one ioctl for both lines, the data is only driven when the line is output
+ */
+uint8_t wire_cs_data_write(uint8_t index, uint8_t cs, uint8_t value);
+
 /**
  * @brief  wire bus init
  * @return status code
@@ -116,31 +160,83 @@ uint8_t wire_clock_deinit(void);
 uint8_t wire_clock_write(uint8_t value);
 
 /**
- * @brief  wire bus cs init
- * @return status code
- *         - 0 success
- *         - 1 failed 
- * @note   none
+ * @brief     wire bus cs init
+ * @param[in] index cs line index
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed 
+ * @note      the cs line starts low so the other chips on the bus stay deselected
  */
-uint8_t wire_cs_init(void);
+uint8_t wire_cs_init(uint8_t index);
 
 /**
- * @brief  wire bus cs deint
- * @return status code
- *         - 0 success
- * @note   none
+ * @brief     wire bus cs deint
+ * @param[in] index cs line index
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      none
  */
-uint8_t wire_cs_deinit(void);
+uint8_t wire_cs_deinit(uint8_t index);
 
 /**
  * @brief     wire bus write data
+ * @param[in] index cs line index
  * @param[in] value write data
  * @return    status code
  *            - 0 success
  *            - 1 failed
  * @note      none
  */
-uint8_t wire_cs_write(uint8_t value);
+uint8_t wire_cs_write(uint8_t index, uint8_t value);
+
+/**
+ * @brief  wire lane init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   only the mmap backend has lanes, ce is the cs line of chip 0 and sclk is the clock line,
+ *         both are shared by all lanes and start low
+ */
+uint8_t wire_lane_init(void);
+
+/**
+ * @brief  wire lane deinit
+ * @return status code
+ *         - 0 success
+ * @note   releases the shared lines and every lane pin
+ */
+uint8_t wire_lane_deinit(void);
+
+/**
+ * @brief     wire lane set the direction
+ * @param[in] mask bcm pins of the lanes
+ * @param[in] output direction, 0 is input and 1 is output
+ * @return    status code
+ *            - 0 success
+ *            - 1 set direction failed
+ * @note      pins above 27 and the io, clock and cs lines can not be lanes
+ */
+uint8_t wire_lane_set_direction(uint32_t mask, uint8_t output);
+
+/**
+ * @brief     wire lane write data
+ * @param[in] mask bcm pins of the lanes
+ * @param[in] value pin levels
+ * @return    status code
+ *            - 0 success
+ * @note      one GPSET0 and one GPCLR0 store
+ */
+uint8_t wire_lane_write(uint32_t mask, uint32_t value);
+
+/**
+ * @brief      wire lane read data
+ * @param[out] *value pointer to a pin levels buffer
+ * @return     status code
+ *             - 0 success
+ * @note       one GPLEV0 load
+ */
+uint8_t wire_lane_read(uint32_t *value);
 
 /**
  * @}
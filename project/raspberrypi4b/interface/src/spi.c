@@ -0,0 +1,259 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      spi.c
+ * @brief     spi source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "spi.h"
+#include <fcntl.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <linux/spi/spidev.h>
+
+/**
+ * @brief global var definition
+ */
+static uint8_t gs_lsb_soft;        /**< reverse the bits in software */
+
+/**
+ * @brief     reverse the bits of each byte
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @note      none
+ */
+static void a_spi_reverse(uint8_t *buf, uint32_t len)
+{
+    uint32_t i;
+    uint8_t v;
+    
+    for (i = 0; i < len; i++)
+    {
+        v = buf[i];
+        v = (uint8_t)(((v & 0xF0) >> 4) | ((v & 0x0F) << 4));
+        v = (uint8_t)(((v & 0xCC) >> 2) | ((v & 0x33) << 2));
+        v = (uint8_t)(((v & 0xAA) >> 1) | ((v & 0x55) << 1));
+        buf[i] = v;
+    }
+}
+
+/**
+ * @brief      spi bus init in the 3-wire mode, lsb first and cs active high
+ * @param[in]  *name pointer to a spi device name buffer
+ * @param[out] *fd pointer to a spi device handle buffer
+ * @param[in]  freq clock frequency in hz
+ * @return     status code
+ *             - 0 success
+ *             - 1 init failed
+ * @note       controllers without lsb first, like the bcm2835, fall back to reversing the bits in software
+ */
+uint8_t spi_init(char *name, int *fd, uint32_t freq)
+{
+    uint32_t mode;
+    uint8_t bits;
+    
+    /* open the device */
+    *fd = open(name, O_RDWR);
+    if ((*fd) < 0)
+    {
+        perror("spi: open failed.\n");
+        
+        return 1;
+    }
+    
+    /* 3-wire, lsb first and cs active high */
+    mode = SPI_MODE_0 | SPI_3WIRE | SPI_LSB_FIRST | SPI_CS_HIGH;
+    gs_lsb_soft = 0;
+    if (ioctl(*fd, SPI_IOC_WR_MODE32, &mode) < 0)
+    {
+        /* msb first and reverse the bits */
+        mode &= ~SPI_LSB_FIRST;
+        gs_lsb_soft = 1;
+        if (ioctl(*fd, SPI_IOC_WR_MODE32, &mode) < 0)
+        {
+            perror("spi: set mode failed.\n");
+            (void)close(*fd);
+            
+            return 1;
+        }
+    }
+    
+    /* 8 bits per word */
+    bits = 8;
+    if (ioctl(*fd, SPI_IOC_WR_BITS_PER_WORD, &bits) < 0)
+    {
+        perror("spi: set bits failed.\n");
+        (void)close(*fd);
+        
+        return 1;
+    }
+    
+    /* set the clock frequency */
+    if (ioctl(*fd, SPI_IOC_WR_MAX_SPEED_HZ, &freq) < 0)
+    {
+        perror("spi: set speed failed.\n");
+        (void)close(*fd);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     spi bus deinit
+ * @param[in] fd spi device handle
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
+ */
+uint8_t spi_deinit(int fd)
+{
+    /* close the device */
+    if (close(fd) < 0)
+    {
+        perror("spi: close failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     spi bus write a command and its data in one message
+ * @param[in] fd spi device handle
+ * @param[in] *cmd pointer to a command buffer
+ * @param[in] cmd_len command length
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      one ioctl with two transfers, cs stays active between them
+ */
+uint8_t spi_write(int fd, uint8_t *cmd, uint32_t cmd_len, uint8_t *buf, uint32_t len)
+{
+    struct spi_ioc_transfer k_ioc[2];
+    uint8_t tx_cmd[SPI_MAX_LEN];
+    uint8_t tx_buf[SPI_MAX_LEN];
+    uint32_t num;
+    
+    /* check the length */
+    if ((cmd_len == 0) || (cmd_len > SPI_MAX_LEN) || (len > SPI_MAX_LEN))
+    {
+        return 1;
+    }
+    
+    /* copy the data */
+    memcpy(tx_cmd, cmd, cmd_len);
+    if (len != 0)
+    {
+        memcpy(tx_buf, buf, len);
+    }
+    if (gs_lsb_soft != 0)
+    {
+        a_spi_reverse(tx_cmd, cmd_len);
+        a_spi_reverse(tx_buf, len);
+    }
+    
+    /* command and data transfers */
+    memset(k_ioc, 0, sizeof(k_ioc));
+    k_ioc[0].tx_buf = (unsigned long)tx_cmd;
+    k_ioc[0].len = cmd_len;
+    k_ioc[1].tx_buf = (unsigned long)tx_buf;
+    k_ioc[1].len = len;
+    num = (len != 0) ? 2 : 1;
+    
+    /* send the message */
+    if (ioctl(fd, SPI_IOC_MESSAGE(num), k_ioc) < 0)
+    {
+        perror("spi: write failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      spi bus write a command and read its data in one message
+ * @param[in]  fd spi device handle
+ * @param[in]  *in_buf pointer to a command buffer
+ * @param[in]  in_len command length
+ * @param[out] *out_buf pointer to a data buffer
+ * @param[in]  out_len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 write read failed
+ * @note       one ioctl with two transfers, the line turns around between them
+ */
+uint8_t spi_write_read(int fd, uint8_t *in_buf, uint32_t in_len, uint8_t *out_buf, uint32_t out_len)
+{
+    struct spi_ioc_transfer k_ioc[2];
+    uint8_t tx_cmd[SPI_MAX_LEN];
+    
+    /* check the length */
+    if ((in_len == 0) || (in_len > SPI_MAX_LEN) || (out_len == 0) || (out_len > SPI_MAX_LEN))
+    {
+        return 1;
+    }
+    
+    /* copy the command */
+    memcpy(tx_cmd, in_buf, in_len);
+    if (gs_lsb_soft != 0)
+    {
+        a_spi_reverse(tx_cmd, in_len);
+    }
+    
+    /* the command goes out and the data comes back on the same line */
+    memset(k_ioc, 0, sizeof(k_ioc));
+    k_ioc[0].tx_buf = (unsigned long)tx_cmd;
+    k_ioc[0].len = in_len;
+    k_ioc[1].rx_buf = (unsigned long)out_buf;
+    k_ioc[1].len = out_len;
+    
+    /* send the message */
+    if (ioctl(fd, SPI_IOC_MESSAGE(2), k_ioc) < 0)
+    {
+        perror("spi: write read failed.\n");
+        
+        return 1;
+    }
+    if (gs_lsb_soft != 0)
+    {
+        a_spi_reverse(out_buf, out_len);
+    }
+    
+    return 0;
+}
@@ -47,188 +47,473 @@
  */
 #define GPIO_DEVICE_LINE 17                      /**< gpio device line */
 #define GPIO_DEVICE_CLOCK_LINE 27                /**< gpio device clock line */
-#define GPIO_DEVICE_CS_LINE 22                    /**< gpio device cs line */
+#define GPIO_DEVICE_CS_LINE 22                   /**< gpio device cs line of chip 0 */
+#define GPIO_DEVICE_CS1_LINE 23                  /**< gpio device cs line of chip 1 */
+#define GPIO_DEVICE_CS2_LINE 24                  /**< gpio device cs line of chip 2 */
+#define GPIO_DEVICE_CS3_LINE 25                  /**< gpio device cs line of chip 3 */
+
+/**
+ * @brief wire line index definition
+ */
+#define WIRE_LINE_IO    0                        /**< io line index */
+#define WIRE_LINE_CLOCK 1                        /**< clock line index */
+#define WIRE_LINE_CS    2                        /**< first cs line index */
+#define WIRE_LINE_NUM   (2 + WIRE_CS_NUM)        /**< requested line number */
+
+/**
+ * @brief wire line mask definition
+ */
+#define WIRE_MASK_IO    (1 << WIRE_LINE_IO)      /**< io line mask */
+#define WIRE_MASK_CLOCK (1 << WIRE_LINE_CLOCK)   /**< clock line mask */
+#define WIRE_MASK_CS(i) (1 << (WIRE_LINE_CS + (i))) /**< cs line mask */
 
 /**
  * @brief global var definition
  */
+static const unsigned int gsc_offsets[2 + 4] =
+{
+    GPIO_DEVICE_LINE, GPIO_DEVICE_CLOCK_LINE, GPIO_DEVICE_CS_LINE,
+    GPIO_DEVICE_CS1_LINE, GPIO_DEVICE_CS2_LINE, GPIO_DEVICE_CS3_LINE,
+};                                               /**< line offsets, the first WIRE_LINE_NUM are requested */
 static struct gpiod_chip *gs_chip;               /**< gpio chip handle */
-static struct gpiod_line *gs_line;               /**< gpio line handle */
-static struct gpiod_chip *gs_clock_chip;         /**< gpio clock chip handle */
-static struct gpiod_line *gs_clock_line;         /**< gpio clock line handle */
-static struct gpiod_chip *gs_cs_chip;            /**< gpio cs chip handle */
-static struct gpiod_line *gs_cs_line;            /**< gpio cs line handle */
+#ifdef WIRE_GPIOD_V2
+static struct gpiod_line_request *gs_request;    /**< gpio line request handle */
+#else
+static struct gpiod_line *gs_lines[WIRE_LINE_NUM];  /**< gpio line handles */
+static struct gpiod_line_bulk gs_bulk;           /**< gpio output line bulk */
+#endif
+static uint8_t gs_values[WIRE_LINE_NUM];         /**< output line values */
+static uint8_t gs_ref;                           /**< init reference count */
 static volatile uint8_t gs_read_write_flag;      /**< read write flag */
 
+#ifdef WIRE_GPIOD_V2
 /**
- * @brief  wire bus init
+ * @brief     make the line config
+ * @param[in] output io direction, 0 is input and 1 is output
+ * @return    pointer to a line config or NULL
+ * @note      outputs start at the shadowed values so a reconfigure does not glitch
+ */
+static struct gpiod_line_config *a_wire_line_config(uint8_t output)
+{
+    struct gpiod_line_config *config;
+    struct gpiod_line_settings *settings;
+    uint8_t i;
+    
+    config = gpiod_line_config_new();
+    if (config == NULL)
+    {
+        return NULL;
+    }
+    for (i = 0; i < WIRE_LINE_NUM; i++)
+    {
+        settings = gpiod_line_settings_new();
+        if (settings == NULL)
+        {
+            gpiod_line_config_free(config);
+            
+            return NULL;
+        }
+        if ((i == WIRE_LINE_IO) && (output == 0))
+        {
+            (void)gpiod_line_settings_set_direction(settings, GPIOD_LINE_DIRECTION_INPUT);
+        }
+        else
+        {
+            (void)gpiod_line_settings_set_direction(settings, GPIOD_LINE_DIRECTION_OUTPUT);
+            (void)gpiod_line_settings_set_output_value(settings, (gs_values[i] != 0) ? 
+                                                       GPIOD_LINE_VALUE_ACTIVE : GPIOD_LINE_VALUE_INACTIVE);
+        }
+        if (gpiod_line_config_add_line_settings(config, &gsc_offsets[i], 1, settings) != 0)
+        {
+            gpiod_line_settings_free(settings);
+            gpiod_line_config_free(config);
+            
+            return NULL;
+        }
+        gpiod_line_settings_free(settings);
+    }
+    
+    return config;
+}
+
+/**
+ * @brief  request all lines in one request
  * @return status code
  *         - 0 success
- *         - 1 init failed
+ *         - 1 request failed
  * @note   none
  */
-uint8_t wire_init(void)
+static uint8_t a_wire_request(void)
 {
-    /* open the gpio group */
-    gs_chip = gpiod_chip_open(GPIO_DEVICE_NAME);
-    if (gs_chip == NULL)
+    struct gpiod_line_config *config;
+    struct gpiod_request_config *req;
+    
+    config = a_wire_line_config(1);
+    if (config == NULL)
     {
-        perror("gpio: open failed.\n");
-        
         return 1;
     }
-    
-    /* get the gpio line */
-    gs_line = gpiod_chip_get_line(gs_chip, GPIO_DEVICE_LINE);
-    if (gs_line == NULL) 
+    req = gpiod_request_config_new();
+    if (req == NULL)
     {
-        perror("gpio: get line failed.\n");
-        gpiod_chip_close(gs_chip);
+        gpiod_line_config_free(config);
         
         return 1;
     }
+    gpiod_request_config_set_consumer(req, "ds1302");
+    gs_request = gpiod_chip_request_lines(gs_chip, req, config);
+    gpiod_request_config_free(req);
+    gpiod_line_config_free(config);
+    if (gs_request == NULL)
+    {
+        return 1;
+    }
     
-    /* set the flag */
-    gs_read_write_flag = 2;
-    
-    /* set high */
-    return wire_write(1);
+    return 0;
 }
 
 /**
- * @brief  wire bus deint
- * @return status code
- *         - 0 success
+ * @brief  release all lines
  * @note   none
  */
-uint8_t wire_deinit(void)
+static void a_wire_release(void)
 {
-    /* close the chip */
-    gpiod_chip_close(gs_chip);
+    gpiod_line_request_release(gs_request);
+    gs_request = NULL;
+}
+
+/**
+ * @brief     switch the io direction
+ * @param[in] output io direction, 0 is input and 1 is output
+ * @return    status code
+ *            - 0 success
+ *            - 1 reconfigure failed
+ * @note      the request is kept, only the line config changes
+ */
+static uint8_t a_wire_reconfigure(uint8_t output)
+{
+    struct gpiod_line_config *config;
+    int res;
+    
+    config = a_wire_line_config(output);
+    if (config == NULL)
+    {
+        return 1;
+    }
+    res = gpiod_line_request_reconfigure_lines(gs_request, config);
+    gpiod_line_config_free(config);
+    if (res != 0)
+    {
+        return 1;
+    }
     
     return 0;
 }
 
 /**
- * @brief      wire bus read data
- * @param[out] *value pointer to a data buffer
+ * @brief     drive the output lines
+ * @param[in] mask changed lines
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      one ioctl for all masked lines
+ */
+static uint8_t a_wire_update(uint8_t mask)
+{
+    unsigned int offsets[WIRE_LINE_NUM];
+    enum gpiod_line_value values[WIRE_LINE_NUM];
+    uint8_t num;
+    uint8_t i;
+    
+    num = 0;
+    for (i = 0; i < WIRE_LINE_NUM; i++)
+    {
+        if ((mask & (1 << i)) != 0)
+        {
+            offsets[num] = gsc_offsets[i];
+            values[num] = (gs_values[i] != 0) ? GPIOD_LINE_VALUE_ACTIVE : GPIOD_LINE_VALUE_INACTIVE;
+            num++;
+        }
+    }
+    if (num == 0)
+    {
+        return 0;
+    }
+    if (gpiod_line_request_set_values_subset(gs_request, num, offsets, values) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      read the io line
+ * @param[out] *value pointer to a value buffer
  * @return     status code
  *             - 0 success
  *             - 1 read failed
  * @note       none
  */
-uint8_t wire_read(uint8_t *value)
+static uint8_t a_wire_get(uint8_t *value)
 {
-    int res;
+    enum gpiod_line_value res;
     
-    /* check the flag */
-    if (gs_read_write_flag != 0)
+    res = gpiod_line_request_get_value(gs_request, gsc_offsets[WIRE_LINE_IO]);
+    if (res == GPIOD_LINE_VALUE_ERROR)
+    {
+        return 1;
+    }
+    *value = (res == GPIOD_LINE_VALUE_ACTIVE) ? 1 : 0;
+    
+    return 0;
+}
+#else
+/**
+ * @brief     request the lines
+ * @param[in] output io direction, 0 is input and 1 is output
+ * @return    status code
+ *            - 0 success
+ *            - 1 request failed
+ * @note      a v1 request carries one direction for all its lines, so an input io
+ *            is requested on its own and the outputs stay in one bulk
+ */
+static uint8_t a_wire_request_lines(uint8_t output)
+{
+    int values[WIRE_LINE_NUM];
+    uint8_t i;
+    
+    gpiod_line_bulk_init(&gs_bulk);
+    for (i = 0; i < WIRE_LINE_NUM; i++)
     {
-        /* check requested */
-        if (gpiod_line_is_requested(gs_line) != 0) 
+        if ((i == WIRE_LINE_IO) && (output == 0))
         {
-            /* release */
-            gpiod_line_release(gs_line);
+            continue;
         }
-        
-        /* set input */
-        if (gpiod_line_request_input(gs_line, "gpio_input") != 0) 
+        values[gpiod_line_bulk_num_lines(&gs_bulk)] = gs_values[i];
+        gpiod_line_bulk_add(&gs_bulk, gs_lines[i]);
+    }
+    if (gpiod_line_request_bulk_output(&gs_bulk, "ds1302", values) != 0)
+    {
+        return 1;
+    }
+    if (output == 0)
+    {
+        if (gpiod_line_request_input(gs_lines[WIRE_LINE_IO], "ds1302") != 0)
         {
+            gpiod_line_release_bulk(&gs_bulk);
+            
             return 1;
         }
-        
-        /* flag read */
-        gs_read_write_flag = 0;
     }
     
-    /* read the value */
-    res = gpiod_line_get_value(gs_line);
-    if (res < 0)
+    return 0;
+}
+
+/**
+ * @brief  request all lines in one request
+ * @return status code
+ *         - 0 success
+ *         - 1 request failed
+ * @note   none
+ */
+static uint8_t a_wire_request(void)
+{
+    uint8_t i;
+    
+    for (i = 0; i < WIRE_LINE_NUM; i++)
     {
-        return 1;
+        gs_lines[i] = gpiod_chip_get_line(gs_chip, gsc_offsets[i]);
+        if (gs_lines[i] == NULL)
+        {
+            return 1;
+        }
     }
     
-    /* set the value */
-    *value = (uint8_t)(res);
+    return a_wire_request_lines(1);
+}
+
+/**
+ * @brief  release all lines
+ * @note   none
+ */
+static void a_wire_release(void)
+{
+    gpiod_line_release_bulk(&gs_bulk);
+    if (gpiod_line_is_requested(gs_lines[WIRE_LINE_IO]) != 0)
+    {
+        gpiod_line_release(gs_lines[WIRE_LINE_IO]);
+    }
+}
+
+/**
+ * @brief     switch the io direction
+ * @param[in] output io direction, 0 is input and 1 is output
+ * @return    status code
+ *            - 0 success
+ *            - 1 reconfigure failed
+ * @note      the outputs are requested again at their shadowed values
+ */
+static uint8_t a_wire_reconfigure(uint8_t output)
+{
+    a_wire_release();
     
-    return 0;
+    return a_wire_request_lines(output);
 }
 
 /**
- * @brief     wire bus write data
- * @param[in] value write data
+ * @brief     drive the output lines
+ * @param[in] mask changed lines
  * @return    status code
  *            - 0 success
- *             - 1 write failed
- * @note      none
+ *            - 1 set failed
+ * @note      the whole output bulk is written with one ioctl
  */
-uint8_t wire_write(uint8_t value)
+static uint8_t a_wire_update(uint8_t mask)
 {
-    /* check the flag */
-    if (gs_read_write_flag != 1)
+    int values[WIRE_LINE_NUM];
+    uint8_t num;
+    uint8_t i;
+    
+    (void)mask;
+    num = 0;
+    for (i = 0; i < WIRE_LINE_NUM; i++)
     {
-        /* check requested */
-        if (gpiod_line_is_requested(gs_line) != 0) 
+        if ((i == WIRE_LINE_IO) && (gs_read_write_flag != 1))
         {
-            /* release */
-            gpiod_line_release(gs_line);
+            continue;
         }
-        
-        /* set output */
-        if (gpiod_line_request_output(gs_line, "gpio_output", GPIOD_LINE_ACTIVE_STATE_HIGH) != 0)
-        {
-            return 1;
-        }
-        
-        /* flag write */
-        gs_read_write_flag = 1;
+        values[num] = gs_values[i];
+        num++;
+    }
+    if (gpiod_line_set_value_bulk(&gs_bulk, values) != 0)
+    {
+        return 1;
     }
     
-    /* set the value */
-    if (gpiod_line_set_value(gs_line, value) != 0)
+    return 0;
+}
+
+/**
+ * @brief      read the io line
+ * @param[out] *value pointer to a value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_wire_get(uint8_t *value)
+{
+    int res;
+    
+    res = gpiod_line_get_value(gs_lines[WIRE_LINE_IO]);
+    if (res < 0)
     {
         return 1;
     }
+    *value = (uint8_t)(res);
     
     return 0;
 }
+#endif
 
 /**
- * @brief  wire bus init
+ * @brief  open the chip and request the lines on first use
  * @return status code
  *         - 0 success
- *         - 1 init failed
- * @note   none
+ *         - 1 open failed
+ * @note   wire, wire clock and all wire cs lines share one chip handle and one request
  */
-uint8_t wire_clock_init(void)
+static uint8_t a_wire_open(void)
 {
+    uint8_t i;
+    
+    /* check the reference */
+    if (gs_ref != 0)
+    {
+        gs_ref++;
+        
+        return 0;
+    }
+    
     /* open the gpio group */
-    gs_clock_chip = gpiod_chip_open(GPIO_DEVICE_NAME);
-    if (gs_clock_chip == NULL)
+    gs_chip = gpiod_chip_open(GPIO_DEVICE_NAME);
+    if (gs_chip == NULL)
     {
         perror("gpio: open failed.\n");
         
         return 1;
     }
     
-    /* get the gpio line */
-    gs_clock_line = gpiod_chip_get_line(gs_clock_chip, GPIO_DEVICE_CLOCK_LINE);
-    if (gs_clock_line == NULL) 
+    /* io and clock start high, cs starts low so no chip is selected */
+    for (i = 0; i < WIRE_LINE_NUM; i++)
     {
-        perror("gpio: get line failed.\n");
-        gpiod_chip_close(gs_clock_chip);
+        gs_values[i] = (i < WIRE_LINE_CS) ? 1 : 0;
+    }
+    gs_read_write_flag = 1;
+    
+    /* request the lines */
+    if (a_wire_request() != 0)
+    {
+        perror("gpio: request lines failed.\n");
+        gpiod_chip_close(gs_chip);
+        gs_read_write_flag = 2;
+        
+        return 1;
+    }
+    gs_ref = 1;
+    
+    return 0;
+}
 
+/**
+ * @brief  release the lines and close the chip on last use
+ * @note   none
+ */
+static void a_wire_close(void)
+{
+    /* check the reference */
+    if (gs_ref == 0)
+    {
+        return;
+    }
+    gs_ref--;
+    if (gs_ref != 0)
+    {
+        return;
+    }
+    
+    /* release and close */
+    a_wire_release();
+    gpiod_chip_close(gs_chip);
+    gs_read_write_flag = 2;
+}
+
+/**
+ * @brief  wire bus init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   none
+ */
+uint8_t wire_init(void)
+{
+    /* open the chip */
+    if (a_wire_open() != 0)
+    {
         return 1;
     }
     
     /* set output */
-    if (gpiod_line_request_output(gs_clock_line, "gpio_output", GPIOD_LINE_ACTIVE_STATE_HIGH) != 0)
+    if (wire_set_direction(1) != 0)
     {
+        a_wire_close();
+        
         return 1;
     }
     
     /* set high */
-    return wire_clock_write(1);
+    return wire_write(1);
 }
 
 /**
@@ -237,100 +522,240 @@ uint8_t wire_clock_init(void)
  *         - 0 success
  * @note   none
  */
-uint8_t wire_clock_deinit(void)
+uint8_t wire_deinit(void)
 {
     /* close the chip */
-    gpiod_chip_close(gs_clock_chip);
+    a_wire_close();
     
     return 0;
 }
 
+/**
+ * @brief     wire bus set the direction
+ * @param[in] output direction, 0 is input and 1 is output
+ * @return    status code
+ *            - 0 success
+ *            - 1 set direction failed
+ * @note      the line is only reconfigured when the direction really changes
+ */
+uint8_t wire_set_direction(uint8_t output)
+{
+    output = (output != 0) ? 1 : 0;
+    
+    /* check the flag */
+    if (gs_read_write_flag == output)
+    {
+        return 0;
+    }
+    
+    /* reconfigure the io line */
+    if (a_wire_reconfigure(output) != 0)
+    {
+        gs_read_write_flag = 2;
+        
+        return 1;
+    }
+    
+    /* set the flag */
+    gs_read_write_flag = output;
+    
+    return 0;
+}
+
+/**
+ * @brief      wire bus read data
+ * @param[out] *value pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the line must be set as input with wire_set_direction
+ */
+uint8_t wire_read(uint8_t *value)
+{
+    return a_wire_get(value);
+}
+
 /**
  * @brief     wire bus write data
  * @param[in] value write data
  * @return    status code
  *            - 0 success
  *            - 1 write failed
- * @note      none
+ * @note      the line must be set as output with wire_set_direction
  */
-uint8_t wire_clock_write(uint8_t value)
+uint8_t wire_write(uint8_t value)
 {
-    /* write the value */
-    if (gpiod_line_set_value(gs_clock_line, value) != 0)
+    /* check the direction */
+    if (gs_read_write_flag != 1)
     {
         return 1;
     }
     
-    return 0;
+    /* set the value */
+    gs_values[WIRE_LINE_IO] = value;
+    
+    return a_wire_update(WIRE_MASK_IO);
+}
+
+/**
+ * @brief     wire bus write data and clock together
+ * @param[in] value write data
+ * @param[in] clock clock level
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      one ioctl for both lines, the data is only driven when the line is output
+ */
+uint8_t wire_data_clock_write(uint8_t value, uint8_t clock)
+{
+    /* set the values */
+    gs_values[WIRE_LINE_IO] = value;
+    gs_values[WIRE_LINE_CLOCK] = clock;
+    
+    return a_wire_update((gs_read_write_flag == 1) ? (WIRE_MASK_IO | WIRE_MASK_CLOCK) : WIRE_MASK_CLOCK);
 }
 
 /**
- * @brief  wire bus cs init
+ * @brief     wire bus write cs and data together
+ * @param[in] index cs line index
+ * @param[in] cs cs level
+ * @param[in] value write data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      one ioctl for both lines, the data is only driven when the line is output
+ */
+uint8_t wire_cs_data_write(uint8_t index, uint8_t cs, uint8_t value)
+{
+    /* check the index */
+    if (index >= WIRE_CS_NUM)
+    {
+        return 1;
+    }
+    
+    /* set the values */
+    gs_values[WIRE_LINE_CS + index] = cs;
+    gs_values[WIRE_LINE_IO] = value;
+    
+    return a_wire_update((gs_read_write_flag == 1) ? (WIRE_MASK_CS(index) | WIRE_MASK_IO) : WIRE_MASK_CS(index));
+}
+
+/**
+ * @brief  wire bus init
  * @return status code
  *         - 0 success
- *         - 1 failed 
+ *         - 1 init failed
  * @note   none
  */
-uint8_t wire_cs_init(void)
+uint8_t wire_clock_init(void)
 {
-    /* open the device */
-    gs_cs_chip = gpiod_chip_open(GPIO_DEVICE_NAME);
-    if (gs_cs_chip == NULL)
+    /* open the chip */
+    if (a_wire_open() != 0)
     {
-        perror("gpio: open failed.\n");
-        
         return 1;
     }
+    
+    /* set high */
+    return wire_clock_write(1);
+}
+
+/**
+ * @brief  wire bus deint
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t wire_clock_deinit(void)
+{
+    /* close the chip */
+    a_wire_close();
+    
+    return 0;
+}
+
+/**
+ * @brief     wire bus write data
+ * @param[in] value write data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t wire_clock_write(uint8_t value)
+{
+    /* write the value */
+    gs_values[WIRE_LINE_CLOCK] = value;
+    
+    return a_wire_update(WIRE_MASK_CLOCK);
+}
 
-    /* get the line */
-    gs_cs_line = gpiod_chip_get_line(gs_cs_chip, GPIO_DEVICE_CS_LINE);
-    if (gs_cs_line == NULL) 
+/**
+ * @brief     wire bus cs init
+ * @param[in] index cs line index
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed 
+ * @note      the cs line starts low so the other chips on the bus stay deselected
+ */
+uint8_t wire_cs_init(uint8_t index)
+{
+    /* check the index */
+    if (index >= WIRE_CS_NUM)
     {
-        perror("gpio: get line failed.\n");
-        gpiod_chip_close(gs_cs_chip);
-        
         return 1;
     }
-
-    /* set active high */
-    if (gpiod_line_request_output(gs_cs_line, "gpio_output", GPIOD_LINE_ACTIVE_STATE_HIGH))
+    
+    /* open the chip */
+    if (a_wire_open() != 0)
     {
         return 1;
     }
 
-    /* set cs high */
-    return wire_cs_write(1);
+    /* set cs low */
+    return wire_cs_write(index, 0);
 }
 
 /**
- * @brief  wire bus cs deint
- * @return status code
- *         - 0 success
- * @note   none
+ * @brief     wire bus cs deint
+ * @param[in] index cs line index
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      none
  */
-uint8_t wire_cs_deinit(void)
+uint8_t wire_cs_deinit(uint8_t index)
 {
-    /* close the gpio */
-    gpiod_chip_close(gs_cs_chip);
+    /* check the index */
+    if (index >= WIRE_CS_NUM)
+    {
+        return 1;
+    }
+    
+    /* close the chip */
+    a_wire_close();
     
     return 0;
 }
 
 /**
  * @brief     wire bus write data
+ * @param[in] index cs line index
  * @param[in] value write data
  * @return    status code
  *            - 0 success
  *            - 1 failed
  * @note      none
  */
-uint8_t wire_cs_write(uint8_t value)
+uint8_t wire_cs_write(uint8_t index, uint8_t value)
 {
-    /* set the value */
-    if (gpiod_line_set_value(gs_cs_line, value))
+    /* check the index */
+    if (index >= WIRE_CS_NUM)
     {
         return 1;
     }
+    
+    /* set the value */
+    gs_values[WIRE_LINE_CS + index] = value;
 
-    return 0;
+    return a_wire_update(WIRE_MASK_CS(index));
 }
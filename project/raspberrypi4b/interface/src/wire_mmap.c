@@ -0,0 +1,626 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ * @file      wire_mmap.c
+ * @brief     wire mmap source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "wire.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+
+/**
+ * @brief gpio device name definition
+ */
+#define GPIO_DEVICE_NAME "/dev/gpiomem"          /**< gpio register device name */
+#define GPIO_DEVICE_ENV  "DS1302_GPIOMEM"        /**< env var overriding the register device */
+#define GPIO_DEVICE_SIZE 4096                    /**< mapped register block size */
+
+/**
+ * @brief gpio device line definition
+ */
+#define GPIO_DEVICE_LINE 17                      /**< gpio device line */
+#define GPIO_DEVICE_CLOCK_LINE 27                /**< gpio device clock line */
+#define GPIO_DEVICE_CS_LINE 22                   /**< gpio device cs line of chip 0 */
+#define GPIO_DEVICE_CS1_LINE 23                  /**< gpio device cs line of chip 1 */
+#define GPIO_DEVICE_CS2_LINE 24                  /**< gpio device cs line of chip 2 */
+#define GPIO_DEVICE_CS3_LINE 25                  /**< gpio device cs line of chip 3 */
+
+/**
+ * @brief bcm2711 gpio register definition
+ */
+#define GPIO_REG_GPFSEL0 (0x00 / 4)              /**< function select 0 word offset */
+#define GPIO_REG_GPSET0  (0x1C / 4)              /**< pin output set 0 word offset */
+#define GPIO_REG_GPCLR0  (0x28 / 4)              /**< pin output clear 0 word offset */
+#define GPIO_REG_GPLEV0  (0x34 / 4)              /**< pin level 0 word offset */
+
+/**
+ * @brief lane pin definition
+ */
+#define WIRE_LANE_PINS   0x0FFFFFFFU             /**< bcm 0 to 27 on the header */
+
+/**
+ * @brief global var definition
+ */
+static const uint8_t gsc_cs_lines[4] =
+{
+    GPIO_DEVICE_CS_LINE, GPIO_DEVICE_CS1_LINE, GPIO_DEVICE_CS2_LINE, GPIO_DEVICE_CS3_LINE,
+};                                               /**< cs lines, the first WIRE_CS_NUM are used */
+static volatile uint32_t *gs_reg;                /**< mapped register block */
+static uint32_t gs_lane_mask;                   /**< lane pins set up so far */
+static uint8_t gs_ref;                           /**< init reference count */
+static volatile uint8_t gs_read_write_flag;      /**< read write flag */
+
+/**
+ * @brief     set the line function
+ * @param[in] line gpio line
+ * @param[in] output 0 is input and 1 is output
+ * @note      none
+ */
+static void a_wire_fsel(uint8_t line, uint8_t output)
+{
+    uint32_t shift;
+    uint32_t reg;
+    
+    shift = (uint32_t)(line % 10) * 3;
+    reg = gs_reg[GPIO_REG_GPFSEL0 + line / 10];
+    reg &= ~(0x7U << shift);
+    if (output != 0)
+    {
+        reg |= 0x1U << shift;
+    }
+    gs_reg[GPIO_REG_GPFSEL0 + line / 10] = reg;
+}
+
+/**
+ * @brief     drive the lines
+ * @param[in] set lines driven high
+ * @param[in] clr lines driven low
+ * @note      no syscall, one store per register
+ */
+static void a_wire_update(uint32_t set, uint32_t clr)
+{
+    if (set != 0)
+    {
+        gs_reg[GPIO_REG_GPSET0] = set;
+    }
+    if (clr != 0)
+    {
+        gs_reg[GPIO_REG_GPCLR0] = clr;
+    }
+}
+
+/**
+ * @brief  map the register block on first use
+ * @return status code
+ *         - 0 success
+ *         - 1 map failed
+ * @note   the DS1302_GPIOMEM env var points the backend at another file,
+ *         a plain file of at least 4096 bytes works for testing without a pi
+ */
+static uint8_t a_wire_open(void)
+{
+    const char *name;
+    void *map;
+    int fd;
+    
+    /* check the reference */
+    if (gs_ref != 0)
+    {
+        gs_ref++;
+        
+        return 0;
+    }
+    
+    /* get the device name */
+    name = getenv(GPIO_DEVICE_ENV);
+    if (name == NULL)
+    {
+        name = GPIO_DEVICE_NAME;
+    }
+    
+    /* open the device */
+    fd = open(name, O_RDWR | O_SYNC);
+    if (fd < 0)
+    {
+        perror("gpio: open failed.\n");
+        
+        return 1;
+    }
+    
+    /* map the registers */
+    map = mmap(NULL, GPIO_DEVICE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (map == MAP_FAILED)
+    {
+        perror("gpio: mmap failed.\n");
+        
+        return 1;
+    }
+    gs_reg = (volatile uint32_t *)map;
+    gs_read_write_flag = 2;
+    gs_ref = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief  unmap the register block on last use
+ * @note   none
+ */
+static void a_wire_close(void)
+{
+    /* check the reference */
+    if (gs_ref == 0)
+    {
+        return;
+    }
+    gs_ref--;
+    if (gs_ref != 0)
+    {
+        return;
+    }
+    
+    /* unmap */
+    (void)munmap((void *)gs_reg, GPIO_DEVICE_SIZE);
+    gs_reg = NULL;
+    gs_read_write_flag = 2;
+}
+
+/**
+ * @brief  wire bus init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   none
+ */
+uint8_t wire_init(void)
+{
+    /* map the registers */
+    if (a_wire_open() != 0)
+    {
+        return 1;
+    }
+    
+    /* set output */
+    if (wire_set_direction(1) != 0)
+    {
+        a_wire_close();
+        
+        return 1;
+    }
+    
+    /* set high */
+    return wire_write(1);
+}
+
+/**
+ * @brief  wire bus deint
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t wire_deinit(void)
+{
+    /* release the line */
+    a_wire_fsel(GPIO_DEVICE_LINE, 0);
+    a_wire_close();
+    
+    return 0;
+}
+
+/**
+ * @brief     wire bus set the direction
+ * @param[in] output direction, 0 is input and 1 is output
+ * @return    status code
+ *            - 0 success
+ * @note      the line is only reconfigured when the direction really changes
+ */
+uint8_t wire_set_direction(uint8_t output)
+{
+    output = (output != 0) ? 1 : 0;
+    
+    /* check the flag */
+    if (gs_read_write_flag == output)
+    {
+        return 0;
+    }
+    
+    /* set the function */
+    a_wire_fsel(GPIO_DEVICE_LINE, output);
+    gs_read_write_flag = output;
+    
+    return 0;
+}
+
+/**
+ * @brief      wire bus read data
+ * @param[out] *value pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the line must be set as input with wire_set_direction
+ */
+uint8_t wire_read(uint8_t *value)
+{
+    /* read the level */
+    *value = (uint8_t)((gs_reg[GPIO_REG_GPLEV0] >> GPIO_DEVICE_LINE) & 0x01);
+    
+    return 0;
+}
+
+/**
+ * @brief     wire bus write data
+ * @param[in] value write data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the line must be set as output with wire_set_direction
+ */
+uint8_t wire_write(uint8_t value)
+{
+    /* check the direction */
+    if (gs_read_write_flag != 1)
+    {
+        return 1;
+    }
+    
+    /* set the value */
+    if (value != 0)
+    {
+        a_wire_update(1U << GPIO_DEVICE_LINE, 0);
+    }
+    else
+    {
+        a_wire_update(0, 1U << GPIO_DEVICE_LINE);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     wire bus write data and clock together
+ * @param[in] value write data
+ * @param[in] clock clock level
+ * @return    status code
+ *            - 0 success
+ * @note      the data only reaches the pin when the line is output
+ */
+uint8_t wire_data_clock_write(uint8_t value, uint8_t clock)
+{
+    uint32_t set;
+    uint32_t clr;
+    
+    set = (clock != 0) ? (1U << GPIO_DEVICE_CLOCK_LINE) : 0;
+    clr = (clock != 0) ? 0 : (1U << GPIO_DEVICE_CLOCK_LINE);
+    if (value != 0)
+    {
+        set |= 1U << GPIO_DEVICE_LINE;
+    }
+    else
+    {
+        clr |= 1U << GPIO_DEVICE_LINE;
+    }
+    a_wire_update(set, clr);
+    
+    return 0;
+}
+
+/**
+ * @brief     wire bus write cs and data together
+ * @param[in] index cs line index
+ * @param[in] cs cs level
+ * @param[in] value write data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the data only reaches the pin when the line is output
+ */
+uint8_t wire_cs_data_write(uint8_t index, uint8_t cs, uint8_t value)
+{
+    uint32_t set;
+    uint32_t clr;
+    
+    /* check the index */
+    if (index >= WIRE_CS_NUM)
+    {
+        return 1;
+    }
+    
+    set = (cs != 0) ? (1U << gsc_cs_lines[index]) : 0;
+    clr = (cs != 0) ? 0 : (1U << gsc_cs_lines[index]);
+    if (value != 0)
+    {
+        set |= 1U << GPIO_DEVICE_LINE;
+    }
+    else
+    {
+        clr |= 1U << GPIO_DEVICE_LINE;
+    }
+    a_wire_update(set, clr);
+    
+    return 0;
+}
+
+/**
+ * @brief  wire bus init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   none
+ */
+uint8_t wire_clock_init(void)
+{
+    /* map the registers */
+    if (a_wire_open() != 0)
+    {
+        return 1;
+    }
+    
+    /* set output */
+    a_wire_fsel(GPIO_DEVICE_CLOCK_LINE, 1);
+    
+    /* set high */
+    return wire_clock_write(1);
+}
+
+/**
+ * @brief  wire bus deint
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t wire_clock_deinit(void)
+{
+    /* release the line */
+    a_wire_fsel(GPIO_DEVICE_CLOCK_LINE, 0);
+    a_wire_close();
+    
+    return 0;
+}
+
+/**
+ * @brief     wire bus write data
+ * @param[in] value write data
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t wire_clock_write(uint8_t value)
+{
+    /* write the value */
+    if (value != 0)
+    {
+        a_wire_update(1U << GPIO_DEVICE_CLOCK_LINE, 0);
+    }
+    else
+    {
+        a_wire_update(0, 1U << GPIO_DEVICE_CLOCK_LINE);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     wire bus cs init
+ * @param[in] index cs line index
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed 
+ * @note      the cs line starts low so the other chips on the bus stay deselected
+ */
+uint8_t wire_cs_init(uint8_t index)
+{
+    /* check the index */
+    if (index >= WIRE_CS_NUM)
+    {
+        return 1;
+    }
+    
+    /* map the registers */
+    if (a_wire_open() != 0)
+    {
+        return 1;
+    }
+    
+    /* set cs low before it drives */
+    a_wire_update(0, 1U << gsc_cs_lines[index]);
+    
+    /* set output */
+    a_wire_fsel(gsc_cs_lines[index], 1);
+
+    return 0;
+}
+
+/**
+ * @brief     wire bus cs deint
+ * @param[in] index cs line index
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      none
+ */
+uint8_t wire_cs_deinit(uint8_t index)
+{
+    /* check the index */
+    if (index >= WIRE_CS_NUM)
+    {
+        return 1;
+    }
+    
+    /* release the line */
+    a_wire_fsel(gsc_cs_lines[index], 0);
+    a_wire_close();
+    
+    return 0;
+}
+
+/**
+ * @brief     wire bus write data
+ * @param[in] index cs line index
+ * @param[in] value write data
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      none
+ */
+uint8_t wire_cs_write(uint8_t index, uint8_t value)
+{
+    /* check the index */
+    if (index >= WIRE_CS_NUM)
+    {
+        return 1;
+    }
+    
+    /* set the value */
+    if (value != 0)
+    {
+        a_wire_update(1U << gsc_cs_lines[index], 0);
+    }
+    else
+    {
+        a_wire_update(0, 1U << gsc_cs_lines[index]);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief  wire lane init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   only the mmap backend has lanes, ce is the cs line of chip 0 and sclk is the clock line,
+ *         both are shared by all lanes and start low
+ */
+uint8_t wire_lane_init(void)
+{
+    /* map the registers */
+    if (a_wire_open() != 0)
+    {
+        return 1;
+    }
+    
+    /* set ce and sclk low before they drive */
+    a_wire_update(0, (1U << gsc_cs_lines[0]) | (1U << GPIO_DEVICE_CLOCK_LINE));
+    a_wire_fsel(gsc_cs_lines[0], 1);
+    a_wire_fsel(GPIO_DEVICE_CLOCK_LINE, 1);
+    gs_lane_mask = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief  wire lane deinit
+ * @return status code
+ *         - 0 success
+ * @note   releases the shared lines and every lane pin
+ */
+uint8_t wire_lane_deinit(void)
+{
+    /* release the lines */
+    (void)wire_lane_set_direction(gs_lane_mask, 0);
+    a_wire_fsel(gsc_cs_lines[0], 0);
+    a_wire_fsel(GPIO_DEVICE_CLOCK_LINE, 0);
+    gs_lane_mask = 0;
+    a_wire_close();
+    
+    return 0;
+}
+
+/**
+ * @brief     wire lane set the direction
+ * @param[in] mask bcm pins of the lanes
+ * @param[in] output direction, 0 is input and 1 is output
+ * @return    status code
+ *            - 0 success
+ *            - 1 set direction failed
+ * @note      pins above 27 and the io, clock and cs lines can not be lanes
+ */
+uint8_t wire_lane_set_direction(uint32_t mask, uint8_t output)
+{
+    uint32_t reserved;
+    uint8_t i;
+    
+    /* check the pins */
+    reserved = (1U << GPIO_DEVICE_LINE) | (1U << GPIO_DEVICE_CLOCK_LINE);
+    for (i = 0; i < WIRE_CS_NUM; i++)
+    {
+        reserved |= 1U << gsc_cs_lines[i];
+    }
+    if (((mask & ~WIRE_LANE_PINS) != 0) || ((mask & reserved) != 0))
+    {
+        return 1;
+    }
+    
+    /* set the functions */
+    for (i = 0; i < 28; i++)
+    {
+        if (((mask >> i) & 0x01) != 0)
+        {
+            a_wire_fsel(i, output);
+        }
+    }
+    gs_lane_mask |= mask;
+    
+    return 0;
+}
+
+/**
+ * @brief     wire lane write data
+ * @param[in] mask bcm pins of the lanes
+ * @param[in] value pin levels
+ * @return    status code
+ *            - 0 success
+ * @note      one GPSET0 and one GPCLR0 store
+ */
+uint8_t wire_lane_write(uint32_t mask, uint32_t value)
+{
+    /* set the values */
+    a_wire_update(mask & value, mask & ~value);
+    
+    return 0;
+}
+
+/**
+ * @brief      wire lane read data
+ * @param[out] *value pointer to a pin levels buffer
+ * @return     status code
+ *             - 0 success
+ * @note       one GPLEV0 load
+ */
+uint8_t wire_lane_read(uint32_t *value)
+{
+    /* read all levels */
+    *value = gs_reg[GPIO_REG_GPLEV0];
+    
+    return 0;
+}
@@ -36,12 +36,34 @@
 
 #include "driver_ds1302_register_test.h"
 #include "driver_ds1302_ram_test.h"
+#include "driver_ds1302_benchmark.h"
+#include "driver_ds1302_trace.h"
+#include "driver_ds1302_bus_test.h"
+#if defined(WIRE_MMAP)
+#include "driver_ds1302_parallel_test.h"
+#endif
 #include "driver_ds1302_basic.h"
 #include "driver_ds1302_advance.h"
+#include "driver_ds1302_async.h"
 #include <getopt.h>
 #include <stdlib.h>
 #include <math.h>
 
+/**
+ * @brief async var definition
+ */
+static volatile uint8_t gs_async_res;        /**< async transfer result */
+
+/**
+ * @brief     async transfer done callback
+ * @param[in] res transfer result
+ * @note      it runs from the timer interrupt
+ */
+static void a_async_done(uint8_t res)
+{
+    gs_async_res = res;
+}
+
 /**
  * @brief     ds1302 full function
  * @param[in] argc arg numbers
@@ -71,6 +93,7 @@ uint8_t ds1302(uint8_t argc, char **argv)
         {"times", required_argument, NULL, 5},
         {"timestamp", required_argument, NULL, 6},
         {"type", required_argument, NULL, 7},
+        {"format", required_argument, NULL, 8},
         {NULL, 0, NULL, 0},
     };
     char type[33] = "unknown";
@@ -84,6 +107,7 @@ uint8_t ds1302(uint8_t argc, char **argv)
     uint8_t charge = DS1302_CHARGE_DISABLE;
     uint8_t charge_flag = 0x00;
     ds1302_burst_type_t burst_type = DS1302_BURST_TYPE_RAM;
+    ds1302_benchmark_format_t format = DS1302_BENCHMARK_FORMAT_CSV;
     uint8_t burst_buffer[31];
 
     /* if no params */
@@ -367,6 +391,25 @@ uint8_t ds1302(uint8_t argc, char **argv)
                 break;
             }
             
+            /* format */
+            case 8 :
+            {
+                if (strcmp(optarg, "CSV") == 0)
+                {
+                    format = DS1302_BENCHMARK_FORMAT_CSV;
+                }
+                else if (strcmp(optarg, "JSON") == 0)
+                {
+                    format = DS1302_BENCHMARK_FORMAT_JSON;
+                }
+                else
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
             /* the end */
             case -1 :
             {
@@ -402,6 +445,48 @@ uint8_t ds1302(uint8_t argc, char **argv)
         
         return 0;
     }
+    else if (strcmp("t_bench", type) == 0)
+    {
+        /* run benchmark */
+        if (ds1302_benchmark(format, times) != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_trace", type) == 0)
+    {
+        /* run trace capture */
+        if (ds1302_trace_capture() != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_bus", type) == 0)
+    {
+        /* run bus test */
+        if (ds1302_bus_test() != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+#if defined(WIRE_MMAP)
+    else if (strcmp("t_parallel", type) == 0)
+    {
+        /* run parallel test */
+        if (ds1302_parallel_test() != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+#endif
     else if (strcmp("e_basic-set-time", type) == 0)
     {
         uint8_t res;
@@ -857,6 +942,58 @@ uint8_t ds1302(uint8_t argc, char **argv)
         
         return 0;
     }
+    else if (strcmp("e_async-read-burst", type) == 0)
+    {
+        uint8_t res;
+        uint8_t i;
+        uint8_t len;
+        uint16_t timeout;
+        ds1302_bool_t busy;
+        
+        /* async init */
+        res = ds1302_async_init(DS1302_ASYNC_DEFAULT_BIT_RATE);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* submit the burst, it returns at once */
+        len = (burst_type == DS1302_BURST_TYPE_CLOCK) ? 8 : 31;
+        gs_async_res = 1;
+        res = ds1302_async_submit((burst_type == DS1302_BURST_TYPE_CLOCK) ? DS1302_XFER_OP_CLOCK_BURST_READ : DS1302_XFER_OP_RAM_BURST_READ,
+                                  burst_buffer, len, a_async_done);
+        if (res != 0)
+        {
+            (void)ds1302_async_deinit();
+            
+            return 1;
+        }
+        
+        /* the cpu is free while the timer clocks the bus */
+        timeout = 1000;
+        do
+        {
+            ds1302_interface_delay_ms(1);
+            (void)ds1302_async_get_busy(&busy);
+            timeout--;
+        } while ((busy == DS1302_BOOL_TRUE) && (timeout != 0));
+        if ((busy == DS1302_BOOL_TRUE) || (gs_async_res != 0))
+        {
+            ds1302_interface_debug_print("ds1302: async burst read failed.\n");
+            (void)ds1302_async_deinit();
+            
+            return 1;
+        }
+        ds1302_interface_debug_print("%s burst read: ", (burst_type == DS1302_BURST_TYPE_CLOCK) ? "clock" : "ram");
+        for (i = 0; i < len; i++)
+        {
+            ds1302_interface_debug_print("0x%02X ", burst_buffer[i]);
+        }
+        
+        (void)ds1302_async_deinit();
+        
+        return 0;
+    }
     else if (strcmp("h", type) == 0)
     {
         help:
@@ -866,6 +1003,12 @@ uint8_t ds1302(uint8_t argc, char **argv)
         ds1302_interface_debug_print("  ds1302 (-p | --port)\n");
         ds1302_interface_debug_print("  ds1302 (-t reg | --test=reg)\n");
         ds1302_interface_debug_print("  ds1302 (-t ram | --test=ram) [--times=<num>]\n");
+        ds1302_interface_debug_print("  ds1302 (-t bench | --test=bench) [--times=<num>] [--format=<CSV | JSON>]\n");
+        ds1302_interface_debug_print("  ds1302 (-t trace | --test=trace)\n");
+        ds1302_interface_debug_print("  ds1302 (-t bus | --test=bus)\n");
+#if defined(WIRE_MMAP)
+        ds1302_interface_debug_print("  ds1302 (-t parallel | --test=parallel)\n");
+#endif
         ds1302_interface_debug_print("  ds1302 (-e basic-set-time | --example=basic-set-time) --timestamp=<time>\n");
         ds1302_interface_debug_print("  ds1302 (-e basic-get-time | --example=basic-get-time)\n");
         ds1302_interface_debug_print("  ds1302 (-e basic-set-ram | --example=basic-set-ram) --addr=<address> --data=<hex>\n");
@@ -877,19 +1020,22 @@ uint8_t ds1302(uint8_t argc, char **argv)
         ds1302_interface_debug_print("  ds1302 (-e advance-charge | --example=advance-charge) --charge=<ENABLE | DISABLE>\n");
         ds1302_interface_debug_print("  ds1302 (-e advance-write-burst | --example=advance-write-burst) [--type=<CLOCK | RAM>] [--buffer=<hex>]\n");
         ds1302_interface_debug_print("  ds1302 (-e advance-read-burst | --example=advance-read-burst) [--type=<CLOCK | RAM>]\n");
+        ds1302_interface_debug_print("  ds1302 (-e async-read-burst | --example=async-read-burst) [--type=<CLOCK | RAM>]\n");
         ds1302_interface_debug_print("\n");
         ds1302_interface_debug_print("Options:\n");
         ds1302_interface_debug_print("      --addr=<address>            Set ram address.([default: 0])\n");
         ds1302_interface_debug_print("      --buffer=<hex>              Set burst buffer.([default: random])\n");
         ds1302_interface_debug_print("      --charge=<ENABLE | DISABLE> Set battery charge.([default: DISABLE])\n");
         ds1302_interface_debug_print("      --data=<hex>                Set ram data and it is hexadecimal.([default: 0x00])\n");
+        ds1302_interface_debug_print("      --format=<CSV | JSON>       Set benchmark output format.([default: CSV])\n");
         ds1302_interface_debug_print("  -e <basic-set-time | basic-get-time | basic-set-ram | basic-get-ram | advance-set-time | advance-get-time |\n");
-        ds1302_interface_debug_print("      advance-set-ram | advance-get-ram | advance-charge | advance-write-burst | advance-read-burst>\n");
+        ds1302_interface_debug_print("      advance-set-ram | advance-get-ram | advance-charge | advance-write-burst | advance-read-burst |\n");
+        ds1302_interface_debug_print("      async-read-burst>\n");
         ds1302_interface_debug_print("                                  Run the driver example.\n");
         ds1302_interface_debug_print("  -h, --help                      Show the help.\n");
         ds1302_interface_debug_print("  -i, --information               Show the chip information.\n");
         ds1302_interface_debug_print("  -p, --port                      Display the pin connections of the current board.\n");
-        ds1302_interface_debug_print("  -t <reg | ram | output>, --test=<reg | ram | output>\n");
+        ds1302_interface_debug_print("  -t <reg | ram | bench | trace | bus | parallel>, --test=<reg | ram | bench | trace | bus | parallel>\n");
         ds1302_interface_debug_print("                                  Run the driver test.\n");
         ds1302_interface_debug_print("      --times=<num>               Set the running times.([default: 3])\n");
         ds1302_interface_debug_print("      --timestamp=<time>          Set the the unix timestamp.\n");
@@ -921,6 +1067,9 @@ uint8_t ds1302(uint8_t argc, char **argv)
         ds1302_interface_debug_print("ds1302: CE connected to GPIO22(BCM).\n");
         ds1302_interface_debug_print("ds1302: SCLK connected to GPIO27(BCM).\n");
         ds1302_interface_debug_print("ds1302: IO connected to GPIO17(BCM).\n");
+#if defined(WIRE_MMAP)
+        ds1302_interface_debug_print("ds1302: parallel lane IO connected to GPIO4-GPIO7(BCM).\n");
+#endif
 
         return 0;
     }
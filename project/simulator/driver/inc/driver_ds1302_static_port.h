@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1302_static_port.h
+ * @brief     driver ds1302 static port header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_DS1302_STATIC_PORT_H
+#define DRIVER_DS1302_STATIC_PORT_H
+
+#include "driver_ds1302_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup ds1302_interface_driver
+ * @{
+ */
+
+/**
+ * @brief     static port sclk gpio write
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] value set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 sclk gpio write failed
+ * @note      the simulated chip lives behind the interface, so the hooks are direct calls into it
+ */
+static inline uint8_t ds1302_static_port_sclk_gpio_write(void *ctx, uint8_t value)
+{
+    return ds1302_interface_sclk_gpio_write(ctx, value);
+}
+
+/**
+ * @brief     static port io gpio write
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] value set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 io gpio write failed
+ * @note      none
+ */
+static inline uint8_t ds1302_static_port_io_gpio_write(void *ctx, uint8_t value)
+{
+    return ds1302_interface_io_gpio_write(ctx, value);
+}
+
+/**
+ * @brief      static port io gpio read
+ * @param[in]  *ctx pointer to a chip context
+ * @param[out] *value pointer to a value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 io gpio read failed
+ * @note       none
+ */
+static inline uint8_t ds1302_static_port_io_gpio_read(void *ctx, uint8_t *value)
+{
+    return ds1302_interface_io_gpio_read(ctx, value);
+}
+
+/**
+ * @brief     static port delay us
+ * @param[in] us time
+ * @note      none
+ */
+static inline void ds1302_static_port_delay_us(uint32_t us)
+{
+    ds1302_interface_delay_us(us);
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,935 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      simulator_driver_ds1302_interface.c
+ * @brief     simulator_driver ds1302 interface source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds1302_interface.h"
+#include "driver_ds1302_parallel_interface.h"
+#include "driver_ds1302_sim.h"
+#include "simulator_driver_ds1302_interface.h"
+#include <stdarg.h>
+#if defined(DS1302_SPIDEV)
+#include <stdint.h>
+#include <linux/spi/spidev.h>
+#endif
+
+/**
+ * @brief simulator chip definition
+ */
+#define SIMULATOR_DS1302_CHIP_NUM    4        /**< simulated chips sharing sclk and io */
+
+/**
+ * @brief global var definition
+ */
+static ds1302_sim_t gs_sim[SIMULATOR_DS1302_CHIP_NUM];        /**< simulated chips */
+static uint8_t gs_powered = 0;                                /**< power on flag */
+static void (*gs_timer_tick)(void) = NULL;                     /**< timer tick function */
+static uint64_t gs_timer_period_ns = 0;                       /**< timer period */
+static uint64_t gs_timer_left_ns = 0;                         /**< time to the next tick */
+
+/**
+ * @brief  power on the simulated chips once
+ * @note   the chips keep their state across driver init calls like battery backed parts
+ */
+static void a_simulator_power_on(void)
+{
+    uint8_t i;
+    
+    if (gs_powered == 0)
+    {
+        for (i = 0; i < SIMULATOR_DS1302_CHIP_NUM; i++)
+        {
+            ds1302_sim_init(&gs_sim[i]);
+        }
+        gs_powered = 1;
+    }
+}
+
+/**
+ * @brief     get the simulated chip of a context
+ * @param[in] *ctx pointer to a chip context
+ * @return    pointer to the chip, NULL if the index is invalid
+ * @note      a NULL context selects chip 0, otherwise ctx points to a uint8_t chip index
+ */
+static ds1302_sim_t *a_simulator_chip(void *ctx)
+{
+    uint8_t index;
+    
+    index = (ctx == NULL) ? 0 : *((uint8_t *)ctx);
+    if (index >= SIMULATOR_DS1302_CHIP_NUM)
+    {
+        return NULL;
+    }
+    
+    return &gs_sim[index];
+}
+
+/**
+ * @brief     drive the shared sclk line
+ * @param[in] value sclk level
+ * @note      none
+ */
+static void a_simulator_sclk_write(uint8_t value)
+{
+    uint8_t i;
+    
+    for (i = 0; i < SIMULATOR_DS1302_CHIP_NUM; i++)
+    {
+        ds1302_sim_sclk_write(&gs_sim[i], value);
+    }
+}
+
+/**
+ * @brief     drive the shared io line
+ * @param[in] value io level
+ * @note      none
+ */
+static void a_simulator_io_write(uint8_t value)
+{
+    uint8_t i;
+    
+    for (i = 0; i < SIMULATOR_DS1302_CHIP_NUM; i++)
+    {
+        ds1302_sim_io_write(&gs_sim[i], value);
+    }
+}
+
+/**
+ * @brief     set the host direction of the shared io line
+ * @param[in] output 0 is input and 1 is output
+ * @note      none
+ */
+static void a_simulator_io_set_direction(uint8_t output)
+{
+    uint8_t i;
+    
+    for (i = 0; i < SIMULATOR_DS1302_CHIP_NUM; i++)
+    {
+        ds1302_sim_io_set_direction(&gs_sim[i], output);
+    }
+}
+
+/**
+ * @brief     advance the virtual clock of all chips
+ * @param[in] ns elapsed time
+ * @note      none
+ */
+static void a_simulator_advance(uint64_t ns)
+{
+    uint8_t i;
+    
+    for (i = 0; i < SIMULATOR_DS1302_CHIP_NUM; i++)
+    {
+        ds1302_sim_advance(&gs_sim[i], ns);
+    }
+}
+
+/**
+ * @brief     let the virtual time pass
+ * @param[in] ns elapsed time
+ * @note      the timer ticks fire on their due time, a tick may stop the timer
+ */
+static void a_simulator_elapse(uint64_t ns)
+{
+    while ((gs_timer_tick != NULL) && (ns >= gs_timer_left_ns))
+    {
+        a_simulator_advance(gs_timer_left_ns);
+        ns -= gs_timer_left_ns;
+        gs_timer_left_ns = gs_timer_period_ns;
+        gs_timer_tick();
+    }
+    if (gs_timer_tick != NULL)
+    {
+        gs_timer_left_ns -= ns;
+    }
+    a_simulator_advance(ns);
+}
+
+/**
+ * @brief     shift bytes out on the shared lines
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data buffer length
+ * @note      bytes are shifted out lsb first
+ */
+static void a_simulator_shift_out(uint8_t *buf, uint32_t len)
+{
+    uint32_t j;
+    uint8_t i;
+    uint8_t temp;
+    
+    /* drive the line */
+    a_simulator_io_set_direction(1);
+    
+    for (j = 0; j < len; j++)
+    {
+        temp = buf[j];
+        for (i = 0; i < 8; i++)
+        {
+            /* set the data bit */
+            a_simulator_io_write(temp & 0x01);
+            temp = temp >> 1;
+            
+            /* clock the bit */
+            ds1302_interface_delay_us(1);
+            a_simulator_sclk_write(1);
+            ds1302_interface_delay_us(1);
+            a_simulator_sclk_write(0);
+        }
+    }
+}
+
+/**
+ * @brief      shift bytes in from a chip
+ * @param[in]  *sim pointer to the driving chip
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data buffer length
+ * @note       bytes are shifted in lsb first
+ */
+static void a_simulator_shift_in(ds1302_sim_t *sim, uint8_t *buf, uint32_t len)
+{
+    uint32_t j;
+    uint8_t i;
+    uint8_t temp;
+    
+    /* release the line */
+    a_simulator_io_set_direction(0);
+    
+    for (j = 0; j < len; j++)
+    {
+        temp = 0;
+        for (i = 0; i < 8; i++)
+        {
+            /* sample the data bit */
+            temp = (uint8_t)((temp >> 1) | ((ds1302_sim_io_read(sim) != 0) ? 0x80 : 0x00));
+            
+            /* clock the next bit */
+            a_simulator_sclk_write(1);
+            ds1302_interface_delay_us(1);
+            a_simulator_sclk_write(0);
+        }
+        buf[j] = temp;
+    }
+}
+
+/**
+ * @brief     interface ce gpio init
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 ce gpio init failed
+ * @note      none
+ */
+uint8_t ds1302_interface_ce_gpio_init(void *ctx)
+{
+    a_simulator_power_on();
+    
+    return 0;
+}
+
+/**
+ * @brief     interface ce gpio deinit
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 ce gpio deinit failed
+ * @note      none
+ */
+uint8_t ds1302_interface_ce_gpio_deinit(void *ctx)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface ce gpio write
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] value set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 ce gpio write failed
+ * @note      none
+ */
+uint8_t ds1302_interface_ce_gpio_write(void *ctx, uint8_t value)
+{
+    ds1302_sim_t *sim;
+    
+    sim = a_simulator_chip(ctx);
+    if (sim == NULL)
+    {
+        return 1;
+    }
+    ds1302_sim_ce_write(sim, value);
+    
+    return 0;
+}
+
+/**
+ * @brief     interface sclk gpio init
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 sclk gpio init failed
+ * @note      none
+ */
+uint8_t ds1302_interface_sclk_gpio_init(void *ctx)
+{
+    a_simulator_power_on();
+    
+    return 0;
+}
+
+/**
+ * @brief     interface sclk gpio deinit
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 sclk gpio deinit failed
+ * @note      none
+ */
+uint8_t ds1302_interface_sclk_gpio_deinit(void *ctx)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface sclk gpio write
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] value set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 sclk gpio write failed
+ * @note      none
+ */
+uint8_t ds1302_interface_sclk_gpio_write(void *ctx, uint8_t value)
+{
+    a_simulator_sclk_write(value);
+    
+    return 0;
+}
+
+/**
+ * @brief     interface io gpio init
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 io gpio init failed
+ * @note      none
+ */
+uint8_t ds1302_interface_io_gpio_init(void *ctx)
+{
+    a_simulator_power_on();
+    a_simulator_io_set_direction(1);
+    
+    return 0;
+}
+
+/**
+ * @brief     interface io gpio deinit
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 io gpio deinit failed
+ * @note      none
+ */
+uint8_t ds1302_interface_io_gpio_deinit(void *ctx)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface io gpio write
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] value set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 io gpio write failed
+ * @note      none
+ */
+uint8_t ds1302_interface_io_gpio_write(void *ctx, uint8_t value)
+{
+    a_simulator_io_write(value);
+    
+    return 0;
+}
+
+/**
+ * @brief      interface io gpio read
+ * @param[in]  *ctx pointer to a chip context
+ * @param[out] *value pointer to a value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 io gpio read failed
+ * @note       none
+ */
+uint8_t ds1302_interface_io_gpio_read(void *ctx, uint8_t *value)
+{
+    ds1302_sim_t *sim;
+    
+    sim = a_simulator_chip(ctx);
+    if (sim == NULL)
+    {
+        return 1;
+    }
+    *value = ds1302_sim_io_read(sim);
+    
+    return 0;
+}
+
+/**
+ * @brief     interface io gpio set direction
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] output direction, 0 is input and 1 is output
+ * @return    status code
+ *            - 0 success
+ *            - 1 io gpio set direction failed
+ * @note      called once per command/data turnaround
+ */
+uint8_t ds1302_interface_io_gpio_set_direction(void *ctx, uint8_t output)
+{
+    a_simulator_io_set_direction(output);
+    
+    return 0;
+}
+
+#if defined(DS1302_SPIDEV)
+
+/**
+ * @brief spidev stand-in definition
+ */
+#define SIMULATOR_SPI_MAX_LEN    64        /**< max bytes in one transfer */
+
+/**
+ * @brief spidev stand-in var definition
+ */
+static uint8_t gs_spi_buf[SIMULATOR_SPI_MAX_LEN];        /**< command and write data of the open transaction */
+static uint8_t gs_spi_len;                               /**< buffered length */
+static uint8_t gs_spi_sent;                              /**< transaction already sent */
+static uint8_t gs_spi_rx[SIMULATOR_SPI_MAX_LEN];         /**< data of the sent read message */
+static uint8_t gs_spi_rx_len;                            /**< read message length */
+static uint8_t gs_spi_rx_index;                          /**< next byte handed out */
+
+/**
+ * @brief     spidev stand-in for ioctl(fd, SPI_IOC_MESSAGE(num), xfer)
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] *xfer pointer to a transfer array
+ * @param[in] num transfer number
+ * @return    0 on success, -1 on error
+ * @note      SPI_3WIRE | SPI_LSB_FIRST | SPI_CS_HIGH, cs is active for the whole message and
+ *            a transfer moves data in one direction only
+ */
+static int a_simulator_spidev_message(void *ctx, struct spi_ioc_transfer *xfer, uint32_t num)
+{
+    ds1302_sim_t *sim;
+    uint32_t i;
+    
+    sim = a_simulator_chip(ctx);
+    if (sim == NULL)
+    {
+        return -1;
+    }
+    for (i = 0; i < num; i++)
+    {
+        if ((xfer[i].len > SIMULATOR_SPI_MAX_LEN) || ((xfer[i].tx_buf != 0) && (xfer[i].rx_buf != 0)))
+        {
+            return -1;
+        }
+    }
+    
+    /* select the chip */
+    ds1302_sim_ce_write(sim, 1);
+    for (i = 0; i < num; i++)
+    {
+        if (xfer[i].tx_buf != 0)
+        {
+            a_simulator_shift_out((uint8_t *)(uintptr_t)xfer[i].tx_buf, xfer[i].len);
+        }
+        else if (xfer[i].rx_buf != 0)
+        {
+            a_simulator_shift_in(sim, (uint8_t *)(uintptr_t)xfer[i].rx_buf, xfer[i].len);
+        }
+        else
+        {
+            /* nothing to move */
+        }
+    }
+    
+    /* deselect the chip */
+    ds1302_sim_ce_write(sim, 0);
+    
+    return 0;
+}
+
+/**
+ * @brief     get the read message length of a command
+ * @param[in] command command byte
+ * @return    read length
+ * @note      a burst reads the whole clock or ram block, a single register reads one byte
+ */
+static uint8_t a_ds1302_interface_read_len(uint8_t command)
+{
+    if (((command >> 1) & 0x1F) == 0x1F)
+    {
+        return ((command & (1 << 6)) != 0) ? 31 : 8;
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     interface transport begin
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] ce ce level
+ * @return    status code
+ *            - 0 success
+ *            - 1 transport begin failed
+ * @note      only used when the transport is DS1302_TRANSPORT_BYTE,
+ *            a write transaction is sent as one message when ce drops
+ */
+uint8_t ds1302_interface_transport_begin(void *ctx, uint8_t ce)
+{
+    struct spi_ioc_transfer k_ioc[2];
+    uint8_t res;
+    
+    res = 0;
+    if ((ce == 0) && (gs_spi_sent == 0) && (gs_spi_len != 0))
+    {
+        /* command and data in one message */
+        memset(k_ioc, 0, sizeof(k_ioc));
+        k_ioc[0].tx_buf = (uintptr_t)gs_spi_buf;
+        k_ioc[0].len = 1;
+        k_ioc[1].tx_buf = (uintptr_t)&gs_spi_buf[1];
+        k_ioc[1].len = gs_spi_len - 1;
+        res = (a_simulator_spidev_message(ctx, k_ioc, (gs_spi_len > 1) ? 2 : 1) < 0) ? 1 : 0;
+    }
+    
+    /* start a new transaction */
+    gs_spi_len = 0;
+    gs_spi_sent = 0;
+    gs_spi_rx_len = 0;
+    gs_spi_rx_index = 0;
+    
+    return res;
+}
+
+/**
+ * @brief     interface transport write bytes
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 transport write bytes failed
+ * @note      only used when the transport is DS1302_TRANSPORT_BYTE,
+ *            the bytes are kept until the transaction ends
+ */
+uint8_t ds1302_interface_transport_write_bytes(void *ctx, uint8_t *buf, uint8_t len)
+{
+    /* a sent transaction can not be extended */
+    if ((gs_spi_sent != 0) || (gs_spi_len + len > SIMULATOR_SPI_MAX_LEN))
+    {
+        return 1;
+    }
+    
+    /* keep the bytes */
+    memcpy(&gs_spi_buf[gs_spi_len], buf, len);
+    gs_spi_len += len;
+    
+    return 0;
+}
+
+/**
+ * @brief      interface transport read bytes
+ * @param[in]  *ctx pointer to a chip context
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 transport read bytes failed
+ * @note       only used when the transport is DS1302_TRANSPORT_BYTE,
+ *             the first read sends the command and the whole burst in one message,
+ *             later reads of the same transaction take the kept bytes so a burst can be read in steps
+ */
+uint8_t ds1302_interface_transport_read_bytes(void *ctx, uint8_t *buf, uint8_t len)
+{
+    struct spi_ioc_transfer k_ioc[2];
+    
+    /* send the read message once */
+    if (gs_spi_sent == 0)
+    {
+        if (gs_spi_len == 0)
+        {
+            return 1;
+        }
+        gs_spi_rx_len = a_ds1302_interface_read_len(gs_spi_buf[0]);
+        if (gs_spi_rx_len < len)
+        {
+            gs_spi_rx_len = len;
+        }
+        if (gs_spi_rx_len > SIMULATOR_SPI_MAX_LEN)
+        {
+            return 1;
+        }
+        gs_spi_rx_index = 0;
+        gs_spi_sent = 1;
+        
+        /* the command goes out and the data comes back on the same line */
+        memset(k_ioc, 0, sizeof(k_ioc));
+        k_ioc[0].tx_buf = (uintptr_t)gs_spi_buf;
+        k_ioc[0].len = gs_spi_len;
+        k_ioc[1].rx_buf = (uintptr_t)gs_spi_rx;
+        k_ioc[1].len = gs_spi_rx_len;
+        if (a_simulator_spidev_message(ctx, k_ioc, 2) < 0)
+        {
+            gs_spi_rx_len = 0;
+            
+            return 1;
+        }
+    }
+    
+    /* hand out the kept bytes */
+    if (gs_spi_rx_index + len > gs_spi_rx_len)
+    {
+        return 1;
+    }
+    memcpy(buf, &gs_spi_rx[gs_spi_rx_index], len);
+    gs_spi_rx_index += len;
+    
+    return 0;
+}
+
+#else
+
+/**
+ * @brief     interface transport begin
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] ce ce level
+ * @return    status code
+ *            - 0 success
+ *            - 1 transport begin failed
+ * @note      only used when the transport is DS1302_TRANSPORT_BYTE
+ */
+uint8_t ds1302_interface_transport_begin(void *ctx, uint8_t ce)
+{
+    ds1302_sim_t *sim;
+    
+    sim = a_simulator_chip(ctx);
+    if (sim == NULL)
+    {
+        return 1;
+    }
+    ds1302_sim_ce_write(sim, ce);
+    
+    return 0;
+}
+
+/**
+ * @brief     interface transport write bytes
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 transport write bytes failed
+ * @note      only used when the transport is DS1302_TRANSPORT_BYTE,
+ *            bytes are shifted out lsb first
+ */
+uint8_t ds1302_interface_transport_write_bytes(void *ctx, uint8_t *buf, uint8_t len)
+{
+    a_simulator_shift_out(buf, len);
+    
+    return 0;
+}
+
+/**
+ * @brief      interface transport read bytes
+ * @param[in]  *ctx pointer to a chip context
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 transport read bytes failed
+ * @note       only used when the transport is DS1302_TRANSPORT_BYTE,
+ *             bytes are shifted in lsb first
+ */
+uint8_t ds1302_interface_transport_read_bytes(void *ctx, uint8_t *buf, uint8_t len)
+{
+    ds1302_sim_t *sim;
+    
+    sim = a_simulator_chip(ctx);
+    if (sim == NULL)
+    {
+        return 1;
+    }
+    a_simulator_shift_in(sim, buf, len);
+    
+    return 0;
+}
+
+#endif
+
+/**
+ * @brief     interface lane init
+ * @param[in] *ctx pointer to a lane context
+ * @return    status code
+ *            - 0 success
+ *            - 1 lane init failed
+ * @note      port pin n is the io of chip n
+ */
+uint8_t ds1302_interface_lane_init(void *ctx)
+{
+    a_simulator_power_on();
+    
+    return 0;
+}
+
+/**
+ * @brief     interface lane deinit
+ * @param[in] *ctx pointer to a lane context
+ * @return    status code
+ *            - 0 success
+ *            - 1 lane deinit failed
+ * @note      none
+ */
+uint8_t ds1302_interface_lane_deinit(void *ctx)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface lane ce write
+ * @param[in] *ctx pointer to a lane context
+ * @param[in] value set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 lane ce write failed
+ * @note      the ce line is shared by all lanes
+ */
+uint8_t ds1302_interface_lane_ce_write(void *ctx, uint8_t value)
+{
+    uint8_t i;
+    
+    for (i = 0; i < SIMULATOR_DS1302_CHIP_NUM; i++)
+    {
+        ds1302_sim_ce_write(&gs_sim[i], value);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     interface lane sclk write
+ * @param[in] *ctx pointer to a lane context
+ * @param[in] value set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 lane sclk write failed
+ * @note      the sclk line is shared by all lanes
+ */
+uint8_t ds1302_interface_lane_sclk_write(void *ctx, uint8_t value)
+{
+    a_simulator_sclk_write(value);
+    
+    return 0;
+}
+
+/**
+ * @brief     interface lane io write
+ * @param[in] *ctx pointer to a lane context
+ * @param[in] mask port pins to drive
+ * @param[in] value port pin levels
+ * @return    status code
+ *            - 0 success
+ *            - 1 lane io write failed
+ * @note      one port wide write, such as a single BSRR store
+ */
+uint8_t ds1302_interface_lane_io_write(void *ctx, uint32_t mask, uint32_t value)
+{
+    uint8_t i;
+    
+    for (i = 0; i < SIMULATOR_DS1302_CHIP_NUM; i++)
+    {
+        if (((mask >> i) & 0x01) != 0)
+        {
+            ds1302_sim_io_write(&gs_sim[i], (uint8_t)((value >> i) & 0x01));
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      interface lane io read
+ * @param[in]  *ctx pointer to a lane context
+ * @param[out] *value pointer to a port word buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 lane io read failed
+ * @note       one port wide read, such as a single IDR or GPLEV load
+ */
+uint8_t ds1302_interface_lane_io_read(void *ctx, uint32_t *value)
+{
+    uint8_t i;
+    
+    *value = 0;
+    for (i = 0; i < SIMULATOR_DS1302_CHIP_NUM; i++)
+    {
+        *value |= (uint32_t)ds1302_sim_io_read(&gs_sim[i]) << i;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     interface lane io set direction
+ * @param[in] *ctx pointer to a lane context
+ * @param[in] mask port pins to change
+ * @param[in] output direction, 0 is input and 1 is output
+ * @return    status code
+ *            - 0 success
+ *            - 1 lane io set direction failed
+ * @note      none
+ */
+uint8_t ds1302_interface_lane_io_set_direction(void *ctx, uint32_t mask, uint8_t output)
+{
+    uint8_t i;
+    
+    for (i = 0; i < SIMULATOR_DS1302_CHIP_NUM; i++)
+    {
+        if (((mask >> i) & 0x01) != 0)
+        {
+            ds1302_sim_io_set_direction(&gs_sim[i], output);
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     interface timer start
+ * @param[in] hz tick rate
+ * @param[in] *tick pointer to a tick function, it runs from the timer interrupt
+ * @return    status code
+ *            - 0 success
+ *            - 1 timer start failed
+ * @note      ticks fire from the virtual clock while the delays run
+ */
+uint8_t ds1302_interface_timer_start(uint32_t hz, void (*tick)(void))
+{
+    if ((hz == 0) || (hz > 1000000000U) || (tick == NULL))
+    {
+        return 1;
+    }
+    gs_timer_period_ns = 1000000000ULL / hz;
+    gs_timer_left_ns = gs_timer_period_ns;
+    gs_timer_tick = tick;
+    
+    return 0;
+}
+
+/**
+ * @brief  interface timer stop
+ * @return status code
+ *         - 0 success
+ *         - 1 timer stop failed
+ * @note   it may be called from the tick function
+ */
+uint8_t ds1302_interface_timer_stop(void)
+{
+    gs_timer_tick = NULL;
+    
+    return 0;
+}
+
+/**
+ * @brief     interface delay ms
+ * @param[in] ms time
+ * @note      advances the virtual clock of the simulated chip
+ */
+void ds1302_interface_delay_ms(uint32_t ms)
+{
+    a_simulator_elapse((uint64_t)ms * 1000000ULL);
+}
+
+/**
+ * @brief     interface delay us
+ * @param[in] us time
+ * @note      advances the virtual clock of the simulated chip
+ */
+void ds1302_interface_delay_us(uint32_t us)
+{
+    a_simulator_elapse((uint64_t)us * 1000ULL);
+}
+
+/**
+ * @brief  interface timestamp us
+ * @return free running microsecond counter
+ * @note   reads the virtual clock, so only the delays count as elapsed bus time
+ */
+uint32_t ds1302_interface_timestamp_us(void)
+{
+    return (uint32_t)(gs_sim[0].now_ns / 1000);
+}
+
+/**
+ * @brief     interface print format data
+ * @param[in] fmt format data
+ * @note      none
+ */
+void ds1302_interface_debug_print(const char *const fmt, ...)
+{
+    char str[256];
+    va_list args;
+    
+    memset((char *)str, 0, sizeof(char) * 256); 
+    va_start(args, fmt);
+    vsnprintf((char *)str, 255, (char const *)fmt, args);
+    va_end(args);
+    
+    (void)printf("%s", str);
+}
+
+/**
+ * @brief     set the crystal skew of the simulated chips
+ * @param[in] ppb crystal skew in ppb, positive runs fast
+ * @note      used by the drift test to give the chips a known drift
+ */
+void simulator_ds1302_set_skew(int32_t ppb)
+{
+    uint8_t i;
+    
+    a_simulator_power_on();
+    for (i = 0; i < SIMULATOR_DS1302_CHIP_NUM; i++)
+    {
+        ds1302_sim_set_skew(&gs_sim[i], ppb);
+    }
+}
@@ -37,131 +37,269 @@
 #include "driver_ds1302_interface.h"
 #include "delay.h"
 #include "wire.h"
+#include "spi.h"
+#include "wave.h"
+#include "tim.h"
 #include "uart.h"
 #include <stdarg.h>
 
 /**
- * @brief  interface ce gpio init
- * @return status code
- *         - 0 success
- *         - 1 ce gpio init failed
- * @note   none
+ * @brief     interface ce gpio init
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 ce gpio init failed
+ * @note      none
  */
-uint8_t ds1302_interface_ce_gpio_init(void)
+uint8_t ds1302_interface_ce_gpio_init(void *ctx)
 {
     return wire_gpio_init();
 }
 
 /**
- * @brief  interface ce gpio deinit
- * @return status code
- *         - 0 success
- *         - 1 ce gpio deinit failed
- * @note   none
+ * @brief     interface ce gpio deinit
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 ce gpio deinit failed
+ * @note      none
  */
-uint8_t ds1302_interface_ce_gpio_deinit(void)
+uint8_t ds1302_interface_ce_gpio_deinit(void *ctx)
 {
     return wire_gpio_deinit();
 }
 
 /**
  * @brief     interface ce gpio write
+ * @param[in] *ctx pointer to a chip context
  * @param[in] value set level
  * @return    status code
  *            - 0 success
  *            - 1 ce gpio write failed
  * @note      none
  */
-uint8_t ds1302_interface_ce_gpio_write(uint8_t value)
+uint8_t ds1302_interface_ce_gpio_write(void *ctx, uint8_t value)
 {
     return wire_gpio_write(value);
 }
 
 /**
- * @brief  interface sclk gpio init
- * @return status code
- *         - 0 success
- *         - 1 sclk gpio init failed
- * @note   none
+ * @brief     interface sclk gpio init
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 sclk gpio init failed
+ * @note      sclk and io are the spi1 pins, or PA0 and PA8 on the bsrr wave engine with DS1302_BSRR
  */
-uint8_t ds1302_interface_sclk_gpio_init(void)
+uint8_t ds1302_interface_sclk_gpio_init(void *ctx)
 {
-    return wire_clock_init();
+#if defined(DS1302_BSRR)
+    return wave_init(WAVE_DEFAULT_BIT_RATE);
+#else
+    return spi_init();
+#endif
 }
 
 /**
- * @brief  interface sclk gpio deinit
- * @return status code
- *         - 0 success
- *         - 1 sclk gpio deinit failed
- * @note   none
+ * @brief     interface sclk gpio deinit
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 sclk gpio deinit failed
+ * @note      none
  */
-uint8_t ds1302_interface_sclk_gpio_deinit(void)
+uint8_t ds1302_interface_sclk_gpio_deinit(void *ctx)
 {
-    return wire_clock_deinit();
+#if defined(DS1302_BSRR)
+    return wave_deinit();
+#else
+    return spi_deinit();
+#endif
 }
 
 /**
  * @brief     interface sclk gpio write
+ * @param[in] *ctx pointer to a chip context
  * @param[in] value set level
  * @return    status code
  *            - 0 success
  *            - 1 sclk gpio write failed
- * @note      none
+ * @note      without DS1302_BSRR the bus runs on spi1, set DS1302_TRANSPORT_BYTE
  */
-uint8_t ds1302_interface_sclk_gpio_write(uint8_t value)
+uint8_t ds1302_interface_sclk_gpio_write(void *ctx, uint8_t value)
 {
+#if defined(DS1302_BSRR)
     return wire_clock_write(value);
+#else
+    return 1;
+#endif
 }
 
 /**
- * @brief  interface io gpio init
- * @return status code
- *         - 0 success
- *         - 1 io gpio init failed
- * @note   none
+ * @brief     interface io gpio init
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 io gpio init failed
+ * @note      the io line is set up with the sclk by spi_init or wave_init
  */
-uint8_t ds1302_interface_io_gpio_init(void)
+uint8_t ds1302_interface_io_gpio_init(void *ctx)
 {
-    return wire_init();
+    return 0;
 }
 
 /**
- * @brief  interface io gpio deinit
- * @return status code
- *         - 0 success
- *         - 1 io gpio deinit failed
- * @note   none
+ * @brief     interface io gpio deinit
+ * @param[in] *ctx pointer to a chip context
+ * @return    status code
+ *            - 0 success
+ *            - 1 io gpio deinit failed
+ * @note      the io line is released with the sclk by spi_deinit or wave_deinit
  */
-uint8_t ds1302_interface_io_gpio_deinit(void)
+uint8_t ds1302_interface_io_gpio_deinit(void *ctx)
 {
-    return wire_deinit();
+    return 0;
 }
 
 /**
  * @brief     interface io gpio write
+ * @param[in] *ctx pointer to a chip context
  * @param[in] value set level
  * @return    status code
  *            - 0 success
  *            - 1 io gpio write failed
- * @note      none
+ * @note      without DS1302_BSRR the bus runs on spi1, set DS1302_TRANSPORT_BYTE
  */
-uint8_t ds1302_interface_io_gpio_write(uint8_t value)
+uint8_t ds1302_interface_io_gpio_write(void *ctx, uint8_t value)
 {
+#if defined(DS1302_BSRR)
     return wire_write(value);
+#else
+    return 1;
+#endif
 }
 
 /**
  * @brief      interface io gpio read
+ * @param[in]  *ctx pointer to a chip context
  * @param[out] *value pointer to a value buffer
  * @return     status code
  *             - 0 success
  *             - 1 io gpio read failed
- * @note       none
+ * @note       without DS1302_BSRR the bus runs on spi1, set DS1302_TRANSPORT_BYTE
  */
-uint8_t ds1302_interface_io_gpio_read(uint8_t *value)
+uint8_t ds1302_interface_io_gpio_read(void *ctx, uint8_t *value)
 {
+#if defined(DS1302_BSRR)
     return wire_read(value);
+#else
+    return 1;
+#endif
+}
+
+/**
+ * @brief     interface io gpio set direction
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] output direction, 0 is input and 1 is output
+ * @return    status code
+ *            - 0 success
+ *            - 1 io gpio set direction failed
+ * @note      without DS1302_BSRR the bus runs on spi1, set DS1302_TRANSPORT_BYTE
+ */
+uint8_t ds1302_interface_io_gpio_set_direction(void *ctx, uint8_t output)
+{
+#if defined(DS1302_BSRR)
+    return wire_set_direction(output);
+#else
+    return 1;
+#endif
+}
+
+/**
+ * @brief     interface transport begin
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] ce ce level
+ * @return    status code
+ *            - 0 success
+ *            - 1 transport begin failed
+ * @note      only used when the transport is DS1302_TRANSPORT_BYTE
+ */
+uint8_t ds1302_interface_transport_begin(void *ctx, uint8_t ce)
+{
+    return wire_gpio_write(ce);
+}
+
+/**
+ * @brief     interface transport write bytes
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 transport write bytes failed
+ * @note      only used when the transport is DS1302_TRANSPORT_BYTE,
+ *            spi1 shifts the bytes out lsb first and bursts run on dma,
+ *            with DS1302_BSRR tim1 plays the precomputed edges into GPIOA->BSRR
+ */
+uint8_t ds1302_interface_transport_write_bytes(void *ctx, uint8_t *buf, uint8_t len)
+{
+#if defined(DS1302_BSRR)
+    return wave_write(buf, len);
+#else
+    return spi_write(buf, len);
+#endif
+}
+
+/**
+ * @brief      interface transport read bytes
+ * @param[in]  *ctx pointer to a chip context
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 transport read bytes failed
+ * @note       only used when the transport is DS1302_TRANSPORT_BYTE,
+ *             spi1 shifts the bytes in lsb first and bursts run on dma,
+ *             with DS1302_BSRR tim1 samples GPIOA->IDR and the bits are unpacked afterwards
+ */
+uint8_t ds1302_interface_transport_read_bytes(void *ctx, uint8_t *buf, uint8_t len)
+{
+#if defined(DS1302_BSRR)
+    return wave_read(buf, len);
+#else
+    return spi_read(buf, len);
+#endif
+}
+
+/**
+ * @brief     interface timer start
+ * @param[in] hz tick rate
+ * @param[in] *tick pointer to a tick function, it runs from the timer interrupt
+ * @return    status code
+ *            - 0 success
+ *            - 1 timer start failed
+ * @note      TIM2 clocks the tick
+ */
+uint8_t ds1302_interface_timer_start(uint32_t hz, void (*tick)(void))
+{
+    if (tim_init(hz, tick) != 0)
+    {
+        return 1;
+    }
+    
+    return tim_start();
+}
+
+/**
+ * @brief  interface timer stop
+ * @return status code
+ *         - 0 success
+ *         - 1 timer stop failed
+ * @note   it may be called from the tick function
+ */
+uint8_t ds1302_interface_timer_stop(void)
+{
+    return tim_stop();
 }
 
 /**
@@ -184,6 +322,16 @@ void ds1302_interface_delay_us(uint32_t us)
     delay_us(us);
 }
 
+/**
+ * @brief  interface timestamp us
+ * @return free running microsecond counter
+ * @note   only differences are used, wrapping is fine
+ */
+uint32_t ds1302_interface_timestamp_us(void)
+{
+    return delay_get_us();
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
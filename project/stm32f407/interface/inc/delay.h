@@ -71,6 +71,13 @@ void delay_us(uint32_t us);
  */
 void delay_ms(uint32_t ms);
 
+/**
+ * @brief  delay get the time
+ * @return free running microsecond counter
+ * @note   built from the hal tick and the systick counter
+ */
+uint32_t delay_get_us(void);
+
 /**
  * @}
  */
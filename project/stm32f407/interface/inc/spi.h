@@ -0,0 +1,126 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      spi.h
+ * @brief     spi header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SPI_H
+#define SPI_H
+
+#include "stm32f4xx_hal.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup spi spi function
+ * @brief    spi function modules
+ * @{
+ */
+
+/**
+ * @brief spi dma definition
+ */
+#define SPI_DMA_MIN_LEN        2        /**< shorter transfers are polled */
+
+/**
+ * @brief  spi bus init in the bidirectional one line mode, lsb first
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   SCLK is PA5 and IO is PA7, the 84MHz apb2 clock / 64 gives 1.3125MHz
+ */
+uint8_t spi_init(void);
+
+/**
+ * @brief  spi bus deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t spi_deinit(void);
+
+/**
+ * @brief     spi bus write data
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the line is driven by the mcu, transfers of SPI_DMA_MIN_LEN bytes or more run on dma
+ *            and must not be started from an interrupt
+ */
+uint8_t spi_write(uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      spi bus read data
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the line is released to the chip, transfers of SPI_DMA_MIN_LEN bytes or more run on dma
+ *             and must not be started from an interrupt
+ */
+uint8_t spi_read(uint8_t *buf, uint16_t len);
+
+/**
+ * @brief  spi get the handle
+ * @return pointer to a spi handle
+ * @note   none
+ */
+SPI_HandleTypeDef* spi_get_handle(void);
+
+/**
+ * @brief spi set done
+ * @note  none
+ */
+void spi_set_done(void);
+
+/**
+ * @brief spi set error
+ * @note  none
+ */
+void spi_set_error(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,115 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      wave.h
+ * @brief     wave header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef WAVE_H
+#define WAVE_H
+
+#include "stm32f4xx_hal.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup wave wave function
+ * @brief    wave function modules
+ * @{
+ */
+
+/**
+ * @brief wave definition
+ */
+#define WAVE_DEFAULT_BIT_RATE        250000        /**< 250 kbit/s, io settles within tCDD at 2V before it is sampled */
+#define WAVE_MAX_LEN                 32            /**< max bytes in one run, a command and a 31 bytes burst */
+
+/**
+ * @brief     wave init
+ * @param[in] bit_rate sclk rate in bit/s
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      SCLK is PA0 and IO is PA8, TIM1 paces DMA2 stream5 into GPIOA->BSRR
+ *            and DMA2 stream1 out of GPIOA->IDR, neither pin may be used by spi1
+ */
+uint8_t wave_init(uint32_t bit_rate);
+
+/**
+ * @brief  wave deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t wave_deinit(void);
+
+/**
+ * @brief     wave write data
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the bytes are shifted out lsb first and the run ends with sclk low
+ */
+uint8_t wave_write(uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      wave read data
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       io is sampled in the middle of each sclk low phase and the bits are unpacked afterwards
+ */
+uint8_t wave_read(uint8_t *buf, uint16_t len);
+
+/**
+ * @brief  wave get the tim handle
+ * @return pointer to a tim handle
+ * @note   the update and cc1 dma handles hang off it
+ */
+TIM_HandleTypeDef* wave_get_handle(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
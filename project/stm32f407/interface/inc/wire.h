@@ -65,12 +65,21 @@ uint8_t wire_init(void);
  */
 uint8_t wire_deinit(void);
 
+/**
+ * @brief     wire bus set the direction
+ * @param[in] output direction, 0 is input and 1 is output
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t wire_set_direction(uint8_t output);
+
 /**
  * @brief      wire bus read data
  * @param[out] *value pointer to a read data buffer
  * @return     status code
  *             - 0 success
- * @note       none
+ * @note       the line must be set as input with wire_set_direction
  */
 uint8_t wire_read(uint8_t *value);
 
@@ -79,7 +88,7 @@ uint8_t wire_read(uint8_t *value);
  * @param[in] value write data
  * @return    status code
  *            - 0 success
- * @note      none
+ * @note      the line must be set as output with wire_set_direction
  */
 uint8_t wire_write(uint8_t value);
 
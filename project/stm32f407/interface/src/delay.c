@@ -107,3 +107,23 @@ void delay_ms(uint32_t ms)
     /* use the hal delay */
     HAL_Delay(ms);
 }
+
+/**
+ * @brief  delay get the time
+ * @return free running microsecond counter
+ * @note   built from the hal tick and the systick counter
+ */
+uint32_t delay_get_us(void)
+{
+    uint32_t ms;
+    uint32_t val;
+    
+    /* read a consistent tick and counter pair */
+    do
+    {
+        ms = HAL_GetTick();
+        val = SysTick->VAL;
+    } while (ms != HAL_GetTick());
+    
+    return ms * 1000 + (SysTick->LOAD - val) / gs_fac_us;
+}
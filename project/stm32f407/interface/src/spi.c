@@ -0,0 +1,241 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      spi.c
+ * @brief     spi source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "spi.h"
+
+/**
+ * @brief spi var definition
+ */
+SPI_HandleTypeDef g_spi_handle;                 /**< spi handle */
+DMA_HandleTypeDef g_spi_dma_tx_handle;          /**< spi dma tx handle */
+DMA_HandleTypeDef g_spi_dma_rx_handle;          /**< spi dma rx handle */
+volatile uint8_t g_spi_done;                    /**< spi done flag, 1 is done and 2 is error */
+
+/**
+ * @brief  spi wait for the dma
+ * @return status code
+ *         - 0 success
+ *         - 1 transfer failed
+ * @note   the core sleeps until the dma or the systick interrupt wakes it
+ */
+static uint8_t a_spi_wait(void)
+{
+    uint32_t start;
+    
+    start = HAL_GetTick();
+    while (g_spi_done == 0)
+    {
+        /* check the timeout */
+        if ((HAL_GetTick() - start) > 1000)
+        {
+            (void)HAL_SPI_Abort(&g_spi_handle);
+            
+            return 1;
+        }
+        
+        /* a pending interrupt wakes wfi even when masked */
+        __disable_irq();
+        if (g_spi_done == 0)
+        {
+            __WFI();
+        }
+        __enable_irq();
+    }
+    
+    return (g_spi_done == 1) ? 0 : 1;
+}
+
+/**
+ * @brief  spi bus init in the bidirectional one line mode, lsb first
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   SCLK is PA5 and IO is PA7, the 84MHz apb2 clock / 64 gives 1.3125MHz
+ */
+uint8_t spi_init(void)
+{
+    /* link the dma streams, the msp init sets them up */
+    __HAL_LINKDMA(&g_spi_handle, hdmatx, g_spi_dma_tx_handle);
+    __HAL_LINKDMA(&g_spi_handle, hdmarx, g_spi_dma_rx_handle);
+    
+    /* the chip samples io on the rising edge and shifts lsb first */
+    g_spi_handle.Instance = SPI1;
+    g_spi_handle.Init.Mode = SPI_MODE_MASTER;
+    g_spi_handle.Init.Direction = SPI_DIRECTION_1LINE;
+    g_spi_handle.Init.DataSize = SPI_DATASIZE_8BIT;
+    g_spi_handle.Init.CLKPolarity = SPI_POLARITY_LOW;
+    g_spi_handle.Init.CLKPhase = SPI_PHASE_1EDGE;
+    g_spi_handle.Init.NSS = SPI_NSS_SOFT;
+    g_spi_handle.Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_64;
+    g_spi_handle.Init.FirstBit = SPI_FIRSTBIT_LSB;
+    g_spi_handle.Init.TIMode = SPI_TIMODE_DISABLE;
+    g_spi_handle.Init.CRCCalculation = SPI_CRCCALCULATION_DISABLE;
+    g_spi_handle.Init.CRCPolynomial = 7;
+    
+    /* spi init */
+    if (HAL_SPI_Init(&g_spi_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  spi bus deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t spi_deinit(void)
+{
+    /* spi deinit */
+    if (HAL_SPI_DeInit(&g_spi_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     spi bus write data
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the line is driven by the mcu, transfers of SPI_DMA_MIN_LEN bytes or more run on dma
+ *            and must not be started from an interrupt
+ */
+uint8_t spi_write(uint8_t *buf, uint16_t len)
+{
+    if (len == 0)
+    {
+        return 0;
+    }
+    
+    /* short transfers are polled */
+    if (len < SPI_DMA_MIN_LEN)
+    {
+        if (HAL_SPI_Transmit(&g_spi_handle, buf, len, 1000) != HAL_OK)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    
+    /* set done 0 */
+    g_spi_done = 0;
+    
+    /* transmit */
+    if (HAL_SPI_Transmit_DMA(&g_spi_handle, buf, len) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return a_spi_wait();
+}
+
+/**
+ * @brief      spi bus read data
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the line is released to the chip, transfers of SPI_DMA_MIN_LEN bytes or more run on dma
+ *             and must not be started from an interrupt
+ */
+uint8_t spi_read(uint8_t *buf, uint16_t len)
+{
+    if (len == 0)
+    {
+        return 0;
+    }
+    
+    /* short transfers are polled */
+    if (len < SPI_DMA_MIN_LEN)
+    {
+        if (HAL_SPI_Receive(&g_spi_handle, buf, len, 1000) != HAL_OK)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    
+    /* set done 0 */
+    g_spi_done = 0;
+    
+    /* receive */
+    if (HAL_SPI_Receive_DMA(&g_spi_handle, buf, len) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return a_spi_wait();
+}
+
+/**
+ * @brief  spi get the handle
+ * @return pointer to a spi handle
+ * @note   none
+ */
+SPI_HandleTypeDef* spi_get_handle(void)
+{
+    return &g_spi_handle;
+}
+
+/**
+ * @brief spi set done
+ * @note  none
+ */
+void spi_set_done(void)
+{
+    g_spi_done = 1;
+}
+
+/**
+ * @brief spi set error
+ * @note  none
+ */
+void spi_set_error(void)
+{
+    g_spi_done = 2;
+}
@@ -0,0 +1,172 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      tim.c
+ * @brief     tim source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "tim.h"
+
+/**
+ * @brief tim var definition
+ */
+TIM_HandleTypeDef g_tim_handle;                   /**< tim handle */
+static void (*gs_tim_callback)(void) = NULL;       /**< tim callback */
+
+/**
+ * @brief     tim init
+ * @param[in] hz update rate
+ * @param[in] *callback pointer to a callback function, it runs from the update interrupt
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      TIM2 counts the 84MHz apb1 timer clock, so the rate is 84MHz / n
+ */
+uint8_t tim_init(uint32_t hz, void (*callback)(void))
+{
+    uint32_t clk;
+    
+    /* apb1 timers run at twice the bus clock when it is divided */
+    clk = HAL_RCC_GetPCLK1Freq();
+    if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_HCLK_DIV1)
+    {
+        clk *= 2;
+    }
+    
+    /* check the rate */
+    if ((hz == 0) || (hz > clk / 2) || (callback == NULL))
+    {
+        return 1;
+    }
+    
+    /* save the callback */
+    gs_tim_callback = callback;
+    
+    /* 32 bits counter without prescaler */
+    g_tim_handle.Instance = TIM2;
+    g_tim_handle.Init.Prescaler = 0;
+    g_tim_handle.Init.CounterMode = TIM_COUNTERMODE_UP;
+    g_tim_handle.Init.Period = clk / hz - 1;
+    g_tim_handle.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    g_tim_handle.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+    if (HAL_TIM_Base_Init(&g_tim_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  tim deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t tim_deinit(void)
+{
+    /* stop the counter */
+    (void)HAL_TIM_Base_Stop_IT(&g_tim_handle);
+    
+    /* tim deinit */
+    if (HAL_TIM_Base_DeInit(&g_tim_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    gs_tim_callback = NULL;
+    
+    return 0;
+}
+
+/**
+ * @brief  tim start
+ * @return status code
+ *         - 0 success
+ *         - 1 start failed
+ * @note   none
+ */
+uint8_t tim_start(void)
+{
+    /* restart from zero without a pending update */
+    __HAL_TIM_SET_COUNTER(&g_tim_handle, 0);
+    __HAL_TIM_CLEAR_FLAG(&g_tim_handle, TIM_FLAG_UPDATE);
+    
+    /* start the counter */
+    if (HAL_TIM_Base_Start_IT(&g_tim_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  tim stop
+ * @return status code
+ *         - 0 success
+ *         - 1 stop failed
+ * @note   it can be called from the callback
+ */
+uint8_t tim_stop(void)
+{
+    /* stop the counter */
+    if (HAL_TIM_Base_Stop_IT(&g_tim_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  tim get the handle
+ * @return pointer to a tim handle
+ * @note   none
+ */
+TIM_HandleTypeDef* tim_get_handle(void)
+{
+    return &g_tim_handle;
+}
+
+/**
+ * @brief tim irq handler
+ * @note  none
+ */
+void tim_irq_handler(void)
+{
+    if (gs_tim_callback != NULL)
+    {
+        /* run the callback */
+        gs_tim_callback();
+    }
+}
@@ -0,0 +1,416 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      wave.c
+ * @brief     wave source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "wave.h"
+
+/**
+ * @brief wave pin definition
+ */
+#define WAVE_SCLK_SET          (1UL << 0)                   /**< PA0 high */
+#define WAVE_SCLK_RESET        (1UL << 16)                  /**< PA0 low */
+#define WAVE_IO_SET            (1UL << 8)                   /**< PA8 high */
+#define WAVE_IO_RESET          (1UL << 24)                  /**< PA8 low */
+#define WAVE_IO_IN()           {GPIOA->MODER &= ~(3UL << (8 * 2));}
+#define WAVE_IO_OUT()          {GPIOA->MODER &= ~(3UL << (8 * 2)); GPIOA->MODER |= 1UL << (8 * 2);}
+
+/**
+ * @brief wave var definition
+ */
+TIM_HandleTypeDef g_wave_handle;                           /**< wave tim handle */
+DMA_HandleTypeDef g_wave_dma_bsrr_handle;                  /**< wave bsrr dma handle */
+DMA_HandleTypeDef g_wave_dma_idr_handle;                   /**< wave idr dma handle */
+volatile uint8_t g_wave_done;                              /**< wave done flag, 1 is done and 2 is error */
+static uint32_t gs_wave_bsrr[WAVE_MAX_LEN * 16 + 1];        /**< bsrr words, two per bit and a final sclk low */
+static uint16_t gs_wave_idr[WAVE_MAX_LEN * 16];             /**< idr samples, one per bsrr word */
+
+/**
+ * @brief     wave dma done callback
+ * @param[in] *hdma pointer to a dma handle
+ * @note      none
+ */
+static void a_wave_dma_done(DMA_HandleTypeDef *hdma)
+{
+    (void)hdma;
+    
+    g_wave_done = 1;
+}
+
+/**
+ * @brief     wave dma error callback
+ * @param[in] *hdma pointer to a dma handle
+ * @note      none
+ */
+static void a_wave_dma_error(DMA_HandleTypeDef *hdma)
+{
+    (void)hdma;
+    
+    g_wave_done = 2;
+}
+
+/**
+ * @brief     wave play the bsrr words
+ * @param[in] words number of bsrr words
+ * @param[in] samples number of idr samples, 0 means no sampling
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the update request writes word n at the end of period n and the cc1 request
+ *            samples idr at three quarters of every period, so sample n + 1 sees word n settled
+ */
+static uint8_t a_wave_run(uint16_t words, uint16_t samples)
+{
+    uint8_t res;
+    uint32_t start;
+    uint8_t in_irq;
+    
+    /* an interrupt caller can not be woken by the dma interrupt, it polls the flag instead */
+    in_irq = (__get_IPSR() != 0) ? 1 : 0;
+    g_wave_done = 0;
+    
+    /* arm the idr stream first, it is the last to finish */
+    if (samples != 0)
+    {
+        if (in_irq != 0)
+        {
+            res = (HAL_DMA_Start(&g_wave_dma_idr_handle, (uint32_t)&GPIOA->IDR,
+                                 (uint32_t)gs_wave_idr, samples) == HAL_OK) ? 0 : 1;
+        }
+        else
+        {
+            res = (HAL_DMA_Start_IT(&g_wave_dma_idr_handle, (uint32_t)&GPIOA->IDR,
+                                    (uint32_t)gs_wave_idr, samples) == HAL_OK) ? 0 : 1;
+        }
+        if (res != 0)
+        {
+            return 1;
+        }
+    }
+    
+    /* arm the bsrr stream, it only signals when nothing is sampled */
+    if ((in_irq != 0) || (samples != 0))
+    {
+        res = (HAL_DMA_Start(&g_wave_dma_bsrr_handle, (uint32_t)gs_wave_bsrr,
+                             (uint32_t)&GPIOA->BSRR, words) == HAL_OK) ? 0 : 1;
+    }
+    else
+    {
+        res = (HAL_DMA_Start_IT(&g_wave_dma_bsrr_handle, (uint32_t)gs_wave_bsrr,
+                                (uint32_t)&GPIOA->BSRR, words) == HAL_OK) ? 0 : 1;
+    }
+    if (res != 0)
+    {
+        (void)HAL_DMA_Abort(&g_wave_dma_idr_handle);
+        
+        return 1;
+    }
+    
+    /* start the timer from zero with the requests enabled */
+    __HAL_TIM_SET_COUNTER(&g_wave_handle, 0);
+    __HAL_TIM_CLEAR_FLAG(&g_wave_handle, TIM_FLAG_UPDATE | TIM_FLAG_CC1);
+    __HAL_TIM_ENABLE_DMA(&g_wave_handle, (samples != 0) ? (TIM_DMA_UPDATE | TIM_DMA_CC1) : TIM_DMA_UPDATE);
+    __HAL_TIM_ENABLE(&g_wave_handle);
+    
+    /* wait for the last stream */
+    res = 0;
+    if (in_irq != 0)
+    {
+        if (HAL_DMA_PollForTransfer(&g_wave_dma_bsrr_handle, HAL_DMA_FULL_TRANSFER, 10) != HAL_OK)
+        {
+            res = 1;
+        }
+        if ((samples != 0) &&
+            (HAL_DMA_PollForTransfer(&g_wave_dma_idr_handle, HAL_DMA_FULL_TRANSFER, 10) != HAL_OK))
+        {
+            res = 1;
+        }
+    }
+    else
+    {
+        start = HAL_GetTick();
+        while (g_wave_done == 0)
+        {
+            /* check the timeout */
+            if ((HAL_GetTick() - start) > 10)
+            {
+                res = 1;
+                
+                break;
+            }
+            
+            /* a pending interrupt wakes wfi even when masked */
+            __disable_irq();
+            if (g_wave_done == 0)
+            {
+                __WFI();
+            }
+            __enable_irq();
+        }
+        if (g_wave_done == 2)
+        {
+            res = 1;
+        }
+        if ((res == 0) && (samples != 0))
+        {
+            /* the bsrr stream has one word more, let it end */
+            if (HAL_DMA_PollForTransfer(&g_wave_dma_bsrr_handle, HAL_DMA_FULL_TRANSFER, 10) != HAL_OK)
+            {
+                res = 1;
+            }
+        }
+    }
+    
+    /* stop the timer and the requests */
+    __HAL_TIM_DISABLE(&g_wave_handle);
+    __HAL_TIM_DISABLE_DMA(&g_wave_handle, TIM_DMA_UPDATE | TIM_DMA_CC1);
+    if (res != 0)
+    {
+        (void)HAL_DMA_Abort(&g_wave_dma_bsrr_handle);
+        (void)HAL_DMA_Abort(&g_wave_dma_idr_handle);
+    }
+    
+    return res;
+}
+
+/**
+ * @brief     wave init
+ * @param[in] bit_rate sclk rate in bit/s
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      SCLK is PA0 and IO is PA8, TIM1 paces DMA2 stream5 into GPIOA->BSRR
+ *            and DMA2 stream1 out of GPIOA->IDR, TIM1 counts the 168MHz apb2 timer clock
+ */
+uint8_t wave_init(uint32_t bit_rate)
+{
+    GPIO_InitTypeDef GPIO_InitStruct;
+    TIM_OC_InitTypeDef sConfig;
+    uint32_t clk;
+    
+    /* apb2 timers run at twice the bus clock when it is divided */
+    clk = HAL_RCC_GetPCLK2Freq();
+    if ((RCC->CFGR & RCC_CFGR_PPRE2) != RCC_CFGR_PPRE2_DIV1)
+    {
+        clk *= 2;
+    }
+    
+    /* two words per bit, the dma needs some ticks per word */
+    if ((bit_rate == 0) || (bit_rate > 2000000) || (clk / (bit_rate * 2) < 16))
+    {
+        return 1;
+    }
+    
+    /* enable the gpio clock */
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    
+    /* both pins idle low as outputs */
+    GPIOA->BSRR = WAVE_SCLK_RESET | WAVE_IO_RESET;
+    GPIO_InitStruct.Pin = GPIO_PIN_0 | GPIO_PIN_8;
+    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+    GPIO_InitStruct.Pull = GPIO_PULLDOWN;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+    
+    /* link the dma streams, the msp init sets them up */
+    __HAL_LINKDMA(&g_wave_handle, hdma[TIM_DMA_ID_UPDATE], g_wave_dma_bsrr_handle);
+    __HAL_LINKDMA(&g_wave_handle, hdma[TIM_DMA_ID_CC1], g_wave_dma_idr_handle);
+    
+    /* one period per word */
+    g_wave_handle.Instance = TIM1;
+    g_wave_handle.Init.Prescaler = 0;
+    g_wave_handle.Init.CounterMode = TIM_COUNTERMODE_UP;
+    g_wave_handle.Init.Period = clk / (bit_rate * 2) - 1;
+    g_wave_handle.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    g_wave_handle.Init.RepetitionCounter = 0;
+    g_wave_handle.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+    if (HAL_TIM_OC_Init(&g_wave_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    /* cc1 only raises the sampling request, the pin stays free */
+    sConfig.OCMode = TIM_OCMODE_TIMING;
+    sConfig.Pulse = (g_wave_handle.Init.Period + 1) * 3 / 4;
+    sConfig.OCPolarity = TIM_OCPOLARITY_HIGH;
+    sConfig.OCNPolarity = TIM_OCNPOLARITY_HIGH;
+    sConfig.OCFastMode = TIM_OCFAST_DISABLE;
+    sConfig.OCIdleState = TIM_OCIDLESTATE_RESET;
+    sConfig.OCNIdleState = TIM_OCNIDLESTATE_RESET;
+    if (HAL_TIM_OC_ConfigChannel(&g_wave_handle, &sConfig, TIM_CHANNEL_1) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    /* the callbacks are set once, the streams are started by hand */
+    g_wave_dma_bsrr_handle.XferCpltCallback = a_wave_dma_done;
+    g_wave_dma_bsrr_handle.XferErrorCallback = a_wave_dma_error;
+    g_wave_dma_idr_handle.XferCpltCallback = a_wave_dma_done;
+    g_wave_dma_idr_handle.XferErrorCallback = a_wave_dma_error;
+    
+    return 0;
+}
+
+/**
+ * @brief  wave deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t wave_deinit(void)
+{
+    /* stop the counter */
+    __HAL_TIM_DISABLE(&g_wave_handle);
+    
+    /* tim deinit */
+    if (HAL_TIM_OC_DeInit(&g_wave_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    /* gpio deinit */
+    HAL_GPIO_DeInit(GPIOA, GPIO_PIN_0 | GPIO_PIN_8);
+    
+    return 0;
+}
+
+/**
+ * @brief     wave write data
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the bytes are shifted out lsb first and the run ends with sclk low
+ */
+uint8_t wave_write(uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+    uint16_t n;
+    uint8_t j;
+    
+    if (len == 0)
+    {
+        return 0;
+    }
+    if (len > WAVE_MAX_LEN)
+    {
+        return 1;
+    }
+    
+    /* io low phase with the data bit, then the rising edge */
+    for (i = 0, n = 0; i < len; i++)
+    {
+        for (j = 0; j < 8; j++)
+        {
+            gs_wave_bsrr[n++] = (((buf[i] >> j) & 0x01) != 0) ? (WAVE_IO_SET | WAVE_SCLK_RESET) :
+                                                                (WAVE_IO_RESET | WAVE_SCLK_RESET);
+            gs_wave_bsrr[n++] = WAVE_SCLK_SET;
+        }
+    }
+    gs_wave_bsrr[n++] = WAVE_SCLK_RESET;
+    
+    /* drive io */
+    WAVE_IO_OUT();
+    
+    return a_wave_run(n, 0);
+}
+
+/**
+ * @brief      wave read data
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       io is sampled in the middle of each sclk low phase and the bits are unpacked afterwards
+ */
+uint8_t wave_read(uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+    uint16_t n;
+    uint8_t j;
+    
+    if (len == 0)
+    {
+        return 0;
+    }
+    if (len > WAVE_MAX_LEN)
+    {
+        return 1;
+    }
+    
+    /* the chip drives io after the falling edge, so each bit is a low phase and a rising edge */
+    for (n = 0; n < len * 16; n += 2)
+    {
+        gs_wave_bsrr[n] = WAVE_SCLK_RESET;
+        gs_wave_bsrr[n + 1] = WAVE_SCLK_SET;
+    }
+    gs_wave_bsrr[n++] = WAVE_SCLK_RESET;
+    
+    /* release io */
+    WAVE_IO_IN();
+    
+    /* play and sample */
+    if (a_wave_run(n, len * 16) != 0)
+    {
+        return 1;
+    }
+    
+    /* bit j of byte i was held by word i * 16 + j * 2, read by the sample after it */
+    for (i = 0; i < len; i++)
+    {
+        buf[i] = 0;
+        for (j = 0; j < 8; j++)
+        {
+            if ((gs_wave_idr[i * 16 + j * 2 + 1] & GPIO_PIN_8) != 0)
+            {
+                buf[i] |= (uint8_t)(1 << j);
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  wave get the tim handle
+ * @return pointer to a tim handle
+ * @note   the update and cc1 dma handles hang off it
+ */
+TIM_HandleTypeDef* wave_get_handle(void)
+{
+    return &g_wave_handle;
+}
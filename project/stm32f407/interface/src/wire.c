@@ -101,18 +101,38 @@ uint8_t wire_deinit(void)
     return 0; 
 }
 
+/**
+ * @brief     wire bus set the direction
+ * @param[in] output direction, 0 is input and 1 is output
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t wire_set_direction(uint8_t output)
+{
+    if (output != 0)
+    {
+        /* output mode */
+        IO_OUT();
+    }
+    else
+    {
+        /* input mode */
+        IO_IN();
+    }
+    
+    return 0;
+}
+
 /**
  * @brief      wire bus read data
  * @param[out] *value pointer to a read data buffer
  * @return     status code
  *             - 0 success
- * @note       none
+ * @note       the line must be set as input with wire_set_direction
  */
 uint8_t wire_read(uint8_t *value)
 {
-    /* input mode */
-    IO_IN();
-    
     /* read the data */
     *value = DQ_IN;
     
@@ -124,13 +144,10 @@ uint8_t wire_read(uint8_t *value)
  * @param[in] value write data
  * @return    status code
  *            - 0 success
- * @note      none
+ * @note      the line must be set as output with wire_set_direction
  */
 uint8_t wire_write(uint8_t value)
 {
-    /* output mode */
-    IO_OUT();
-    
     /* set the data */
     DQ_OUT = value;
   
@@ -114,6 +114,36 @@ void USART1_IRQHandler(void);
  */
 void USART2_IRQHandler(void);
 
+/**
+ * @brief tim2 irq handler
+ * @note  none
+ */
+void TIM2_IRQHandler(void);
+
+/**
+ * @brief dma2 stream1 irq handler
+ * @note  none
+ */
+void DMA2_Stream1_IRQHandler(void);
+
+/**
+ * @brief dma2 stream2 irq handler
+ * @note  none
+ */
+void DMA2_Stream2_IRQHandler(void);
+
+/**
+ * @brief dma2 stream3 irq handler
+ * @note  none
+ */
+void DMA2_Stream3_IRQHandler(void);
+
+/**
+ * @brief dma2 stream5 irq handler
+ * @note  none
+ */
+void DMA2_Stream5_IRQHandler(void);
+
 /**
  * @}
  */
@@ -147,6 +147,198 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef* huart)
     }
 }
 
+/**
+ * @brief     tim hal init
+ * @param[in] *htim pointer to a tim handle
+ * @note      none
+ */
+void HAL_TIM_Base_MspInit(TIM_HandleTypeDef *htim)
+{
+    if (htim->Instance == TIM2)
+    {
+        /* enable tim2 clock */
+        __HAL_RCC_TIM2_CLK_ENABLE();
+        
+        /* enable nvic, below systick so a polled spi byte in the tick still sees the hal timeout advance */
+        HAL_NVIC_SetPriority(TIM2_IRQn, 1, 0);
+        HAL_NVIC_EnableIRQ(TIM2_IRQn);
+    }
+}
+
+/**
+ * @brief     tim hal deinit
+ * @param[in] *htim pointer to a tim handle
+ * @note      none
+ */
+void HAL_TIM_Base_MspDeInit(TIM_HandleTypeDef *htim)
+{
+    if (htim->Instance == TIM2)
+    {
+        /* disable tim2 clock */
+        __HAL_RCC_TIM2_CLK_DISABLE();
+        
+        /* disable nvic */
+        HAL_NVIC_DisableIRQ(TIM2_IRQn);
+    }
+}
+
+/**
+ * @brief     tim oc hal init
+ * @param[in] *htim pointer to a tim handle
+ * @note      none
+ */
+void HAL_TIM_OC_MspInit(TIM_HandleTypeDef *htim)
+{
+    if (htim->Instance == TIM1)
+    {
+        /* enable tim1 and dma2 clock */
+        __HAL_RCC_TIM1_CLK_ENABLE();
+        __HAL_RCC_DMA2_CLK_ENABLE();
+        
+        /* dma2 stream5 channel6 ------> TIM1_UP, words into GPIOA->BSRR */
+        htim->hdma[TIM_DMA_ID_UPDATE]->Instance = DMA2_Stream5;
+        htim->hdma[TIM_DMA_ID_UPDATE]->Init.Channel = DMA_CHANNEL_6;
+        htim->hdma[TIM_DMA_ID_UPDATE]->Init.Direction = DMA_MEMORY_TO_PERIPH;
+        htim->hdma[TIM_DMA_ID_UPDATE]->Init.PeriphInc = DMA_PINC_DISABLE;
+        htim->hdma[TIM_DMA_ID_UPDATE]->Init.MemInc = DMA_MINC_ENABLE;
+        htim->hdma[TIM_DMA_ID_UPDATE]->Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+        htim->hdma[TIM_DMA_ID_UPDATE]->Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+        htim->hdma[TIM_DMA_ID_UPDATE]->Init.Mode = DMA_NORMAL;
+        htim->hdma[TIM_DMA_ID_UPDATE]->Init.Priority = DMA_PRIORITY_VERY_HIGH;
+        htim->hdma[TIM_DMA_ID_UPDATE]->Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+        (void)HAL_DMA_Init(htim->hdma[TIM_DMA_ID_UPDATE]);
+        
+        /* dma2 stream1 channel6 ------> TIM1_CH1, GPIOA->IDR into the samples */
+        htim->hdma[TIM_DMA_ID_CC1]->Instance = DMA2_Stream1;
+        htim->hdma[TIM_DMA_ID_CC1]->Init.Channel = DMA_CHANNEL_6;
+        htim->hdma[TIM_DMA_ID_CC1]->Init.Direction = DMA_PERIPH_TO_MEMORY;
+        htim->hdma[TIM_DMA_ID_CC1]->Init.PeriphInc = DMA_PINC_DISABLE;
+        htim->hdma[TIM_DMA_ID_CC1]->Init.MemInc = DMA_MINC_ENABLE;
+        htim->hdma[TIM_DMA_ID_CC1]->Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+        htim->hdma[TIM_DMA_ID_CC1]->Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+        htim->hdma[TIM_DMA_ID_CC1]->Init.Mode = DMA_NORMAL;
+        htim->hdma[TIM_DMA_ID_CC1]->Init.Priority = DMA_PRIORITY_VERY_HIGH;
+        htim->hdma[TIM_DMA_ID_CC1]->Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+        (void)HAL_DMA_Init(htim->hdma[TIM_DMA_ID_CC1]);
+        
+        /* enable nvic */
+        HAL_NVIC_SetPriority(DMA2_Stream5_IRQn, 1, 0);
+        HAL_NVIC_EnableIRQ(DMA2_Stream5_IRQn);
+        HAL_NVIC_SetPriority(DMA2_Stream1_IRQn, 1, 0);
+        HAL_NVIC_EnableIRQ(DMA2_Stream1_IRQn);
+    }
+}
+
+/**
+ * @brief     tim oc hal deinit
+ * @param[in] *htim pointer to a tim handle
+ * @note      none
+ */
+void HAL_TIM_OC_MspDeInit(TIM_HandleTypeDef *htim)
+{
+    if (htim->Instance == TIM1)
+    {
+        /* disable tim1 clock */
+        __HAL_RCC_TIM1_CLK_DISABLE();
+        
+        /* dma deinit */
+        (void)HAL_DMA_DeInit(htim->hdma[TIM_DMA_ID_UPDATE]);
+        (void)HAL_DMA_DeInit(htim->hdma[TIM_DMA_ID_CC1]);
+        
+        /* disable nvic */
+        HAL_NVIC_DisableIRQ(DMA2_Stream5_IRQn);
+        HAL_NVIC_DisableIRQ(DMA2_Stream1_IRQn);
+    }
+}
+
+/**
+ * @brief     spi hal init
+ * @param[in] *hspi pointer to a spi handle
+ * @note      none
+ */
+void HAL_SPI_MspInit(SPI_HandleTypeDef *hspi)
+{
+    GPIO_InitTypeDef GPIO_InitStruct;
+    
+    if (hspi->Instance == SPI1)
+    {
+        /* enable spi gpio clock */
+        __HAL_RCC_GPIOA_CLK_ENABLE();
+        
+        /* enable spi1 and dma2 clock */
+        __HAL_RCC_SPI1_CLK_ENABLE();
+        __HAL_RCC_DMA2_CLK_ENABLE();
+        
+        /**
+         * PA5 ------> SPI1_SCK
+         * PA7 ------> SPI1_MOSI, the bidirectional data line
+         */
+        GPIO_InitStruct.Pin = GPIO_PIN_5 | GPIO_PIN_7;
+        GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+        GPIO_InitStruct.Pull = GPIO_PULLDOWN;
+        GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+        GPIO_InitStruct.Alternate = GPIO_AF5_SPI1;
+        HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+        
+        /* dma2 stream3 channel3 ------> SPI1_TX */
+        hspi->hdmatx->Instance = DMA2_Stream3;
+        hspi->hdmatx->Init.Channel = DMA_CHANNEL_3;
+        hspi->hdmatx->Init.Direction = DMA_MEMORY_TO_PERIPH;
+        hspi->hdmatx->Init.PeriphInc = DMA_PINC_DISABLE;
+        hspi->hdmatx->Init.MemInc = DMA_MINC_ENABLE;
+        hspi->hdmatx->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+        hspi->hdmatx->Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+        hspi->hdmatx->Init.Mode = DMA_NORMAL;
+        hspi->hdmatx->Init.Priority = DMA_PRIORITY_HIGH;
+        hspi->hdmatx->Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+        (void)HAL_DMA_Init(hspi->hdmatx);
+        
+        /* dma2 stream2 channel3 ------> SPI1_RX */
+        hspi->hdmarx->Instance = DMA2_Stream2;
+        hspi->hdmarx->Init.Channel = DMA_CHANNEL_3;
+        hspi->hdmarx->Init.Direction = DMA_PERIPH_TO_MEMORY;
+        hspi->hdmarx->Init.PeriphInc = DMA_PINC_DISABLE;
+        hspi->hdmarx->Init.MemInc = DMA_MINC_ENABLE;
+        hspi->hdmarx->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+        hspi->hdmarx->Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+        hspi->hdmarx->Init.Mode = DMA_NORMAL;
+        hspi->hdmarx->Init.Priority = DMA_PRIORITY_HIGH;
+        hspi->hdmarx->Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+        (void)HAL_DMA_Init(hspi->hdmarx);
+        
+        /* enable nvic */
+        HAL_NVIC_SetPriority(DMA2_Stream3_IRQn, 1, 0);
+        HAL_NVIC_EnableIRQ(DMA2_Stream3_IRQn);
+        HAL_NVIC_SetPriority(DMA2_Stream2_IRQn, 1, 0);
+        HAL_NVIC_EnableIRQ(DMA2_Stream2_IRQn);
+    }
+}
+
+/**
+ * @brief     spi hal deinit
+ * @param[in] *hspi pointer to a spi handle
+ * @note      none
+ */
+void HAL_SPI_MspDeInit(SPI_HandleTypeDef *hspi)
+{
+    if (hspi->Instance == SPI1)
+    {
+        /* disable spi1 clock */
+        __HAL_RCC_SPI1_CLK_DISABLE();
+        
+        /* spi gpio deinit */
+        HAL_GPIO_DeInit(GPIOA, GPIO_PIN_5 | GPIO_PIN_7);
+        
+        /* dma deinit */
+        (void)HAL_DMA_DeInit(hspi->hdmatx);
+        (void)HAL_DMA_DeInit(hspi->hdmarx);
+        
+        /* disable nvic */
+        HAL_NVIC_DisableIRQ(DMA2_Stream3_IRQn);
+        HAL_NVIC_DisableIRQ(DMA2_Stream2_IRQn);
+    }
+}
+
 /**
  * @}
  */
@@ -36,6 +36,9 @@
 
 #include "stm32f4xx_it.h"
 #include "uart.h"
+#include "tim.h"
+#include "spi.h"
+#include "wave.h"
 
 /**
  * @brief nmi handler
@@ -164,6 +167,58 @@ void USART2_IRQHandler(void)
     HAL_UART_IRQHandler(uart2_get_handle());
 }
 
+/**
+ * @brief tim2 irq handler
+ * @note  the update flag is handled here without the hal dispatch to keep the tick short
+ */
+void TIM2_IRQHandler(void)
+{
+    if (__HAL_TIM_GET_FLAG(tim_get_handle(), TIM_FLAG_UPDATE) != RESET)
+    {
+        /* clear the update flag */
+        __HAL_TIM_CLEAR_FLAG(tim_get_handle(), TIM_FLAG_UPDATE);
+        
+        /* run the tim irq handler */
+        tim_irq_handler();
+    }
+}
+
+/**
+ * @brief dma2 stream1 irq handler
+ * @note  none
+ */
+void DMA2_Stream1_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(wave_get_handle()->hdma[TIM_DMA_ID_CC1]);
+}
+
+/**
+ * @brief dma2 stream2 irq handler
+ * @note  none
+ */
+void DMA2_Stream2_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(spi_get_handle()->hdmarx);
+}
+
+/**
+ * @brief dma2 stream3 irq handler
+ * @note  none
+ */
+void DMA2_Stream3_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(spi_get_handle()->hdmatx);
+}
+
+/**
+ * @brief dma2 stream5 irq handler
+ * @note  none
+ */
+void DMA2_Stream5_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(wave_get_handle()->hdma[TIM_DMA_ID_UPDATE]);
+}
+
 /**
  * @brief     uart error callback
  * @param[in] *huart pointer to a uart handle
@@ -211,3 +266,45 @@ void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
         uart2_set_tx_done();
     }
 }
+
+/**
+ * @brief     spi tx finished callback
+ * @param[in] *hspi pointer to a spi handle
+ * @note      none
+ */
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi->Instance == SPI1)
+    {
+        /* set done */
+        spi_set_done();
+    }
+}
+
+/**
+ * @brief     spi rx finished callback
+ * @param[in] *hspi pointer to a spi handle
+ * @note      none
+ */
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi->Instance == SPI1)
+    {
+        /* set done */
+        spi_set_done();
+    }
+}
+
+/**
+ * @brief     spi error callback
+ * @param[in] *hspi pointer to a spi handle
+ * @note      none
+ */
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi->Instance == SPI1)
+    {
+        /* set error */
+        spi_set_error();
+    }
+}
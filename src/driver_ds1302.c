@@ -69,209 +69,269 @@
 #define DS1302_COMMAND_BURST            (0x1F << 1)     /**< burst command */
 
 /**
- * @brief     write one byte
+ * @brief io direction definition
+ */
+#define DS1302_IO_DIRECTION_INPUT       0x00            /**< io input */
+#define DS1302_IO_DIRECTION_OUTPUT      0x01            /**< io output */
+#define DS1302_IO_DIRECTION_UNKNOWN     0xFF            /**< io direction unknown */
+
+/**
+ * @brief xfer state definition
+ */
+#define DS1302_XFER_STATE_IDLE          0x00            /**< no transfer */
+#define DS1302_XFER_STATE_BEGIN         0x01            /**< raise ce */
+#define DS1302_XFER_STATE_RISE          0x02            /**< sample io and raise sclk */
+#define DS1302_XFER_STATE_FALL          0x03            /**< drop sclk and set the next bit */
+#define DS1302_XFER_STATE_BYTE          0x04            /**< move one byte */
+#define DS1302_XFER_STATE_END           0x05            /**< drop ce */
+
+/**
+ * @brief time cache definition
+ */
+#define DS1302_CACHE_INTERVAL_MS        1000            /**< default resync interval */
+#define DS1302_CACHE_INTERVAL_MAX_MS    3600000         /**< the elapsed us must fit in 32 bits */
+
+/**
+ * @brief second edge definition
+ */
+#define DS1302_EDGE_COARSE_MS           50              /**< polling step before the first edge */
+#define DS1302_EDGE_COARSE_POLLS        24              /**< a little more than 1s */
+#define DS1302_EDGE_FINE_MS             1               /**< polling step near the second edge */
+#define DS1302_EDGE_FINE_POLLS          100             /**< covers the coarse window and the guard */
+#define DS1302_EDGE_GUARD_US            5000            /**< wake up before the expected edge */
+
+/**
+ * @brief unix timestamp definition
+ */
+#define DS1302_UNIX_2000                946684800U      /**< 2000-01-01 00:00:00 */
+#define DS1302_UNIX_2099                4102444799U     /**< 2099-12-31 23:59:59 */
+#define DS1302_WEEK_2000                6               /**< 2000-01-01 is a saturday */
+
+/**
+ * @brief swar definition
+ */
+#define DS1302_SWAR_NIBBLE              0x0F0F0F0F0F0F0F0FULL     /**< low nibble of every byte */
+#define DS1302_SWAR_LANE                0x00FF00FF00FF00FFULL     /**< low byte of every 16 bits lane */
+#define DS1302_SWAR_TENS                0x000F000F000F000FULL     /**< tens of every 16 bits lane */
+#define DS1302_SWAR_MASK_24H            0x00FF071F3F3F7F7FULL     /**< clock fields in 24H */
+#define DS1302_SWAR_MASK_12H            0x00FF071F3F1F7F7FULL     /**< clock fields in 12H */
+#define DS1302_COMPACT_MAX              3155759999U               /**< 2099-12-31 23:59:59 */
+
+/**
+ * @brief drift definition
+ */
+#define DS1302_DRIFT_MAGIC              0xD5            /**< drift ram record magic */
+#define DS1302_DRIFT_RECORD_LEN         10              /**< magic, ppb, reference and crc8 */
+#define DS1302_DRIFT_WINDOW_MAX_S       4000            /**< the elapsed us must fit in 32 bits */
+#define DS1302_DRIFT_NO_REF             0xFFFFFFFFU     /**< no drift reference yet */
+
+/**
+ * @brief bit hook definition
+ */
+#if (DS1302_STATIC_PORT == 1)
+    #include "driver_ds1302_static_port.h"
+    #define DS1302_SCLK_WRITE(HANDLE, VALUE)      ds1302_static_port_sclk_gpio_write((HANDLE)->ctx, (VALUE))
+    #define DS1302_IO_WRITE(HANDLE, VALUE)        ds1302_static_port_io_gpio_write((HANDLE)->ctx, (VALUE))
+    #define DS1302_IO_READ(HANDLE, VALUE)         ds1302_static_port_io_gpio_read((HANDLE)->ctx, (VALUE))
+    #define DS1302_DELAY_US(HANDLE, US)           ds1302_static_port_delay_us(US)
+#else
+    #define DS1302_SCLK_WRITE(HANDLE, VALUE)      (HANDLE)->sclk_gpio_write((HANDLE)->ctx, (VALUE))
+    #define DS1302_IO_WRITE(HANDLE, VALUE)        (HANDLE)->io_gpio_write((HANDLE)->ctx, (VALUE))
+    #define DS1302_IO_READ(HANDLE, VALUE)         (HANDLE)->io_gpio_read((HANDLE)->ctx, (VALUE))
+    #define DS1302_DELAY_US(HANDLE, US)           (HANDLE)->delay_us(US)
+#endif
+
+/**
+ * @brief stats counter definition
+ */
+#if (DS1302_ENABLE_STATS == 1)
+    #define DS1302_STATS_ADD(HANDLE, FIELD, N)    ((HANDLE)->stats.FIELD += (N))
+#else
+    #define DS1302_STATS_ADD(HANDLE, FIELD, N)
+#endif
+
+/**
+ * @brief     set the io direction
  * @param[in] *handle pointer to a ds1302 handle structure
- * @param[in] reg register address
- * @param[in] data written data
+ * @param[in] direction io direction
+ * @return    status code
+ *            - 0 success
+ *            - 1 set direction failed
+ * @note      the callback is only invoked when the direction really changes
+ */
+static uint8_t a_ds1302_gpio_set_direction(ds1302_handle_t *handle, uint8_t direction)
+{
+    if (handle->io_gpio_set_direction == NULL)                  /* check the callback */
+    {
+        return 0;                                               /* success return 0 */
+    }
+    if (handle->io_direction == direction)                      /* check the direction */
+    {
+        return 0;                                               /* success return 0 */
+    }
+    DS1302_STATS_ADD(handle, gpio_calls, 1);                    /* count the call */
+    if (handle->io_gpio_set_direction(handle->ctx, direction) != 0) /* set the direction */
+    {
+        handle->io_direction = DS1302_IO_DIRECTION_UNKNOWN;     /* direction unknown */
+        
+        return 1;                                               /* return error */
+    }
+    handle->io_direction = direction;                           /* save the direction */
+    
+    return 0;                                                   /* success return 0 */
+}
+
+/**
+ * @brief     gpio write bytes
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data buffer length
  * @return    status code
  *            - 0 success
  *            - 1 write failed
- * @note      none
+ * @note      bytes are shifted out lsb first and latched on the rising edge of sclk
  */
-static uint8_t a_ds1302_write(ds1302_handle_t *handle, uint8_t reg, uint8_t data)
+static uint8_t a_ds1302_gpio_write_bytes(ds1302_handle_t *handle, uint8_t *buf, uint8_t len)
 {
     uint8_t res;
     uint8_t i;
+    uint8_t j;
     uint8_t temp;
-    uint8_t prev;
     
-    prev = (1 << 7) | reg;                         /* set reg */
-    res = handle->ce_gpio_write(1);                /* set ce high */
-    if (res != 0)                                  /* check the result */
+    res = a_ds1302_gpio_set_direction(handle, DS1302_IO_DIRECTION_OUTPUT);        /* set io output */
+    if (res != 0)                                                                 /* check the result */
     {
-        return 1;                                  /* return error */
+        return 1;                                                                 /* return error */
     }
-    temp = prev;                                   /* set reg */
-    for (i = 0; i < 8; i++)                        /* loop */
+    for (j = 0; j < len; j++)                      /* write all */
     {
-        if ((temp & 0x01) != 0)                    /* check lsb bit */
+        temp = buf[j];                             /* set data */
+        for (i = 0; i < 8; i++)                    /* loop */
         {
-            res = handle->io_gpio_write(1);        /* set io high */
-            if (res != 0)                          /* check the result */
+            if ((temp & 0x01) != 0)                /* check the lsb bit */
             {
-                return 1;                          /* return error */
+                res = DS1302_IO_WRITE(handle, 1);  /* set io high */
+                if (res != 0)                      /* check the result */
+                {
+                    return 1;                      /* return error */
+                }
             }
-        }
-        else
-        {
-            res = handle->io_gpio_write(0);        /* set io low */
-            if (res != 0)                          /* check the result */
+            else
             {
-                return 1;                          /* return error */
+                res = DS1302_IO_WRITE(handle, 0);  /* set io low */
+                if (res != 0)                      /* check the result */
+                {
+                    return 1;                      /* return error */
+                }
             }
-        }
-        temp = temp >> 1;                          /* right shift 1 */
-        handle->delay_us(1);                       /* delay 1us */
-        res = handle->sclk_gpio_write(1);          /* set sclk high */
-        if (res != 0)                              /* check the result */
-        {
-            return 1;                              /* return error */
-        }
-        handle->delay_us(1);                       /* delay 1us */
-        res = handle->sclk_gpio_write(0);          /* set sclk low */
-        if (res != 0)                              /* check the result */
-        {
-            return 1;                              /* return error */
-        }
-    }
-    temp = data;                                   /* set data */
-    for (i = 0; i < 8; i++)                        /* loop */
-    {
-        if ((temp & 0x01) != 0)                    /* check the lsb bit */
-        {
-            res = handle->io_gpio_write(1);        /* set io high */
+            temp = temp >> 1;                      /* right shift 1 */
+            DS1302_STATS_ADD(handle, gpio_calls, 3);   /* count the calls */
+            DS1302_DELAY_US(handle, 1);            /* delay 1us */
+            res = DS1302_SCLK_WRITE(handle, 1);    /* set sclk high */
             if (res != 0)                          /* check the result */
             {
                 return 1;                          /* return error */
             }
-        }
-        else
-        {
-            res = handle->io_gpio_write(0);        /* set io low */
+            DS1302_DELAY_US(handle, 1);            /* delay 1us */
+            res = DS1302_SCLK_WRITE(handle, 0);    /* set sclk low */
             if (res != 0)                          /* check the result */
             {
                 return 1;                          /* return error */
             }
         }
-        temp = temp >> 1;                          /* right shift 1 */
-        handle->delay_us(1);                       /* delay 1us */
-        res = handle->sclk_gpio_write(1);          /* set sclk high */
-        if (res != 0)                              /* check the result */
-        {
-            return 1;                              /* return error */
-        }
-        handle->delay_us(1);                       /* delay 1us */
-        res = handle->sclk_gpio_write(0);          /* set sclk low */
-        if (res != 0)                              /* check the result */
-        {
-            return 1;                              /* return error */
-        }
-    }
-    res = handle->io_gpio_write(0);                /* set io low */
-    if (res != 0)                                  /* check the result */
-    {
-        return 1;                                  /* return error */
-    }
-    res = handle->ce_gpio_write(0);                /* set ce low */
-    if (res != 0)                                  /* check the result */
-    {
-        return 1;                                  /* return error */
     }
     
     return 0;                                      /* success return 0 */
 }
 
 /**
- * @brief      read one byte
+ * @brief      gpio read bytes
  * @param[in]  *handle pointer to a ds1302 handle structure
- * @param[in]  reg register address
- * @param[out] *data pointer to a data buffer
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data buffer length
  * @return     status code
  *             - 0 success
  *             - 1 read failed
- * @note       none
+ * @note       bytes are shifted in lsb first, each bit is valid after the falling edge of sclk
  */
-static uint8_t a_ds1302_read(ds1302_handle_t *handle, uint8_t reg, uint8_t *data)
+static uint8_t a_ds1302_gpio_read_bytes(ds1302_handle_t *handle, uint8_t *buf, uint8_t len)
 {
     uint8_t res;
     uint8_t i;
+    uint8_t j;
     uint8_t temp;
-    uint8_t prev;
     
-    prev = (1 << 7) | reg;                         /* set reg */
-    res = handle->ce_gpio_write(1);                /* set ce high */
-    if (res != 0)                                  /* check the result */
+    res = a_ds1302_gpio_set_direction(handle, DS1302_IO_DIRECTION_INPUT);         /* set io input */
+    if (res != 0)                                                                 /* check the result */
     {
-        return 1;                                  /* return error */
+        return 1;                                                                 /* return error */
     }
-    temp = prev;                                   /* set reg */
-    for (i = 0; i < 8; i++)                        /* loop */
+    for (j = 0; j < len; j++)                      /* read all */
     {
-        if ((temp & 0x01) != 0)                    /* check the lsb */
+        temp = 0;                                  /* init temp 0 */
+        for (i = 0; i < 8; i++)                    /* loop */
         {
-            res = handle->io_gpio_write(1);        /* set io high */
+            uint8_t level;
+            
+            temp = temp >> 1;                      /* right shift 1 */
+            DS1302_STATS_ADD(handle, gpio_calls, 3);   /* count the calls */
+            res = DS1302_IO_READ(handle, &level);  /* read the level */
             if (res != 0)                          /* check the result */
             {
                 return 1;                          /* return error */
             }
-        }
-        else
-        {
-            res = handle->io_gpio_write(0);        /* set io low */
+            if (level != 0)                        /* check the level */
+            {
+                temp |= 1 << 7;                    /* set msb bit high */
+            }
+            else
+            {
+                temp &= ~(1 << 7);                 /* set msb bit low */
+            }
+            res = DS1302_SCLK_WRITE(handle, 1);    /* set sclk high */
+            if (res != 0)                          /* check the result */
+            {
+                return 1;                          /* return error */
+            }
+            DS1302_DELAY_US(handle, 1);            /* delay 1us */
+            res = DS1302_SCLK_WRITE(handle, 0);    /* set sclk low */
             if (res != 0)                          /* check the result */
             {
                 return 1;                          /* return error */
             }
         }
-        temp = temp >> 1;                          /* right shift 1 */
-        handle->delay_us(1);                       /* delay 1us */
-        res = handle->sclk_gpio_write(1);          /* set sclk high */
-        if (res != 0)                              /* check the result */
-        {
-            return 1;                              /* return error */
-        }
-        handle->delay_us(1);                       /* delay 1us */
-        res = handle->sclk_gpio_write(0);          /* set sclk low */
-        if (res != 0)                              /* check the result */
-        {
-            return 1;                              /* return error */
-        }
+        buf[j] = temp;                             /* save to buffer */
     }
-    temp = 0;                                      /* init temp 0 */
-    for (i = 0; i < 8; i++)                        /* loop */
+    
+    return 0;                                      /* success return 0 */
+}
+
+/**
+ * @brief     begin or end a transaction
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] ce ce level
+ * @return    status code
+ *            - 0 success
+ *            - 1 set ce failed
+ * @note      none
+ */
+static uint8_t a_ds1302_begin(ds1302_handle_t *handle, uint8_t ce)
+{
+    DS1302_STATS_ADD(handle, gpio_calls, 1);                    /* count the call */
+    DS1302_STATS_ADD(handle, ce_cycles, (ce != 0) ? 1 : 0);     /* count the ce cycle */
+    if (handle->transport == DS1302_TRANSPORT_BYTE)             /* byte transport */
     {
-        uint8_t level;
-        
-        temp = temp >> 1;                          /* right shift 1 */
-        res = handle->io_gpio_read(&level);        /* read the level */
-        if (res != 0)                              /* check the result */
-        {
-            return 1;                              /* return error */
-        }
-        if (level != 0)                            /* check the level */
-        {
-            temp |= 1 << 7;                        /* set msb bit high */
-        }
-        else
-        {
-            temp &= ~(1 << 7);                     /* set msb bit low */
-        }
-        res = handle->sclk_gpio_write(1);          /* set sclk high */
-        if (res != 0)                              /* check the result */
-        {
-            return 1;                              /* return error */
-        }
-        handle->delay_us(1);                       /* delay 1us */
-        res = handle->sclk_gpio_write(0);          /* set sclk low */
-        if (res != 0)                              /* check the result */
-        {
-            return 1;                              /* return error */
-        }
+        return handle->transport_begin(handle->ctx, ce);        /* transport begin */
     }
-    *data = temp;                                  /* save data */
-    res = handle->ce_gpio_write(0);                /* set ce low */
-    if (res != 0)                                  /* check the result */
+    else
     {
-        return 1;                                  /* return error */
+        return handle->ce_gpio_write(handle->ctx, ce);          /* set ce */
     }
-    
-    return 0;                                      /* success return 0 */
 }
 
 /**
- * @brief     write multiple bytes
+ * @brief     write bytes
  * @param[in] *handle pointer to a ds1302 handle structure
- * @param[in] reg register address
  * @param[in] *buf pointer to a data buffer
  * @param[in] len data buffer length
  * @return    status code
@@ -279,27 +339,23 @@ static uint8_t a_ds1302_read(ds1302_handle_t *handle, uint8_t reg, uint8_t *data
  *            - 1 write failed
  * @note      none
  */
-static uint8_t a_ds1302_multiple_write(ds1302_handle_t *handle, uint8_t reg, uint8_t *buf, uint8_t len)
+static uint8_t a_ds1302_write_bytes(ds1302_handle_t *handle, uint8_t *buf, uint8_t len)
 {
-    uint8_t res;
-    uint8_t i;
-    
-    for (i = 0; i < len; i++)                                                   /* loop */
+    if (handle->transport == DS1302_TRANSPORT_BYTE)             /* byte transport */
     {
-        res = a_ds1302_write(handle, (uint8_t)(reg + (i << 1)), buf[i]);        /* write one byte */
-        if (res != 0)                                                           /* check the result */
-        {
-            return 1;                                                           /* return error */
-        }
+        DS1302_STATS_ADD(handle, gpio_calls, 1);                /* count the call */
+        
+        return handle->transport_write_bytes(handle->ctx, buf, len); /* transport write */
+    }
+    else
+    {
+        return a_ds1302_gpio_write_bytes(handle, buf, len);     /* gpio write */
     }
-    
-    return 0;                                                                   /* success return 0 */
 }
 
 /**
- * @brief      read multiple bytes
+ * @brief      read bytes
  * @param[in]  *handle pointer to a ds1302 handle structure
- * @param[in]  reg register address
  * @param[out] *buf pointer to a data buffer
  * @param[in]  len data buffer length
  * @return     status code
@@ -307,25 +363,22 @@ static uint8_t a_ds1302_multiple_write(ds1302_handle_t *handle, uint8_t reg, uin
  *             - 1 read failed
  * @note       none
  */
-static uint8_t a_ds1302_multiple_read(ds1302_handle_t *handle, uint8_t reg, uint8_t *buf, uint8_t len)
+static uint8_t a_ds1302_read_bytes(ds1302_handle_t *handle, uint8_t *buf, uint8_t len)
 {
-    uint8_t res;
-    uint8_t i;
-    
-    for (i = 0; i < len; i++)                                                          /* loop */
+    if (handle->transport == DS1302_TRANSPORT_BYTE)             /* byte transport */
     {
-        res = a_ds1302_read(handle, (uint8_t)(reg + (i << 1) | 0x01), &buf[i]);        /* read one byte */
-        if (res != 0)                                                                  /* check the result */
-        {
-            return 1;                                                                  /* read error */
-        }
+        DS1302_STATS_ADD(handle, gpio_calls, 1);                /* count the call */
+        
+        return handle->transport_read_bytes(handle->ctx, buf, len); /* transport read */
+    }
+    else
+    {
+        return a_ds1302_gpio_read_bytes(handle, buf, len);      /* gpio read */
     }
-    
-    return 0;                                                                          /* success return 0 */
 }
 
 /**
- * @brief     burst write bytes
+ * @brief     transfer write bytes
  * @param[in] *handle pointer to a ds1302 handle structure
  * @param[in] reg register address
  * @param[in] *buf pointer to a data buffer
@@ -335,105 +388,49 @@ static uint8_t a_ds1302_multiple_read(ds1302_handle_t *handle, uint8_t reg, uint
  *            - 1 write failed
  * @note      none
  */
-static uint8_t a_ds1302_burst_write(ds1302_handle_t *handle, uint8_t reg, uint8_t *buf, uint8_t len)
+static uint8_t a_ds1302_transfer_write(ds1302_handle_t *handle, uint8_t reg, uint8_t *buf, uint8_t len)
 {
     uint8_t res;
-    uint8_t i;
-    uint8_t j;
-    uint8_t temp;
     uint8_t prev;
     
-    prev = (1 << 7) | reg;                         /* set reg */
-    res = handle->ce_gpio_write(1);                /* set ce high */
-    if (res != 0)                                  /* check the result */
+    prev = (1 << 7) | reg;                                     /* set reg */
+    res = a_ds1302_begin(handle, 1);                           /* set ce high */
+    if (res != 0)                                              /* check the result */
     {
-        return 1;                                  /* return error */
+        return 1;                                              /* return error */
     }
-    temp = prev;                                   /* set reg */
-    for (i = 0; i < 8; i++)                        /* loop */
+    res = a_ds1302_write_bytes(handle, &prev, 1);              /* write command */
+    if (res != 0)                                              /* check the result */
     {
-        if ((temp & 0x01) != 0)                    /* check lsb bit */
-        {
-            res = handle->io_gpio_write(1);        /* set io high */
-            if (res != 0)                          /* check the result */
-            {
-                return 1;                          /* return error */
-            }
-        }
-        else
-        {
-            res = handle->io_gpio_write(0);        /* set io low */
-            if (res != 0)                          /* check the result */
-            {
-                return 1;                          /* return error */
-            }
-        }
-        temp = temp >> 1;                          /* right shift 1 */
-        handle->delay_us(1);                       /* delay 1us */
-        res = handle->sclk_gpio_write(1);          /* set sclk high */
-        if (res != 0)                              /* check the result */
-        {
-            return 1;                              /* return error */
-        }
-        handle->delay_us(1);                       /* delay 1us */
-        res = handle->sclk_gpio_write(0);          /* set sclk low */
-        if (res != 0)                              /* check the result */
-        {
-            return 1;                              /* return error */
-        }
+        return 1;                                              /* return error */
     }
-    for (j = 0; j < len; j++)                      /* write all */
+    DS1302_STATS_ADD(handle, command_bytes, 1);                /* count the command */
+    res = a_ds1302_write_bytes(handle, buf, len);              /* write data */
+    if (res != 0)                                              /* check the result */
     {
-        temp = buf[j];                             /* set data */
-        for (i = 0; i < 8; i++)                    /* loop */
-        {
-            if ((temp & 0x01) != 0)                /* check the lsb bit */
-            {
-                res = handle->io_gpio_write(1);    /* set io high */
-                if (res != 0)                      /* check the result */
-                {
-                    return 1;                      /* return error */
-                }
-            }
-            else
-            {
-                res = handle->io_gpio_write(0);    /* set io low */
-                if (res != 0)                      /* check the result */
-                {
-                    return 1;                      /* return error */
-                }
-            }
-            temp = temp >> 1;                      /* right shift 1 */
-            handle->delay_us(1);                   /* delay 1us */
-            res = handle->sclk_gpio_write(1);      /* set sclk high */
-            if (res != 0)                          /* check the result */
-            {
-                return 1;                          /* return error */
-            }
-            handle->delay_us(1);                   /* delay 1us */
-            res = handle->sclk_gpio_write(0);      /* set sclk low */
-            if (res != 0)                          /* check the result */
-            {
-                return 1;                          /* return error */
-            }
-        }
+        return 1;                                              /* return error */
     }
-    res = handle->io_gpio_write(0);                /* set io low */
-    if (res != 0)                                  /* check the result */
+    DS1302_STATS_ADD(handle, data_bytes, len);                 /* count the data */
+    if (handle->transport == DS1302_TRANSPORT_GPIO)            /* gpio transport */
     {
-        return 1;                                  /* return error */
+        DS1302_STATS_ADD(handle, gpio_calls, 1);               /* count the call */
+        res = handle->io_gpio_write(handle->ctx, 0);           /* set io low */
+        if (res != 0)                                          /* check the result */
+        {
+            return 1;                                          /* return error */
+        }
     }
-    res = handle->ce_gpio_write(0);                /* set ce low */
-    if (res != 0)                                  /* check the result */
+    res = a_ds1302_begin(handle, 0);                           /* set ce low */
+    if (res != 0)                                              /* check the result */
     {
-        return 1;                                  /* return error */
+        return 1;                                              /* return error */
     }
     
-    return 0;                                      /* success return 0 */
+    return 0;                                                  /* success return 0 */
 }
 
 /**
- * @brief      burst read bytes
+ * @brief      transfer read bytes
  * @param[in]  *handle pointer to a ds1302 handle structure
  * @param[in]  reg register address
  * @param[out] *buf pointer to a data buffer
@@ -443,95 +440,210 @@ static uint8_t a_ds1302_burst_write(ds1302_handle_t *handle, uint8_t reg, uint8_
  *             - 1 read failed
  * @note       none
  */
-static uint8_t a_ds1302_burst_read(ds1302_handle_t *handle, uint8_t reg, uint8_t *buf, uint8_t len)
+static uint8_t a_ds1302_transfer_read(ds1302_handle_t *handle, uint8_t reg, uint8_t *buf, uint8_t len)
 {
     uint8_t res;
-    uint8_t i;
-    uint8_t j;
-    uint8_t temp;
     uint8_t prev;
     
-    prev = (1 << 7) | reg | 0x01;                  /* set reg */
-    res = handle->ce_gpio_write(1);                /* set ce high */
-    if (res != 0)                                  /* check the result */
+    prev = (1 << 7) | reg | 0x01;                              /* set reg */
+    res = a_ds1302_begin(handle, 1);                           /* set ce high */
+    if (res != 0)                                              /* check the result */
     {
-        return 1;                                  /* return error */
+        return 1;                                              /* return error */
     }
-    temp = prev;                                   /* set reg */
-    for (i = 0; i < 8; i++)                        /* loop */
+    res = a_ds1302_write_bytes(handle, &prev, 1);              /* write command */
+    if (res != 0)                                              /* check the result */
     {
-        if ((temp & 0x01) != 0)                    /* check the lsb */
-        {
-            res = handle->io_gpio_write(1);        /* set io high */
-            if (res != 0)                          /* check the result */
-            {
-                return 1;                          /* return error */
-            }
-        }
-        else
-        {
-            res = handle->io_gpio_write(0);        /* set io low */
-            if (res != 0)                          /* check the result */
-            {
-                return 1;                          /* return error */
-            }
-        }
-        temp = temp >> 1;                          /* right shift 1 */
-        handle->delay_us(1);                       /* delay 1us */
-        res = handle->sclk_gpio_write(1);          /* set sclk high */
-        if (res != 0)                              /* check the result */
-        {
-            return 1;                              /* return error */
-        }
-        handle->delay_us(1);                       /* delay 1us */
-        res = handle->sclk_gpio_write(0);          /* set sclk low */
-        if (res != 0)                              /* check the result */
-        {
-            return 1;                              /* return error */
-        }
+        return 1;                                              /* return error */
     }
-    for (j = 0; j < len; j++)                      /* read all */
+    DS1302_STATS_ADD(handle, command_bytes, 1);                /* count the command */
+    res = a_ds1302_read_bytes(handle, buf, len);               /* read data */
+    if (res != 0)                                              /* check the result */
     {
-        temp = 0;                                  /* init temp 0 */
-        for (i = 0; i < 8; i++)                    /* loop */
+        return 1;                                              /* return error */
+    }
+    DS1302_STATS_ADD(handle, data_bytes, len);                 /* count the data */
+    res = a_ds1302_begin(handle, 0);                           /* set ce low */
+    if (res != 0)                                              /* check the result */
+    {
+        return 1;                                              /* return error */
+    }
+    
+    return 0;                                                  /* success return 0 */
+}
+
+#if (DS1302_ENABLE_STATS == 1)
+/**
+ * @brief     record one transfer
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] start transfer start timestamp
+ * @param[in] res transfer result
+ * @note      none
+ */
+static void a_ds1302_stats_record(ds1302_handle_t *handle, uint32_t start, uint8_t res)
+{
+    uint32_t latency;
+    uint8_t bin;
+    
+    handle->stats.transactions++;                              /* count the transfer */
+    if (res != 0)                                              /* check the result */
+    {
+        handle->stats.failures++;                              /* count the failure */
+    }
+    if (handle->timestamp_us == NULL)                          /* check the timestamp */
+    {
+        return;                                                /* no latency */
+    }
+    latency = handle->timestamp_us() - start;                  /* get the latency */
+    handle->stats.bus_time_us += latency;                      /* sum the bus time */
+    bin = 0;                                                   /* init 0 */
+    while ((latency != 0) && (bin < (DS1302_STATS_HISTOGRAM_BINS - 1)))        /* log2 */
+    {
+        latency >>= 1;                                         /* right shift 1 */
+        bin++;                                                 /* next bin */
+    }
+    handle->stats.latency_histogram[bin]++;                    /* count the latency */
+}
+#endif
+
+/**
+ * @brief     burst write bytes
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_ds1302_burst_write(ds1302_handle_t *handle, uint8_t reg, uint8_t *buf, uint8_t len)
+{
+#if (DS1302_ENABLE_STATS == 1)
+    uint32_t start;
+    uint8_t res;
+    
+    start = (handle->timestamp_us != NULL) ? handle->timestamp_us() : 0;        /* get the start time */
+    res = a_ds1302_transfer_write(handle, reg, buf, len);                      /* write */
+    a_ds1302_stats_record(handle, start, res);                                 /* record the transfer */
+    
+    return res;                                                                /* return the result */
+#else
+    return a_ds1302_transfer_write(handle, reg, buf, len);                     /* write */
+#endif
+}
+
+/**
+ * @brief      burst read bytes
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_ds1302_burst_read(ds1302_handle_t *handle, uint8_t reg, uint8_t *buf, uint8_t len)
+{
+#if (DS1302_ENABLE_STATS == 1)
+    uint32_t start;
+    uint8_t res;
+    
+    start = (handle->timestamp_us != NULL) ? handle->timestamp_us() : 0;        /* get the start time */
+    res = a_ds1302_transfer_read(handle, reg, buf, len);                       /* read */
+    a_ds1302_stats_record(handle, start, res);                                 /* record the transfer */
+    
+    return res;                                                                /* return the result */
+#else
+    return a_ds1302_transfer_read(handle, reg, buf, len);                      /* read */
+#endif
+}
+
+/**
+ * @brief     write one byte
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] reg register address
+ * @param[in] data written data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_ds1302_write(ds1302_handle_t *handle, uint8_t reg, uint8_t data)
+{
+    return a_ds1302_burst_write(handle, reg, &data, 1);        /* write one byte */
+}
+
+/**
+ * @brief      read one byte
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[in]  reg register address
+ * @param[out] *data pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_ds1302_read(ds1302_handle_t *handle, uint8_t reg, uint8_t *data)
+{
+    return a_ds1302_burst_read(handle, reg, data, 1);          /* read one byte */
+}
+
+/**
+ * @brief     write multiple bytes
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_ds1302_multiple_write(ds1302_handle_t *handle, uint8_t reg, uint8_t *buf, uint8_t len)
+{
+    uint8_t res;
+    uint8_t i;
+    
+    for (i = 0; i < len; i++)                                                   /* loop */
+    {
+        res = a_ds1302_write(handle, (uint8_t)(reg + (i << 1)), buf[i]);        /* write one byte */
+        if (res != 0)                                                           /* check the result */
         {
-            uint8_t level;
-            
-            temp = temp >> 1;                      /* right shift 1 */
-            res = handle->io_gpio_read(&level);    /* read the level */
-            if (res != 0)                          /* check the result */
-            {
-                return 1;                          /* return error */
-            }
-            if (level != 0)                        /* check the level */
-            {
-                temp |= 1 << 7;                    /* set msb bit high */
-            }
-            else
-            {
-                temp &= ~(1 << 7);                 /* set msb bit low */
-            }
-            res = handle->sclk_gpio_write(1);      /* set sclk high */
-            if (res != 0)                          /* check the result */
-            {
-                return 1;                          /* return error */
-            }
-            handle->delay_us(1);                   /* delay 1us */
-            res = handle->sclk_gpio_write(0);      /* set sclk low */
-            if (res != 0)                          /* check the result */
-            {
-                return 1;                          /* return error */
-            }
+            return 1;                                                           /* return error */
         }
-        buf[j] = temp;                             /* save to buffer */
     }
-    res = handle->ce_gpio_write(0);                /* set ce low */
-    if (res != 0)                                  /* check the result */
+    
+    return 0;                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      read multiple bytes
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_ds1302_multiple_read(ds1302_handle_t *handle, uint8_t reg, uint8_t *buf, uint8_t len)
+{
+    uint8_t res;
+    uint8_t i;
+    
+    for (i = 0; i < len; i++)                                                          /* loop */
     {
-        return 1;                                  /* return error */
+        res = a_ds1302_read(handle, (uint8_t)(reg + (i << 1) | 0x01), &buf[i]);        /* read one byte */
+        if (res != 0)                                                                  /* check the result */
+        {
+            return 1;                                                                  /* read error */
+        }
     }
     
-    return 0;                                      /* success return 0 */
+    return 0;                                                                          /* success return 0 */
 }
 
 /**
@@ -570,74 +682,401 @@ static uint8_t a_ds1302_bcd2hex(uint8_t val)
 }
 
 /**
- * @brief     set the current time
- * @param[in] *handle pointer to a ds1302 handle structure
+ * @brief     get the days since 2000-01-01
+ * @param[in] year year
+ * @param[in] month month
+ * @param[in] date date
+ * @return    days
+ * @note      2000 <= year
+ */
+static uint32_t a_ds1302_days_from_civil(uint16_t year, uint8_t month, uint8_t date)
+{
+    uint32_t y;
+    uint32_t era;
+    uint32_t yoe;
+    uint32_t doy;
+    uint32_t doe;
+    
+    y = (uint32_t)year - ((month <= 2) ? 1 : 0);                                          /* years start in march */
+    era = y / 400;                                                                        /* 400 years era */
+    yoe = y - era * 400;                                                                  /* year of era */
+    doy = (153 * ((month + 9) % 12) + 2) / 5 + date - 1;                                  /* day of year */
+    doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;                                          /* day of era */
+    
+    return era * 146097 + doe - 730425;                                                   /* shift to 2000-01-01 */
+}
+
+/**
+ * @brief      get the date from the days since 2000-01-01
+ * @param[in]  days days since 2000-01-01
+ * @param[out] *year pointer to a year buffer
+ * @param[out] *month pointer to a month buffer
+ * @param[out] *date pointer to a date buffer
+ * @note       none
+ */
+static void a_ds1302_civil_from_days(uint32_t days, uint16_t *year, uint8_t *month, uint8_t *date)
+{
+    uint32_t era;
+    uint32_t doe;
+    uint32_t yoe;
+    uint32_t doy;
+    uint32_t mp;
+    uint32_t y;
+    
+    days += 730425;                                                                       /* shift to 0000-03-01 */
+    era = days / 146097;                                                                  /* 400 years era */
+    doe = days - era * 146097;                                                            /* day of era */
+    yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;                          /* year of era */
+    y = yoe + era * 400;                                                                  /* year from march */
+    doy = doe - (365 * yoe + yoe / 4 - yoe / 100);                                        /* day of year */
+    mp = (5 * doy + 2) / 153;                                                             /* month from march */
+    *date = (uint8_t)(doy - (153 * mp + 2) / 5 + 1);                                      /* set date */
+    *month = (uint8_t)((mp < 10) ? (mp + 3) : (mp - 9));                                  /* set month */
+    *year = (uint16_t)(y + ((*month <= 2) ? 1 : 0));                                      /* set year */
+}
+
+/**
+ * @brief     get the seconds since 2000-01-01
  * @param[in] *t pointer to a time structure
- * @return    status code
- *            - 0 success
- *            - 1 set time failed
- *            - 2 handle or time is NULL
- *            - 3 handle is not initialized
- *            - 4 time is invalid
+ * @return    seconds
  * @note      none
  */
-uint8_t ds1302_set_time(ds1302_handle_t *handle, ds1302_time_t *t)
+static uint32_t a_ds1302_time_to_seconds(ds1302_time_t *t)
 {
-    uint8_t res;
-    uint8_t reg;
-    uint16_t year;
+    uint32_t hour;
     
-    if (handle == NULL)                                                                                      /* check handle */
+    hour = t->hour;                                                                       /* get hour */
+    if (t->format == DS1302_FORMAT_12H)                                                   /* if 12H */
     {
-        return 2;                                                                                            /* return error */
+        hour = (hour % 12) + ((t->am_pm == DS1302_PM) ? 12 : 0);                          /* convert to 24H */
     }
-    if (handle->inited != 1)                                                                                 /* check handle initialization */
+    
+    return a_ds1302_days_from_civil(t->year, t->month, t->date) * 86400 +
+           hour * 3600 + (uint32_t)t->minute * 60 + t->second;                            /* return seconds */
+}
+
+/**
+ * @brief      get the time from the seconds since 2000-01-01
+ * @param[in]  s seconds since 2000-01-01
+ * @param[in]  ref_s reference seconds
+ * @param[in]  ref_week week at the reference seconds
+ * @param[in]  format hour format
+ * @param[out] *t pointer to a time structure
+ * @note       the week register is user defined, so it advances from the reference week
+ */
+static void a_ds1302_seconds_to_time(uint32_t s, uint32_t ref_s, uint8_t ref_week, 
+                                     ds1302_format_t format, ds1302_time_t *t)
+{
+    int32_t days;
+    uint32_t hour;
+    
+    a_ds1302_civil_from_days(s / 86400, &t->year, &t->month, &t->date);                  /* get date */
+    days = (int32_t)(s / 86400) - (int32_t)(ref_s / 86400);                               /* days from the reference */
+    t->week = (uint8_t)(((int32_t)ref_week - 1 + days % 7 + 7) % 7 + 1);                  /* get week */
+    s = s % 86400;                                                                        /* second of day */
+    hour = s / 3600;                                                                      /* get hour */
+    t->minute = (uint8_t)((s % 3600) / 60);                                               /* get minute */
+    t->second = (uint8_t)(s % 60);                                                        /* get second */
+    t->format = format;                                                                   /* get format */
+    if (t->format == DS1302_FORMAT_12H)                                                   /* if 12H */
     {
-        return 3;                                                                                            /* return error */
+        t->am_pm = (hour >= 12) ? DS1302_PM : DS1302_AM;                                  /* get am pm */
+        t->hour = (uint8_t)((hour % 12 == 0) ? 12 : (hour % 12));                         /* get hour */
     }
-    if (t == NULL)                                                                                           /* check time */
+    else
     {
-        handle->debug_print("ds1302: time is null.\n");                                                      /* time is null */
-        
-        return 2;                                                                                            /* return error */
+        t->hour = (uint8_t)hour;                                                          /* get hour */
+        t->am_pm = (ds1302_am_pm_t)((a_ds1302_hex2bcd(t->hour) >> 5) & 0x01);             /* same as the register decode */
     }
-    if (t->format == DS1302_FORMAT_12H)                                                                      /* if 12H */
+}
+
+/**
+ * @brief     crc8 of the drift record
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data buffer length
+ * @return    crc8
+ * @note      maxim polynomial x^8 + x^5 + x^4 + 1
+ */
+static uint8_t a_ds1302_crc8(uint8_t *buf, uint8_t len)
+{
+    uint8_t crc;
+    uint8_t i;
+    uint8_t j;
+    
+    crc = 0;                                                                              /* init 0 */
+    for (i = 0; i < len; i++)                                                             /* all bytes */
     {
-        if ((t->year < 2000) || (t->year > 2100))                                                            /* check year */
-        {
-            handle->debug_print("ds1302: year can't be over 2100 or less than 2000.\n");                     /* year can't be over 2100 or less than 2000 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if ((t->month == 0) || (t->month > 12))                                                              /* check month */
-        {
-            handle->debug_print("ds1302: month can't be zero or over than 12.\n");                           /* month can't be zero or over than 12 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if ((t->week == 0) || (t->week > 7))                                                                 /* check week */
-        {
-            handle->debug_print("ds1302: week can't be zero or over than 7.\n");                             /* week can't be zero or over than 7 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if ((t->date == 0) || (t->date > 31))                                                                /* check data */
-        {
-            handle->debug_print("ds1302: date can't be zero or over than 31.\n");                            /* date can't be zero or over than 31 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if ((t->hour < 1) || (t->hour > 12))                                                                 /* check hour */
-        {
-            handle->debug_print("ds1302: hour can't be over than 12 or less 1.\n");                          /* hour can't be over than 12 or less 1 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if (t->minute > 59)                                                                                  /* check minute */
+        crc ^= buf[i];                                                                    /* xor the byte */
+        for (j = 0; j < 8; j++)                                                           /* all bits */
         {
-            handle->debug_print("ds1302: minute can't be over than 59.\n");                                  /* minute can't be over than 59 */
-            
-            return 4;                                                                                        /* return error */
+            crc = (uint8_t)((crc & 0x01) ? ((crc >> 1) ^ 0x8C) : (crc >> 1));             /* shift */
+        }
+    }
+    
+    return crc;                                                                           /* return crc */
+}
+
+/**
+ * @brief     store the drift record in the chip ram
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 store failed
+ * @note      write protect must be disabled
+ */
+static uint8_t a_ds1302_drift_store(ds1302_handle_t *handle)
+{
+    uint8_t buf[DS1302_DRIFT_RECORD_LEN];
+    uint8_t check[DS1302_DRIFT_RECORD_LEN];
+    uint32_t ppb;
+    
+    ppb = (uint32_t)handle->drift_ppb;                                                    /* get ppb */
+    buf[0] = DS1302_DRIFT_MAGIC;                                                          /* set magic */
+    buf[1] = (uint8_t)(ppb >> 0);                                                         /* set ppb */
+    buf[2] = (uint8_t)(ppb >> 8);                                                         /* set ppb */
+    buf[3] = (uint8_t)(ppb >> 16);                                                        /* set ppb */
+    buf[4] = (uint8_t)(ppb >> 24);                                                        /* set ppb */
+    buf[5] = (uint8_t)(handle->drift_ref_s >> 0);                                         /* set reference */
+    buf[6] = (uint8_t)(handle->drift_ref_s >> 8);                                         /* set reference */
+    buf[7] = (uint8_t)(handle->drift_ref_s >> 16);                                        /* set reference */
+    buf[8] = (uint8_t)(handle->drift_ref_s >> 24);                                        /* set reference */
+    buf[9] = a_ds1302_crc8(buf, DS1302_DRIFT_RECORD_LEN - 1);                             /* set crc8 */
+    if (ds1302_write_ram(handle, DS1302_DRIFT_RAM_ADDR, buf, DS1302_DRIFT_RECORD_LEN) != 0)      /* write ram */
+    {
+        handle->debug_print("ds1302: write ram failed.\n");                               /* write ram failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    if (ds1302_read_ram(handle, DS1302_DRIFT_RAM_ADDR, check, DS1302_DRIFT_RECORD_LEN) != 0)     /* read ram */
+    {
+        handle->debug_print("ds1302: read ram failed.\n");                                /* read ram failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    if (memcmp(buf, check, DS1302_DRIFT_RECORD_LEN) != 0)                                 /* check the record */
+    {
+        handle->debug_print("ds1302: drift record verify failed.\n");                     /* drift record verify failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     move the drift reference to a newly written clock
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] ref seconds since 2000-01-01 of the written clock
+ * @param[in] control control register to restore
+ * @return    status code
+ *            - 0 success
+ *            - 1 rebase failed
+ * @note      while a drift record is kept in ram the clock burst leaves write protect cleared,
+ *            the record is rewritten with the new reference and then control is restored
+ */
+static uint8_t a_ds1302_drift_rebase(ds1302_handle_t *handle, uint32_t ref, uint8_t control)
+{
+    uint8_t res;
+    
+    handle->drift_ref_s = ref;                                                            /* the chip is right now */
+    if (handle->drift_record == 0)                                                        /* no record */
+    {
+        return 0;                                                                         /* success return 0 */
+    }
+    res = a_ds1302_drift_store(handle);                                                   /* rewrite the record */
+    if ((control & (1 << 7)) != 0)                                                        /* check write protect */
+    {
+        if (a_ds1302_write(handle, DS1302_COMMAND_RTC | DS1302_REG_CONTROL, control) != 0)   /* restore write protect */
+        {
+            res = 1;                                                                      /* restore failed */
+        }
+    }
+    
+    return res;                                                                           /* return the result */
+}
+
+/**
+ * @brief         correct the chip time with the drift coefficient
+ * @param[in]     *handle pointer to a ds1302 handle structure
+ * @param[in,out] *t pointer to a time structure
+ * @note          the error grows linearly from the drift reference
+ */
+static void a_ds1302_drift_apply(ds1302_handle_t *handle, ds1302_time_t *t)
+{
+    uint32_t s;
+    int64_t error;
+    
+    if ((handle->drift_ppb == 0) || (handle->drift_ref_s == DS1302_DRIFT_NO_REF))         /* no drift or no reference */
+    {
+        return;                                                                           /* return */
+    }
+    s = a_ds1302_time_to_seconds(t);                                                      /* get seconds */
+    error = ((int64_t)s - (int64_t)handle->drift_ref_s) * handle->drift_ppb / 1000000000; /* get the error */
+    if (error != 0)                                                                       /* check the error */
+    {
+        a_ds1302_seconds_to_time((uint32_t)((int64_t)s - error), s, t->week, t->format, t);  /* correct */
+    }
+}
+
+/**
+ * @brief     anchor the time cache
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] *t pointer to the corrected time
+ * @param[in] now timestamp before the read
+ * @note      none
+ */
+static void a_ds1302_cache_anchor(ds1302_handle_t *handle, ds1302_time_t *t, uint32_t now)
+{
+    handle->cache_anchor_s = a_ds1302_time_to_seconds(t);                                 /* set anchor seconds */
+    handle->cache_anchor_us = now;                                                        /* set anchor timestamp */
+    handle->cache_week = t->week;                                                         /* set anchor week */
+    handle->cache_format = (uint8_t)t->format;                                            /* set anchor format */
+    handle->cache_valid = 1;                                                              /* anchor valid */
+}
+
+/**
+ * @brief      extrapolate the time cache
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[in]  elapsed us since the anchor
+ * @param[out] *t pointer to a time structure
+ * @note       the host clock is the reference, so no drift correction is needed
+ */
+static void a_ds1302_cache_extrapolate(ds1302_handle_t *handle, uint32_t elapsed, ds1302_time_t *t)
+{
+    a_ds1302_seconds_to_time(handle->cache_anchor_s + elapsed / 1000000, handle->cache_anchor_s,
+                             handle->cache_week, (ds1302_format_t)handle->cache_format, t);     /* extrapolate */
+}
+
+/**
+ * @brief     load the clock burst as one word
+ * @param[in] *buf pointer to an 8 bytes buffer
+ * @return    word with buf[0] in the low byte
+ * @note      none
+ */
+static uint64_t a_ds1302_load64(uint8_t *buf)
+{
+    uint64_t w;
+    uint8_t i;
+    
+    w = 0;                                                                                /* init 0 */
+    for (i = 0; i < 8; i++)                                                               /* little endian */
+    {
+        w |= (uint64_t)buf[i] << (i * 8);                                                 /* set byte */
+    }
+    
+    return w;                                                                             /* return word */
+}
+
+/**
+ * @brief     convert 8 packed bcd bytes to binary
+ * @param[in] x packed bcd bytes
+ * @return    packed binary bytes
+ * @note      each byte 16 * h + l becomes 10 * h + l, no borrow crosses a byte
+ */
+static uint64_t a_ds1302_bcd2hex_swar(uint64_t x)
+{
+    return x - 6 * ((x >> 4) & DS1302_SWAR_NIBBLE);                                       /* subtract 6 per tens */
+}
+
+/**
+ * @brief     convert 8 packed binary bytes to bcd
+ * @param[in] x packed binary bytes below 100
+ * @return    packed bcd bytes
+ * @note      the bytes are split in two 16 bits lane words so (b * 103) >> 10 == b / 10 fits
+ */
+static uint64_t a_ds1302_hex2bcd_swar(uint64_t x)
+{
+    uint64_t even;
+    uint64_t odd;
+    
+    even = x & DS1302_SWAR_LANE;                                                          /* bytes 0, 2, 4, 6 */
+    odd = (x >> 8) & DS1302_SWAR_LANE;                                                    /* bytes 1, 3, 5, 7 */
+    even += 6 * (((even * 103) >> 10) & DS1302_SWAR_TENS);                                /* add 6 per tens */
+    odd += 6 * (((odd * 103) >> 10) & DS1302_SWAR_TENS);                                  /* add 6 per tens */
+    
+    return even | (odd << 8);                                                             /* merge */
+}
+
+/**
+ * @brief     set the current time
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] *t pointer to a time structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 set time failed
+ *            - 2 handle or time is NULL
+ *            - 3 handle is not initialized
+ *            - 4 time is invalid
+ *            - 6 a transfer is pending
+ * @note      the clock is written in one 8 byte clock burst which keeps the ch bit,
+ *            if write protect is enabled it is cleared first and restored by the
+ *            control byte of the same burst, a drift record in ram is rewritten with
+ *            the new reference before write protect is restored
+ */
+uint8_t ds1302_set_time(ds1302_handle_t *handle, ds1302_time_t *t)
+{
+    uint8_t res;
+    uint8_t control;
+    uint8_t buf[8];
+    uint16_t year;
+    
+    if (handle == NULL)                                                                                      /* check handle */
+    {
+        return 2;                                                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                                                 /* check handle initialization */
+    {
+        return 3;                                                                                            /* return error */
+    }
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)                                                        /* check the pending transfer */
+    {
+        handle->debug_print("ds1302: xfer is pending.\n");                                                   /* xfer is pending */
+        
+        return 6;                                                                                            /* return error */
+    }
+    if (t == NULL)                                                                                           /* check time */
+    {
+        handle->debug_print("ds1302: time is null.\n");                                                      /* time is null */
+        
+        return 2;                                                                                            /* return error */
+    }
+    if (t->format == DS1302_FORMAT_12H)                                                                      /* if 12H */
+    {
+        if ((t->year < 2000) || (t->year > 2100))                                                            /* check year */
+        {
+            handle->debug_print("ds1302: year can't be over 2100 or less than 2000.\n");                     /* year can't be over 2100 or less than 2000 */
+            
+            return 4;                                                                                        /* return error */
+        }
+        if ((t->month == 0) || (t->month > 12))                                                              /* check month */
+        {
+            handle->debug_print("ds1302: month can't be zero or over than 12.\n");                           /* month can't be zero or over than 12 */
+            
+            return 4;                                                                                        /* return error */
+        }
+        if ((t->week == 0) || (t->week > 7))                                                                 /* check week */
+        {
+            handle->debug_print("ds1302: week can't be zero or over than 7.\n");                             /* week can't be zero or over than 7 */
+            
+            return 4;                                                                                        /* return error */
+        }
+        if ((t->date == 0) || (t->date > 31))                                                                /* check data */
+        {
+            handle->debug_print("ds1302: date can't be zero or over than 31.\n");                            /* date can't be zero or over than 31 */
+            
+            return 4;                                                                                        /* return error */
+        }
+        if ((t->hour < 1) || (t->hour > 12))                                                                 /* check hour */
+        {
+            handle->debug_print("ds1302: hour can't be over than 12 or less 1.\n");                          /* hour can't be over than 12 or less 1 */
+            
+            return 4;                                                                                        /* return error */
+        }
+        if (t->minute > 59)                                                                                  /* check minute */
+        {
+            handle->debug_print("ds1302: minute can't be over than 59.\n");                                  /* minute can't be over than 59 */
+            
+            return 4;                                                                                        /* return error */
         }
         if (t->second > 59)                                                                                  /* check second */
         {
@@ -698,74 +1137,90 @@ uint8_t ds1302_set_time(ds1302_handle_t *handle, ds1302_time_t *t)
         return 4;                                                                                            /* return error */
     }
     
-    res = a_ds1302_multiple_read(handle, DS1302_COMMAND_RTC | DS1302_REG_SECOND, &reg, 1);                   /* read second */
+    res = a_ds1302_burst_read(handle, DS1302_COMMAND_RTC | DS1302_COMMAND_BURST, buf, 8);                    /* read clock and control */
     if (res != 0)                                                                                            /* check result */
     {
-        handle->debug_print("ds1302: read second failed.\n");                                                /* read second failed */
+        handle->debug_print("ds1302: read clock failed.\n");                                                 /* read clock failed */
         
         return 1;                                                                                            /* return error */
     }
-    res = a_ds1302_write(handle, DS1302_COMMAND_RTC | DS1302_REG_SECOND, 
-                         a_ds1302_hex2bcd(t->second) | reg & (1 << 7));                                      /* write second */
-    if (res != 0)                                                                                            /* check result */
-    {
-        handle->debug_print("ds1302: write second failed.\n");                                               /* write second failed */
-        
-        return 1;                                                                                            /* return error */
-    }
-    res = a_ds1302_write(handle, DS1302_COMMAND_RTC | DS1302_REG_MINUTE, a_ds1302_hex2bcd(t->minute));       /* write minute */
-    if (res != 0)                                                                                            /* check result */
+    control = buf[7];                                                                                        /* save control */
+    if ((buf[7] & (1 << 7)) != 0)                                                                            /* check write protect */
     {
-        handle->debug_print("ds1302: write minute failed.\n");                                               /* write minute failed */
-        
-        return 1;                                                                                            /* return error */
+        res = a_ds1302_write(handle, DS1302_COMMAND_RTC | DS1302_REG_CONTROL, 
+                             (uint8_t)(buf[7] & (~(1 << 7))));                                               /* disable write protect */
+        if (res != 0)                                                                                        /* check result */
+        {
+            handle->debug_print("ds1302: disable write protect failed.\n");                                  /* disable write protect failed */
+            
+            return 1;                                                                                        /* return error */
+        }
     }
+    buf[0] = (uint8_t)(a_ds1302_hex2bcd(t->second) | (buf[0] & (1 << 7)));                                  /* set second and keep ch */
+    buf[1] = a_ds1302_hex2bcd(t->minute);                                                                    /* set minute */
     if (t->format == DS1302_FORMAT_12H)                                                                      /* if 12H */
     {
-        reg = (uint8_t)((1 << 7) | (t->am_pm << 5) | a_ds1302_hex2bcd(t->hour));                             /* set hour in 12H */
+        buf[2] = (uint8_t)((1 << 7) | (t->am_pm << 5) | a_ds1302_hex2bcd(t->hour));                          /* set hour in 12H */
     }
     else                                                                                                     /* if 24H */
     {
-        reg = (0 << 7) | a_ds1302_hex2bcd(t->hour);                                                          /* set hour in 24H */
+        buf[2] = (0 << 7) | a_ds1302_hex2bcd(t->hour);                                                       /* set hour in 24H */
     }
-    res = a_ds1302_write(handle, DS1302_COMMAND_RTC | DS1302_REG_HOUR, reg);                                 /* write hour */
-    if (res != 0)                                                                                            /* check result */
+    buf[3] = a_ds1302_hex2bcd(t->date);                                                                      /* set date */
+    buf[4] = a_ds1302_hex2bcd(t->month);                                                                     /* set month */
+    buf[5] = a_ds1302_hex2bcd(t->week);                                                                      /* set week */
+    year = t->year - 2000;                                                                                   /* year - 2000 */
+    buf[6] = a_ds1302_hex2bcd((uint8_t)year);                                                                /* set year */
+    if (handle->drift_record != 0)                                                                           /* drift record */
     {
-        handle->debug_print("ds1302: write hour failed.\n");                                                 /* write hour failed */
-        
-        return 1;                                                                                            /* return error */
+        buf[7] = (uint8_t)(control & (~(1 << 7)));                                                           /* keep write protect cleared for the record */
     }
-    res = a_ds1302_write(handle, DS1302_COMMAND_RTC | DS1302_REG_WEEK, a_ds1302_hex2bcd(t->week));           /* write week */
+    handle->cache_valid = 0;                                                                                 /* drop the anchor */
+    res = a_ds1302_burst_write(handle, DS1302_COMMAND_RTC | DS1302_COMMAND_BURST, buf, 8);                   /* write clock and restore control */
     if (res != 0)                                                                                            /* check result */
     {
-        handle->debug_print("ds1302: write week failed.\n");                                                 /* write week failed */
+        handle->debug_print("ds1302: write clock failed.\n");                                                /* write clock failed */
+        if ((control & (1 << 7)) != 0)                                                                       /* check write protect */
+        {
+            (void)a_ds1302_write(handle, DS1302_COMMAND_RTC | DS1302_REG_CONTROL, control);                  /* restore write protect */
+        }
         
         return 1;                                                                                            /* return error */
     }
-    res = a_ds1302_write(handle, DS1302_COMMAND_RTC | DS1302_REG_DATE, a_ds1302_hex2bcd(t->date));           /* write data */
-    if (res != 0)                                                                                            /* check result */
+    if (a_ds1302_drift_rebase(handle, a_ds1302_time_to_seconds(t), control) != 0)                            /* move the drift reference */
     {
-        handle->debug_print("ds1302: write date failed.\n");                                                 /* write date failed */
+        handle->debug_print("ds1302: rewrite drift record failed.\n");                                       /* rewrite drift record failed */
         
         return 1;                                                                                            /* return error */
     }
-    res = a_ds1302_write(handle, DS1302_COMMAND_RTC | DS1302_REG_MONTH, a_ds1302_hex2bcd(t->month));         /* write month and century */
-    if (res != 0)                                                                                            /* check result */
+    
+    return 0;                                                                                                /* success return 0 */
+}
+
+/**
+ * @brief      decode the clock registers
+ * @param[in]  *buf pointer to a clock register buffer
+ * @param[out] *t pointer to a time structure
+ * @note       buf must hold at least 7 bytes
+ */
+static void a_ds1302_decode_time(uint8_t *buf, ds1302_time_t *t)
+{
+    t->year = a_ds1302_bcd2hex(buf[6]) + 2000;                                            /* get year */
+    t->month = a_ds1302_bcd2hex(buf[4] & 0x1F);                                           /* get month */
+    t->week = a_ds1302_bcd2hex(buf[5] & 0x7);                                             /* get week */
+    t->date = a_ds1302_bcd2hex(buf[3] & 0x3F);                                            /* get date */
+    t->am_pm = (ds1302_am_pm_t)((buf[2] >> 5) & 0x01);                                    /* get am pm */
+    t->format = (ds1302_format_t)((buf[2] >> 7) & 0x01);                                  /* get format */
+    if (t->format == DS1302_FORMAT_12H)                                                   /* if 12H */
     {
-        handle->debug_print("ds1302: write century and month failed.\n");                                    /* write century and month failed */
-        
-        return 1;                                                                                            /* return error */
+        t->hour = a_ds1302_bcd2hex(buf[2] & 0x1F);                                        /* get hour */
     }
-    year = t->year - 2000;                                                                                   /* year - 2000 */
-    res = a_ds1302_write(handle, DS1302_COMMAND_RTC | DS1302_REG_YEAR, a_ds1302_hex2bcd((uint8_t)year));     /* write year */
-    if (res != 0)                                                                                            /* check result */
+    else
     {
-        handle->debug_print("ds1302: write year failed.\n");                                                 /* write year failed */
-        
-        return 1;                                                                                            /* return error */
+        t->hour = a_ds1302_bcd2hex(buf[2] & 0x3F);                                        /* get hour */
     }
-    
-    return 0;                                                                                                /* success return 0 */
+    t->minute = a_ds1302_bcd2hex(buf[1]);                                                 /* get minute */
+    t->second = a_ds1302_bcd2hex(buf[0] & (~(1 << 7)));                                   /* get second */
 }
 
 /**
@@ -777,12 +1232,15 @@ uint8_t ds1302_set_time(ds1302_handle_t *handle, ds1302_time_t *t)
  *             - 1 get time failed
  *             - 2 handle or time is NULL
  *             - 3 handle is not initialized
- * @note       none
+ *             - 6 a transfer is pending
+ * @note       all seven clock registers are fetched in one clock burst,
+ *             with the time cache enabled the read is served from the anchor until it expires
  */
 uint8_t ds1302_get_time(ds1302_handle_t *handle, ds1302_time_t *t)
 {
     uint8_t res;
     uint8_t buf[7];
+    uint32_t now;
     
     if (handle == NULL)                                                                   /* check handle */
     {
@@ -792,6 +1250,12 @@ uint8_t ds1302_get_time(ds1302_handle_t *handle, ds1302_time_t *t)
     {
         return 3;                                                                         /* return error */
     }
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)                                     /* check the pending transfer */
+    {
+        handle->debug_print("ds1302: xfer is pending.\n");                                /* xfer is pending */
+        
+        return 6;                                                                         /* return error */
+    }
     if (t == NULL)                                                                        /* check time */
     {
         handle->debug_print("ds1302: time is null.\n");                                   /* time is null */
@@ -799,685 +1263,2255 @@ uint8_t ds1302_get_time(ds1302_handle_t *handle, ds1302_time_t *t)
         return 2;                                                                         /* return error */
     }
     
+    now = 0;                                                                              /* init 0 */
+    if (handle->cache_enable != 0)                                                        /* time cache */
+    {
+        now = handle->timestamp_us();                                                     /* get timestamp */
+        if ((handle->cache_valid != 0) && 
+            ((now - handle->cache_anchor_us) < handle->cache_interval_ms * 1000))         /* check the anchor */
+        {
+            a_ds1302_cache_extrapolate(handle, now - handle->cache_anchor_us, t);         /* extrapolate */
+            
+            return 0;                                                                     /* success return 0 */
+        }
+    }
     memset(buf, 0, sizeof(uint8_t) * 7);                                                  /* clear the buffer */
-    res = a_ds1302_multiple_read(handle, DS1302_COMMAND_RTC | DS1302_REG_SECOND, 
-                                (uint8_t *)buf, 7);                                       /* multiple_read */
+    res = a_ds1302_burst_read(handle, DS1302_COMMAND_RTC | DS1302_COMMAND_BURST, 
+                              (uint8_t *)buf, 7);                                         /* burst read */
     if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("ds1302: multiple read failed.\n");                           /* multiple read failed */
+        handle->debug_print("ds1302: burst read failed.\n");                              /* burst read failed */
         
         return 1;                                                                         /* return error */
     }
-    t->year = a_ds1302_bcd2hex(buf[6]) + 2000;                                            /* get year */
-    t->month = a_ds1302_bcd2hex(buf[4] & 0x1F);                                           /* get month */
-    t->week = a_ds1302_bcd2hex(buf[5] & 0x7);                                             /* get week */
-    t->date = a_ds1302_bcd2hex(buf[3] & 0x3F);                                            /* get date */
-    t->am_pm = (ds1302_am_pm_t)((buf[2] >> 5) & 0x01);                                    /* get am pm */
-    t->format = (ds1302_format_t)((buf[2] >> 7) & 0x01);                                  /* get format */
-    if (t->format == DS1302_FORMAT_12H)                                                   /* if 12H */
+    a_ds1302_decode_time(buf, t);                                                         /* decode time */
+    a_ds1302_drift_apply(handle, t);                                                      /* correct the drift */
+    if (handle->cache_enable != 0)                                                        /* time cache */
     {
-        t->hour = a_ds1302_bcd2hex(buf[2] & 0x1F);                                        /* get hour */
+        if ((buf[0] & (1 << 7)) == 0)                                                     /* oscillator running */
+        {
+            a_ds1302_cache_anchor(handle, t, now);                                        /* anchor */
+        }
+        else
+        {
+            handle->cache_valid = 0;                                                      /* a halted clock is not extrapolated */
+        }
     }
-    else
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief      get a coherent time snapshot
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *t pointer to a time structure
+ * @param[out] *rollover pointer to a rollover flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get time snapshot failed
+ *             - 2 handle, time or rollover is NULL
+ *             - 3 handle is not initialized
+ *             - 6 a transfer is pending
+ * @note       the snapshot is taken in one clock burst, so it never tears across registers;
+ *             when the chip seconds read 59 the second register is read once more and rollover
+ *             is set if the minute has already turned over after the snapshot,
+ *             the drift correction is applied to the returned time only, like ds1302_get_time
+ */
+uint8_t ds1302_get_time_snapshot(ds1302_handle_t *handle, ds1302_time_t *t, ds1302_bool_t *rollover)
+{
+    uint8_t res;
+    uint8_t reg;
+    uint8_t buf[7];
+    
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)                                     /* check the pending transfer */
+    {
+        handle->debug_print("ds1302: xfer is pending.\n");                                /* xfer is pending */
+        
+        return 6;                                                                         /* return error */
+    }
+    if ((t == NULL) || (rollover == NULL))                                                /* check time and rollover */
+    {
+        handle->debug_print("ds1302: time or rollover is null.\n");                       /* time or rollover is null */
+        
+        return 2;                                                                         /* return error */
+    }
+    
+    memset(buf, 0, sizeof(uint8_t) * 7);                                                  /* clear the buffer */
+    res = a_ds1302_burst_read(handle, DS1302_COMMAND_RTC | DS1302_COMMAND_BURST, 
+                              (uint8_t *)buf, 7);                                         /* burst read */
+    if (res != 0)                                                                         /* check result */
+    {
+        handle->debug_print("ds1302: burst read failed.\n");                              /* burst read failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    a_ds1302_decode_time(buf, t);                                                         /* decode time */
+    *rollover = DS1302_BOOL_FALSE;                                                        /* no rollover */
+    if ((buf[0] & 0x7F) == 0x59)                                                          /* check the last chip second */
+    {
+        res = a_ds1302_multiple_read(handle, DS1302_COMMAND_RTC | DS1302_REG_SECOND, 
+                                     &reg, 1);                                            /* read second */
+        if (res != 0)                                                                     /* check result */
+        {
+            handle->debug_print("ds1302: read second failed.\n");                         /* read second failed */
+            
+            return 1;                                                                     /* return error */
+        }
+        if ((reg & (~(1 << 7))) != (buf[0] & (~(1 << 7))))                                /* check second changed */
+        {
+            *rollover = DS1302_BOOL_TRUE;                                                 /* rollover */
+        }
+    }
+    a_ds1302_drift_apply(handle, t);                                                      /* correct the drift */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief      get the current time as a compact timestamp
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *compact pointer to a compact timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get compact time failed
+ *             - 2 handle or compact is NULL
+ *             - 3 handle is not initialized
+ *             - 6 a transfer is pending
+ * @note       compact is the seconds since 2000-01-01, add 946684800 for unix time,
+ *             the 8 byte clock burst is decoded in one 64 bits word and the drift correction
+ *             is applied, the time cache is not used
+ */
+uint8_t ds1302_get_compact_time(ds1302_handle_t *handle, uint32_t *compact)
+{
+    uint8_t buf[8];
+    uint32_t s;
+    
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)                                     /* check the pending transfer */
+    {
+        handle->debug_print("ds1302: xfer is pending.\n");                                /* xfer is pending */
+        
+        return 6;                                                                         /* return error */
+    }
+    if (compact == NULL)                                                                  /* check compact */
+    {
+        handle->debug_print("ds1302: compact is null.\n");                                /* compact is null */
+        
+        return 2;                                                                         /* return error */
+    }
+    
+    if (a_ds1302_burst_read(handle, DS1302_COMMAND_RTC | DS1302_COMMAND_BURST, 
+                            (uint8_t *)buf, 8) != 0)                                      /* burst read */
+    {
+        handle->debug_print("ds1302: burst read failed.\n");                              /* burst read failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    if (ds1302_clock_burst_to_compact(buf, &s) != 0)                                      /* decode */
+    {
+        handle->debug_print("ds1302: clock registers are invalid.\n");                    /* clock registers are invalid */
+        
+        return 1;                                                                         /* return error */
+    }
+    if ((handle->drift_ppb != 0) && (handle->drift_ref_s != DS1302_DRIFT_NO_REF))         /* correct the drift */
+    {
+        s = (uint32_t)((int64_t)s - ((int64_t)s - (int64_t)handle->drift_ref_s) * 
+                       handle->drift_ppb / 1000000000);                                   /* subtract the error */
+    }
+    *compact = s;                                                                         /* set compact */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     set the time from a compact timestamp
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] compact seconds since 2000-01-01
+ * @return    status code
+ *            - 0 success
+ *            - 1 set compact time failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 compact is invalid
+ *            - 6 a transfer is pending
+ * @note      the clock is written in 24H format with the week derived from the date,
+ *            ch and write protect are kept like ds1302_set_time
+ */
+uint8_t ds1302_set_compact_time(ds1302_handle_t *handle, uint32_t compact)
+{
+    uint8_t control;
+    uint8_t buf[8];
+    
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)                                     /* check the pending transfer */
+    {
+        handle->debug_print("ds1302: xfer is pending.\n");                                /* xfer is pending */
+        
+        return 6;                                                                         /* return error */
+    }
+    if (compact > DS1302_COMPACT_MAX)                                                     /* check compact */
+    {
+        handle->debug_print("ds1302: compact is invalid.\n");                             /* compact is invalid */
+        
+        return 4;                                                                         /* return error */
+    }
+    
+    if (a_ds1302_burst_read(handle, DS1302_COMMAND_RTC | DS1302_COMMAND_BURST, 
+                            (uint8_t *)buf, 8) != 0)                                      /* read clock and control */
+    {
+        handle->debug_print("ds1302: read clock failed.\n");                              /* read clock failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    control = buf[7];                                                                     /* save control */
+    if ((buf[7] & (1 << 7)) != 0)                                                         /* check write protect */
+    {
+        if (a_ds1302_write(handle, DS1302_COMMAND_RTC | DS1302_REG_CONTROL, 
+                           (uint8_t)(buf[7] & (~(1 << 7)))) != 0)                         /* disable write protect */
+        {
+            handle->debug_print("ds1302: disable write protect failed.\n");               /* disable write protect failed */
+            
+            return 1;                                                                     /* return error */
+        }
+    }
+    (void)ds1302_compact_to_clock_burst(compact, buf);                                    /* encode */
+    if (handle->drift_record != 0)                                                        /* drift record */
+    {
+        buf[7] = (uint8_t)(control & (~(1 << 7)));                                        /* keep write protect cleared for the record */
+    }
+    handle->cache_valid = 0;                                                              /* drop the anchor */
+    if (a_ds1302_burst_write(handle, DS1302_COMMAND_RTC | DS1302_COMMAND_BURST, 
+                             buf, 8) != 0)                                                /* write clock and restore control */
+    {
+        handle->debug_print("ds1302: write clock failed.\n");                             /* write clock failed */
+        if ((control & (1 << 7)) != 0)                                                    /* check write protect */
+        {
+            (void)a_ds1302_write(handle, DS1302_COMMAND_RTC | DS1302_REG_CONTROL, control);   /* restore write protect */
+        }
+        
+        return 1;                                                                         /* return error */
+    }
+    if (a_ds1302_drift_rebase(handle, compact, control) != 0)                             /* move the drift reference */
+    {
+        handle->debug_print("ds1302: rewrite drift record failed.\n");                    /* rewrite drift record failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the time cache
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 timestamp_us is not linked
+ * @note      when enabled ds1302_get_time reads the chip once, anchors it to timestamp_us and
+ *            extrapolates later reads until the resync interval elapses,
+ *            the cached time follows the chip within one second
+ */
+uint8_t ds1302_set_time_cache(ds1302_handle_t *handle, ds1302_bool_t enable)
+{
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    if ((enable != DS1302_BOOL_FALSE) && (handle->timestamp_us == NULL)) /* check timestamp_us */
+    {
+        handle->debug_print("ds1302: timestamp_us is null.\n");          /* timestamp_us is null */
+        
+        return 4;                                                        /* return error */
+    }
+    
+    handle->cache_enable = (uint8_t)enable;                              /* set enable */
+    handle->cache_valid = 0;                                             /* anchor on the next read */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief      get the time cache status
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1302_get_time_cache(ds1302_handle_t *handle, ds1302_bool_t *enable)
+{
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    
+    *enable = (ds1302_bool_t)(handle->cache_enable);                     /* get enable */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief     set the time cache resync interval
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] ms resync interval in ms
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 ms is invalid
+ * @note      1 <= ms <= 3600000, default is 1000
+ */
+uint8_t ds1302_set_time_cache_interval(ds1302_handle_t *handle, uint32_t ms)
+{
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    if ((ms == 0) || (ms > DS1302_CACHE_INTERVAL_MAX_MS))                /* check ms */
+    {
+        handle->debug_print("ds1302: ms is invalid.\n");                 /* ms is invalid */
+        
+        return 4;                                                        /* return error */
+    }
+    
+    handle->cache_interval_ms = ms;                                      /* set interval */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief      get the time cache resync interval
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *ms pointer to an interval buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1302_get_time_cache_interval(ds1302_handle_t *handle, uint32_t *ms)
+{
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    
+    *ms = handle->cache_interval_ms;                                     /* get interval */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief     resync the time cache with the chip
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 sync time cache failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 time cache is disabled
+ *            - 6 a transfer is pending
+ * @note      none
+ */
+uint8_t ds1302_sync_time_cache(ds1302_handle_t *handle)
+{
+    ds1302_time_t t;
+    
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)                    /* check the pending transfer */
+    {
+        handle->debug_print("ds1302: xfer is pending.\n");               /* xfer is pending */
+        
+        return 6;                                                        /* return error */
+    }
+    if (handle->cache_enable == 0)                                       /* check enable */
+    {
+        handle->debug_print("ds1302: time cache is disabled.\n");        /* time cache is disabled */
+        
+        return 4;                                                        /* return error */
+    }
+    
+    handle->cache_valid = 0;                                             /* drop the anchor */
+    if (ds1302_get_time(handle, &t) != 0)                                /* read and anchor */
+    {
+        return 1;                                                        /* return error */
+    }
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief      read the second register with a timestamp
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *second pointer to a second register buffer
+ * @param[out] *timestamp pointer to a timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the timestamp is taken before the read
+ */
+static uint8_t a_ds1302_read_second(ds1302_handle_t *handle, uint8_t *second, uint32_t *timestamp)
+{
+    *timestamp = handle->timestamp_us();                                                  /* get timestamp */
+    
+    return a_ds1302_multiple_read(handle, DS1302_COMMAND_RTC | DS1302_REG_SECOND, 
+                                  second, 1);                                             /* read second */
+}
+
+/**
+ * @brief      find the seconds register rollover
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *timestamp_us pointer to an edge timestamp buffer
+ * @param[out] *resolution_us pointer to a resolution buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get second edge failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 timestamp_us is not linked
+ *             - 6 a transfer is pending
+ * @note       the second register is polled every 50ms until it changes, then polling
+ *             resumes every 1ms just before the next edge, so it takes up to 2s and
+ *             about 70 single register reads, the timestamp is the middle of the last two
+ *             reads and resolution is their distance, with the time cache enabled the
+ *             cache is anchored to the edge
+ */
+uint8_t ds1302_get_second_edge(ds1302_handle_t *handle, uint32_t *timestamp_us, uint32_t *resolution_us)
+{
+    uint8_t res;
+    uint8_t second;
+    uint8_t last;
+    uint8_t buf[7];
+    uint32_t i;
+    uint32_t prev;
+    uint32_t now;
+    uint32_t wait;
+    ds1302_time_t t;
+    
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)                                     /* check the pending transfer */
+    {
+        handle->debug_print("ds1302: xfer is pending.\n");                                /* xfer is pending */
+        
+        return 6;                                                                         /* return error */
+    }
+    if (handle->timestamp_us == NULL)                                                     /* check timestamp_us */
+    {
+        handle->debug_print("ds1302: timestamp_us is null.\n");                           /* timestamp_us is null */
+        
+        return 4;                                                                         /* return error */
+    }
+    
+    res = a_ds1302_read_second(handle, &last, &prev);                                     /* read second */
+    if (res != 0)                                                                         /* check result */
+    {
+        handle->debug_print("ds1302: read second failed.\n");                             /* read second failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    if ((last & (1 << 7)) != 0)                                                           /* check ch */
+    {
+        handle->debug_print("ds1302: oscillator is halted.\n");                           /* oscillator is halted */
+        
+        return 1;                                                                         /* return error */
+    }
+    for (i = 0; i < DS1302_EDGE_COARSE_POLLS; i++)                                        /* coarse polling */
+    {
+        handle->delay_ms(DS1302_EDGE_COARSE_MS);                                          /* delay */
+        res = a_ds1302_read_second(handle, &second, &now);                                /* read second */
+        if (res != 0)                                                                     /* check result */
+        {
+            handle->debug_print("ds1302: read second failed.\n");                         /* read second failed */
+            
+            return 1;                                                                     /* return error */
+        }
+        if (second != last)                                                               /* check the edge */
+        {
+            break;                                                                        /* break */
+        }
+        prev = now;                                                                       /* last unchanged read */
+    }
+    if (i == DS1302_EDGE_COARSE_POLLS)                                                    /* check timeout */
+    {
+        handle->debug_print("ds1302: no second edge.\n");                                 /* no second edge */
+        
+        return 1;                                                                         /* return error */
+    }
+    
+    *timestamp_us = prev + (now - prev) / 2 + 1000000;                                    /* coarse estimate of the next edge */
+    *resolution_us = now - prev;                                                          /* coarse resolution */
+    wait = prev + 1000000 - DS1302_EDGE_GUARD_US - handle->timestamp_us();                /* time until the next window */
+    if ((wait < 1000000) && (wait >= 1000))                                               /* check the wait */
+    {
+        handle->delay_ms(wait / 1000);                                                    /* sleep until the window */
+    }
+    last = second;                                                                        /* expected second */
+    res = a_ds1302_read_second(handle, &second, &prev);                                   /* read second */
+    if (res != 0)                                                                         /* check result */
+    {
+        handle->debug_print("ds1302: read second failed.\n");                             /* read second failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    if (second == last)                                                                   /* the window is not missed */
+    {
+        for (i = 0; i < DS1302_EDGE_FINE_POLLS; i++)                                      /* fine polling */
+        {
+            handle->delay_ms(DS1302_EDGE_FINE_MS);                                        /* delay */
+            res = a_ds1302_read_second(handle, &second, &now);                            /* read second */
+            if (res != 0)                                                                 /* check result */
+            {
+                handle->debug_print("ds1302: read second failed.\n");                     /* read second failed */
+                
+                return 1;                                                                 /* return error */
+            }
+            if (second != last)                                                           /* check the edge */
+            {
+                *timestamp_us = prev + (now - prev) / 2;                                  /* edge in the middle */
+                *resolution_us = now - prev;                                              /* fine resolution */
+                
+                break;                                                                    /* break */
+            }
+            prev = now;                                                                   /* last unchanged read */
+        }
+    }
+    
+    if (handle->cache_enable != 0)                                                        /* time cache */
+    {
+        res = a_ds1302_burst_read(handle, DS1302_COMMAND_RTC | DS1302_COMMAND_BURST, 
+                                  (uint8_t *)buf, 7);                                     /* burst read */
+        if (res != 0)                                                                     /* check result */
+        {
+            handle->debug_print("ds1302: burst read failed.\n");                          /* burst read failed */
+            
+            return 1;                                                                     /* return error */
+        }
+        if ((second != last) && (buf[0] == second))                                       /* still the second after the edge */
+        {
+            a_ds1302_decode_time(buf, &t);                                                /* decode time */
+            a_ds1302_drift_apply(handle, &t);                                             /* correct the drift */
+            a_ds1302_cache_anchor(handle, &t, *timestamp_us);                             /* anchor to the edge */
+        }
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     set the drift coefficient
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] ppb chip drift in ppb, positive runs fast
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      ds1302_get_time subtracts the drift accumulated since the last ds1302_set_time,
+ *            until ds1302_set_time, ds1302_set_compact_time or ds1302_load_drift gives a
+ *            reference no correction is applied
+ */
+uint8_t ds1302_set_drift(ds1302_handle_t *handle, int32_t ppb)
+{
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    
+    handle->drift_ppb = ppb;                                             /* set ppb */
+    handle->cache_valid = 0;                                             /* drop the anchor */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief      get the drift coefficient
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *ppb pointer to a ppb buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1302_get_drift(ds1302_handle_t *handle, int32_t *ppb)
+{
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    
+    *ppb = handle->drift_ppb;                                            /* get ppb */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief      capture a second edge with the chip seconds
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *us pointer to an edge timestamp buffer
+ * @param[out] *s pointer to a chip seconds buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 capture failed
+ * @note       the chip seconds are not corrected
+ */
+static uint8_t a_ds1302_capture_edge(ds1302_handle_t *handle, uint32_t *us, uint32_t *s)
+{
+    uint8_t buf[7];
+    uint32_t resolution;
+    ds1302_time_t t;
+    
+    if (ds1302_get_second_edge(handle, us, &resolution) != 0)                             /* get second edge */
+    {
+        return 1;                                                                         /* return error */
+    }
+    if (a_ds1302_burst_read(handle, DS1302_COMMAND_RTC | DS1302_COMMAND_BURST, 
+                            (uint8_t *)buf, 7) != 0)                                      /* burst read */
+    {
+        handle->debug_print("ds1302: burst read failed.\n");                              /* burst read failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    a_ds1302_decode_time(buf, &t);                                                        /* decode time */
+    *s = a_ds1302_time_to_seconds(&t);                                                    /* get seconds */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     start the drift measure
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start drift measure failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 timestamp_us is not linked
+ *            - 6 a transfer is pending
+ * @note      a second edge is captured against timestamp_us
+ */
+uint8_t ds1302_start_drift_measure(ds1302_handle_t *handle)
+{
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)                                     /* check the pending transfer */
+    {
+        handle->debug_print("ds1302: xfer is pending.\n");                                /* xfer is pending */
+        
+        return 6;                                                                         /* return error */
+    }
+    if (handle->timestamp_us == NULL)                                                     /* check timestamp_us */
+    {
+        handle->debug_print("ds1302: timestamp_us is null.\n");                           /* timestamp_us is null */
+        
+        return 4;                                                                         /* return error */
+    }
+    
+    handle->drift_started = 0;                                                            /* clear the flag */
+    if (a_ds1302_capture_edge(handle, &handle->drift_start_us, 
+                              &handle->drift_start_s) != 0)                               /* capture the start edge */
+    {
+        handle->debug_print("ds1302: capture edge failed.\n");                            /* capture edge failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    handle->drift_started = 1;                                                            /* set the flag */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief      get the drift measure
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *ppb pointer to a ppb buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get drift measure failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 measure is not started
+ *             - 6 a transfer is pending
+ * @note       every call captures one more second edge and compares it with the start edge,
+ *             so the estimate improves with the window, the window must stay below 4000s
+ *             for the 32 bits timestamp_us, at 1ms edge resolution 1000s give about 1ppm
+ */
+uint8_t ds1302_get_drift_measure(ds1302_handle_t *handle, int32_t *ppb)
+{
+    uint32_t us;
+    uint32_t s;
+    int64_t host;
+    int64_t chip;
+    
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)                                     /* check the pending transfer */
+    {
+        handle->debug_print("ds1302: xfer is pending.\n");                                /* xfer is pending */
+        
+        return 6;                                                                         /* return error */
+    }
+    if (handle->drift_started == 0)                                                       /* check the start */
+    {
+        handle->debug_print("ds1302: measure is not started.\n");                         /* measure is not started */
+        
+        return 4;                                                                         /* return error */
+    }
+    
+    if (a_ds1302_capture_edge(handle, &us, &s) != 0)                                      /* capture an edge */
+    {
+        handle->debug_print("ds1302: capture edge failed.\n");                            /* capture edge failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    if ((s <= handle->drift_start_s) || (s - handle->drift_start_s > DS1302_DRIFT_WINDOW_MAX_S))  /* check the window */
+    {
+        handle->debug_print("ds1302: measure window is invalid.\n");                      /* measure window is invalid */
+        
+        return 1;                                                                         /* return error */
+    }
+    host = (int64_t)(uint32_t)(us - handle->drift_start_us);                              /* host elapsed us */
+    chip = (int64_t)(s - handle->drift_start_s) * 1000000;                                /* chip elapsed us */
+    *ppb = (int32_t)((chip - host) * 1000000000 / host);                                  /* get ppb */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     save the drift coefficient to the chip ram
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 save drift failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 6 a transfer is pending
+ * @note      the coefficient and its reference are kept with a crc8 in ram from
+ *            DS1302_DRIFT_RAM_ADDR, write protect must be disabled, once saved or loaded
+ *            the record is rewritten by every ds1302_set_time and ds1302_set_compact_time
+ */
+uint8_t ds1302_save_drift(ds1302_handle_t *handle)
+{
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)                                     /* check the pending transfer */
+    {
+        handle->debug_print("ds1302: xfer is pending.\n");                                /* xfer is pending */
+        
+        return 6;                                                                         /* return error */
+    }
+    
+    if (a_ds1302_drift_store(handle) != 0)                                                /* store the record */
+    {
+        return 1;                                                                         /* return error */
+    }
+    handle->drift_record = 1;                                                             /* rewrite the record on every set time */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     load the drift coefficient from the chip ram
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 load drift failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 6 a transfer is pending
+ * @note      a bad magic or crc8 leaves the coefficient unchanged
+ */
+uint8_t ds1302_load_drift(ds1302_handle_t *handle)
+{
+    uint8_t buf[DS1302_DRIFT_RECORD_LEN];
+    
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)                                     /* check the pending transfer */
+    {
+        handle->debug_print("ds1302: xfer is pending.\n");                                /* xfer is pending */
+        
+        return 6;                                                                         /* return error */
+    }
+    
+    if (ds1302_read_ram(handle, DS1302_DRIFT_RAM_ADDR, buf, DS1302_DRIFT_RECORD_LEN) != 0)       /* read ram */
+    {
+        handle->debug_print("ds1302: read ram failed.\n");                                /* read ram failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    if ((buf[0] != DS1302_DRIFT_MAGIC) || 
+        (a_ds1302_crc8(buf, DS1302_DRIFT_RECORD_LEN - 1) != buf[9]))                      /* check the record */
+    {
+        handle->debug_print("ds1302: drift record is invalid.\n");                        /* drift record is invalid */
+        
+        return 1;                                                                         /* return error */
+    }
+    handle->drift_ppb = (int32_t)((uint32_t)buf[1] | ((uint32_t)buf[2] << 8) | 
+                                  ((uint32_t)buf[3] << 16) | ((uint32_t)buf[4] << 24));   /* get ppb */
+    handle->drift_ref_s = (uint32_t)buf[5] | ((uint32_t)buf[6] << 8) | 
+                          ((uint32_t)buf[7] << 16) | ((uint32_t)buf[8] << 24);            /* get reference */
+    handle->drift_record = 1;                                                             /* rewrite the record on every set time */
+    handle->cache_valid = 0;                                                              /* drop the anchor */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the oscillator
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set oscillator failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 6 a transfer is pending
+ * @note      none
+ */
+uint8_t ds1302_set_oscillator(ds1302_handle_t *handle, ds1302_bool_t enable)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                           /* check handle */
+    {
+        return 2;                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                      /* check handle initialization */
+    {
+        return 3;                                                                 /* return error */
+    }
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)                             /* check the pending transfer */
+    {
+        handle->debug_print("ds1302: xfer is pending.\n");                        /* xfer is pending */
+        
+        return 6;                                                                 /* return error */
+    }
+    
+    res = a_ds1302_multiple_read(handle, DS1302_COMMAND_RTC | DS1302_REG_SECOND, 
+                                 &prev, 1);                                       /* read second */
+    if (res != 0)                                                                 /* check result */
+    {
+        handle->debug_print("ds1302: read second failed.\n");                     /* read second failed */
+        
+        return 1;                                                                 /* return error */
+    }
+    prev &= ~(1 << 7);                                                            /* clear config */
+    prev |= (!enable) << 7;                                                       /* set enable */
+    handle->cache_valid = 0;                                                      /* drop the anchor */
+    res = a_ds1302_write(handle, DS1302_COMMAND_RTC | DS1302_REG_SECOND, 
+                         prev);                                                   /* write second */
+    if (res != 0)                                                                 /* check result */
+    {
+        handle->debug_print("ds1302: write second failed.\n");                    /* write second failed */
+        
+        return 1;                                                                 /* return error */
+    }
+    
+    return 0;                                                                     /* success return 0 */
+}
+
+/**
+ * @brief      get the chip oscillator status
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get oscillator failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 6 a transfer is pending
+ * @note       none
+ */
+uint8_t ds1302_get_oscillator(ds1302_handle_t *handle, ds1302_bool_t *enable)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                                      /* check handle */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                                 /* check handle initialization */
+    {
+        return 3;                                                                            /* return error */
+    }
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)                                        /* check the pending transfer */
+    {
+        handle->debug_print("ds1302: xfer is pending.\n");                                   /* xfer is pending */
+        
+        return 6;                                                                            /* return error */
+    }
+    
+    res = a_ds1302_multiple_read(handle, DS1302_COMMAND_RTC | DS1302_REG_SECOND, 
+                                (uint8_t *)&prev, 1);                                        /* multiple read */
+    if (res != 0)                                                                            /* check result */
+    {
+        handle->debug_print("ds1302: read second failed.\n");                                /* read second failed */
+        
+        return 1;                                                                            /* return error */
+    }
+    *enable = (ds1302_bool_t)(!((prev >> 7) & 0x01));                                        /* get enable */
+    
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable write protect
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set write protect failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 6 a transfer is pending
+ * @note      none
+ */
+uint8_t ds1302_set_write_protect(ds1302_handle_t *handle, ds1302_bool_t enable)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                            /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                       /* check handle initialization */
+    {
+        return 3;                                                                  /* return error */
+    }
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)                              /* check the pending transfer */
+    {
+        handle->debug_print("ds1302: xfer is pending.\n");                         /* xfer is pending */
+        
+        return 6;                                                                  /* return error */
+    }
+    
+    res = a_ds1302_multiple_read(handle, DS1302_COMMAND_RTC | DS1302_REG_CONTROL, 
+                                 &prev, 1);                                        /* read control */
+    if (res != 0)                                                                  /* check result */
+    {
+        handle->debug_print("ds1302: read control failed.\n");                     /* read control failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    prev &= ~(1 << 7);                                                             /* clear config */
+    prev |= enable << 7;                                                           /* set bool */
+    res = a_ds1302_write(handle, DS1302_COMMAND_RTC | DS1302_REG_CONTROL, prev);   /* write control */
+    if (res != 0)                                                                  /* check result */
+    {
+        handle->debug_print("ds1302: write control failed.\n");                    /* write control failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      get write protect status
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get write protect failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 6 a transfer is pending
+ * @note       none
+ */
+uint8_t ds1302_get_write_protect(ds1302_handle_t *handle, ds1302_bool_t *enable)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                            /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                       /* check handle initialization */
+    {
+        return 3;                                                                  /* return error */
+    }
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)                              /* check the pending transfer */
+    {
+        handle->debug_print("ds1302: xfer is pending.\n");                         /* xfer is pending */
+        
+        return 6;                                                                  /* return error */
+    }
+    
+    res = a_ds1302_multiple_read(handle, DS1302_COMMAND_RTC | DS1302_REG_CONTROL, 
+                                 &prev, 1);                                        /* read control */
+    if (res != 0)                                                                  /* check result */
+    {
+        handle->debug_print("ds1302: read control failed.\n");                     /* read control failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    *enable = (ds1302_bool_t)((prev >> 7) & 0x01);                                 /* set bool */
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     set charge
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] charge charge mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 set charge failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 6 a transfer is pending
+ * @note      none
+ */
+uint8_t ds1302_set_charge(ds1302_handle_t *handle, uint8_t charge)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)                                    /* check the pending transfer */
+    {
+        handle->debug_print("ds1302: xfer is pending.\n");                               /* xfer is pending */
+        
+        return 6;                                                                        /* return error */
+    }
+    
+    res = a_ds1302_write(handle, DS1302_COMMAND_RTC | DS1302_REG_CHARGE, charge);        /* write charge */
+    if (res != 0)                                                                        /* check result */
+    {
+        handle->debug_print("ds1302: write charge failed.\n");                           /* write charge failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief      get charge
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *charge pointer to a charge buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get charge failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 6 a transfer is pending
+ * @note       none
+ */
+uint8_t ds1302_get_charge(ds1302_handle_t *handle, uint8_t *charge)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                             /* check handle */
+    {
+        return 2;                                                                                   /* return error */
+    }
+    if (handle->inited != 1)                                                                        /* check handle initialization */
+    {
+        return 3;                                                                                   /* return error */
+    }
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)                                               /* check the pending transfer */
+    {
+        handle->debug_print("ds1302: xfer is pending.\n");                                          /* xfer is pending */
+        
+        return 6;                                                                                   /* return error */
+    }
+    
+    res = a_ds1302_multiple_read(handle, DS1302_COMMAND_RTC | DS1302_REG_CHARGE, charge, 1);        /* read charge */
+    if (res != 0)                                                                                   /* check result */
+    {
+        handle->debug_print("ds1302: read charge failed.\n");                                       /* read charge failed */
+        
+        return 1;                                                                                   /* return error */
+    }
+    
+    return 0;                                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      read ram
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[in]  addr ram address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read ram failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 addr > 30
+ *             - 5 len is invalid
+ *             - 6 a transfer is pending
+ * @note       none
+ */
+uint8_t ds1302_read_ram(ds1302_handle_t *handle, uint8_t addr, uint8_t *buf, uint8_t len)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                            /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                       /* check handle initialization */
+    {
+        return 3;                                                                  /* return error */
+    }
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)                              /* check the pending transfer */
+    {
+        handle->debug_print("ds1302: xfer is pending.\n");                         /* xfer is pending */
+        
+        return 6;                                                                  /* return error */
+    }
+    if (addr > 30)                                                                 /* check addr */
+    {
+        handle->debug_print("ds1302: addr > 30.\n");                               /* addr > 30 */
+        
+        return 4;                                                                  /* return error */
+    }
+    if (addr + len - 1 > 30)                                                       /* check len */
+    {
+        handle->debug_print("ds1302: len is invalid.\n");                          /* len is invalid */
+        
+        return 5;                                                                  /* return error */
+    }
+    
+    res = a_ds1302_multiple_read(handle, (uint8_t)(DS1302_COMMAND_RAM +
+                                (addr << 1)), buf, len);                           /* read ram */
+    if (res != 0)                                                                  /* check result */
+    {
+        handle->debug_print("ds1302: read ram failed.\n");                         /* read ram failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     write ram
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] addr ram address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write ram failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr > 30
+ *            - 5 len is invalid
+ *            - 6 a transfer is pending
+ * @note      none
+ */
+uint8_t ds1302_write_ram(ds1302_handle_t *handle, uint8_t addr, uint8_t *buf, uint8_t len)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                            /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                       /* check handle initialization */
+    {
+        return 3;                                                                  /* return error */
+    }
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)                              /* check the pending transfer */
+    {
+        handle->debug_print("ds1302: xfer is pending.\n");                         /* xfer is pending */
+        
+        return 6;                                                                  /* return error */
+    }
+    if (addr > 30)                                                                 /* check addr */
+    {
+        handle->debug_print("ds1302: addr > 30.\n");                               /* addr > 30 */
+        
+        return 4;                                                                  /* return error */
+    }
+    if (addr + len - 1 > 30)                                                       /* check len */
+    {
+        handle->debug_print("ds1302: len is invalid.\n");                          /* len is invalid */
+        
+        return 5;                                                                  /* return error */
+    }
+    
+    res = a_ds1302_multiple_write(handle, (uint8_t)(DS1302_COMMAND_RAM +
+                                 (addr << 1)), buf, len);                          /* write ram */
+    if (res != 0)                                                                  /* check result */
+    {
+        handle->debug_print("ds1302: write ram failed.\n");                        /* write ram failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     set the bus transport
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] transport bus transport
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      DS1302_TRANSPORT_GPIO bit-bangs the bus with the gpio callbacks,
+ *            DS1302_TRANSPORT_BYTE hands whole lsb first bytes to the transport callbacks,
+ *            it must be set before ds1302_init
+ */
+uint8_t ds1302_set_transport(ds1302_handle_t *handle, ds1302_transport_t transport)
+{
+    if (handle == NULL)                                       /* check handle */
+    {
+        return 2;                                             /* return error */
+    }
+    
+    handle->transport = (uint8_t)transport;                   /* set transport */
+    
+    return 0;                                                 /* success return 0 */
+}
+
+/**
+ * @brief      get the bus transport
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *transport pointer to a bus transport buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t ds1302_get_transport(ds1302_handle_t *handle, ds1302_transport_t *transport)
+{
+    if (handle == NULL)                                       /* check handle */
     {
-        t->hour = a_ds1302_bcd2hex(buf[2] & 0x3F);                                        /* get hour */
+        return 2;                                             /* return error */
     }
-    t->minute = a_ds1302_bcd2hex(buf[1]);                                                 /* get minute */
-    t->second = a_ds1302_bcd2hex(buf[0] & (~(1 << 7)));                                   /* get second */
     
-    return 0;                                                                             /* success return 0 */
+    *transport = (ds1302_transport_t)(handle->transport);     /* get transport */
+    
+    return 0;                                                 /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the oscillator
+ * @brief     set the shared lines flag
  * @param[in] *handle pointer to a ds1302 handle structure
  * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set oscillator failed
  *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @note      when enabled ds1302_init and ds1302_deinit leave the sclk and io lines alone
+ *            because another handle owns them, it must be set before ds1302_init
  */
-uint8_t ds1302_set_oscillator(ds1302_handle_t *handle, ds1302_bool_t enable)
+uint8_t ds1302_set_shared_lines(ds1302_handle_t *handle, ds1302_bool_t enable)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                           /* check handle */
+    if (handle == NULL)                                       /* check handle */
     {
-        return 2;                                                                 /* return error */
-    }
-    if (handle->inited != 1)                                                      /* check handle initialization */
-    {
-        return 3;                                                                 /* return error */
+        return 2;                                             /* return error */
     }
     
-    res = a_ds1302_multiple_read(handle, DS1302_COMMAND_RTC | DS1302_REG_SECOND, 
-                                 &prev, 1);                                       /* read second */
-    if (res != 0)                                                                 /* check result */
-    {
-        handle->debug_print("ds1302: read second failed.\n");                     /* read second failed */
-        
-        return 1;                                                                 /* return error */
-    }
-    prev &= ~(1 << 7);                                                            /* clear config */
-    prev |= (!enable) << 7;                                                       /* set enable */
-    res = a_ds1302_write(handle, DS1302_COMMAND_RTC | DS1302_REG_SECOND, 
-                         prev);                                                   /* write second */
-    if (res != 0)                                                                 /* check result */
-    {
-        handle->debug_print("ds1302: write second failed.\n");                    /* write second failed */
-        
-        return 1;                                                                 /* return error */
-    }
+    handle->shared_lines = (uint8_t)enable;                   /* set shared lines */
     
-    return 0;                                                                     /* success return 0 */
+    return 0;                                                 /* success return 0 */
 }
 
 /**
- * @brief      get the chip oscillator status
+ * @brief      get the shared lines flag
  * @param[in]  *handle pointer to a ds1302 handle structure
  * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get oscillator failed
  *             - 2 handle is NULL
- *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t ds1302_get_oscillator(ds1302_handle_t *handle, ds1302_bool_t *enable)
+uint8_t ds1302_get_shared_lines(ds1302_handle_t *handle, ds1302_bool_t *enable)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                                      /* check handle */
+    if (handle == NULL)                                       /* check handle */
     {
-        return 2;                                                                            /* return error */
+        return 2;                                             /* return error */
     }
-    if (handle->inited != 1)                                                                 /* check handle initialization */
+    
+    *enable = (ds1302_bool_t)(handle->shared_lines);          /* get shared lines */
+    
+    return 0;                                                 /* success return 0 */
+}
+
+#if (DS1302_ENABLE_STATS == 1)
+/**
+ * @brief      get the bus statistics
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *stats pointer to a stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       latencies are only recorded when timestamp_us is linked
+ */
+uint8_t ds1302_get_stats(ds1302_handle_t *handle, ds1302_stats_t *stats)
+{
+    if (handle == NULL)                                                /* check handle */
     {
-        return 3;                                                                            /* return error */
+        return 2;                                                      /* return error */
     }
-    
-    res = a_ds1302_multiple_read(handle, DS1302_COMMAND_RTC | DS1302_REG_SECOND, 
-                                (uint8_t *)&prev, 1);                                        /* multiple read */
-    if (res != 0)                                                                            /* check result */
+    if (handle->inited != 1)                                           /* check handle initialization */
     {
-        handle->debug_print("ds1302: read second failed.\n");                                /* read second failed */
-        
-        return 1;                                                                            /* return error */
+        return 3;                                                      /* return error */
     }
-    *enable = (ds1302_bool_t)(!((prev >> 7) & 0x01));                                        /* get enable */
     
-    return 0;                                                                                /* success return 0 */
+    memcpy(stats, &handle->stats, sizeof(ds1302_stats_t));             /* copy stats */
+    
+    return 0;                                                          /* success return 0 */
 }
 
 /**
- * @brief     enable or disable write protect
+ * @brief     reset the bus statistics
  * @param[in] *handle pointer to a ds1302 handle structure
- * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set write protect failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t ds1302_set_write_protect(ds1302_handle_t *handle, ds1302_bool_t enable)
+uint8_t ds1302_reset_stats(ds1302_handle_t *handle)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                            /* check handle */
+    if (handle == NULL)                                                /* check handle */
     {
-        return 2;                                                                  /* return error */
+        return 2;                                                      /* return error */
     }
-    if (handle->inited != 1)                                                       /* check handle initialization */
+    if (handle->inited != 1)                                           /* check handle initialization */
     {
-        return 3;                                                                  /* return error */
+        return 3;                                                      /* return error */
     }
     
-    res = a_ds1302_multiple_read(handle, DS1302_COMMAND_RTC | DS1302_REG_CONTROL, 
-                                 &prev, 1);                                        /* read control */
-    if (res != 0)                                                                  /* check result */
-    {
-        handle->debug_print("ds1302: read control failed.\n");                     /* read control failed */
-        
-        return 1;                                                                  /* return error */
-    }
-    prev &= ~(1 << 7);                                                             /* clear config */
-    prev |= enable << 7;                                                           /* set bool */
-    res = a_ds1302_write(handle, DS1302_COMMAND_RTC | DS1302_REG_CONTROL, prev);   /* write control */
-    if (res != 0)                                                                  /* check result */
-    {
-        handle->debug_print("ds1302: write control failed.\n");                    /* write control failed */
-        
-        return 1;                                                                  /* return error */
-    }
+    memset(&handle->stats, 0, sizeof(ds1302_stats_t));                 /* clear stats */
     
-    return 0;                                                                      /* success return 0 */
+    return 0;                                                          /* success return 0 */
 }
+#endif
 
 /**
- * @brief      get write protect status
- * @param[in]  *handle pointer to a ds1302 handle structure
- * @param[out] *enable pointer to a bool value buffer
- * @return     status code
- *             - 0 success
- *             - 1 get write protect failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     initialize the chip
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 gpio initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ * @note      none
  */
-uint8_t ds1302_get_write_protect(ds1302_handle_t *handle, ds1302_bool_t *enable)
+uint8_t ds1302_init(ds1302_handle_t *handle)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                            /* check handle */
+    if (handle == NULL)                                                                          /* check handle */
     {
-        return 2;                                                                  /* return error */
+        return 2;                                                                                /* return error */
     }
-    if (handle->inited != 1)                                                       /* check handle initialization */
+    if (handle->debug_print == NULL)                                                             /* check debug_print */
     {
-        return 3;                                                                  /* return error */
+        return 3;                                                                                /* return error */
     }
-    
-    res = a_ds1302_multiple_read(handle, DS1302_COMMAND_RTC | DS1302_REG_CONTROL, 
-                                 &prev, 1);                                        /* read control */
-    if (res != 0)                                                                  /* check result */
+    if (handle->ce_gpio_init == NULL)                                                            /* check ce_gpio_init */
     {
-        handle->debug_print("ds1302: read control failed.\n");                     /* read control failed */
-        
-        return 1;                                                                  /* return error */
+        handle->debug_print("ds1302: ce_gpio_init is null.\n");                                  /* ce_gpio_init is null */
+       
+        return 3;                                                                                /* return error */
+    }
+    if (handle->ce_gpio_deinit == NULL)                                                          /* check ce_gpio_deinit */
+    {
+        handle->debug_print("ds1302: ce_gpio_deinit is null.\n");                                /* ce_gpio_deinit is null */
+       
+        return 3;                                                                                /* return error */
+    }
+    if ((handle->transport == DS1302_TRANSPORT_GPIO) && (handle->ce_gpio_write == NULL))         /* check ce_gpio_write */
+    {
+        handle->debug_print("ds1302: ce_gpio_write is null.\n");                                 /* ce_gpio_write is null */
+       
+        return 3;                                                                                /* return error */
+    }
+    if (handle->sclk_gpio_init == NULL)                                                          /* check sclk_gpio_init */
+    {
+        handle->debug_print("ds1302: sclk_gpio_init is null.\n");                                /* sclk_gpio_init is null */
+       
+        return 3;                                                                                /* return error */
+    }
+    if (handle->sclk_gpio_deinit == NULL)                                                        /* check sclk_gpio_deinit */
+    {
+        handle->debug_print("ds1302: sclk_gpio_deinit is null.\n");                              /* sclk_gpio_deinit is null */
+       
+        return 3;                                                                                /* return error */
+    }
+    if ((handle->transport == DS1302_TRANSPORT_GPIO) && (handle->sclk_gpio_write == NULL))       /* check sclk_gpio_write */
+    {
+        handle->debug_print("ds1302: sclk_gpio_write is null.\n");                               /* sclk_gpio_write is null */
+       
+        return 3;                                                                                /* return error */
+    }
+    if (handle->io_gpio_init == NULL)                                                            /* check io_gpio_init */
+    {
+        handle->debug_print("ds1302: io_gpio_init is null.\n");                                  /* io_gpio_init is null */
+       
+        return 3;                                                                                /* return error */
+    }
+    if (handle->io_gpio_deinit == NULL)                                                          /* check io_gpio_deinit */
+    {
+        handle->debug_print("ds1302: io_gpio_deinit is null.\n");                                /* io_gpio_deinit is null */
+       
+        return 3;                                                                                /* return error */
+    }
+    if ((handle->transport == DS1302_TRANSPORT_GPIO) && (handle->io_gpio_write == NULL))         /* check io_gpio_write */
+    {
+        handle->debug_print("ds1302: io_gpio_write is null.\n");                                 /* io_gpio_write is null */
+       
+        return 3;                                                                                /* return error */
+    }
+    if ((handle->transport == DS1302_TRANSPORT_GPIO) && (handle->io_gpio_read == NULL))          /* check io_gpio_read */
+    {
+        handle->debug_print("ds1302: io_gpio_read is null.\n");                                  /* io_gpio_read is null */
+       
+        return 3;                                                                                /* return error */
+    }
+    if ((handle->transport == DS1302_TRANSPORT_BYTE) && (handle->transport_begin == NULL))       /* check transport_begin */
+    {
+        handle->debug_print("ds1302: transport_begin is null.\n");                               /* transport_begin is null */
+       
+        return 3;                                                                                /* return error */
+    }
+    if ((handle->transport == DS1302_TRANSPORT_BYTE) && (handle->transport_write_bytes == NULL)) /* check transport_write_bytes */
+    {
+        handle->debug_print("ds1302: transport_write_bytes is null.\n");                         /* transport_write_bytes is null */
+       
+        return 3;                                                                                /* return error */
+    }
+    if ((handle->transport == DS1302_TRANSPORT_BYTE) && (handle->transport_read_bytes == NULL))  /* check transport_read_bytes */
+    {
+        handle->debug_print("ds1302: transport_read_bytes is null.\n");                          /* transport_read_bytes is null */
+       
+        return 3;                                                                                /* return error */
+    }
+    if (handle->delay_ms == NULL)                                                                /* check delay_ms */
+    {
+        handle->debug_print("ds1302: delay_ms is null.\n");                                      /* delay_ms is null */
+       
+        return 3;                                                                                /* return error */
+    }
+    if ((handle->transport == DS1302_TRANSPORT_GPIO) && (handle->delay_us == NULL))              /* check delay_us */
+    {
+        handle->debug_print("ds1302: delay_us is null.\n");                                      /* delay_us is null */
+       
+        return 3;                                                                                /* return error */
     }
-    *enable = (ds1302_bool_t)((prev >> 7) & 0x01);                                 /* set bool */
     
-    return 0;                                                                      /* success return 0 */
+    if (handle->ce_gpio_init(handle->ctx) != 0)                                                  /* ce gpio init */
+    {
+        handle->debug_print("ds1302: ce gpio init failed.\n");                                   /* ce gpio init failed */
+       
+        return 1;                                                                                /* return error */
+    }
+    if (handle->shared_lines == 0)                                                               /* own sclk and io */
+    {
+        if (handle->sclk_gpio_init(handle->ctx) != 0)                                            /* sclk gpio init */
+        {
+            handle->debug_print("ds1302: sclk gpio init failed.\n");                             /* sclk gpio init failed */
+            (void)handle->ce_gpio_deinit(handle->ctx);                                           /* ce gpio deinit */
+            
+            return 1;                                                                            /* return error */
+        }
+        if (handle->io_gpio_init(handle->ctx) != 0)                                              /* io gpio init */
+        {
+            handle->debug_print("ds1302: io gpio init failed.\n");                               /* io gpio init failed */
+            (void)handle->ce_gpio_deinit(handle->ctx);                                           /* ce gpio deinit */
+            (void)handle->sclk_gpio_deinit(handle->ctx);                                         /* sclk gpio deinit */
+            
+            return 1;                                                                            /* return error */
+        }
+    }
+    handle->io_direction = DS1302_IO_DIRECTION_UNKNOWN;                                          /* io direction unknown */
+    handle->cache_enable = 0;                                                                    /* disable time cache */
+    handle->cache_valid = 0;                                                                     /* no anchor */
+    handle->cache_interval_ms = DS1302_CACHE_INTERVAL_MS;                                        /* default interval */
+    handle->drift_ppb = 0;                                                                       /* no drift */
+    handle->drift_ref_s = DS1302_DRIFT_NO_REF;                                                   /* no reference */
+    handle->drift_started = 0;                                                                   /* no measure */
+    handle->drift_record = 0;                                                                    /* no record */
+    handle->xfer_state = DS1302_XFER_STATE_IDLE;                                                 /* no transfer */
+    handle->xfer_done = NULL;                                                                    /* no callback */
+#if (DS1302_ENABLE_STATS == 1)
+    memset(&handle->stats, 0, sizeof(ds1302_stats_t));                                           /* clear stats */
+#endif
+    handle->inited = 1;                                                                          /* flag finish initialization */
+    
+    return 0;                                                                                    /* success return 0 */
 }
 
 /**
- * @brief     set charge
+ * @brief     close the chip
  * @param[in] *handle pointer to a ds1302 handle structure
- * @param[in] charge charge mode
  * @return    status code
  *            - 0 success
- *            - 1 set charge failed
+ *            - 1 gpio deinit failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 6 a transfer is pending
+ * @note      abort a pending transfer with ds1302_xfer_abort first
  */
-uint8_t ds1302_set_charge(ds1302_handle_t *handle, uint8_t charge)
+uint8_t ds1302_deinit(ds1302_handle_t *handle)
 {
-    uint8_t res;
-    
-    if (handle == NULL)                                                                  /* check handle */
+    if (handle == NULL)                                             /* check handle */
     {
-        return 2;                                                                        /* return error */
+        return 2;                                                   /* return error */
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->inited != 1)                                        /* check handle initialization */
     {
-        return 3;                                                                        /* return error */
+        return 3;                                                   /* return error */
     }
-    
-    res = a_ds1302_write(handle, DS1302_COMMAND_RTC | DS1302_REG_CHARGE, charge);        /* write charge */
-    if (res != 0)                                                                        /* check result */
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)               /* check the pending transfer */
     {
-        handle->debug_print("ds1302: write charge failed.\n");                           /* write charge failed */
+        handle->debug_print("ds1302: xfer is pending.\n");          /* xfer is pending */
         
-        return 1;                                                                        /* return error */
+        return 6;                                                   /* return error */
     }
     
-    return 0;                                                                            /* success return 0 */
+    if (handle->ce_gpio_deinit(handle->ctx) != 0)                   /* ce gpio deinit */
+    {
+        handle->debug_print("ds1302: ce gpio deinit failed.\n");    /* ce gpio deinit failed */
+       
+        return 1;                                                   /* return error */
+    }
+    if (handle->shared_lines == 0)                                  /* own sclk and io */
+    {
+        if (handle->sclk_gpio_deinit(handle->ctx) != 0)             /* sclk gpio deinit */
+        {
+            handle->debug_print("ds1302: sclk gpio deinit failed.\n");  /* sclk gpio deinit failed */
+           
+            return 1;                                               /* return error */
+        }
+        if (handle->io_gpio_deinit(handle->ctx) != 0)               /* io gpio deinit */
+        {
+            handle->debug_print("ds1302: io gpio deinit failed.\n");    /* io gpio deinit failed */
+           
+            return 1;                                               /* return error */
+        }
+    }
+    handle->inited = 0;                                             /* flag close */
+    
+    return 0;                                                       /* success return 0 */
 }
 
 /**
- * @brief      get charge
- * @param[in]  *handle pointer to a ds1302 handle structure
- * @param[out] *charge pointer to a charge buffer
- * @return     status code
- *             - 0 success
- *             - 1 get charge failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     clock burst write
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 len > 8
+ *            - 6 a transfer is pending
+ * @note      none
  */
-uint8_t ds1302_get_charge(ds1302_handle_t *handle, uint8_t *charge)
+uint8_t ds1302_clock_burst_write(ds1302_handle_t *handle, uint8_t *buf, uint8_t len)
 {
-    uint8_t res;
-    
-    if (handle == NULL)                                                                             /* check handle */
+    if (handle == NULL)                                                                                /* check handle */
     {
-        return 2;                                                                                   /* return error */
+        return 2;                                                                                      /* return error */
     }
-    if (handle->inited != 1)                                                                        /* check handle initialization */
+    if (handle->inited != 1)                                                                           /* check handle initialization */
     {
-        return 3;                                                                                   /* return error */
+        return 3;                                                                                      /* return error */
     }
-    
-    res = a_ds1302_multiple_read(handle, DS1302_COMMAND_RTC | DS1302_REG_CHARGE, charge, 1);        /* read charge */
-    if (res != 0)                                                                                   /* check result */
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)                                                  /* check the pending transfer */
     {
-        handle->debug_print("ds1302: read charge failed.\n");                                       /* read charge failed */
+        handle->debug_print("ds1302: xfer is pending.\n");                                             /* xfer is pending */
         
-        return 1;                                                                                   /* return error */
+        return 6;                                                                                      /* return error */
+    }
+    if (len > 8)                                                                                       /* check len */
+    {
+        handle->debug_print("ds1302: len > 8.\n");                                                     /* len > 8 */
+        
+        return 4;                                                                                      /* return error */
     }
     
-    return 0;                                                                                       /* success return 0 */
+    handle->cache_valid = 0;                                                                           /* drop the anchor */
+    if (a_ds1302_burst_write(handle, DS1302_COMMAND_RTC | DS1302_COMMAND_BURST, buf, len) != 0)        /* write data */
+    {
+        return 1;                                                                                      /* return error */
+    }
+    
+    return 0;                                                                                          /* success return 0 */
 }
 
 /**
- * @brief      read ram
+ * @brief      clock burst read
  * @param[in]  *handle pointer to a ds1302 handle structure
- * @param[in]  addr ram address
  * @param[out] *buf pointer to a data buffer
- * @param[in]  len buffer length
+ * @param[in]  len data buffer length
  * @return     status code
  *             - 0 success
- *             - 1 read ram failed
+ *             - 1 read failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 addr > 30
- *             - 5 len is invalid
+ *             - 4 len > 8
+ *             - 6 a transfer is pending
  * @note       none
  */
-uint8_t ds1302_read_ram(ds1302_handle_t *handle, uint8_t addr, uint8_t *buf, uint8_t len)
+uint8_t ds1302_clock_burst_read(ds1302_handle_t *handle, uint8_t *buf, uint8_t len)
 {
-    uint8_t res;
-    
-    if (handle == NULL)                                                            /* check handle */
+    if (handle == NULL)                                                                               /* check handle */
     {
-        return 2;                                                                  /* return error */
+        return 2;                                                                                     /* return error */
     }
-    if (handle->inited != 1)                                                       /* check handle initialization */
+    if (handle->inited != 1)                                                                          /* check handle initialization */
     {
-        return 3;                                                                  /* return error */
+        return 3;                                                                                     /* return error */
     }
-    if (addr > 30)                                                                 /* check addr */
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)                                                 /* check the pending transfer */
     {
-        handle->debug_print("ds1302: addr > 30.\n");                               /* addr > 30 */
+        handle->debug_print("ds1302: xfer is pending.\n");                                            /* xfer is pending */
         
-        return 4;                                                                  /* return error */
+        return 6;                                                                                     /* return error */
     }
-    if (addr + len - 1 > 30)                                                       /* check len */
+    if (len > 8)                                                                                      /* check len */
     {
-        handle->debug_print("ds1302: len is invalid.\n");                          /* len is invalid */
+        handle->debug_print("ds1302: len > 8.\n");                                                    /* len > 8 */
         
-        return 5;                                                                  /* return error */
+        return 4;                                                                                     /* return error */
     }
     
-    res = a_ds1302_multiple_read(handle, (uint8_t)(DS1302_COMMAND_RAM +
-                                (addr << 1)), buf, len);                           /* read ram */
-    if (res != 0)                                                                  /* check result */
+    if (a_ds1302_burst_read(handle, DS1302_COMMAND_RTC | DS1302_COMMAND_BURST, buf, len) != 0)        /* read data */
     {
-        handle->debug_print("ds1302: read ram failed.\n");                         /* read ram failed */
-        
-        return 1;                                                                  /* return error */
+        return 1;                                                                                     /* return error */
     }
     
-    return 0;                                                                      /* success return 0 */
+    return 0;                                                                                         /* success return 0 */
 }
 
 /**
- * @brief     write ram
+ * @brief     ram burst write
  * @param[in] *handle pointer to a ds1302 handle structure
- * @param[in] addr ram address
  * @param[in] *buf pointer to a data buffer
- * @param[in] len buffer length
+ * @param[in] len data buffer length
  * @return    status code
  *            - 0 success
- *            - 1 write ram failed
+ *            - 1 write failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 addr > 30
- *            - 5 len is invalid
+ *            - 4 len > 31
+ *            - 6 a transfer is pending
  * @note      none
  */
-uint8_t ds1302_write_ram(ds1302_handle_t *handle, uint8_t addr, uint8_t *buf, uint8_t len)
+uint8_t ds1302_ram_burst_write(ds1302_handle_t *handle, uint8_t *buf, uint8_t len)
 {
-    uint8_t res;
-    
-    if (handle == NULL)                                                            /* check handle */
+    if (handle == NULL)                                                                                /* check handle */
     {
-        return 2;                                                                  /* return error */
+        return 2;                                                                                      /* return error */
     }
-    if (handle->inited != 1)                                                       /* check handle initialization */
+    if (handle->inited != 1)                                                                           /* check handle initialization */
     {
-        return 3;                                                                  /* return error */
+        return 3;                                                                                      /* return error */
     }
-    if (addr > 30)                                                                 /* check addr */
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)                                                  /* check the pending transfer */
     {
-        handle->debug_print("ds1302: addr > 30.\n");                               /* addr > 30 */
+        handle->debug_print("ds1302: xfer is pending.\n");                                             /* xfer is pending */
         
-        return 4;                                                                  /* return error */
+        return 6;                                                                                      /* return error */
     }
-    if (addr + len - 1 > 30)                                                       /* check len */
+    if (len > 31)                                                                                      /* check len */
     {
-        handle->debug_print("ds1302: len is invalid.\n");                          /* len is invalid */
+        handle->debug_print("ds1302: len > 31.\n");                                                    /* len > 31 */
         
-        return 5;                                                                  /* return error */
+        return 4;                                                                                      /* return error */
     }
     
-    res = a_ds1302_multiple_write(handle, (uint8_t)(DS1302_COMMAND_RAM +
-                                 (addr << 1)), buf, len);                          /* write ram */
-    if (res != 0)                                                                  /* check result */
+    if (a_ds1302_burst_write(handle, DS1302_COMMAND_RAM | DS1302_COMMAND_BURST, buf, len) != 0)        /* write data */
     {
-        handle->debug_print("ds1302: write ram failed.\n");                        /* write ram failed */
-        
-        return 1;                                                                  /* return error */
+        return 1;                                                                                      /* return error */
     }
     
-    return 0;                                                                      /* success return 0 */
+    return 0;                                                                                          /* success return 0 */
 }
 
 /**
- * @brief     initialize the chip
- * @param[in] *handle pointer to a ds1302 handle structure
- * @return    status code
- *            - 0 success
- *            - 1 gpio initialization failed
- *            - 2 handle is NULL
- *            - 3 linked functions is NULL
- * @note      none
+ * @brief      ram burst read
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 len > 31
+ *             - 6 a transfer is pending
+ * @note       none
  */
-uint8_t ds1302_init(ds1302_handle_t *handle)
+uint8_t ds1302_ram_burst_read(ds1302_handle_t *handle, uint8_t *buf, uint8_t len)
 {
-    if (handle == NULL)                                              /* check handle */
-    {
-        return 2;                                                    /* return error */
-    }
-    if (handle->debug_print == NULL)                                 /* check debug_print */
-    {
-        return 3;                                                    /* return error */
-    }
-    if (handle->ce_gpio_init == NULL)                                /* check ce_gpio_init */
-    {
-        handle->debug_print("ds1302: ce_gpio_init is null.\n");      /* ce_gpio_init is null */
-       
-        return 3;                                                    /* return error */
-    }
-    if (handle->ce_gpio_deinit == NULL)                              /* check ce_gpio_deinit */
-    {
-        handle->debug_print("ds1302: ce_gpio_deinit is null.\n");    /* ce_gpio_deinit is null */
-       
-        return 3;                                                    /* return error */
-    }
-    if (handle->ce_gpio_write == NULL)                               /* check ce_gpio_write */
-    {
-        handle->debug_print("ds1302: ce_gpio_write is null.\n");     /* ce_gpio_write is null */
-       
-        return 3;                                                    /* return error */
-    }
-    if (handle->sclk_gpio_init == NULL)                              /* check sclk_gpio_init */
-    {
-        handle->debug_print("ds1302: sclk_gpio_init is null.\n");    /* sclk_gpio_init is null */
-       
-        return 3;                                                    /* return error */
-    }
-    if (handle->sclk_gpio_deinit == NULL)                            /* check sclk_gpio_deinit */
+    if (handle == NULL)                                                                               /* check handle */
     {
-        handle->debug_print("ds1302: sclk_gpio_deinit is null.\n");  /* sclk_gpio_deinit is null */
-       
-        return 3;                                                    /* return error */
+        return 2;                                                                                     /* return error */
     }
-    if (handle->sclk_gpio_write == NULL)                             /* check sclk_gpio_write */
+    if (handle->inited != 1)                                                                          /* check handle initialization */
     {
-        handle->debug_print("ds1302: sclk_gpio_write is null.\n");   /* sclk_gpio_write is null */
-       
-        return 3;                                                    /* return error */
+        return 3;                                                                                     /* return error */
     }
-    if (handle->io_gpio_init == NULL)                                /* check io_gpio_init */
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)                                                 /* check the pending transfer */
     {
-        handle->debug_print("ds1302: io_gpio_init is null.\n");      /* io_gpio_init is null */
-       
-        return 3;                                                    /* return error */
+        handle->debug_print("ds1302: xfer is pending.\n");                                            /* xfer is pending */
+        
+        return 6;                                                                                     /* return error */
     }
-    if (handle->io_gpio_deinit == NULL)                              /* check io_gpio_deinit */
+    if (len > 31)                                                                                     /* check len */
     {
-        handle->debug_print("ds1302: io_gpio_deinit is null.\n");    /* io_gpio_deinit is null */
-       
-        return 3;                                                    /* return error */
+        handle->debug_print("ds1302: len > 31.\n");                                                   /* len > 31 */
+        
+        return 4;                                                                                     /* return error */
     }
-    if (handle->io_gpio_write == NULL)                               /* check io_gpio_write */
+    
+    if (a_ds1302_burst_read(handle, DS1302_COMMAND_RAM | DS1302_COMMAND_BURST, buf, len) != 0)        /* read data */
     {
-        handle->debug_print("ds1302: io_gpio_write is null.\n");     /* io_gpio_write is null */
-       
-        return 3;                                                    /* return error */
+        return 1;                                                                                     /* return error */
     }
-    if (handle->io_gpio_read == NULL)                                /* check io_gpio_read */
+    
+    return 0;                                                                                         /* success return 0 */
+}
+
+/**
+ * @brief     finish the pending transfer
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] res transfer result
+ * @note      the handle is idle before done runs, so done can submit the next transfer
+ */
+static void a_ds1302_xfer_finish(ds1302_handle_t *handle, uint8_t res)
+{
+    void (*done)(struct ds1302_handle_s *handle, uint8_t res);
+    
+    handle->xfer_state = DS1302_XFER_STATE_IDLE;                /* idle */
+    if (res == 0)                                               /* check the result */
     {
-        handle->debug_print("ds1302: io_gpio_read is null.\n");      /* io_gpio_read is null */
-       
-        return 3;                                                    /* return error */
+        DS1302_STATS_ADD(handle, command_bytes, 1);             /* count the command */
+        DS1302_STATS_ADD(handle, data_bytes, handle->xfer_len); /* count the data */
     }
-    if (handle->delay_ms == NULL)                                    /* check delay_ms */
+#if (DS1302_ENABLE_STATS == 1)
+    a_ds1302_stats_record(handle, handle->xfer_start_us, res);  /* record the transfer */
+#endif
+    done = handle->xfer_done;                                   /* get the callback */
+    handle->xfer_done = NULL;                                   /* clear the callback */
+    if (done != NULL)                                           /* check the callback */
     {
-        handle->debug_print("ds1302: delay_ms is null.\n");          /* delay_ms is null */
-       
-        return 3;                                                    /* return error */
+        done(handle, res);                                      /* run the callback */
     }
+}
+
+/**
+ * @brief     move a gpio transfer by one sclk edge
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 step failed
+ * @note      the bit is set up after the falling edge and a read samples io before
+ *            the rising edge, the same order as the blocking transfers
+ */
+static uint8_t a_ds1302_xfer_gpio_step(ds1302_handle_t *handle)
+{
+    uint8_t read;
+    uint8_t level;
     
-    if (handle->ce_gpio_init() != 0)                                 /* ce gpio init */
-    {
-        handle->debug_print("ds1302: ce gpio init failed.\n");       /* ce gpio init failed */
-       
-        return 1;                                                    /* return error */
-    }
-    if (handle->sclk_gpio_init() != 0)                               /* sclk gpio init */
+    read = handle->xfer_command & 0x01;                                                         /* read flag */
+    switch (handle->xfer_state)
     {
-        handle->debug_print("ds1302: sclk gpio init failed.\n");     /* sclk gpio init failed */
-        (void)handle->ce_gpio_deinit();                              /* ce gpio deinit */
-        
-        return 1;                                                    /* return error */
+        case DS1302_XFER_STATE_BEGIN :
+        {
+            if (a_ds1302_begin(handle, 1) != 0)                                                 /* set ce high */
+            {
+                return 1;                                                                       /* return error */
+            }
+            if (a_ds1302_gpio_set_direction(handle, DS1302_IO_DIRECTION_OUTPUT) != 0)          /* set io output */
+            {
+                return 1;                                                                       /* return error */
+            }
+            DS1302_STATS_ADD(handle, gpio_calls, 1);                                            /* count the call */
+            if (handle->io_gpio_write(handle->ctx, handle->xfer_byte & 0x01) != 0)              /* set the first bit */
+            {
+                return 1;                                                                       /* return error */
+            }
+            handle->xfer_state = DS1302_XFER_STATE_RISE;                                        /* next rising edge */
+            
+            return 0;                                                                           /* success return 0 */
+        }
+        case DS1302_XFER_STATE_RISE :
+        {
+            if ((read != 0) && (handle->xfer_index != 0))                                       /* data phase of a read */
+            {
+                DS1302_STATS_ADD(handle, gpio_calls, 1);                                        /* count the call */
+                if (handle->io_gpio_read(handle->ctx, &level) != 0)                             /* read the level */
+                {
+                    return 1;                                                                   /* return error */
+                }
+                if (level != 0)                                                                 /* check the level */
+                {
+                    handle->xfer_byte |= (uint8_t)(1 << handle->xfer_bit);                      /* set the bit */
+                }
+            }
+            DS1302_STATS_ADD(handle, gpio_calls, 1);                                            /* count the call */
+            if (handle->sclk_gpio_write(handle->ctx, 1) != 0)                                   /* set sclk high */
+            {
+                return 1;                                                                       /* return error */
+            }
+            handle->xfer_state = DS1302_XFER_STATE_FALL;                                        /* next falling edge */
+            
+            return 0;                                                                           /* success return 0 */
+        }
+        case DS1302_XFER_STATE_FALL :
+        {
+            DS1302_STATS_ADD(handle, gpio_calls, 1);                                            /* count the call */
+            if (handle->sclk_gpio_write(handle->ctx, 0) != 0)                                   /* set sclk low */
+            {
+                return 1;                                                                       /* return error */
+            }
+            handle->xfer_bit++;                                                                 /* next bit */
+            if (handle->xfer_bit == 8)                                                          /* byte done */
+            {
+                handle->xfer_bit = 0;                                                           /* first bit */
+                if ((read != 0) && (handle->xfer_index != 0))                                   /* data phase of a read */
+                {
+                    handle->xfer_buf[handle->xfer_index - 1] = handle->xfer_byte;               /* save the byte */
+                }
+                handle->xfer_index++;                                                           /* next byte */
+                if (handle->xfer_index > handle->xfer_len)                                      /* all bytes done */
+                {
+                    handle->xfer_state = DS1302_XFER_STATE_END;                                 /* drop ce next */
+                    
+                    return 0;                                                                   /* success return 0 */
+                }
+                if (read != 0)                                                                  /* read */
+                {
+                    if (handle->xfer_index == 1)                                                /* after the command */
+                    {
+                        if (a_ds1302_gpio_set_direction(handle, DS1302_IO_DIRECTION_INPUT) != 0) /* set io input */
+                        {
+                            return 1;                                                           /* return error */
+                        }
+                    }
+                    handle->xfer_byte = 0;                                                      /* init 0 */
+                }
+                else
+                {
+                    handle->xfer_byte = handle->xfer_buf[handle->xfer_index - 1];               /* next data byte */
+                }
+            }
+            if ((read == 0) || (handle->xfer_index == 0))                                       /* command or write data */
+            {
+                DS1302_STATS_ADD(handle, gpio_calls, 1);                                        /* count the call */
+                if (handle->io_gpio_write(handle->ctx, (handle->xfer_byte >> handle->xfer_bit) & 0x01) != 0) /* set the bit */
+                {
+                    return 1;                                                                   /* return error */
+                }
+            }
+            handle->xfer_state = DS1302_XFER_STATE_RISE;                                        /* next rising edge */
+            
+            return 0;                                                                           /* success return 0 */
+        }
+        default :
+        {
+            if (read == 0)                                                                      /* write */
+            {
+                DS1302_STATS_ADD(handle, gpio_calls, 1);                                        /* count the call */
+                if (handle->io_gpio_write(handle->ctx, 0) != 0)                                 /* set io low */
+                {
+                    return 1;                                                                   /* return error */
+                }
+            }
+            if (a_ds1302_begin(handle, 0) != 0)                                                 /* set ce low */
+            {
+                return 1;                                                                       /* return error */
+            }
+            a_ds1302_xfer_finish(handle, 0);                                                    /* finish */
+            
+            return 0;                                                                           /* success return 0 */
+        }
     }
-    if (handle->io_gpio_init() != 0)                                 /* io gpio init */
+}
+
+/**
+ * @brief     move a byte transfer by one byte
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 step failed
+ * @note      none
+ */
+static uint8_t a_ds1302_xfer_byte_step(ds1302_handle_t *handle)
+{
+    uint8_t res;
+    
+    switch (handle->xfer_state)
     {
-        handle->debug_print("ds1302: io gpio init failed.\n");       /* io gpio init failed */
-        (void)handle->ce_gpio_deinit();                              /* ce gpio deinit */
-        (void)handle->sclk_gpio_deinit();                            /* sclk gpio deinit */
-        
-        return 1;                                                    /* return error */
+        case DS1302_XFER_STATE_BEGIN :
+        {
+            if (a_ds1302_begin(handle, 1) != 0)                                                 /* begin */
+            {
+                return 1;                                                                       /* return error */
+            }
+            handle->xfer_state = DS1302_XFER_STATE_BYTE;                                        /* bytes next */
+            
+            return 0;                                                                           /* success return 0 */
+        }
+        case DS1302_XFER_STATE_BYTE :
+        {
+            if (handle->xfer_index == 0)                                                        /* command */
+            {
+                res = a_ds1302_write_bytes(handle, &handle->xfer_command, 1);                   /* write command */
+            }
+            else if ((handle->xfer_command & 0x01) != 0)                                        /* read */
+            {
+                res = a_ds1302_read_bytes(handle, &handle->xfer_buf[handle->xfer_index - 1], 1); /* read one byte */
+            }
+            else
+            {
+                res = a_ds1302_write_bytes(handle, &handle->xfer_buf[handle->xfer_index - 1], 1); /* write one byte */
+            }
+            if (res != 0)                                                                       /* check the result */
+            {
+                return 1;                                                                       /* return error */
+            }
+            handle->xfer_index++;                                                               /* next byte */
+            if (handle->xfer_index > handle->xfer_len)                                          /* all bytes done */
+            {
+                handle->xfer_state = DS1302_XFER_STATE_END;                                     /* end next */
+            }
+            
+            return 0;                                                                           /* success return 0 */
+        }
+        default :
+        {
+            if (a_ds1302_begin(handle, 0) != 0)                                                 /* end */
+            {
+                return 1;                                                                       /* return error */
+            }
+            a_ds1302_xfer_finish(handle, 0);                                                    /* finish */
+            
+            return 0;                                                                           /* success return 0 */
+        }
     }
-    handle->inited = 1;                                              /* flag finish initialization */
-    
-    return 0;                                                        /* success return 0 */
 }
 
 /**
- * @brief     close the chip
+ * @brief     submit a non-blocking transfer
  * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] op transfer operation
+ * @param[in] *buf pointer to a data buffer, it must stay valid until done runs
+ * @param[in] len data buffer length
+ * @param[in] *done pointer to a done callback, res is 0 on success and 1 on failure, it can be NULL
  * @return    status code
  *            - 0 success
- *            - 1 gpio deinit failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 a transfer is pending, op is invalid or len > 8 for clock and len > 31 for ram
+ * @note      nothing touches the bus until ds1302_xfer_step is called, done runs from
+ *            the last step and may submit the next transfer, blocking calls return 6
+ *            while a transfer is pending
  */
-uint8_t ds1302_deinit(ds1302_handle_t *handle)
+uint8_t ds1302_xfer_submit(ds1302_handle_t *handle, ds1302_xfer_op_t op, uint8_t *buf, uint8_t len,
+                           void (*done)(ds1302_handle_t *handle, uint8_t res))
 {
-    if (handle == NULL)                                             /* check handle */
+    uint8_t reg;
+    uint8_t max;
+    
+    if (handle == NULL)                                                         /* check handle */
     {
-        return 2;                                                   /* return error */
+        return 2;                                                               /* return error */
     }
-    if (handle->inited != 1)                                        /* check handle initialization */
+    if (handle->inited != 1)                                                    /* check handle initialization */
     {
-        return 3;                                                   /* return error */
+        return 3;                                                               /* return error */
     }
-    
-    if (handle->ce_gpio_deinit() != 0)                              /* ce gpio deinit */
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)                           /* check the pending transfer */
     {
-        handle->debug_print("ds1302: ce gpio deinit failed.\n");    /* ce gpio deinit failed */
-       
-        return 1;                                                   /* return error */
+        handle->debug_print("ds1302: xfer is pending.\n");                      /* xfer is pending */
+        
+        return 4;                                                               /* return error */
     }
-    if (handle->sclk_gpio_deinit() != 0)                            /* sclk gpio deinit */
+    switch (op)
     {
-        handle->debug_print("ds1302: sclk gpio deinit failed.\n");  /* sclk gpio deinit failed */
-       
-        return 1;                                                   /* return error */
+        case DS1302_XFER_OP_CLOCK_BURST_READ :
+        {
+            reg = (1 << 7) | DS1302_COMMAND_RTC | DS1302_COMMAND_BURST | 0x01;  /* clock burst read */
+            max = 8;                                                            /* 8 bytes */
+            
+            break;
+        }
+        case DS1302_XFER_OP_CLOCK_BURST_WRITE :
+        {
+            reg = (1 << 7) | DS1302_COMMAND_RTC | DS1302_COMMAND_BURST;         /* clock burst write */
+            max = 8;                                                            /* 8 bytes */
+            
+            break;
+        }
+        case DS1302_XFER_OP_RAM_BURST_READ :
+        {
+            reg = (1 << 7) | DS1302_COMMAND_RAM | DS1302_COMMAND_BURST | 0x01;  /* ram burst read */
+            max = 31;                                                           /* 31 bytes */
+            
+            break;
+        }
+        case DS1302_XFER_OP_RAM_BURST_WRITE :
+        {
+            reg = (1 << 7) | DS1302_COMMAND_RAM | DS1302_COMMAND_BURST;         /* ram burst write */
+            max = 31;                                                           /* 31 bytes */
+            
+            break;
+        }
+        default :
+        {
+            handle->debug_print("ds1302: op is invalid.\n");                    /* op is invalid */
+            
+            return 4;                                                           /* return error */
+        }
     }
-    if (handle->io_gpio_deinit() != 0)                              /* io gpio deinit */
+    if (len > max)                                                              /* check len */
     {
-        handle->debug_print("ds1302: io gpio deinit failed.\n");    /* io gpio deinit failed */
-       
-        return 1;                                                   /* return error */
+        handle->debug_print("ds1302: len > %d.\n", max);                        /* len is too long */
+        
+        return 4;                                                               /* return error */
     }
-    handle->inited = 0;                                             /* flag close */
     
-    return 0;                                                       /* success return 0 */
+    if (op == DS1302_XFER_OP_CLOCK_BURST_WRITE)                                 /* clock write */
+    {
+        handle->cache_valid = 0;                                                /* drop the anchor */
+    }
+#if (DS1302_ENABLE_STATS == 1)
+    handle->xfer_start_us = (handle->timestamp_us != NULL) ? handle->timestamp_us() : 0; /* get the start time */
+#endif
+    handle->xfer_done = done;                                                   /* save the callback */
+    handle->xfer_buf = buf;                                                     /* save the buffer */
+    handle->xfer_len = len;                                                     /* save the length */
+    handle->xfer_command = reg;                                                 /* save the command */
+    handle->xfer_index = 0;                                                     /* command first */
+    handle->xfer_bit = 0;                                                       /* lsb first */
+    handle->xfer_byte = reg;                                                    /* shift the command */
+    handle->xfer_state = DS1302_XFER_STATE_BEGIN;                               /* raise ce next */
+    
+    return 0;                                                                   /* success return 0 */
 }
 
 /**
- * @brief     clock burst write
+ * @brief     move the pending transfer forward by one step
  * @param[in] *handle pointer to a ds1302 handle structure
- * @param[in] *buf pointer to a data buffer
- * @param[in] len data buffer length
  * @return    status code
  *            - 0 success
- *            - 1 write failed
+ *            - 1 step failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 len > 8
- * @note      none
+ *            - 4 no transfer is pending
+ * @note      with DS1302_TRANSPORT_GPIO a step is one sclk edge, with DS1302_TRANSPORT_BYTE
+ *            one byte, it never delays and prints nothing so a timer isr or an rtos tick
+ *            can call it, the steps must be at least 1us apart, a failed step drops ce and
+ *            runs done with 1
  */
-uint8_t ds1302_clock_burst_write(ds1302_handle_t *handle, uint8_t *buf, uint8_t len)
+uint8_t ds1302_xfer_step(ds1302_handle_t *handle)
 {
-    if (handle == NULL)                                                                                /* check handle */
-    {
-        return 2;                                                                                      /* return error */
-    }
-    if (handle->inited != 1)                                                                           /* check handle initialization */
+    uint8_t res;
+    
+    if (handle == NULL)                                             /* check handle */
     {
-        return 3;                                                                                      /* return error */
+        return 2;                                                   /* return error */
     }
-    if (len > 8)                                                                                       /* check len */
+    if (handle->inited != 1)                                        /* check handle initialization */
     {
-        handle->debug_print("ds1302: len > 8.\n");                                                     /* len > 8 */
-        
-        return 4;                                                                                      /* return error */
+        return 3;                                                   /* return error */
     }
-    
-    if (a_ds1302_burst_write(handle, DS1302_COMMAND_RTC | DS1302_COMMAND_BURST, buf, len) != 0)        /* write data */
+    if (handle->xfer_state == DS1302_XFER_STATE_IDLE)               /* check the pending transfer */
     {
-        return 1;                                                                                      /* return error */
+        return 4;                                                   /* return error */
     }
     
-    return 0;                                                                                          /* success return 0 */
-}
-
-/**
- * @brief      clock burst read
- * @param[in]  *handle pointer to a ds1302 handle structure
- * @param[out] *buf pointer to a data buffer
- * @param[in]  len data buffer length
- * @return     status code
- *             - 0 success
- *             - 1 read failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 len > 8
- * @note       none
- */
-uint8_t ds1302_clock_burst_read(ds1302_handle_t *handle, uint8_t *buf, uint8_t len)
-{
-    if (handle == NULL)                                                                               /* check handle */
+    if (handle->transport == DS1302_TRANSPORT_BYTE)                 /* byte transport */
     {
-        return 2;                                                                                     /* return error */
+        res = a_ds1302_xfer_byte_step(handle);                      /* one byte */
     }
-    if (handle->inited != 1)                                                                          /* check handle initialization */
+    else
     {
-        return 3;                                                                                     /* return error */
+        res = a_ds1302_xfer_gpio_step(handle);                      /* one edge */
     }
-    if (len > 8)                                                                                      /* check len */
+    if (res != 0)                                                   /* check the result */
     {
-        handle->debug_print("ds1302: len > 8.\n");                                                    /* len > 8 */
+        (void)a_ds1302_begin(handle, 0);                            /* set ce low */
+        a_ds1302_xfer_finish(handle, 1);                            /* finish */
         
-        return 4;                                                                                     /* return error */
-    }
-    
-    if (a_ds1302_burst_read(handle, DS1302_COMMAND_RTC | DS1302_COMMAND_BURST, buf, len) != 0)        /* read data */
-    {
-        return 1;                                                                                     /* return error */
+        return 1;                                                   /* return error */
     }
     
-    return 0;                                                                                         /* success return 0 */
+    return 0;                                                       /* success return 0 */
 }
 
 /**
- * @brief     ram burst write
+ * @brief     abort the pending transfer
  * @param[in] *handle pointer to a ds1302 handle structure
- * @param[in] *buf pointer to a data buffer
- * @param[in] len data buffer length
  * @return    status code
  *            - 0 success
- *            - 1 write failed
+ *            - 1 abort failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 len > 31
- * @note      none
+ *            - 4 no transfer is pending
+ * @note      ce is dropped and done runs with 1, an aborted clock burst write may have
+ *            left the registers unchanged
  */
-uint8_t ds1302_ram_burst_write(ds1302_handle_t *handle, uint8_t *buf, uint8_t len)
+uint8_t ds1302_xfer_abort(ds1302_handle_t *handle)
 {
-    if (handle == NULL)                                                                                /* check handle */
+    uint8_t res;
+    
+    if (handle == NULL)                                             /* check handle */
     {
-        return 2;                                                                                      /* return error */
+        return 2;                                                   /* return error */
     }
-    if (handle->inited != 1)                                                                           /* check handle initialization */
+    if (handle->inited != 1)                                        /* check handle initialization */
     {
-        return 3;                                                                                      /* return error */
+        return 3;                                                   /* return error */
     }
-    if (len > 31)                                                                                      /* check len */
+    if (handle->xfer_state == DS1302_XFER_STATE_IDLE)               /* check the pending transfer */
     {
-        handle->debug_print("ds1302: len > 31.\n");                                                    /* len > 31 */
+        handle->debug_print("ds1302: no xfer is pending.\n");       /* no xfer is pending */
         
-        return 4;                                                                                      /* return error */
+        return 4;                                                   /* return error */
     }
     
-    if (a_ds1302_burst_write(handle, DS1302_COMMAND_RAM | DS1302_COMMAND_BURST, buf, len) != 0)        /* write data */
+    res = 0;                                                        /* init 0 */
+    if (handle->xfer_state != DS1302_XFER_STATE_BEGIN)              /* ce is high */
     {
-        return 1;                                                                                      /* return error */
+        res = a_ds1302_begin(handle, 0);                            /* set ce low */
+    }
+    a_ds1302_xfer_finish(handle, 1);                                /* finish */
+    if (res != 0)                                                   /* check the result */
+    {
+        handle->debug_print("ds1302: set ce low failed.\n");        /* set ce low failed */
+        
+        return 1;                                                   /* return error */
     }
     
-    return 0;                                                                                          /* success return 0 */
+    return 0;                                                       /* success return 0 */
 }
 
 /**
- * @brief      ram burst read
+ * @brief      get the transfer status
  * @param[in]  *handle pointer to a ds1302 handle structure
- * @param[out] *buf pointer to a data buffer
- * @param[in]  len data buffer length
+ * @param[out] *busy pointer to a busy buffer
  * @return     status code
  *             - 0 success
- *             - 1 read failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 len > 31
  * @note       none
  */
-uint8_t ds1302_ram_burst_read(ds1302_handle_t *handle, uint8_t *buf, uint8_t len)
+uint8_t ds1302_xfer_get_busy(ds1302_handle_t *handle, ds1302_bool_t *busy)
 {
-    if (handle == NULL)                                                                               /* check handle */
-    {
-        return 2;                                                                                     /* return error */
-    }
-    if (handle->inited != 1)                                                                          /* check handle initialization */
+    if (handle == NULL)                                             /* check handle */
     {
-        return 3;                                                                                     /* return error */
+        return 2;                                                   /* return error */
     }
-    if (len > 31)                                                                                     /* check len */
+    if (handle->inited != 1)                                        /* check handle initialization */
     {
-        handle->debug_print("ds1302: len > 31.\n");                                                   /* len > 31 */
-        
-        return 4;                                                                                     /* return error */
+        return 3;                                                   /* return error */
     }
     
-    if (a_ds1302_burst_read(handle, DS1302_COMMAND_RAM | DS1302_COMMAND_BURST, buf, len) != 0)        /* read data */
-    {
-        return 1;                                                                                     /* return error */
-    }
+    *busy = (ds1302_bool_t)(handle->xfer_state != DS1302_XFER_STATE_IDLE); /* get the status */
     
-    return 0;                                                                                         /* success return 0 */
+    return 0;                                                       /* success return 0 */
 }
 
 /**
@@ -1491,6 +3525,7 @@ uint8_t ds1302_ram_burst_read(ds1302_handle_t *handle, uint8_t *buf, uint8_t len
  *            - 1 write failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 6 a transfer is pending
  * @note      none
  */
 uint8_t ds1302_set_reg(ds1302_handle_t *handle, uint8_t reg, uint8_t *buf, uint8_t len)
@@ -1503,7 +3538,14 @@ uint8_t ds1302_set_reg(ds1302_handle_t *handle, uint8_t reg, uint8_t *buf, uint8
     {
         return 3;                                                   /* return error */
     }
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)               /* check the pending transfer */
+    {
+        handle->debug_print("ds1302: xfer is pending.\n");          /* xfer is pending */
+        
+        return 6;                                                   /* return error */
+    }
     
+    handle->cache_valid = 0;                                        /* drop the anchor */
     if (a_ds1302_multiple_write(handle, reg, buf, len) != 0)        /* write data */
     {
         return 1;                                                   /* return error */
@@ -1523,6 +3565,7 @@ uint8_t ds1302_set_reg(ds1302_handle_t *handle, uint8_t reg, uint8_t *buf, uint8
  *             - 1 read failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 6 a transfer is pending
  * @note       none
  */
 uint8_t ds1302_get_reg(ds1302_handle_t *handle, uint8_t reg, uint8_t *buf, uint8_t len)
@@ -1535,6 +3578,12 @@ uint8_t ds1302_get_reg(ds1302_handle_t *handle, uint8_t reg, uint8_t *buf, uint8
     {
         return 3;                                                  /* return error */
     }
+    if (handle->xfer_state != DS1302_XFER_STATE_IDLE)              /* check the pending transfer */
+    {
+        handle->debug_print("ds1302: xfer is pending.\n");         /* xfer is pending */
+        
+        return 6;                                                  /* return error */
+    }
     
     if (a_ds1302_multiple_read(handle, reg, buf, len) != 0)        /* read data */
     {
@@ -1572,3 +3621,172 @@ uint8_t ds1302_info(ds1302_info_t *info)
     
     return 0;                                                       /* success return 0 */
 }
+
+/**
+ * @brief      convert a time to a unix timestamp
+ * @param[in]  *t pointer to a time structure
+ * @param[out] *timestamp pointer to a unix timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 time or timestamp is NULL
+ *             - 4 time is invalid
+ * @note       the time is taken as utc, 2000 <= year <= 2099, a date past the last day
+ *             of the month is invalid, integer arithmetic only, no libc time support and reentrant
+ */
+uint8_t ds1302_time_to_unix(ds1302_time_t *t, uint32_t *timestamp)
+{
+    uint16_t year;
+    uint8_t month;
+    uint8_t date;
+    
+    if ((t == NULL) || (timestamp == NULL))                                               /* check time and timestamp */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if ((t->year < 2000) || (t->year > 2099) || (t->month == 0) || (t->month > 12) ||
+        (t->date == 0) || (t->date > 31) || (t->minute > 59) || (t->second > 59))         /* check time */
+    {
+        return 4;                                                                         /* return error */
+    }
+    if (((t->format == DS1302_FORMAT_24H) && (t->hour > 23)) ||
+        ((t->format == DS1302_FORMAT_12H) && ((t->hour < 1) || (t->hour > 12))))          /* check hour */
+    {
+        return 4;                                                                         /* return error */
+    }
+    a_ds1302_civil_from_days(a_ds1302_days_from_civil(t->year, t->month, t->date), 
+                             &year, &month, &date);                                       /* round trip the date */
+    if ((month != t->month) || (date != t->date))                                         /* check the last day of the month */
+    {
+        return 4;                                                                         /* return error */
+    }
+    
+    *timestamp = a_ds1302_time_to_seconds(t) + DS1302_UNIX_2000;                          /* convert */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief      convert a unix timestamp to a time
+ * @param[in]  timestamp unix timestamp
+ * @param[in]  format hour format
+ * @param[out] *t pointer to a time structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 time is NULL
+ *             - 4 timestamp is invalid
+ * @note       the time is utc in 2000 - 2099, week is derived with monday as 1 and sunday as 7,
+ *             integer arithmetic only, no libc time support and reentrant
+ */
+uint8_t ds1302_unix_to_time(uint32_t timestamp, ds1302_format_t format, ds1302_time_t *t)
+{
+    uint32_t s;
+    
+    if (t == NULL)                                                                        /* check time */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if ((timestamp < DS1302_UNIX_2000) || (timestamp > DS1302_UNIX_2099))                 /* check timestamp */
+    {
+        return 4;                                                                         /* return error */
+    }
+    
+    s = timestamp - DS1302_UNIX_2000;                                                     /* seconds since 2000-01-01 */
+    a_ds1302_seconds_to_time(s, 0, DS1302_WEEK_2000, format, t);                          /* convert */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief      decode a clock burst to a compact timestamp
+ * @param[in]  *buf pointer to an 8 bytes clock burst buffer
+ * @param[out] *compact pointer to a compact timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 buf or compact is NULL
+ *             - 4 clock registers are invalid
+ * @note       all bcd fields are converted in parallel inside one 64 bits word,
+ *             compact is the seconds since 2000-01-01
+ */
+uint8_t ds1302_clock_burst_to_compact(uint8_t *buf, uint32_t *compact)
+{
+    uint64_t w;
+    uint32_t hour;
+    uint32_t month;
+    uint32_t date;
+    
+    if ((buf == NULL) || (compact == NULL))                                               /* check buf and compact */
+    {
+        return 2;                                                                         /* return error */
+    }
+    
+    w = a_ds1302_load64(buf) & (((buf[2] & (1 << 7)) != 0) ? DS1302_SWAR_MASK_12H : 
+                                                             DS1302_SWAR_MASK_24H);      /* mask the flags */
+    w = a_ds1302_bcd2hex_swar(w);                                                         /* all fields to binary */
+    hour = (uint32_t)(w >> 16) & 0xFF;                                                    /* get hour */
+    date = (uint32_t)(w >> 24) & 0xFF;                                                    /* get date */
+    month = (uint32_t)(w >> 32) & 0xFF;                                                   /* get month */
+    if ((month == 0) || (month > 12) || (date == 0) || (date > 31))                       /* check date */
+    {
+        return 4;                                                                         /* return error */
+    }
+    if ((buf[2] & (1 << 7)) != 0)                                                         /* if 12H */
+    {
+        hour = (hour % 12) + (((buf[2] >> 5) & 0x01) ? 12 : 0);                           /* convert to 24H */
+    }
+    *compact = a_ds1302_days_from_civil((uint16_t)(2000 + ((w >> 48) & 0xFF)), 
+                                        (uint8_t)month, (uint8_t)date) * 86400 + 
+               hour * 3600 + (uint32_t)((w >> 8) & 0xFF) * 60 + (uint32_t)(w & 0xFF);    /* set compact */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief         encode a compact timestamp to a clock burst
+ * @param[in]     compact seconds since 2000-01-01
+ * @param[in,out] *buf pointer to an 8 bytes clock burst buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 buf is NULL
+ *                - 4 compact is invalid
+ * @note          the registers are written in 24H format with the week derived from the date,
+ *                the ch bit of buf[0] and the control byte buf[7] are kept, so a clock burst read
+ *                before can be written back with ds1302_clock_burst_write
+ */
+uint8_t ds1302_compact_to_clock_burst(uint32_t compact, uint8_t *buf)
+{
+    uint64_t w;
+    uint32_t days;
+    uint32_t s;
+    uint16_t year;
+    uint8_t month;
+    uint8_t date;
+    uint8_t i;
+    
+    if (buf == NULL)                                                                      /* check buf */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (compact > DS1302_COMPACT_MAX)                                                     /* check compact */
+    {
+        return 4;                                                                         /* return error */
+    }
+    
+    days = compact / 86400;                                                               /* get days */
+    s = compact % 86400;                                                                  /* second of day */
+    a_ds1302_civil_from_days(days, &year, &month, &date);                                 /* get date */
+    w = (uint64_t)(s % 60) |                                                              /* second */
+        ((uint64_t)((s % 3600) / 60) << 8) |                                              /* minute */
+        ((uint64_t)(s / 3600) << 16) |                                                    /* hour */
+        ((uint64_t)date << 24) |                                                          /* date */
+        ((uint64_t)month << 32) |                                                         /* month */
+        ((uint64_t)((days + DS1302_WEEK_2000 - 1) % 7 + 1) << 40) |                       /* week */
+        ((uint64_t)(year - 2000) << 48);                                                  /* year */
+    w = a_ds1302_hex2bcd_swar(w);                                                         /* all fields to bcd */
+    buf[0] = (uint8_t)((buf[0] & (1 << 7)) | (w & 0x7F));                                 /* keep ch */
+    for (i = 1; i < 7; i++)                                                               /* other registers */
+    {
+        buf[i] = (uint8_t)(w >> (i * 8));                                                 /* set byte */
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
@@ -41,6 +41,35 @@
 #include <stdint.h>
 #include <string.h>
 
+/**
+ * @brief ds1302 stats definition
+ */
+#ifndef DS1302_ENABLE_STATS
+    #define DS1302_ENABLE_STATS        0         /**< set 1 to keep per handle bus statistics */
+#endif
+#define DS1302_STATS_HISTOGRAM_BINS    16        /**< log2 latency histogram bins */
+
+/**
+ * @brief ds1302 static port definition
+ */
+#ifndef DS1302_STATIC_PORT
+    #define DS1302_STATIC_PORT         0         /**< set 1 to inline the bit hooks of driver_ds1302_static_port.h */
+#endif
+
+/**
+ * @brief ds1302 transport definition
+ */
+#ifndef DS1302_DEFAULT_TRANSPORT
+    #define DS1302_DEFAULT_TRANSPORT   DS1302_TRANSPORT_GPIO    /**< transport of a freshly linked handle */
+#endif
+
+/**
+ * @brief ds1302 drift definition
+ */
+#ifndef DS1302_DRIFT_RAM_ADDR
+    #define DS1302_DRIFT_RAM_ADDR      21        /**< first of the 10 ram bytes that keep the drift coefficient */
+#endif
+
 #ifdef __cplusplus
 extern "C"{
 #endif
@@ -97,6 +126,26 @@ typedef enum
     DS1302_CHARGE_8K      = (3 << 0),        /**< 8k */
 } ds1302_charge_t;
 
+/**
+ * @brief ds1302 transport enumeration definition
+ */
+typedef enum
+{
+    DS1302_TRANSPORT_GPIO = 0x00,        /**< gpio bit-bang transport */
+    DS1302_TRANSPORT_BYTE = 0x01,        /**< byte transport */
+} ds1302_transport_t;
+
+/**
+ * @brief ds1302 xfer operation enumeration definition
+ */
+typedef enum
+{
+    DS1302_XFER_OP_CLOCK_BURST_READ  = 0x00,        /**< clock burst read */
+    DS1302_XFER_OP_CLOCK_BURST_WRITE = 0x01,        /**< clock burst write */
+    DS1302_XFER_OP_RAM_BURST_READ    = 0x02,        /**< ram burst read */
+    DS1302_XFER_OP_RAM_BURST_WRITE   = 0x03,        /**< ram burst write */
+} ds1302_xfer_op_t;
+
 /**
  * @brief ds1302 time structure definition
  */
@@ -113,25 +162,78 @@ typedef struct ds1302_time_s
     ds1302_am_pm_t am_pm;          /**< am pm */
 } ds1302_time_t;
 
+#if (DS1302_ENABLE_STATS == 1)
+/**
+ * @brief ds1302 stats structure definition
+ */
+typedef struct ds1302_stats_s
+{
+    uint32_t transactions;                                        /**< ce framed transfers */
+    uint32_t command_bytes;                                       /**< command bytes sent */
+    uint32_t data_bytes;                                          /**< data bytes sent or received */
+    uint32_t ce_cycles;                                           /**< ce rising edges */
+    uint32_t gpio_calls;                                          /**< gpio and transport callback invocations */
+    uint32_t failures;                                            /**< failed transfers */
+    uint32_t bus_time_us;                                         /**< summed transfer latency */
+    uint32_t latency_histogram[DS1302_STATS_HISTOGRAM_BINS];      /**< bin n counts latencies below 2^n us, the last bin the rest */
+} ds1302_stats_t;
+#endif
+
 /**
  * @brief ds1302 handle structure definition
  */
 typedef struct ds1302_handle_s
 {
-    uint8_t (*ce_gpio_init)(void);                          /**< point to a ce_gpio_init function address */
-    uint8_t (*ce_gpio_deinit)(void);                        /**< point to a ce_gpio_deinit function address */
-    uint8_t (*ce_gpio_write)(uint8_t value);                /**< point to a ce_gpio_write function address */
-    uint8_t (*sclk_gpio_init)(void);                        /**< point to an sclk_gpio_init function address */
-    uint8_t (*sclk_gpio_deinit)(void);                      /**< point to an sclk_gpio_deinit function address */
-    uint8_t (*sclk_gpio_write)(uint8_t value);              /**< point to an sclk_gpio_write function address */
-    uint8_t (*io_gpio_init)(void);                          /**< point to an io_gpio_init function address */
-    uint8_t (*io_gpio_deinit)(void);                        /**< point to an io_gpio_deinit function address */
-    uint8_t (*io_gpio_write)(uint8_t value);                /**< point to an io_gpio_write function address */
-    uint8_t (*io_gpio_read)(uint8_t *value);                /**< point to an io_gpio_read function address */
-    void (*debug_print)(const char *const fmt, ...);        /**< point to a debug_print function address */
-    void (*delay_ms)(uint32_t ms);                          /**< point to a delay_ms function address */
-    void (*delay_us)(uint32_t us);                          /**< point to a delay_us function address */
-    uint8_t inited;                                         /**< inited flag */
+    uint8_t (*ce_gpio_init)(void *ctx);                                        /**< point to a ce_gpio_init function address */
+    uint8_t (*ce_gpio_deinit)(void *ctx);                                      /**< point to a ce_gpio_deinit function address */
+    uint8_t (*ce_gpio_write)(void *ctx, uint8_t value);                        /**< point to a ce_gpio_write function address */
+    uint8_t (*sclk_gpio_init)(void *ctx);                                      /**< point to an sclk_gpio_init function address */
+    uint8_t (*sclk_gpio_deinit)(void *ctx);                                    /**< point to an sclk_gpio_deinit function address */
+    uint8_t (*sclk_gpio_write)(void *ctx, uint8_t value);                      /**< point to an sclk_gpio_write function address */
+    uint8_t (*io_gpio_init)(void *ctx);                                        /**< point to an io_gpio_init function address */
+    uint8_t (*io_gpio_deinit)(void *ctx);                                      /**< point to an io_gpio_deinit function address */
+    uint8_t (*io_gpio_write)(void *ctx, uint8_t value);                        /**< point to an io_gpio_write function address */
+    uint8_t (*io_gpio_read)(void *ctx, uint8_t *value);                        /**< point to an io_gpio_read function address */
+    uint8_t (*io_gpio_set_direction)(void *ctx, uint8_t output);               /**< point to an io_gpio_set_direction function address */
+    void (*debug_print)(const char *const fmt, ...);                           /**< point to a debug_print function address */
+    void (*delay_ms)(uint32_t ms);                                             /**< point to a delay_ms function address */
+    void (*delay_us)(uint32_t us);                                             /**< point to a delay_us function address */
+    uint8_t (*transport_begin)(void *ctx, uint8_t ce);                         /**< point to a transport_begin function address */
+    uint8_t (*transport_write_bytes)(void *ctx, uint8_t *buf, uint8_t len);    /**< point to a transport_write_bytes function address */
+    uint8_t (*transport_read_bytes)(void *ctx, uint8_t *buf, uint8_t len);     /**< point to a transport_read_bytes function address */
+    uint32_t (*timestamp_us)(void);                                            /**< point to a timestamp_us function address */
+    void *ctx;                                                                 /**< context passed to the gpio and transport functions */
+#if (DS1302_ENABLE_STATS == 1)
+    ds1302_stats_t stats;                                                      /**< bus statistics */
+#endif
+    uint8_t transport;                                                         /**< transport type */
+    uint8_t shared_lines;                                                      /**< sclk and io are owned by another handle */
+    uint8_t io_direction;                                                      /**< io direction */
+    uint8_t cache_enable;                                                      /**< time cache enable */
+    uint8_t cache_valid;                                                       /**< time cache valid flag */
+    uint8_t cache_week;                                                        /**< anchor week */
+    uint8_t cache_format;                                                      /**< anchor hour format */
+    uint32_t cache_interval_ms;                                                /**< time cache resync interval */
+    uint32_t cache_anchor_us;                                                  /**< anchor timestamp */
+    uint32_t cache_anchor_s;                                                   /**< anchor seconds since 2000-01-01 */
+    int32_t drift_ppb;                                                         /**< chip drift in ppb, positive runs fast */
+    uint32_t drift_ref_s;                                                      /**< seconds since 2000-01-01 when the chip was last right, 0xFFFFFFFF if none */
+    uint32_t drift_start_us;                                                   /**< drift measure start timestamp */
+    uint32_t drift_start_s;                                                    /**< drift measure start chip seconds */
+    uint8_t drift_started;                                                     /**< drift measure started flag */
+    uint8_t drift_record;                                                      /**< drift record kept in ram flag */
+    void (*xfer_done)(struct ds1302_handle_s *handle, uint8_t res);            /**< point to a xfer done callback address */
+    uint8_t *xfer_buf;                                                         /**< xfer data buffer */
+#if (DS1302_ENABLE_STATS == 1)
+    uint32_t xfer_start_us;                                                    /**< xfer submit timestamp */
+#endif
+    uint8_t xfer_len;                                                          /**< xfer data length */
+    uint8_t xfer_command;                                                      /**< xfer command byte */
+    uint8_t xfer_state;                                                        /**< xfer state */
+    uint8_t xfer_index;                                                        /**< xfer byte index, 0 is the command */
+    uint8_t xfer_bit;                                                          /**< xfer bit index */
+    uint8_t xfer_byte;                                                         /**< xfer shift byte */
+    uint8_t inited;                                                            /**< inited flag */
 } ds1302_handle_t;
 
 /**
@@ -165,9 +267,11 @@ typedef struct ds1302_info_s
  * @brief     initialize ds1302_handle_t structure
  * @param[in] HANDLE pointer to a ds1302 handle structure
  * @param[in] STRUCTURE ds1302_handle_t
- * @note      none
+ * @note      the transport starts as DS1302_DEFAULT_TRANSPORT, a port without gpio bit-banging sets it to
+ *            DS1302_TRANSPORT_BYTE in its build flags
  */
-#define DRIVER_DS1302_LINK_INIT(HANDLE, STRUCTURE)          memset(HANDLE, 0, sizeof(STRUCTURE))
+#define DRIVER_DS1302_LINK_INIT(HANDLE, STRUCTURE)              do { memset(HANDLE, 0, sizeof(STRUCTURE));                         \
+                                                                     (HANDLE)->transport = (uint8_t)DS1302_DEFAULT_TRANSPORT; } while (0)
 
 /**
  * @brief     link ce_gpio_init function
@@ -175,7 +279,7 @@ typedef struct ds1302_info_s
  * @param[in] FUC pointer to a ce_gpio_init function address
  * @note      none
  */
-#define DRIVER_DS1302_LINK_CE_GPIO_INIT(HANDLE, FUC)        (HANDLE)->ce_gpio_init = FUC
+#define DRIVER_DS1302_LINK_CE_GPIO_INIT(HANDLE, FUC)            (HANDLE)->ce_gpio_init = FUC
 
 /**
  * @brief     link ce_gpio_deinit function
@@ -183,7 +287,7 @@ typedef struct ds1302_info_s
  * @param[in] FUC pointer to a ce_gpio_deinit function address
  * @note      none
  */
-#define DRIVER_DS1302_LINK_CE_GPIO_DEINIT(HANDLE, FUC)      (HANDLE)->ce_gpio_deinit = FUC
+#define DRIVER_DS1302_LINK_CE_GPIO_DEINIT(HANDLE, FUC)          (HANDLE)->ce_gpio_deinit = FUC
 
 /**
  * @brief     link ce_gpio_write function
@@ -191,7 +295,7 @@ typedef struct ds1302_info_s
  * @param[in] FUC pointer to a ce_gpio_write function address
  * @note      none
  */
-#define DRIVER_DS1302_LINK_CE_GPIO_WRITE(HANDLE, FUC)       (HANDLE)->ce_gpio_write = FUC
+#define DRIVER_DS1302_LINK_CE_GPIO_WRITE(HANDLE, FUC)           (HANDLE)->ce_gpio_write = FUC
 
 /**
  * @brief     link sclk_gpio_init function
@@ -199,7 +303,7 @@ typedef struct ds1302_info_s
  * @param[in] FUC pointer to a sclk_gpio_init function address
  * @note      none
  */
-#define DRIVER_DS1302_LINK_SCLK_GPIO_INIT(HANDLE, FUC)      (HANDLE)->sclk_gpio_init = FUC
+#define DRIVER_DS1302_LINK_SCLK_GPIO_INIT(HANDLE, FUC)          (HANDLE)->sclk_gpio_init = FUC
 
 /**
  * @brief     link sclk_gpio_deinit function
@@ -207,7 +311,7 @@ typedef struct ds1302_info_s
  * @param[in] FUC pointer to a sclk_gpio_deinit function address
  * @note      none
  */
-#define DRIVER_DS1302_LINK_SCLK_GPIO_DEINIT(HANDLE, FUC)    (HANDLE)->sclk_gpio_deinit = FUC
+#define DRIVER_DS1302_LINK_SCLK_GPIO_DEINIT(HANDLE, FUC)        (HANDLE)->sclk_gpio_deinit = FUC
 
 /**
  * @brief     link sclk_gpio_write function
@@ -215,7 +319,7 @@ typedef struct ds1302_info_s
  * @param[in] FUC pointer to a sclk_gpio_write function address
  * @note      none
  */
-#define DRIVER_DS1302_LINK_SCLK_GPIO_WRITE(HANDLE, FUC)     (HANDLE)->sclk_gpio_write = FUC
+#define DRIVER_DS1302_LINK_SCLK_GPIO_WRITE(HANDLE, FUC)         (HANDLE)->sclk_gpio_write = FUC
 
 /**
  * @brief     link io_gpio_init function
@@ -223,7 +327,7 @@ typedef struct ds1302_info_s
  * @param[in] FUC pointer to a io_gpio_init function address
  * @note      none
  */
-#define DRIVER_DS1302_LINK_IO_GPIO_INIT(HANDLE, FUC)        (HANDLE)->io_gpio_init = FUC
+#define DRIVER_DS1302_LINK_IO_GPIO_INIT(HANDLE, FUC)            (HANDLE)->io_gpio_init = FUC
 
 /**
  * @brief     link io_gpio_deinit function
@@ -231,7 +335,7 @@ typedef struct ds1302_info_s
  * @param[in] FUC pointer to a io_gpio_deinit function address
  * @note      none
  */
-#define DRIVER_DS1302_LINK_IO_GPIO_DEINIT(HANDLE, FUC)      (HANDLE)->io_gpio_deinit = FUC
+#define DRIVER_DS1302_LINK_IO_GPIO_DEINIT(HANDLE, FUC)          (HANDLE)->io_gpio_deinit = FUC
 
 /**
  * @brief     link io_gpio_write function
@@ -239,7 +343,7 @@ typedef struct ds1302_info_s
  * @param[in] FUC pointer to a io_gpio_write function address
  * @note      none
  */
-#define DRIVER_DS1302_LINK_IO_GPIO_WRITE(HANDLE, FUC)       (HANDLE)->io_gpio_write = FUC
+#define DRIVER_DS1302_LINK_IO_GPIO_WRITE(HANDLE, FUC)           (HANDLE)->io_gpio_write = FUC
 
 /**
  * @brief     link io_gpio_read function
@@ -247,7 +351,15 @@ typedef struct ds1302_info_s
  * @param[in] FUC pointer to a io_gpio_read function address
  * @note      none
  */
-#define DRIVER_DS1302_LINK_IO_GPIO_READ(HANDLE, FUC)        (HANDLE)->io_gpio_read = FUC
+#define DRIVER_DS1302_LINK_IO_GPIO_READ(HANDLE, FUC)            (HANDLE)->io_gpio_read = FUC
+
+/**
+ * @brief     link io_gpio_set_direction function
+ * @param[in] HANDLE pointer to a ds1302 handle structure
+ * @param[in] FUC pointer to an io_gpio_set_direction function address
+ * @note      optional, when linked io_gpio_read and io_gpio_write only access the level
+ */
+#define DRIVER_DS1302_LINK_IO_GPIO_SET_DIRECTION(HANDLE, FUC)   (HANDLE)->io_gpio_set_direction = FUC
 
 /**
  * @brief     link debug_print function
@@ -255,7 +367,7 @@ typedef struct ds1302_info_s
  * @param[in] FUC pointer to a debug_print function address
  * @note      none
  */
-#define DRIVER_DS1302_LINK_DEBUG_PRINT(HANDLE, FUC)         (HANDLE)->debug_print = FUC
+#define DRIVER_DS1302_LINK_DEBUG_PRINT(HANDLE, FUC)             (HANDLE)->debug_print = FUC
 
 /**
  * @brief     link delay_ms function
@@ -263,7 +375,7 @@ typedef struct ds1302_info_s
  * @param[in] FUC pointer to a delay_ms function address
  * @note      none
  */
-#define DRIVER_DS1302_LINK_DELAY_MS(HANDLE, FUC)            (HANDLE)->delay_ms = FUC
+#define DRIVER_DS1302_LINK_DELAY_MS(HANDLE, FUC)                (HANDLE)->delay_ms = FUC
 
 /**
  * @brief     link delay_us function
@@ -271,7 +383,48 @@ typedef struct ds1302_info_s
  * @param[in] FUC pointer to a delay_us function address
  * @note      none
  */
-#define DRIVER_DS1302_LINK_DELAY_US(HANDLE, FUC)            (HANDLE)->delay_us = FUC
+#define DRIVER_DS1302_LINK_DELAY_US(HANDLE, FUC)                (HANDLE)->delay_us = FUC
+
+/**
+ * @brief     link transport_begin function
+ * @param[in] HANDLE pointer to a ds1302 handle structure
+ * @param[in] FUC pointer to a transport_begin function address
+ * @note      none
+ */
+#define DRIVER_DS1302_LINK_TRANSPORT_BEGIN(HANDLE, FUC)         (HANDLE)->transport_begin = FUC
+
+/**
+ * @brief     link transport_write_bytes function
+ * @param[in] HANDLE pointer to a ds1302 handle structure
+ * @param[in] FUC pointer to a transport_write_bytes function address
+ * @note      none
+ */
+#define DRIVER_DS1302_LINK_TRANSPORT_WRITE_BYTES(HANDLE, FUC)   (HANDLE)->transport_write_bytes = FUC
+
+/**
+ * @brief     link transport_read_bytes function
+ * @param[in] HANDLE pointer to a ds1302 handle structure
+ * @param[in] FUC pointer to a transport_read_bytes function address
+ * @note      none
+ */
+#define DRIVER_DS1302_LINK_TRANSPORT_READ_BYTES(HANDLE, FUC)    (HANDLE)->transport_read_bytes = FUC
+
+/**
+ * @brief     link timestamp_us function
+ * @param[in] HANDLE pointer to a ds1302 handle structure
+ * @param[in] FUC pointer to a timestamp_us function address
+ * @note      optional, only used for the latency statistics
+ */
+#define DRIVER_DS1302_LINK_TIMESTAMP_US(HANDLE, FUC)            (HANDLE)->timestamp_us = FUC
+
+/**
+ * @brief     link the chip context
+ * @param[in] HANDLE pointer to a ds1302 handle structure
+ * @param[in] CTX pointer to a context
+ * @note      optional, the context is passed as the first argument of every gpio and transport function,
+ *            so one port can tell several chips apart, it stays NULL for a single chip
+ */
+#define DRIVER_DS1302_LINK_CONTEXT(HANDLE, CTX)                 (HANDLE)->ctx = CTX
 
 /**
  * @}
@@ -294,6 +447,132 @@ typedef struct ds1302_info_s
  */
 uint8_t ds1302_info(ds1302_info_t *info);
 
+/**
+ * @brief      convert a time to a unix timestamp
+ * @param[in]  *t pointer to a time structure
+ * @param[out] *timestamp pointer to a unix timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 time or timestamp is NULL
+ *             - 4 time is invalid
+ * @note       the time is taken as utc, 2000 <= year <= 2099, a date past the last day
+ *             of the month is invalid, integer arithmetic only, no libc time support and reentrant
+ */
+uint8_t ds1302_time_to_unix(ds1302_time_t *t, uint32_t *timestamp);
+
+/**
+ * @brief      convert a unix timestamp to a time
+ * @param[in]  timestamp unix timestamp
+ * @param[in]  format hour format
+ * @param[out] *t pointer to a time structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 time is NULL
+ *             - 4 timestamp is invalid
+ * @note       the time is utc in 2000 - 2099, week is derived with monday as 1 and sunday as 7,
+ *             integer arithmetic only, no libc time support and reentrant
+ */
+uint8_t ds1302_unix_to_time(uint32_t timestamp, ds1302_format_t format, ds1302_time_t *t);
+
+/**
+ * @brief      decode a clock burst to a compact timestamp
+ * @param[in]  *buf pointer to an 8 bytes clock burst buffer
+ * @param[out] *compact pointer to a compact timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 buf or compact is NULL
+ *             - 4 clock registers are invalid
+ * @note       all bcd fields are converted in parallel inside one 64 bits word,
+ *             compact is the seconds since 2000-01-01
+ */
+uint8_t ds1302_clock_burst_to_compact(uint8_t *buf, uint32_t *compact);
+
+/**
+ * @brief         encode a compact timestamp to a clock burst
+ * @param[in]     compact seconds since 2000-01-01
+ * @param[in,out] *buf pointer to an 8 bytes clock burst buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 buf is NULL
+ *                - 4 compact is invalid
+ * @note          the registers are written in 24H format with the week derived from the date,
+ *                the ch bit of buf[0] and the control byte buf[7] are kept, so a clock burst read
+ *                before can be written back with ds1302_clock_burst_write
+ */
+uint8_t ds1302_compact_to_clock_burst(uint32_t compact, uint8_t *buf);
+
+/**
+ * @brief     set the bus transport
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] transport bus transport
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      DS1302_TRANSPORT_GPIO bit-bangs the bus with the gpio callbacks,
+ *            DS1302_TRANSPORT_BYTE hands whole lsb first bytes to the transport callbacks,
+ *            it must be set before ds1302_init
+ */
+uint8_t ds1302_set_transport(ds1302_handle_t *handle, ds1302_transport_t transport);
+
+/**
+ * @brief      get the bus transport
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *transport pointer to a bus transport buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t ds1302_get_transport(ds1302_handle_t *handle, ds1302_transport_t *transport);
+
+/**
+ * @brief     set the shared lines flag
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      when enabled ds1302_init and ds1302_deinit leave the sclk and io lines alone
+ *            because another handle owns them, it must be set before ds1302_init
+ */
+uint8_t ds1302_set_shared_lines(ds1302_handle_t *handle, ds1302_bool_t enable);
+
+/**
+ * @brief      get the shared lines flag
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t ds1302_get_shared_lines(ds1302_handle_t *handle, ds1302_bool_t *enable);
+
+#if (DS1302_ENABLE_STATS == 1)
+/**
+ * @brief      get the bus statistics
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *stats pointer to a stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       latencies are only recorded when timestamp_us is linked
+ */
+uint8_t ds1302_get_stats(ds1302_handle_t *handle, ds1302_stats_t *stats);
+
+/**
+ * @brief     reset the bus statistics
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ds1302_reset_stats(ds1302_handle_t *handle);
+#endif
+
 /**
  * @brief     initialize the chip
  * @param[in] *handle pointer to a ds1302 handle structure
@@ -314,7 +593,8 @@ uint8_t ds1302_init(ds1302_handle_t *handle);
  *            - 1 gpio deinit failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 6 a transfer is pending
+ * @note      abort a pending transfer with ds1302_xfer_abort first
  */
 uint8_t ds1302_deinit(ds1302_handle_t *handle);
 
@@ -328,7 +608,11 @@ uint8_t ds1302_deinit(ds1302_handle_t *handle);
  *            - 2 handle or time is NULL
  *            - 3 handle is not initialized
  *            - 4 time is invalid
- * @note      none
+ *            - 6 a transfer is pending
+ * @note      the clock is written in one 8 byte clock burst which keeps the ch bit,
+ *            if write protect is enabled it is cleared first and restored by the
+ *            control byte of the same burst, a drift record in ram is rewritten with
+ *            the new reference before write protect is restored
  */
 uint8_t ds1302_set_time(ds1302_handle_t *handle, ds1302_time_t *t);
 
@@ -341,10 +625,232 @@ uint8_t ds1302_set_time(ds1302_handle_t *handle, ds1302_time_t *t);
  *             - 1 get time failed
  *             - 2 handle or time is NULL
  *             - 3 handle is not initialized
- * @note       none
+ *             - 6 a transfer is pending
+ * @note       all seven clock registers are fetched in one clock burst
  */
 uint8_t ds1302_get_time(ds1302_handle_t *handle, ds1302_time_t *t);
 
+/**
+ * @brief      get a coherent time snapshot
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *t pointer to a time structure
+ * @param[out] *rollover pointer to a rollover flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get time snapshot failed
+ *             - 2 handle, time or rollover is NULL
+ *             - 3 handle is not initialized
+ *             - 6 a transfer is pending
+ * @note       the snapshot is taken in one clock burst, so it never tears across registers;
+ *             when the chip seconds read 59 the second register is read once more and rollover
+ *             is set if the minute has already turned over after the snapshot,
+ *             the drift correction is applied to the returned time only, like ds1302_get_time
+ */
+uint8_t ds1302_get_time_snapshot(ds1302_handle_t *handle, ds1302_time_t *t, ds1302_bool_t *rollover);
+
+/**
+ * @brief      get the current time as a compact timestamp
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *compact pointer to a compact timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get compact time failed
+ *             - 2 handle or compact is NULL
+ *             - 3 handle is not initialized
+ *             - 6 a transfer is pending
+ * @note       compact is the seconds since 2000-01-01, add 946684800 for unix time,
+ *             the 8 byte clock burst is decoded in one 64 bits word and the drift correction
+ *             is applied, the time cache is not used
+ */
+uint8_t ds1302_get_compact_time(ds1302_handle_t *handle, uint32_t *compact);
+
+/**
+ * @brief     set the time from a compact timestamp
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] compact seconds since 2000-01-01
+ * @return    status code
+ *            - 0 success
+ *            - 1 set compact time failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 compact is invalid
+ *            - 6 a transfer is pending
+ * @note      the clock is written in 24H format with the week derived from the date,
+ *            ch and write protect are kept like ds1302_set_time
+ */
+uint8_t ds1302_set_compact_time(ds1302_handle_t *handle, uint32_t compact);
+
+/**
+ * @brief     enable or disable the time cache
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 timestamp_us is not linked
+ * @note      when enabled ds1302_get_time reads the chip once, anchors it to timestamp_us and
+ *            extrapolates later reads until the resync interval elapses,
+ *            the cached time follows the chip within one second
+ */
+uint8_t ds1302_set_time_cache(ds1302_handle_t *handle, ds1302_bool_t enable);
+
+/**
+ * @brief      get the time cache status
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1302_get_time_cache(ds1302_handle_t *handle, ds1302_bool_t *enable);
+
+/**
+ * @brief     set the time cache resync interval
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] ms resync interval in ms
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 ms is invalid
+ * @note      1 <= ms <= 3600000, default is 1000
+ */
+uint8_t ds1302_set_time_cache_interval(ds1302_handle_t *handle, uint32_t ms);
+
+/**
+ * @brief      get the time cache resync interval
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *ms pointer to an interval buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1302_get_time_cache_interval(ds1302_handle_t *handle, uint32_t *ms);
+
+/**
+ * @brief     resync the time cache with the chip
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 sync time cache failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 time cache is disabled
+ *            - 6 a transfer is pending
+ * @note      none
+ */
+uint8_t ds1302_sync_time_cache(ds1302_handle_t *handle);
+
+/**
+ * @brief      find the seconds register rollover
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *timestamp_us pointer to an edge timestamp buffer
+ * @param[out] *resolution_us pointer to a resolution buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get second edge failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 timestamp_us is not linked
+ *             - 6 a transfer is pending
+ * @note       the second register is polled every 50ms until it changes, then polling
+ *             resumes every 1ms just before the next edge, so it takes up to 2s and
+ *             about 70 single register reads, the timestamp is the middle of the last two
+ *             reads and resolution is their distance, with the time cache enabled the
+ *             cache is anchored to the edge
+ */
+uint8_t ds1302_get_second_edge(ds1302_handle_t *handle, uint32_t *timestamp_us, uint32_t *resolution_us);
+
+/**
+ * @brief     set the drift coefficient
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] ppb chip drift in ppb, positive runs fast
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      ds1302_get_time subtracts the drift accumulated since the last ds1302_set_time,
+ *            until ds1302_set_time, ds1302_set_compact_time or ds1302_load_drift gives a
+ *            reference no correction is applied
+ */
+uint8_t ds1302_set_drift(ds1302_handle_t *handle, int32_t ppb);
+
+/**
+ * @brief      get the drift coefficient
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *ppb pointer to a ppb buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1302_get_drift(ds1302_handle_t *handle, int32_t *ppb);
+
+/**
+ * @brief     start the drift measure
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start drift measure failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 timestamp_us is not linked
+ *            - 6 a transfer is pending
+ * @note      a second edge is captured against timestamp_us
+ */
+uint8_t ds1302_start_drift_measure(ds1302_handle_t *handle);
+
+/**
+ * @brief      get the drift measure
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *ppb pointer to a ppb buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get drift measure failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 measure is not started
+ *             - 6 a transfer is pending
+ * @note       every call captures one more second edge and compares it with the start edge,
+ *             so the estimate improves with the window, the window must stay below 4000s
+ *             for the 32 bits timestamp_us, at 1ms edge resolution 1000s give about 1ppm
+ */
+uint8_t ds1302_get_drift_measure(ds1302_handle_t *handle, int32_t *ppb);
+
+/**
+ * @brief     save the drift coefficient to the chip ram
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 save drift failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 6 a transfer is pending
+ * @note      the coefficient and its reference are kept with a crc8 in ram from
+ *            DS1302_DRIFT_RAM_ADDR, write protect must be disabled, once saved or loaded
+ *            the record is rewritten by every ds1302_set_time and ds1302_set_compact_time
+ */
+uint8_t ds1302_save_drift(ds1302_handle_t *handle);
+
+/**
+ * @brief     load the drift coefficient from the chip ram
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 load drift failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 6 a transfer is pending
+ * @note      a bad magic or crc8 leaves the coefficient unchanged
+ */
+uint8_t ds1302_load_drift(ds1302_handle_t *handle);
+
 /**
  * @brief     enable or disable the oscillator
  * @param[in] *handle pointer to a ds1302 handle structure
@@ -354,6 +860,7 @@ uint8_t ds1302_get_time(ds1302_handle_t *handle, ds1302_time_t *t);
  *            - 1 set oscillator failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 6 a transfer is pending
  * @note      none
  */
 uint8_t ds1302_set_oscillator(ds1302_handle_t *handle, ds1302_bool_t enable);
@@ -367,6 +874,7 @@ uint8_t ds1302_set_oscillator(ds1302_handle_t *handle, ds1302_bool_t enable);
  *             - 1 get oscillator failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 6 a transfer is pending
  * @note       none
  */
 uint8_t ds1302_get_oscillator(ds1302_handle_t *handle, ds1302_bool_t *enable);
@@ -380,6 +888,7 @@ uint8_t ds1302_get_oscillator(ds1302_handle_t *handle, ds1302_bool_t *enable);
  *            - 1 set write protect failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 6 a transfer is pending
  * @note      none
  */
 uint8_t ds1302_set_write_protect(ds1302_handle_t *handle, ds1302_bool_t enable);
@@ -393,6 +902,7 @@ uint8_t ds1302_set_write_protect(ds1302_handle_t *handle, ds1302_bool_t enable);
  *             - 1 get write protect failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 6 a transfer is pending
  * @note       none
  */
 uint8_t ds1302_get_write_protect(ds1302_handle_t *handle, ds1302_bool_t *enable);
@@ -406,6 +916,7 @@ uint8_t ds1302_get_write_protect(ds1302_handle_t *handle, ds1302_bool_t *enable)
  *            - 1 set charge failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 6 a transfer is pending
  * @note      none
  */
 uint8_t ds1302_set_charge(ds1302_handle_t *handle, uint8_t charge);
@@ -419,6 +930,7 @@ uint8_t ds1302_set_charge(ds1302_handle_t *handle, uint8_t charge);
  *             - 1 get charge failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 6 a transfer is pending
  * @note       none
  */
 uint8_t ds1302_get_charge(ds1302_handle_t *handle, uint8_t *charge);
@@ -436,6 +948,7 @@ uint8_t ds1302_get_charge(ds1302_handle_t *handle, uint8_t *charge);
  *             - 3 handle is not initialized
  *             - 4 addr > 30
  *             - 5 len is invalid
+ *             - 6 a transfer is pending
  * @note       none
  */
 uint8_t ds1302_read_ram(ds1302_handle_t *handle, uint8_t addr, uint8_t *buf, uint8_t len);
@@ -453,6 +966,7 @@ uint8_t ds1302_read_ram(ds1302_handle_t *handle, uint8_t addr, uint8_t *buf, uin
  *            - 3 handle is not initialized
  *            - 4 addr > 30
  *            - 5 len is invalid
+ *            - 6 a transfer is pending
  * @note      none
  */
 uint8_t ds1302_write_ram(ds1302_handle_t *handle, uint8_t addr, uint8_t *buf, uint8_t len);
@@ -479,6 +993,7 @@ uint8_t ds1302_write_ram(ds1302_handle_t *handle, uint8_t addr, uint8_t *buf, ui
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 len > 8
+ *            - 6 a transfer is pending
  * @note      none
  */
 uint8_t ds1302_clock_burst_write(ds1302_handle_t *handle, uint8_t *buf, uint8_t len);
@@ -494,6 +1009,7 @@ uint8_t ds1302_clock_burst_write(ds1302_handle_t *handle, uint8_t *buf, uint8_t
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 len > 8
+ *             - 6 a transfer is pending
  * @note       none
  */
 uint8_t ds1302_clock_burst_read(ds1302_handle_t *handle, uint8_t *buf, uint8_t len);
@@ -509,6 +1025,7 @@ uint8_t ds1302_clock_burst_read(ds1302_handle_t *handle, uint8_t *buf, uint8_t l
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 len > 31
+ *            - 6 a transfer is pending
  * @note      none
  */
 uint8_t ds1302_ram_burst_write(ds1302_handle_t *handle, uint8_t *buf, uint8_t len);
@@ -524,10 +1041,72 @@ uint8_t ds1302_ram_burst_write(ds1302_handle_t *handle, uint8_t *buf, uint8_t le
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 len > 31
+ *             - 6 a transfer is pending
  * @note       none
  */
 uint8_t ds1302_ram_burst_read(ds1302_handle_t *handle, uint8_t *buf, uint8_t len);
 
+/**
+ * @brief     submit a non-blocking transfer
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] op transfer operation
+ * @param[in] *buf pointer to a data buffer, it must stay valid until done runs
+ * @param[in] len data buffer length
+ * @param[in] *done pointer to a done callback, res is 0 on success and 1 on failure, it can be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 a transfer is pending, op is invalid or len > 8 for clock and len > 31 for ram
+ * @note      nothing touches the bus until ds1302_xfer_step is called, done runs from
+ *            the last step and may submit the next transfer, blocking calls return 6
+ *            while a transfer is pending
+ */
+uint8_t ds1302_xfer_submit(ds1302_handle_t *handle, ds1302_xfer_op_t op, uint8_t *buf, uint8_t len,
+                           void (*done)(ds1302_handle_t *handle, uint8_t res));
+
+/**
+ * @brief     move the pending transfer forward by one step
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 step failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 no transfer is pending
+ * @note      with DS1302_TRANSPORT_GPIO a step is one sclk edge, with DS1302_TRANSPORT_BYTE
+ *            one byte, it never delays and prints nothing so a timer isr or an rtos tick
+ *            can call it, the steps must be at least 1us apart, a failed step drops ce and
+ *            runs done with 1
+ */
+uint8_t ds1302_xfer_step(ds1302_handle_t *handle);
+
+/**
+ * @brief     abort the pending transfer
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 abort failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 no transfer is pending
+ * @note      ce is dropped and done runs with 1, an aborted clock burst write may have
+ *            left the registers unchanged
+ */
+uint8_t ds1302_xfer_abort(ds1302_handle_t *handle);
+
+/**
+ * @brief      get the transfer status
+ * @param[in]  *handle pointer to a ds1302 handle structure
+ * @param[out] *busy pointer to a busy buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1302_xfer_get_busy(ds1302_handle_t *handle, ds1302_bool_t *busy);
+
 /**
  * @}
  */
@@ -550,6 +1129,7 @@ uint8_t ds1302_ram_burst_read(ds1302_handle_t *handle, uint8_t *buf, uint8_t len
  *            - 1 write failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 6 a transfer is pending
  * @note      none
  */
 uint8_t ds1302_set_reg(ds1302_handle_t *handle, uint8_t reg, uint8_t *buf, uint8_t len);
@@ -565,6 +1145,7 @@ uint8_t ds1302_set_reg(ds1302_handle_t *handle, uint8_t reg, uint8_t *buf, uint8
  *             - 1 read failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 6 a transfer is pending
  * @note       none
  */
 uint8_t ds1302_get_reg(ds1302_handle_t *handle, uint8_t reg, uint8_t *buf, uint8_t len);
@@ -0,0 +1,1174 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1302.hpp
+ * @brief     driver ds1302 c++ header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_DS1302_HPP
+#define DRIVER_DS1302_HPP
+
+#include "driver_ds1302.h"
+#include "driver_ds1302_interface.h"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+/**
+ * @defgroup ds1302_cpp_driver ds1302 c++ driver function
+ * @brief    ds1302 c++ driver modules, needs c++20 for concepts and std::span
+ * @ingroup  ds1302_driver
+ * @{
+ */
+
+namespace ds1302
+{
+
+/**
+ * @brief ds1302 register definition
+ */
+namespace reg
+{
+inline constexpr uint8_t second = 0 << 1;        /**< second register */
+inline constexpr uint8_t minute = 1 << 1;        /**< minute register */
+inline constexpr uint8_t hour = 2 << 1;          /**< hour register */
+inline constexpr uint8_t date = 3 << 1;          /**< date register */
+inline constexpr uint8_t month = 4 << 1;         /**< month register */
+inline constexpr uint8_t week = 5 << 1;          /**< week register */
+inline constexpr uint8_t year = 6 << 1;          /**< year register */
+inline constexpr uint8_t control = 7 << 1;       /**< control register */
+inline constexpr uint8_t charge = 8 << 1;        /**< charge register */
+inline constexpr uint8_t burst = 0x1F << 1;      /**< burst register */
+}
+
+/**
+ * @brief ds1302 command definition
+ */
+namespace command
+{
+inline constexpr uint8_t rtc = 0 << 6;           /**< rtc command */
+inline constexpr uint8_t ram = 1 << 6;           /**< ram command */
+}
+
+inline constexpr uint8_t clock_burst_len = 8;    /**< seven clock registers and the control register */
+inline constexpr uint8_t ram_len = 31;           /**< ram bytes */
+
+/**
+ * @brief     build a command byte
+ * @param[in] address command and register address
+ * @param[in] read true to read
+ * @return    command byte
+ * @note      none
+ */
+constexpr uint8_t make_command(uint8_t address, bool read) noexcept
+{
+    return static_cast<uint8_t>((1 << 7) | address | (read ? 0x01 : 0x00));
+}
+
+/**
+ * @brief     hex to bcd
+ * @param[in] val hex data
+ * @return    bcd data
+ * @note      none
+ */
+constexpr uint8_t hex2bcd(uint8_t val) noexcept
+{
+    return static_cast<uint8_t>(((val / 10) << 4) | (val % 10));
+}
+
+/**
+ * @brief     bcd to hex
+ * @param[in] val bcd data
+ * @return    hex data
+ * @note      none
+ */
+constexpr uint8_t bcd2hex(uint8_t val) noexcept
+{
+    return static_cast<uint8_t>(((val >> 4) & 0x0F) * 10 + (val & 0x0F));
+}
+
+static_assert(make_command(command::ram | reg::burst, true) == 0xFF, "ram burst read is 0xFF");
+static_assert(make_command(command::rtc | reg::burst, false) == 0xBE, "clock burst write is 0xBE");
+static_assert(hex2bcd(59) == 0x59, "hex2bcd");
+static_assert(bcd2hex(0x59) == 59, "bcd2hex");
+
+/**
+ * @brief     check a time
+ * @param[in] t time
+ * @return    true if the time can be written
+ * @note      the same ranges as ds1302_set_time
+ */
+constexpr bool check_time(const ds1302_time_t &t) noexcept
+{
+    if ((t.format != DS1302_FORMAT_12H) && (t.format != DS1302_FORMAT_24H))
+    {
+        return false;
+    }
+    if ((t.year < 2000) || (t.year > 2100) || (t.month == 0) || (t.month > 12) ||
+        (t.week == 0) || (t.week > 7) || (t.date == 0) || (t.date > 31) ||
+        (t.minute > 59) || (t.second > 59))
+    {
+        return false;
+    }
+    if (t.format == DS1302_FORMAT_12H)
+    {
+        return (t.hour >= 1) && (t.hour <= 12);
+    }
+    
+    return t.hour <= 23;
+}
+
+/**
+ * @brief     encode the clock registers
+ * @param[in] t checked time
+ * @return    second to year registers, the ch bit clear
+ * @note      none
+ */
+constexpr std::array<uint8_t, 7> encode_time(const ds1302_time_t &t) noexcept
+{
+    uint8_t hour = 0;
+    
+    if (t.format == DS1302_FORMAT_12H)
+    {
+        hour = static_cast<uint8_t>((1 << 7) | (t.am_pm << 5) | hex2bcd(t.hour));
+    }
+    else
+    {
+        hour = hex2bcd(t.hour);
+    }
+    
+    return {hex2bcd(t.second), hex2bcd(t.minute), hour, hex2bcd(t.date),
+            hex2bcd(t.month), hex2bcd(t.week), hex2bcd(static_cast<uint8_t>(t.year - 2000))};
+}
+
+/**
+ * @brief     decode the clock registers
+ * @param[in] buf second to year registers
+ * @return    time
+ * @note      the same masks as ds1302_get_time
+ */
+constexpr ds1302_time_t decode_time(std::span<const uint8_t, 7> buf) noexcept
+{
+    ds1302_time_t t{};
+    
+    t.year = static_cast<uint16_t>(bcd2hex(buf[6]) + 2000);
+    t.month = bcd2hex(buf[4] & 0x1F);
+    t.week = bcd2hex(buf[5] & 0x07);
+    t.date = bcd2hex(buf[3] & 0x3F);
+    t.am_pm = static_cast<ds1302_am_pm_t>((buf[2] >> 5) & 0x01);
+    t.format = static_cast<ds1302_format_t>((buf[2] >> 7) & 0x01);
+    t.hour = bcd2hex(buf[2] & ((t.format == DS1302_FORMAT_12H) ? 0x1F : 0x3F));
+    t.minute = bcd2hex(buf[1]);
+    t.second = bcd2hex(buf[0] & 0x7F);
+    
+    return t;
+}
+
+/**
+ * @brief ds1302 transport policy concept
+ * @note  write and read run one whole ce framed transaction, the command byte first,
+ *        all of them return the c driver status codes
+ */
+template <class T>
+concept transport_policy = requires(T t, uint8_t cmd, std::span<const uint8_t> out, std::span<uint8_t> in)
+{
+    { t.init() } -> std::same_as<uint8_t>;
+    { t.deinit() } -> std::same_as<uint8_t>;
+    { t.write(cmd, out) } -> std::same_as<uint8_t>;
+    { t.read(cmd, in) } -> std::same_as<uint8_t>;
+};
+
+/**
+ * @brief gpio bit-bang transport
+ * @note  Pins provides init, deinit, ce_write, sclk_write, io_write, io_read, io_output and delay_us,
+ *        an empty Pins with inline register accesses makes the whole bit loop inline
+ */
+template <class Pins>
+class gpio_transport
+{
+    public:
+        /**
+         * @brief     gpio transport constructor
+         * @param[in] pins pin accessors
+         * @note      none
+         */
+        explicit gpio_transport(Pins pins = Pins{}) : m_pins(std::move(pins))
+        {
+        }
+        
+        /**
+         * @brief  init the pins
+         * @return status code
+         *         - 0 success
+         *         - 1 init failed
+         * @note   none
+         */
+        uint8_t init()
+        {
+            return m_pins.init();
+        }
+        
+        /**
+         * @brief  deinit the pins
+         * @return status code
+         *         - 0 success
+         *         - 1 deinit failed
+         * @note   none
+         */
+        uint8_t deinit()
+        {
+            return m_pins.deinit();
+        }
+        
+        /**
+         * @brief     write transaction
+         * @param[in] cmd command byte
+         * @param[in] buf data bytes
+         * @return    status code
+         *            - 0 success
+         *            - 1 write failed
+         * @note      io is left low before ce drops
+         */
+        uint8_t write(uint8_t cmd, std::span<const uint8_t> buf)
+        {
+            if (m_pins.ce_write(true) != 0)
+            {
+                return 1;
+            }
+            if (m_pins.io_output(true) != 0)
+            {
+                return 1;
+            }
+            if (shift_out(cmd) != 0)
+            {
+                return 1;
+            }
+            for (uint8_t b : buf)
+            {
+                if (shift_out(b) != 0)
+                {
+                    return 1;
+                }
+            }
+            if (m_pins.io_write(false) != 0)
+            {
+                return 1;
+            }
+            
+            return m_pins.ce_write(false);
+        }
+        
+        /**
+         * @brief      read transaction
+         * @param[in]  cmd command byte
+         * @param[out] buf data bytes
+         * @return     status code
+         *             - 0 success
+         *             - 1 read failed
+         * @note       each bit is valid after the falling edge of sclk
+         */
+        uint8_t read(uint8_t cmd, std::span<uint8_t> buf)
+        {
+            if (m_pins.ce_write(true) != 0)
+            {
+                return 1;
+            }
+            if (m_pins.io_output(true) != 0)
+            {
+                return 1;
+            }
+            if (shift_out(cmd) != 0)
+            {
+                return 1;
+            }
+            if (m_pins.io_output(false) != 0)
+            {
+                return 1;
+            }
+            for (uint8_t &b : buf)
+            {
+                if (shift_in(b) != 0)
+                {
+                    return 1;
+                }
+            }
+            
+            return m_pins.ce_write(false);
+        }
+        
+    private:
+        /**
+         * @brief     shift one byte out lsb first
+         * @param[in] data byte
+         * @return    status code
+         *            - 0 success
+         *            - 1 shift failed
+         * @note      latched on the rising edge of sclk
+         */
+        uint8_t shift_out(uint8_t data)
+        {
+            for (uint8_t i = 0; i < 8; i++)
+            {
+                if (m_pins.io_write(((data >> i) & 0x01) != 0) != 0)
+                {
+                    return 1;
+                }
+                m_pins.delay_us(1);
+                if (m_pins.sclk_write(true) != 0)
+                {
+                    return 1;
+                }
+                m_pins.delay_us(1);
+                if (m_pins.sclk_write(false) != 0)
+                {
+                    return 1;
+                }
+            }
+            
+            return 0;
+        }
+        
+        /**
+         * @brief      shift one byte in lsb first
+         * @param[out] data byte
+         * @return     status code
+         *             - 0 success
+         *             - 1 shift failed
+         * @note       none
+         */
+        uint8_t shift_in(uint8_t &data)
+        {
+            bool level;
+            
+            data = 0;
+            for (uint8_t i = 0; i < 8; i++)
+            {
+                if (m_pins.io_read(level) != 0)
+                {
+                    return 1;
+                }
+                data |= static_cast<uint8_t>((level ? 1 : 0) << i);
+                if (m_pins.sclk_write(true) != 0)
+                {
+                    return 1;
+                }
+                m_pins.delay_us(1);
+                if (m_pins.sclk_write(false) != 0)
+                {
+                    return 1;
+                }
+            }
+            
+            return 0;
+        }
+        
+        Pins m_pins;        /**< pin accessors */
+};
+
+/**
+ * @brief interface pins
+ * @note  the ds1302_interface gpio functions called directly, any port or the simulator
+ */
+class interface_pins
+{
+    public:
+        /**
+         * @brief     interface pins constructor
+         * @param[in] *ctx pointer to a chip context
+         * @note      none
+         */
+        explicit interface_pins(void *ctx = nullptr) : m_ctx(ctx)
+        {
+        }
+        
+        /**
+         * @brief  init the pins
+         * @return status code
+         *         - 0 success
+         *         - 1 init failed
+         * @note   none
+         */
+        uint8_t init()
+        {
+            if (ds1302_interface_ce_gpio_init(m_ctx) != 0)
+            {
+                return 1;
+            }
+            if (ds1302_interface_sclk_gpio_init(m_ctx) != 0)
+            {
+                (void)ds1302_interface_ce_gpio_deinit(m_ctx);
+                
+                return 1;
+            }
+            if (ds1302_interface_io_gpio_init(m_ctx) != 0)
+            {
+                (void)ds1302_interface_ce_gpio_deinit(m_ctx);
+                (void)ds1302_interface_sclk_gpio_deinit(m_ctx);
+                
+                return 1;
+            }
+            
+            return 0;
+        }
+        
+        /**
+         * @brief  deinit the pins
+         * @return status code
+         *         - 0 success
+         *         - 1 deinit failed
+         * @note   none
+         */
+        uint8_t deinit()
+        {
+            uint8_t res;
+            
+            res = ds1302_interface_ce_gpio_deinit(m_ctx);
+            res |= ds1302_interface_sclk_gpio_deinit(m_ctx);
+            res |= ds1302_interface_io_gpio_deinit(m_ctx);
+            
+            return (res != 0) ? 1 : 0;
+        }
+        
+        /**
+         * @brief     write ce
+         * @param[in] value level
+         * @return    status code
+         * @note      none
+         */
+        uint8_t ce_write(bool value)
+        {
+            return ds1302_interface_ce_gpio_write(m_ctx, value ? 1 : 0);
+        }
+        
+        /**
+         * @brief     write sclk
+         * @param[in] value level
+         * @return    status code
+         * @note      none
+         */
+        uint8_t sclk_write(bool value)
+        {
+            return ds1302_interface_sclk_gpio_write(m_ctx, value ? 1 : 0);
+        }
+        
+        /**
+         * @brief     write io
+         * @param[in] value level
+         * @return    status code
+         * @note      none
+         */
+        uint8_t io_write(bool value)
+        {
+            return ds1302_interface_io_gpio_write(m_ctx, value ? 1 : 0);
+        }
+        
+        /**
+         * @brief      read io
+         * @param[out] value level
+         * @return     status code
+         * @note       none
+         */
+        uint8_t io_read(bool &value)
+        {
+            uint8_t level;
+            
+            if (ds1302_interface_io_gpio_read(m_ctx, &level) != 0)
+            {
+                return 1;
+            }
+            value = (level != 0);
+            
+            return 0;
+        }
+        
+        /**
+         * @brief     set the io direction
+         * @param[in] output true for output
+         * @return    status code
+         * @note      the callback only runs when the direction changes, like the c driver
+         */
+        uint8_t io_output(bool output)
+        {
+            uint8_t direction;
+            
+            direction = output ? 1 : 0;
+            if (m_direction == direction)
+            {
+                return 0;
+            }
+            if (ds1302_interface_io_gpio_set_direction(m_ctx, direction) != 0)
+            {
+                m_direction = 0xFF;
+                
+                return 1;
+            }
+            m_direction = direction;
+            
+            return 0;
+        }
+        
+        /**
+         * @brief     delay
+         * @param[in] us time
+         * @note      none
+         */
+        void delay_us(uint32_t us)
+        {
+            ds1302_interface_delay_us(us);
+        }
+        
+    private:
+        void *m_ctx;                     /**< chip context */
+        uint8_t m_direction = 0xFF;      /**< io direction, 0xFF is unknown */
+};
+
+/**
+ * @brief interface byte transport
+ * @note  the ds1302_interface transport functions, spidev on the raspberrypi4b with DS1302_SPIDEV,
+ *        spi1 or the bsrr wave engine on the stm32f407
+ */
+class byte_transport
+{
+    public:
+        /**
+         * @brief     byte transport constructor
+         * @param[in] *ctx pointer to a chip context
+         * @note      none
+         */
+        explicit byte_transport(void *ctx = nullptr) : m_pins(ctx), m_ctx(ctx)
+        {
+        }
+        
+        /**
+         * @brief  init the bus
+         * @return status code
+         *         - 0 success
+         *         - 1 init failed
+         * @note   none
+         */
+        uint8_t init()
+        {
+            return m_pins.init();
+        }
+        
+        /**
+         * @brief  deinit the bus
+         * @return status code
+         *         - 0 success
+         *         - 1 deinit failed
+         * @note   none
+         */
+        uint8_t deinit()
+        {
+            return m_pins.deinit();
+        }
+        
+        /**
+         * @brief     write transaction
+         * @param[in] cmd command byte
+         * @param[in] buf data bytes
+         * @return    status code
+         *            - 0 success
+         *            - 1 write failed
+         * @note      none
+         */
+        uint8_t write(uint8_t cmd, std::span<const uint8_t> buf)
+        {
+            uint8_t res;
+            
+            if (ds1302_interface_transport_begin(m_ctx, 1) != 0)
+            {
+                return 1;
+            }
+            res = ds1302_interface_transport_write_bytes(m_ctx, &cmd, 1);
+            if ((res == 0) && !buf.empty())
+            {
+                res = ds1302_interface_transport_write_bytes(m_ctx, const_cast<uint8_t *>(buf.data()),
+                                                             static_cast<uint8_t>(buf.size()));
+            }
+            if (ds1302_interface_transport_begin(m_ctx, 0) != 0)
+            {
+                return 1;
+            }
+            
+            return (res != 0) ? 1 : 0;
+        }
+        
+        /**
+         * @brief      read transaction
+         * @param[in]  cmd command byte
+         * @param[out] buf data bytes
+         * @return     status code
+         *             - 0 success
+         *             - 1 read failed
+         * @note       none
+         */
+        uint8_t read(uint8_t cmd, std::span<uint8_t> buf)
+        {
+            uint8_t res;
+            
+            if (ds1302_interface_transport_begin(m_ctx, 1) != 0)
+            {
+                return 1;
+            }
+            res = ds1302_interface_transport_write_bytes(m_ctx, &cmd, 1);
+            if (res == 0)
+            {
+                res = ds1302_interface_transport_read_bytes(m_ctx, buf.data(), static_cast<uint8_t>(buf.size()));
+            }
+            if (ds1302_interface_transport_begin(m_ctx, 0) != 0)
+            {
+                return 1;
+            }
+            
+            return (res != 0) ? 1 : 0;
+        }
+        
+    private:
+        interface_pins m_pins;        /**< pins for init and deinit */
+        void *m_ctx;                  /**< chip context */
+};
+
+/**
+ * @brief ds1302 c++ driver
+ * @note  the status codes follow the c driver, the time cache, the drift and the step api
+ *        stay in the c driver
+ */
+template <class Transport>
+    requires transport_policy<Transport>
+class Ds1302
+{
+    public:
+        /**
+         * @brief     ds1302 constructor
+         * @param[in] transport transport policy
+         * @note      none
+         */
+        explicit Ds1302(Transport transport = Transport{}) : m_transport(std::move(transport))
+        {
+        }
+        
+        /**
+         * @brief  initialize the chip
+         * @return status code
+         *         - 0 success
+         *         - 1 init failed
+         * @note   none
+         */
+        uint8_t init()
+        {
+            if (m_transport.init() != 0)
+            {
+                return 1;
+            }
+            m_inited = true;
+            
+            return 0;
+        }
+        
+        /**
+         * @brief  close the chip
+         * @return status code
+         *         - 0 success
+         *         - 1 deinit failed
+         *         - 3 handle is not initialized
+         * @note   none
+         */
+        uint8_t deinit()
+        {
+            if (!m_inited)
+            {
+                return 3;
+            }
+            if (m_transport.deinit() != 0)
+            {
+                return 1;
+            }
+            m_inited = false;
+            
+            return 0;
+        }
+        
+        /**
+         * @brief     set the current time
+         * @param[in] t time
+         * @return    status code
+         *            - 0 success
+         *            - 1 set time failed
+         *            - 3 handle is not initialized
+         *            - 4 time is invalid
+         * @note      one clock burst keeps the ch bit and restores the write protect bit,
+         *            a failed clock burst writes the saved control byte back
+         */
+        uint8_t set_time(const ds1302_time_t &t)
+        {
+            std::array<uint8_t, clock_burst_len> buf;
+            std::array<uint8_t, 7> regs;
+            
+            if (!m_inited)
+            {
+                return 3;
+            }
+            if (!check_time(t))
+            {
+                return 4;
+            }
+            if (clock_burst_read(buf) != 0)
+            {
+                return 1;
+            }
+            if ((buf[7] & (1 << 7)) != 0)
+            {
+                if (write_reg(command::rtc | reg::control, static_cast<uint8_t>(buf[7] & 0x7F)) != 0)
+                {
+                    return 1;
+                }
+            }
+            regs = encode_time(t);
+            regs[0] |= static_cast<uint8_t>(buf[0] & (1 << 7));
+            std::copy(regs.begin(), regs.end(), buf.begin());
+            if (clock_burst_write(buf) != 0)
+            {
+                if ((buf[7] & (1 << 7)) != 0)
+                {
+                    (void)write_reg(command::rtc | reg::control, buf[7]);
+                }
+                
+                return 1;
+            }
+            
+            return 0;
+        }
+        
+        /**
+         * @brief      get the current time
+         * @param[out] t time
+         * @return     status code
+         *             - 0 success
+         *             - 1 get time failed
+         *             - 3 handle is not initialized
+         * @note       all seven clock registers are fetched in one clock burst
+         */
+        uint8_t get_time(ds1302_time_t &t)
+        {
+            std::array<uint8_t, 7> buf;
+            
+            if (!m_inited)
+            {
+                return 3;
+            }
+            if (m_transport.read(make_command(command::rtc | reg::burst, true), buf) != 0)
+            {
+                return 1;
+            }
+            t = decode_time(buf);
+            
+            return 0;
+        }
+        
+        /**
+         * @brief     enable or disable the oscillator
+         * @param[in] enable bool value
+         * @return    status code
+         *            - 0 success
+         *            - 1 set oscillator failed
+         *            - 3 handle is not initialized
+         * @note      none
+         */
+        uint8_t set_oscillator(bool enable)
+        {
+            return update_bit(command::rtc | reg::second, !enable);
+        }
+        
+        /**
+         * @brief      get the oscillator status
+         * @param[out] enable bool value
+         * @return     status code
+         *             - 0 success
+         *             - 1 get oscillator failed
+         *             - 3 handle is not initialized
+         * @note       none
+         */
+        uint8_t get_oscillator(bool &enable)
+        {
+            uint8_t res;
+            bool halt;
+            
+            res = read_bit(command::rtc | reg::second, halt);
+            enable = !halt;
+            
+            return res;
+        }
+        
+        /**
+         * @brief     enable or disable write protect
+         * @param[in] enable bool value
+         * @return    status code
+         *            - 0 success
+         *            - 1 set write protect failed
+         *            - 3 handle is not initialized
+         * @note      none
+         */
+        uint8_t set_write_protect(bool enable)
+        {
+            return update_bit(command::rtc | reg::control, enable);
+        }
+        
+        /**
+         * @brief      get the write protect status
+         * @param[out] enable bool value
+         * @return     status code
+         *             - 0 success
+         *             - 1 get write protect failed
+         *             - 3 handle is not initialized
+         * @note       none
+         */
+        uint8_t get_write_protect(bool &enable)
+        {
+            return read_bit(command::rtc | reg::control, enable);
+        }
+        
+        /**
+         * @brief     set the charge
+         * @param[in] charge ds1302_charge_t bits
+         * @return    status code
+         *            - 0 success
+         *            - 1 set charge failed
+         *            - 3 handle is not initialized
+         * @note      none
+         */
+        uint8_t set_charge(uint8_t charge)
+        {
+            if (!m_inited)
+            {
+                return 3;
+            }
+            
+            return write_reg(command::rtc | reg::charge, charge);
+        }
+        
+        /**
+         * @brief      get the charge
+         * @param[out] charge ds1302_charge_t bits
+         * @return     status code
+         *             - 0 success
+         *             - 1 get charge failed
+         *             - 3 handle is not initialized
+         * @note       none
+         */
+        uint8_t get_charge(uint8_t &charge)
+        {
+            if (!m_inited)
+            {
+                return 3;
+            }
+            
+            return read_reg(command::rtc | reg::charge, charge);
+        }
+        
+        /**
+         * @brief      read ram
+         * @param[in]  addr ram address
+         * @param[out] buf data bytes
+         * @return     status code
+         *             - 0 success
+         *             - 1 read ram failed
+         *             - 3 handle is not initialized
+         *             - 4 addr is invalid
+         *             - 5 length is invalid
+         * @note       0 <= addr <= 30, one transaction per byte like ds1302_read_ram
+         */
+        uint8_t read_ram(uint8_t addr, std::span<uint8_t> buf)
+        {
+            if (!m_inited)
+            {
+                return 3;
+            }
+            if (addr > 30)
+            {
+                return 4;
+            }
+            if (addr + buf.size() > ram_len)
+            {
+                return 5;
+            }
+            for (uint8_t &b : buf)
+            {
+                if (read_reg(static_cast<uint8_t>(command::ram | (addr++ << 1)), b) != 0)
+                {
+                    return 1;
+                }
+            }
+            
+            return 0;
+        }
+        
+        /**
+         * @brief     write ram
+         * @param[in] addr ram address
+         * @param[in] buf data bytes
+         * @return    status code
+         *            - 0 success
+         *            - 1 write ram failed
+         *            - 3 handle is not initialized
+         *            - 4 addr is invalid
+         *            - 5 length is invalid
+         * @note      0 <= addr <= 30, one transaction per byte like ds1302_write_ram
+         */
+        uint8_t write_ram(uint8_t addr, std::span<const uint8_t> buf)
+        {
+            if (!m_inited)
+            {
+                return 3;
+            }
+            if (addr > 30)
+            {
+                return 4;
+            }
+            if (addr + buf.size() > ram_len)
+            {
+                return 5;
+            }
+            for (uint8_t b : buf)
+            {
+                if (write_reg(static_cast<uint8_t>(command::ram | (addr++ << 1)), b) != 0)
+                {
+                    return 1;
+                }
+            }
+            
+            return 0;
+        }
+        
+        /**
+         * @brief      clock burst read
+         * @param[out] buf second to year registers and the control register
+         * @return     status code
+         *             - 0 success
+         *             - 1 burst read failed
+         *             - 3 handle is not initialized
+         * @note       none
+         */
+        uint8_t clock_burst_read(std::span<uint8_t, clock_burst_len> buf)
+        {
+            if (!m_inited)
+            {
+                return 3;
+            }
+            
+            return m_transport.read(make_command(command::rtc | reg::burst, true), buf);
+        }
+        
+        /**
+         * @brief     clock burst write
+         * @param[in] buf second to year registers and the control register
+         * @return    status code
+         *            - 0 success
+         *            - 1 burst write failed
+         *            - 3 handle is not initialized
+         * @note      none
+         */
+        uint8_t clock_burst_write(std::span<const uint8_t, clock_burst_len> buf)
+        {
+            if (!m_inited)
+            {
+                return 3;
+            }
+            
+            return m_transport.write(make_command(command::rtc | reg::burst, false), buf);
+        }
+        
+        /**
+         * @brief      ram burst read
+         * @param[out] buf ram bytes
+         * @return     status code
+         *             - 0 success
+         *             - 1 burst read failed
+         *             - 3 handle is not initialized
+         * @note       the bytes land in buf without a copy
+         */
+        uint8_t ram_burst_read(std::span<uint8_t, ram_len> buf)
+        {
+            if (!m_inited)
+            {
+                return 3;
+            }
+            
+            return m_transport.read(make_command(command::ram | reg::burst, true), buf);
+        }
+        
+        /**
+         * @brief     ram burst write
+         * @param[in] buf ram bytes
+         * @return    status code
+         *            - 0 success
+         *            - 1 burst write failed
+         *            - 3 handle is not initialized
+         * @note      the bytes are shifted out of buf without a copy
+         */
+        uint8_t ram_burst_write(std::span<const uint8_t, ram_len> buf)
+        {
+            if (!m_inited)
+            {
+                return 3;
+            }
+            
+            return m_transport.write(make_command(command::ram | reg::burst, false), buf);
+        }
+        
+        /**
+         * @brief     set the chip register
+         * @param[in] address command and register address
+         * @param[in] buf data bytes
+         * @return    status code
+         *            - 0 success
+         *            - 1 write failed
+         *            - 3 handle is not initialized
+         * @note      one transaction, bursts need the burst address
+         */
+        uint8_t set_reg(uint8_t address, std::span<const uint8_t> buf)
+        {
+            if (!m_inited)
+            {
+                return 3;
+            }
+            
+            return m_transport.write(make_command(address, false), buf);
+        }
+        
+        /**
+         * @brief      get the chip register
+         * @param[in]  address command and register address
+         * @param[out] buf data bytes
+         * @return     status code
+         *             - 0 success
+         *             - 1 read failed
+         *             - 3 handle is not initialized
+         * @note       one transaction, bursts need the burst address
+         */
+        uint8_t get_reg(uint8_t address, std::span<uint8_t> buf)
+        {
+            if (!m_inited)
+            {
+                return 3;
+            }
+            
+            return m_transport.read(make_command(address, true), buf);
+        }
+        
+    private:
+        /**
+         * @brief     write one register
+         * @param[in] address command and register address
+         * @param[in] data byte
+         * @return    status code
+         * @note      none
+         */
+        uint8_t write_reg(uint8_t address, uint8_t data)
+        {
+            return (m_transport.write(make_command(address, false), std::span<const uint8_t, 1>(&data, 1)) != 0) ? 1 : 0;
+        }
+        
+        /**
+         * @brief      read one register
+         * @param[in]  address command and register address
+         * @param[out] data byte
+         * @return     status code
+         * @note       none
+         */
+        uint8_t read_reg(uint8_t address, uint8_t &data)
+        {
+            return (m_transport.read(make_command(address, true), std::span<uint8_t, 1>(&data, 1)) != 0) ? 1 : 0;
+        }
+        
+        /**
+         * @brief     update bit 7 of a register
+         * @param[in] address command and register address
+         * @param[in] set bit value
+         * @return    status code
+         * @note      none
+         */
+        uint8_t update_bit(uint8_t address, bool set)
+        {
+            uint8_t prev;
+            
+            if (!m_inited)
+            {
+                return 3;
+            }
+            if (read_reg(address, prev) != 0)
+            {
+                return 1;
+            }
+            prev = static_cast<uint8_t>((prev & 0x7F) | (set ? (1 << 7) : 0));
+            
+            return write_reg(address, prev);
+        }
+        
+        /**
+         * @brief      read bit 7 of a register
+         * @param[in]  address command and register address
+         * @param[out] set bit value
+         * @return     status code
+         * @note       none
+         */
+        uint8_t read_bit(uint8_t address, bool &set)
+        {
+            uint8_t prev;
+            
+            if (!m_inited)
+            {
+                return 3;
+            }
+            if (read_reg(address, prev) != 0)
+            {
+                return 1;
+            }
+            set = ((prev & (1 << 7)) != 0);
+            
+            return 0;
+        }
+        
+        Transport m_transport;        /**< transport policy */
+        bool m_inited = false;        /**< inited flag */
+};
+
+}
+
+/**
+ * @}
+ */
+
+#endif
@@ -0,0 +1,338 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1302_bus.c
+ * @brief     driver ds1302 bus source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds1302_bus.h"
+
+/**
+ * @brief     hand the shared lines to a chip
+ * @param[in] *bus pointer to a ds1302 bus structure
+ * @param[in] index chip index
+ * @note      every handle caches the io direction it last set, the cache is only
+ *            right for the shared line if it is carried over from the previous owner
+ */
+static void a_ds1302_bus_switch(ds1302_bus_t *bus, uint8_t index)
+{
+    bus->chip[index]->io_direction = bus->io_direction;           /* inherit the io direction */
+    bus->owner = index;                                           /* set the owner */
+}
+
+/**
+ * @brief     take the shared lines back from the owner
+ * @param[in] *bus pointer to a ds1302 bus structure
+ * @note      none
+ */
+static void a_ds1302_bus_return(ds1302_bus_t *bus)
+{
+    bus->io_direction = bus->chip[bus->owner]->io_direction;      /* save the io direction */
+    bus->owner = DS1302_BUS_OWNER_NONE;                           /* no owner */
+}
+
+/**
+ * @brief      attach a chip to the bus
+ * @param[in]  *bus pointer to a ds1302 bus structure
+ * @param[in]  *handle pointer to a linked but not initialized ds1302 handle structure
+ * @param[out] *index pointer to a chip index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 bus or handle is NULL
+ *             - 4 bus is full, already initialized or the handle is initialized
+ * @note       every handle links the shared sclk and io functions and its own ce and context,
+ *             every chip but chip 0 is flagged with ds1302_set_shared_lines so that its
+ *             init and deinit only touch its ce line
+ */
+uint8_t ds1302_bus_attach(ds1302_bus_t *bus, ds1302_handle_t *handle, uint8_t *index)
+{
+    if ((bus == NULL) || (handle == NULL))                        /* check bus and handle */
+    {
+        return 2;                                                 /* return error */
+    }
+    if ((bus->inited == 1) || (handle->inited == 1))              /* check initialization */
+    {
+        return 4;                                                 /* return error */
+    }
+    if (bus->count >= DS1302_BUS_MAX_CHIPS)                       /* check the count */
+    {
+        return 4;                                                 /* return error */
+    }
+    
+    (void)ds1302_set_shared_lines(handle, (bus->count == 0) ? DS1302_BOOL_FALSE : 
+                                  DS1302_BOOL_TRUE);              /* chip 0 owns the shared lines */
+    bus->chip[bus->count] = handle;                               /* save the handle */
+    if (index != NULL)                                            /* check the index */
+    {
+        *index = bus->count;                                      /* set the index */
+    }
+    bus->count++;                                                 /* count the chip */
+    
+    return 0;                                                     /* success return 0 */
+}
+
+/**
+ * @brief     initialize the bus and all attached chips
+ * @param[in] *bus pointer to a ds1302 bus structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 chip init failed
+ *            - 2 bus is NULL
+ *            - 4 no chip is attached or the bus is initialized
+ * @note      the shared sclk and io lines are initialized once through chip 0,
+ *            the other chips only initialize their ce lines
+ */
+uint8_t ds1302_bus_init(ds1302_bus_t *bus)
+{
+    uint8_t i;
+    
+    if (bus == NULL)                                              /* check bus */
+    {
+        return 2;                                                 /* return error */
+    }
+    if ((bus->count == 0) || (bus->inited == 1))                  /* check the bus */
+    {
+        return 4;                                                 /* return error */
+    }
+    if ((bus->lock == NULL) != (bus->unlock == NULL))             /* check the lock pair */
+    {
+        return 4;                                                 /* return error */
+    }
+    
+    for (i = 0; i < bus->count; i++)                              /* init all chips */
+    {
+        if (ds1302_init(bus->chip[i]) != 0)                       /* init the chip */
+        {
+            while (i > 0)                                         /* close the initialized chips */
+            {
+                i--;                                              /* previous chip */
+                (void)ds1302_deinit(bus->chip[i]);                /* deinit the chip */
+            }
+            
+            return 1;                                             /* return error */
+        }
+    }
+    bus->io_direction = bus->chip[0]->io_direction;               /* direction after init */
+    bus->owner = DS1302_BUS_OWNER_NONE;                           /* no owner */
+    bus->inited = 1;                                              /* flag finish initialization */
+    
+    return 0;                                                     /* success return 0 */
+}
+
+/**
+ * @brief     close the bus and all attached chips
+ * @param[in] *bus pointer to a ds1302 bus structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 chip deinit failed
+ *            - 2 bus is NULL
+ *            - 3 bus is not initialized
+ *            - 4 bus is held by a chip
+ * @note      the shared lines are closed last through chip 0,
+ *            every chip is tried and the bus is closed even when one chip deinit fails
+ */
+uint8_t ds1302_bus_deinit(ds1302_bus_t *bus)
+{
+    uint8_t i;
+    uint8_t res;
+    
+    if (bus == NULL)                                              /* check bus */
+    {
+        return 2;                                                 /* return error */
+    }
+    if (bus->inited != 1)                                         /* check bus initialization */
+    {
+        return 3;                                                 /* return error */
+    }
+    if (bus->owner != DS1302_BUS_OWNER_NONE)                      /* check the owner */
+    {
+        return 4;                                                 /* return error */
+    }
+    
+    res = 0;                                                      /* init 0 */
+    for (i = bus->count; i > 0; i--)                              /* close chip 0 last */
+    {
+        if (ds1302_deinit(bus->chip[i - 1]) != 0)                 /* deinit the chip */
+        {
+            res = 1;                                              /* flag error */
+        }
+    }
+    bus->inited = 0;                                              /* flag close */
+    
+    return res;                                                   /* return the result */
+}
+
+/**
+ * @brief      acquire the bus for one chip
+ * @param[in]  *bus pointer to a ds1302 bus structure
+ * @param[in]  index chip index
+ * @param[out] **handle pointer to a ds1302 handle pointer buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 bus is busy or lock failed
+ *             - 2 bus or handle is NULL
+ *             - 3 bus is not initialized
+ *             - 4 index is invalid
+ * @note       the chip inherits the io direction the previous owner left behind,
+ *             so the shared line is only reconfigured when the next transfer needs it
+ */
+uint8_t ds1302_bus_acquire(ds1302_bus_t *bus, uint8_t index, ds1302_handle_t **handle)
+{
+    if ((bus == NULL) || (handle == NULL))                        /* check bus and handle */
+    {
+        return 2;                                                 /* return error */
+    }
+    if (bus->inited != 1)                                         /* check bus initialization */
+    {
+        return 3;                                                 /* return error */
+    }
+    if (index >= bus->count)                                      /* check the index */
+    {
+        return 4;                                                 /* return error */
+    }
+    
+    if ((bus->lock != NULL) && (bus->lock(bus->ctx) != 0))        /* take the lock */
+    {
+        return 1;                                                 /* return error */
+    }
+    if (bus->owner != DS1302_BUS_OWNER_NONE)                      /* check the owner */
+    {
+        if (bus->unlock != NULL)                                  /* check the unlock */
+        {
+            bus->unlock(bus->ctx);                                /* give the lock back */
+        }
+        
+        return 1;                                                 /* return error */
+    }
+    a_ds1302_bus_switch(bus, index);                              /* hand over the lines */
+    *handle = bus->chip[index];                                   /* set the handle */
+    
+    return 0;                                                     /* success return 0 */
+}
+
+/**
+ * @brief     release the bus
+ * @param[in] *bus pointer to a ds1302 bus structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 bus is NULL
+ *            - 3 bus is not initialized
+ *            - 4 bus is not acquired
+ * @note      none
+ */
+uint8_t ds1302_bus_release(ds1302_bus_t *bus)
+{
+    if (bus == NULL)                                              /* check bus */
+    {
+        return 2;                                                 /* return error */
+    }
+    if (bus->inited != 1)                                         /* check bus initialization */
+    {
+        return 3;                                                 /* return error */
+    }
+    if (bus->owner == DS1302_BUS_OWNER_NONE)                      /* check the owner */
+    {
+        return 4;                                                 /* return error */
+    }
+    
+    a_ds1302_bus_return(bus);                                     /* take the lines back */
+    if (bus->unlock != NULL)                                      /* check the unlock */
+    {
+        bus->unlock(bus->ctx);                                    /* give the lock back */
+    }
+    
+    return 0;                                                     /* success return 0 */
+}
+
+/**
+ * @brief      run one operation on every chip
+ * @param[in]  *bus pointer to a ds1302 bus structure
+ * @param[in]  *fuc pointer to an operation function address
+ * @param[in]  *arg pointer to an operation argument
+ * @param[out] *failed pointer to a failed chip mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 lock failed or an operation failed
+ *             - 2 bus or fuc is NULL
+ *             - 3 bus is not initialized
+ *             - 4 bus is held by a chip
+ * @note       the lock is taken once for the whole sweep, bit n of failed is set when chip n failed
+ */
+uint8_t ds1302_bus_sweep(ds1302_bus_t *bus, uint8_t (*fuc)(ds1302_handle_t *handle, uint8_t index, void *arg),
+                         void *arg, uint32_t *failed)
+{
+    uint8_t i;
+    uint32_t mask;
+    
+    if ((bus == NULL) || (fuc == NULL))                           /* check bus and fuc */
+    {
+        return 2;                                                 /* return error */
+    }
+    if (bus->inited != 1)                                         /* check bus initialization */
+    {
+        return 3;                                                 /* return error */
+    }
+    
+    if ((bus->lock != NULL) && (bus->lock(bus->ctx) != 0))        /* take the lock */
+    {
+        return 1;                                                 /* return error */
+    }
+    if (bus->owner != DS1302_BUS_OWNER_NONE)                      /* check the owner */
+    {
+        if (bus->unlock != NULL)                                  /* check the unlock */
+        {
+            bus->unlock(bus->ctx);                                /* give the lock back */
+        }
+        
+        return 4;                                                 /* return error */
+    }
+    mask = 0;                                                     /* init 0 */
+    for (i = 0; i < bus->count; i++)                              /* run all chips */
+    {
+        a_ds1302_bus_switch(bus, i);                              /* hand over the lines */
+        if (fuc(bus->chip[i], i, arg) != 0)                       /* run the operation */
+        {
+            mask |= (uint32_t)1 << i;                             /* flag the chip */
+        }
+        a_ds1302_bus_return(bus);                                 /* take the lines back */
+    }
+    if (bus->unlock != NULL)                                      /* check the unlock */
+    {
+        bus->unlock(bus->ctx);                                    /* give the lock back */
+    }
+    if (failed != NULL)                                           /* check failed */
+    {
+        *failed = mask;                                           /* set the mask */
+    }
+    
+    return (mask != 0) ? 1 : 0;                                   /* return the result */
+}
@@ -0,0 +1,206 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1302_bus.h
+ * @brief     driver ds1302 bus header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_DS1302_BUS_H
+#define DRIVER_DS1302_BUS_H
+
+#include "driver_ds1302.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ds1302_bus_driver ds1302 bus driver function
+ * @brief    ds1302 bus driver modules
+ * @ingroup  ds1302_driver
+ * @{
+ */
+
+/**
+ * @brief ds1302 bus definition
+ */
+#ifndef DS1302_BUS_MAX_CHIPS
+    #define DS1302_BUS_MAX_CHIPS    8           /**< max chips on one bus, at most 32 */
+#endif
+#if (DS1302_BUS_MAX_CHIPS > 32)
+    #error "DS1302_BUS_MAX_CHIPS must not exceed 32"
+#endif
+#define DS1302_BUS_OWNER_NONE       0xFF        /**< no chip holds the bus */
+
+/**
+ * @brief ds1302 bus structure definition
+ */
+typedef struct ds1302_bus_s
+{
+    ds1302_handle_t *chip[DS1302_BUS_MAX_CHIPS];        /**< chip handles, chip 0 owns the shared lines */
+    uint8_t (*lock)(void *ctx);                         /**< point to a lock function address */
+    void (*unlock)(void *ctx);                          /**< point to an unlock function address */
+    void *ctx;                                          /**< context passed to the lock functions */
+    uint8_t count;                                      /**< attached chips */
+    uint8_t owner;                                      /**< index of the chip holding the bus */
+    uint8_t io_direction;                               /**< last direction of the shared io line */
+    uint8_t inited;                                     /**< inited flag */
+} ds1302_bus_t;
+
+/**
+ * @brief     initialize ds1302_bus_t structure
+ * @param[in] BUS pointer to a ds1302 bus structure
+ * @param[in] STRUCTURE ds1302_bus_t
+ * @note      none
+ */
+#define DRIVER_DS1302_BUS_LINK_INIT(BUS, STRUCTURE)        memset(BUS, 0, sizeof(STRUCTURE))
+
+/**
+ * @brief     link lock function
+ * @param[in] BUS pointer to a ds1302 bus structure
+ * @param[in] FUC pointer to a lock function address
+ * @note      optional, only needed when several threads share the bus
+ */
+#define DRIVER_DS1302_BUS_LINK_LOCK(BUS, FUC)              (BUS)->lock = FUC
+
+/**
+ * @brief     link unlock function
+ * @param[in] BUS pointer to a ds1302 bus structure
+ * @param[in] FUC pointer to an unlock function address
+ * @note      optional, only needed when several threads share the bus
+ */
+#define DRIVER_DS1302_BUS_LINK_UNLOCK(BUS, FUC)            (BUS)->unlock = FUC
+
+/**
+ * @brief     link the lock context
+ * @param[in] BUS pointer to a ds1302 bus structure
+ * @param[in] CTX pointer to a context
+ * @note      optional
+ */
+#define DRIVER_DS1302_BUS_LINK_CONTEXT(BUS, CTX)           (BUS)->ctx = CTX
+
+/**
+ * @brief      attach a chip to the bus
+ * @param[in]  *bus pointer to a ds1302 bus structure
+ * @param[in]  *handle pointer to a linked but not initialized ds1302 handle structure
+ * @param[out] *index pointer to a chip index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 bus or handle is NULL
+ *             - 4 bus is full, already initialized or the handle is initialized
+ * @note       every handle links the shared sclk and io functions and its own ce and context,
+ *             every chip but chip 0 is flagged with ds1302_set_shared_lines so that its
+ *             init and deinit only touch its ce line
+ */
+uint8_t ds1302_bus_attach(ds1302_bus_t *bus, ds1302_handle_t *handle, uint8_t *index);
+
+/**
+ * @brief     initialize the bus and all attached chips
+ * @param[in] *bus pointer to a ds1302 bus structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 chip init failed
+ *            - 2 bus is NULL
+ *            - 4 no chip is attached or the bus is initialized
+ * @note      the shared sclk and io lines are initialized once through chip 0,
+ *            the other chips only initialize their ce lines
+ */
+uint8_t ds1302_bus_init(ds1302_bus_t *bus);
+
+/**
+ * @brief     close the bus and all attached chips
+ * @param[in] *bus pointer to a ds1302 bus structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 chip deinit failed
+ *            - 2 bus is NULL
+ *            - 3 bus is not initialized
+ *            - 4 bus is held by a chip
+ * @note      the shared lines are closed last through chip 0,
+ *            every chip is tried and the bus is closed even when one chip deinit fails
+ */
+uint8_t ds1302_bus_deinit(ds1302_bus_t *bus);
+
+/**
+ * @brief      acquire the bus for one chip
+ * @param[in]  *bus pointer to a ds1302 bus structure
+ * @param[in]  index chip index
+ * @param[out] **handle pointer to a ds1302 handle pointer buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 bus is busy or lock failed
+ *             - 2 bus or handle is NULL
+ *             - 3 bus is not initialized
+ *             - 4 index is invalid
+ * @note       the chip inherits the io direction the previous owner left behind,
+ *             so the shared line is only reconfigured when the next transfer needs it
+ */
+uint8_t ds1302_bus_acquire(ds1302_bus_t *bus, uint8_t index, ds1302_handle_t **handle);
+
+/**
+ * @brief     release the bus
+ * @param[in] *bus pointer to a ds1302 bus structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 bus is NULL
+ *            - 3 bus is not initialized
+ *            - 4 bus is not acquired
+ * @note      none
+ */
+uint8_t ds1302_bus_release(ds1302_bus_t *bus);
+
+/**
+ * @brief      run one operation on every chip
+ * @param[in]  *bus pointer to a ds1302 bus structure
+ * @param[in]  *fuc pointer to an operation function address
+ * @param[in]  *arg pointer to an operation argument
+ * @param[out] *failed pointer to a failed chip mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 lock failed or an operation failed
+ *             - 2 bus or fuc is NULL
+ *             - 3 bus is not initialized
+ *             - 4 bus is held by a chip
+ * @note       the lock is taken once for the whole sweep, bit n of failed is set when chip n failed
+ */
+uint8_t ds1302_bus_sweep(ds1302_bus_t *bus, uint8_t (*fuc)(ds1302_handle_t *handle, uint8_t index, void *arg),
+                         void *arg, uint32_t *failed);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,799 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1302_parallel.c
+ * @brief     driver ds1302 parallel source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds1302_parallel.h"
+
+/**
+ * @brief chip command definition
+ */
+#define DS1302_PARALLEL_COMMAND_CONTROL        0x8E        /**< control register write */
+#define DS1302_PARALLEL_COMMAND_CLOCK_BURST    0xBE        /**< clock burst write */
+#define DS1302_PARALLEL_COMMAND_RAM_BURST      0xFE        /**< ram burst write */
+
+/**
+ * @brief io direction definition
+ */
+#define DS1302_PARALLEL_IO_INPUT               0x00        /**< io input */
+#define DS1302_PARALLEL_IO_OUTPUT              0x01        /**< io output */
+#define DS1302_PARALLEL_IO_UNKNOWN             0xFF        /**< io direction unknown */
+
+/**
+ * @brief     transpose an 8x8 bit matrix
+ * @param[in] x matrix, bit c of byte r is row r column c
+ * @return    transposed matrix, bit r of byte c
+ * @note      three rounds of masked swaps instead of 64 single bit moves
+ */
+static uint64_t a_ds1302_parallel_transpose8(uint64_t x)
+{
+    uint64_t t;
+    
+    t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;                        /* swap 1x1 blocks */
+    x = x ^ t ^ (t << 7);                                               /* apply */
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;                       /* swap 2x2 blocks */
+    x = x ^ t ^ (t << 14);                                              /* apply */
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;                       /* swap 4x4 blocks */
+    x = x ^ t ^ (t << 28);                                              /* apply */
+    
+    return x;                                                           /* return the matrix */
+}
+
+/**
+ * @brief     set the io direction of all lanes
+ * @param[in] *parallel pointer to a ds1302 parallel structure
+ * @param[in] direction io direction
+ * @return    status code
+ *            - 0 success
+ *            - 1 set direction failed
+ * @note      none
+ */
+static uint8_t a_ds1302_parallel_set_direction(ds1302_parallel_t *parallel, uint8_t direction)
+{
+    if (parallel->io_direction == direction)                            /* check the direction */
+    {
+        return 0;                                                       /* success return 0 */
+    }
+    if (parallel->io_set_direction(parallel->ctx, parallel->mask, direction) != 0) /* set the direction */
+    {
+        parallel->io_direction = DS1302_PARALLEL_IO_UNKNOWN;           /* direction unknown */
+        
+        return 1;                                                       /* return error */
+    }
+    parallel->io_direction = direction;                                 /* save the direction */
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief     clock one port word out
+ * @param[in] *parallel pointer to a ds1302 parallel structure
+ * @param[in] word port word
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_ds1302_parallel_write_word(ds1302_parallel_t *parallel, uint32_t word)
+{
+    if (parallel->io_write(parallel->ctx, parallel->mask, word) != 0)   /* set all io lines */
+    {
+        return 1;                                                       /* return error */
+    }
+    parallel->delay_us(1);                                              /* delay 1us */
+    if (parallel->sclk_write(parallel->ctx, 1) != 0)                    /* set sclk high */
+    {
+        return 1;                                                       /* return error */
+    }
+    parallel->delay_us(1);                                              /* delay 1us */
+    if (parallel->sclk_write(parallel->ctx, 0) != 0)                    /* set sclk low */
+    {
+        return 1;                                                       /* return error */
+    }
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief     write the command byte to all lanes
+ * @param[in] *parallel pointer to a ds1302 parallel structure
+ * @param[in] command command byte
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      ce is set high first
+ */
+static uint8_t a_ds1302_parallel_command(ds1302_parallel_t *parallel, uint8_t command)
+{
+    uint8_t i;
+    
+    if (parallel->ce_write(parallel->ctx, 1) != 0)                      /* set ce high */
+    {
+        return 1;                                                       /* return error */
+    }
+    if (a_ds1302_parallel_set_direction(parallel, DS1302_PARALLEL_IO_OUTPUT) != 0) /* set io output */
+    {
+        return 1;                                                       /* return error */
+    }
+    for (i = 0; i < 8; i++)                                             /* lsb first */
+    {
+        if (a_ds1302_parallel_write_word(parallel, 
+                                         ((command >> i) & 0x01) ? parallel->mask : 0) != 0) /* same bit on all lanes */
+        {
+            return 1;                                                   /* return error */
+        }
+    }
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief     burst write all lanes
+ * @param[in] *parallel pointer to a ds1302 parallel structure
+ * @param[in] command command byte
+ * @param[in] *buf pointer to a data buffer, len bytes per lane, lane after lane
+ * @param[in] len bytes per lane
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_ds1302_parallel_write(ds1302_parallel_t *parallel, uint8_t command, uint8_t *buf, uint8_t len)
+{
+    uint8_t i;
+    uint8_t j;
+    uint8_t l;
+    uint64_t x[4];
+    uint32_t word[8];
+    
+    if (a_ds1302_parallel_command(parallel, command) != 0)              /* write command */
+    {
+        (void)parallel->ce_write(parallel->ctx, 0);                     /* set ce low */
+        
+        return 1;                                                       /* return error */
+    }
+    for (j = 0; j < len; j++)                                           /* write all bytes */
+    {
+        memset(x, 0, sizeof(x));                                        /* clear the matrices */
+        for (l = 0; l < parallel->lanes; l++)                           /* gather one byte per lane */
+        {
+            x[parallel->pin[l] >> 3] |= (uint64_t)buf[l * len + j] << ((parallel->pin[l] & 0x07) * 8); /* byte of pin n at row n */
+        }
+        memset(word, 0, sizeof(word));                                  /* clear the words */
+        for (i = 0; i < 4; i++)                                         /* 8 pins per matrix */
+        {
+            if (((parallel->mask >> (i * 8)) & 0xFF) != 0)              /* skip empty groups */
+            {
+                uint64_t y;
+                uint8_t b;
+                
+                y = a_ds1302_parallel_transpose8(x[i]);                 /* bit b of every pin at row b */
+                for (b = 0; b < 8; b++)                                 /* spread the rows */
+                {
+                    word[b] |= (uint32_t)((y >> (b * 8)) & 0xFF) << (i * 8); /* row b to port bits */
+                }
+            }
+        }
+        for (i = 0; i < 8; i++)                                         /* lsb first */
+        {
+            if (a_ds1302_parallel_write_word(parallel, word[i]) != 0)   /* clock the bit on all lanes */
+            {
+                (void)parallel->ce_write(parallel->ctx, 0);             /* set ce low */
+                
+                return 1;                                               /* return error */
+            }
+        }
+    }
+    if (parallel->io_write(parallel->ctx, parallel->mask, 0) != 0)      /* set io low */
+    {
+        (void)parallel->ce_write(parallel->ctx, 0);                     /* set ce low */
+        
+        return 1;                                                       /* return error */
+    }
+    if (parallel->ce_write(parallel->ctx, 0) != 0)                      /* set ce low */
+    {
+        return 1;                                                       /* return error */
+    }
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief      burst read all lanes
+ * @param[in]  *parallel pointer to a ds1302 parallel structure
+ * @param[in]  command command byte
+ * @param[out] *buf pointer to a data buffer, len bytes per lane, lane after lane
+ * @param[in]  len bytes per lane
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_ds1302_parallel_read(ds1302_parallel_t *parallel, uint8_t command, uint8_t *buf, uint8_t len)
+{
+    uint8_t i;
+    uint8_t j;
+    uint8_t l;
+    uint64_t x[4];
+    uint32_t word;
+    
+    if (a_ds1302_parallel_command(parallel, (uint8_t)(command | 0x01)) != 0) /* write command */
+    {
+        (void)parallel->ce_write(parallel->ctx, 0);                     /* set ce low */
+        
+        return 1;                                                       /* return error */
+    }
+    if (a_ds1302_parallel_set_direction(parallel, DS1302_PARALLEL_IO_INPUT) != 0) /* set io input */
+    {
+        (void)parallel->ce_write(parallel->ctx, 0);                     /* set ce low */
+        
+        return 1;                                                       /* return error */
+    }
+    for (j = 0; j < len; j++)                                           /* read all bytes */
+    {
+        memset(x, 0, sizeof(x));                                        /* clear the matrices */
+        for (i = 0; i < 8; i++)                                         /* lsb first */
+        {
+            if (parallel->io_read(parallel->ctx, &word) != 0)           /* sample all lanes */
+            {
+                (void)parallel->ce_write(parallel->ctx, 0);             /* set ce low */
+                
+                return 1;                                               /* return error */
+            }
+            word &= parallel->mask;                                     /* keep the lanes */
+            x[0] |= (uint64_t)(word & 0xFF) << (i * 8);                 /* pins 0 - 7 at row i */
+            x[1] |= (uint64_t)((word >> 8) & 0xFF) << (i * 8);          /* pins 8 - 15 at row i */
+            x[2] |= (uint64_t)((word >> 16) & 0xFF) << (i * 8);         /* pins 16 - 23 at row i */
+            x[3] |= (uint64_t)((word >> 24) & 0xFF) << (i * 8);         /* pins 24 - 31 at row i */
+            if (parallel->sclk_write(parallel->ctx, 1) != 0)            /* set sclk high */
+            {
+                (void)parallel->ce_write(parallel->ctx, 0);             /* set ce low */
+                
+                return 1;                                               /* return error */
+            }
+            parallel->delay_us(1);                                      /* delay 1us */
+            if (parallel->sclk_write(parallel->ctx, 0) != 0)            /* set sclk low */
+            {
+                (void)parallel->ce_write(parallel->ctx, 0);             /* set ce low */
+                
+                return 1;                                               /* return error */
+            }
+        }
+        for (i = 0; i < 4; i++)                                         /* 8 pins per matrix */
+        {
+            if (x[i] != 0)                                              /* skip empty groups */
+            {
+                x[i] = a_ds1302_parallel_transpose8(x[i]);              /* byte of pin n at row n */
+            }
+        }
+        for (l = 0; l < parallel->lanes; l++)                           /* scatter one byte per lane */
+        {
+            buf[l * len + j] = (uint8_t)(x[parallel->pin[l] >> 3] >> ((parallel->pin[l] & 0x07) * 8)); /* get the byte */
+        }
+    }
+    if (parallel->ce_write(parallel->ctx, 0) != 0)                      /* set ce low */
+    {
+        return 1;                                                       /* return error */
+    }
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief     initialize the lanes
+ * @param[in] *parallel pointer to a ds1302 parallel structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 lane init failed
+ *            - 2 parallel is NULL
+ *            - 3 linked functions is NULL
+ * @note      none
+ */
+uint8_t ds1302_parallel_init(ds1302_parallel_t *parallel)
+{
+    if (parallel == NULL)                                               /* check parallel */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (parallel->debug_print == NULL)                                  /* check debug_print */
+    {
+        return 3;                                                       /* return error */
+    }
+    if (parallel->lane_init == NULL)                                    /* check lane_init */
+    {
+        parallel->debug_print("ds1302: lane_init is null.\n");          /* lane_init is null */
+        
+        return 3;                                                       /* return error */
+    }
+    if (parallel->lane_deinit == NULL)                                  /* check lane_deinit */
+    {
+        parallel->debug_print("ds1302: lane_deinit is null.\n");        /* lane_deinit is null */
+        
+        return 3;                                                       /* return error */
+    }
+    if (parallel->ce_write == NULL)                                     /* check ce_write */
+    {
+        parallel->debug_print("ds1302: ce_write is null.\n");           /* ce_write is null */
+        
+        return 3;                                                       /* return error */
+    }
+    if (parallel->sclk_write == NULL)                                   /* check sclk_write */
+    {
+        parallel->debug_print("ds1302: sclk_write is null.\n");         /* sclk_write is null */
+        
+        return 3;                                                       /* return error */
+    }
+    if (parallel->io_write == NULL)                                     /* check io_write */
+    {
+        parallel->debug_print("ds1302: io_write is null.\n");           /* io_write is null */
+        
+        return 3;                                                       /* return error */
+    }
+    if (parallel->io_read == NULL)                                      /* check io_read */
+    {
+        parallel->debug_print("ds1302: io_read is null.\n");            /* io_read is null */
+        
+        return 3;                                                       /* return error */
+    }
+    if (parallel->io_set_direction == NULL)                             /* check io_set_direction */
+    {
+        parallel->debug_print("ds1302: io_set_direction is null.\n");   /* io_set_direction is null */
+        
+        return 3;                                                       /* return error */
+    }
+    if (parallel->delay_us == NULL)                                     /* check delay_us */
+    {
+        parallel->debug_print("ds1302: delay_us is null.\n");           /* delay_us is null */
+        
+        return 3;                                                       /* return error */
+    }
+    
+    if (parallel->lane_init(parallel->ctx) != 0)                        /* lane init */
+    {
+        parallel->debug_print("ds1302: lane init failed.\n");           /* lane init failed */
+        
+        return 1;                                                       /* return error */
+    }
+    parallel->lanes = 0;                                                /* no lane */
+    parallel->mask = 0;                                                 /* no pin */
+    parallel->io_direction = DS1302_PARALLEL_IO_UNKNOWN;                /* io direction unknown */
+    parallel->inited = 1;                                               /* flag finish initialization */
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief     close the lanes
+ * @param[in] *parallel pointer to a ds1302 parallel structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 lane deinit failed
+ *            - 2 parallel is NULL
+ *            - 3 parallel is not initialized
+ * @note      none
+ */
+uint8_t ds1302_parallel_deinit(ds1302_parallel_t *parallel)
+{
+    if (parallel == NULL)                                               /* check parallel */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (parallel->inited != 1)                                          /* check parallel initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    
+    if (parallel->lane_deinit(parallel->ctx) != 0)                      /* lane deinit */
+    {
+        parallel->debug_print("ds1302: lane deinit failed.\n");         /* lane deinit failed */
+        
+        return 1;                                                       /* return error */
+    }
+    parallel->inited = 0;                                               /* flag close */
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief     set the port pins of the lanes
+ * @param[in] *parallel pointer to a ds1302 parallel structure
+ * @param[in] *pin pointer to a port pin array, one entry per lane
+ * @param[in] lanes number of lanes
+ * @return    status code
+ *            - 0 success
+ *            - 2 parallel or pin is NULL
+ *            - 3 parallel is not initialized
+ *            - 4 lanes or pin is invalid
+ * @note      pins are bit positions of the port word and must be unique
+ */
+uint8_t ds1302_parallel_set_lanes(ds1302_parallel_t *parallel, const uint8_t *pin, uint8_t lanes)
+{
+    uint8_t i;
+    uint32_t mask;
+    
+    if ((parallel == NULL) || (pin == NULL))                            /* check parallel and pin */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (parallel->inited != 1)                                          /* check parallel initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    if ((lanes == 0) || (lanes > DS1302_PARALLEL_MAX_LANES))            /* check lanes */
+    {
+        parallel->debug_print("ds1302: lanes is invalid.\n");           /* lanes is invalid */
+        
+        return 4;                                                       /* return error */
+    }
+    
+    mask = 0;                                                           /* init 0 */
+    for (i = 0; i < lanes; i++)                                         /* check all pins */
+    {
+        if ((pin[i] > 31) || (((mask >> pin[i]) & 0x01) != 0))          /* out of the port or used twice */
+        {
+            parallel->debug_print("ds1302: pin is invalid.\n");         /* pin is invalid */
+            
+            return 4;                                                   /* return error */
+        }
+        mask |= (uint32_t)1 << pin[i];                                  /* add the pin */
+    }
+    memcpy(parallel->pin, pin, lanes);                                  /* save the pins */
+    parallel->lanes = lanes;                                            /* save the lanes */
+    parallel->mask = mask;                                              /* save the mask */
+    parallel->io_direction = DS1302_PARALLEL_IO_UNKNOWN;                /* new pins, direction unknown */
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief      get the number of lanes
+ * @param[in]  *parallel pointer to a ds1302 parallel structure
+ * @param[out] *lanes pointer to a lanes buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 parallel is NULL
+ *             - 3 parallel is not initialized
+ * @note       none
+ */
+uint8_t ds1302_parallel_get_lanes(ds1302_parallel_t *parallel, uint8_t *lanes)
+{
+    if (parallel == NULL)                                               /* check parallel */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (parallel->inited != 1)                                          /* check parallel initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    
+    *lanes = parallel->lanes;                                           /* get the lanes */
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief     clock burst write on all lanes
+ * @param[in] *parallel pointer to a ds1302 parallel structure
+ * @param[in] *buf pointer to a data buffer, len bytes per lane, lane after lane
+ * @param[in] len bytes per lane
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 parallel is NULL
+ *            - 3 parallel is not initialized
+ *            - 4 len > 8 or no lane is set
+ * @note      every lane gets its own bytes in the same bus time as one chip
+ */
+uint8_t ds1302_parallel_clock_burst_write(ds1302_parallel_t *parallel, uint8_t *buf, uint8_t len)
+{
+    if (parallel == NULL)                                               /* check parallel */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (parallel->inited != 1)                                          /* check parallel initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    if ((len > 8) || (parallel->lanes == 0))                            /* check len and lanes */
+    {
+        parallel->debug_print("ds1302: len > 8 or no lane.\n");         /* len > 8 or no lane */
+        
+        return 4;                                                       /* return error */
+    }
+    
+    if (a_ds1302_parallel_write(parallel, DS1302_PARALLEL_COMMAND_CLOCK_BURST, buf, len) != 0) /* burst write */
+    {
+        parallel->debug_print("ds1302: clock burst write failed.\n");   /* clock burst write failed */
+        
+        return 1;                                                       /* return error */
+    }
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief      clock burst read on all lanes
+ * @param[in]  *parallel pointer to a ds1302 parallel structure
+ * @param[out] *buf pointer to a data buffer, len bytes per lane, lane after lane
+ * @param[in]  len bytes per lane
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 parallel is NULL
+ *             - 3 parallel is not initialized
+ *             - 4 len > 8 or no lane is set
+ * @note       none
+ */
+uint8_t ds1302_parallel_clock_burst_read(ds1302_parallel_t *parallel, uint8_t *buf, uint8_t len)
+{
+    if (parallel == NULL)                                               /* check parallel */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (parallel->inited != 1)                                          /* check parallel initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    if ((len > 8) || (parallel->lanes == 0))                            /* check len and lanes */
+    {
+        parallel->debug_print("ds1302: len > 8 or no lane.\n");         /* len > 8 or no lane */
+        
+        return 4;                                                       /* return error */
+    }
+    
+    if (a_ds1302_parallel_read(parallel, DS1302_PARALLEL_COMMAND_CLOCK_BURST, buf, len) != 0) /* burst read */
+    {
+        parallel->debug_print("ds1302: clock burst read failed.\n");    /* clock burst read failed */
+        
+        return 1;                                                       /* return error */
+    }
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief     ram burst write on all lanes
+ * @param[in] *parallel pointer to a ds1302 parallel structure
+ * @param[in] *buf pointer to a data buffer, len bytes per lane, lane after lane
+ * @param[in] len bytes per lane
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 parallel is NULL
+ *            - 3 parallel is not initialized
+ *            - 4 len > 31 or no lane is set
+ * @note      none
+ */
+uint8_t ds1302_parallel_ram_burst_write(ds1302_parallel_t *parallel, uint8_t *buf, uint8_t len)
+{
+    if (parallel == NULL)                                               /* check parallel */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (parallel->inited != 1)                                          /* check parallel initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    if ((len > 31) || (parallel->lanes == 0))                           /* check len and lanes */
+    {
+        parallel->debug_print("ds1302: len > 31 or no lane.\n");        /* len > 31 or no lane */
+        
+        return 4;                                                       /* return error */
+    }
+    
+    if (a_ds1302_parallel_write(parallel, DS1302_PARALLEL_COMMAND_RAM_BURST, buf, len) != 0) /* burst write */
+    {
+        parallel->debug_print("ds1302: ram burst write failed.\n");     /* ram burst write failed */
+        
+        return 1;                                                       /* return error */
+    }
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief      ram burst read on all lanes
+ * @param[in]  *parallel pointer to a ds1302 parallel structure
+ * @param[out] *buf pointer to a data buffer, len bytes per lane, lane after lane
+ * @param[in]  len bytes per lane
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 parallel is NULL
+ *             - 3 parallel is not initialized
+ *             - 4 len > 31 or no lane is set
+ * @note       none
+ */
+uint8_t ds1302_parallel_ram_burst_read(ds1302_parallel_t *parallel, uint8_t *buf, uint8_t len)
+{
+    if (parallel == NULL)                                               /* check parallel */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (parallel->inited != 1)                                          /* check parallel initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    if ((len > 31) || (parallel->lanes == 0))                           /* check len and lanes */
+    {
+        parallel->debug_print("ds1302: len > 31 or no lane.\n");        /* len > 31 or no lane */
+        
+        return 4;                                                       /* return error */
+    }
+    
+    if (a_ds1302_parallel_read(parallel, DS1302_PARALLEL_COMMAND_RAM_BURST, buf, len) != 0) /* burst read */
+    {
+        parallel->debug_print("ds1302: ram burst read failed.\n");      /* ram burst read failed */
+        
+        return 1;                                                       /* return error */
+    }
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief      get the time of all lanes as compact timestamps
+ * @param[in]  *parallel pointer to a ds1302 parallel structure
+ * @param[out] *compact pointer to a compact timestamp array, one entry per lane
+ * @param[out] *failed pointer to a failed lane mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed or a lane holds an invalid time
+ *             - 2 parallel, compact or failed is NULL
+ *             - 3 parallel is not initialized
+ *             - 4 no lane is set
+ * @note       bit n of failed is set when lane n holds an invalid time, its compact entry is 0
+ */
+uint8_t ds1302_parallel_get_compact_time(ds1302_parallel_t *parallel, uint32_t *compact, uint32_t *failed)
+{
+    uint8_t l;
+    uint8_t buf[DS1302_PARALLEL_MAX_LANES * 8];
+    
+    if ((parallel == NULL) || (compact == NULL) || (failed == NULL))    /* check parallel, compact and failed */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (parallel->inited != 1)                                          /* check parallel initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    if (parallel->lanes == 0)                                           /* check lanes */
+    {
+        parallel->debug_print("ds1302: no lane.\n");                    /* no lane */
+        
+        return 4;                                                       /* return error */
+    }
+    
+    if (a_ds1302_parallel_read(parallel, DS1302_PARALLEL_COMMAND_CLOCK_BURST, buf, 8) != 0) /* read all clocks */
+    {
+        parallel->debug_print("ds1302: clock burst read failed.\n");    /* clock burst read failed */
+        
+        return 1;                                                       /* return error */
+    }
+    *failed = 0;                                                        /* init 0 */
+    for (l = 0; l < parallel->lanes; l++)                               /* decode all lanes */
+    {
+        if (ds1302_clock_burst_to_compact(&buf[l * 8], &compact[l]) != 0) /* decode */
+        {
+            compact[l] = 0;                                             /* no time */
+            *failed |= (uint32_t)1 << l;                                /* flag the lane */
+        }
+    }
+    
+    return (*failed != 0) ? 1 : 0;                                      /* return the result */
+}
+
+/**
+ * @brief     set the same compact timestamp on all lanes
+ * @param[in] *parallel pointer to a ds1302 parallel structure
+ * @param[in] compact seconds since 2000-01-01
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 parallel is NULL
+ *            - 3 parallel is not initialized
+ *            - 4 compact is invalid or no lane is set
+ * @note      write protect is lifted for the write and every lane keeps its own control byte,
+ *            a failed clock burst write puts the saved control bytes back
+ */
+uint8_t ds1302_parallel_set_compact_time(ds1302_parallel_t *parallel, uint32_t compact)
+{
+    uint8_t l;
+    uint8_t protect;
+    uint8_t control[DS1302_PARALLEL_MAX_LANES];
+    uint8_t buf[DS1302_PARALLEL_MAX_LANES * 8];
+    
+    if (parallel == NULL)                                               /* check parallel */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (parallel->inited != 1)                                          /* check parallel initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    if (parallel->lanes == 0)                                           /* check lanes */
+    {
+        parallel->debug_print("ds1302: no lane.\n");                    /* no lane */
+        
+        return 4;                                                       /* return error */
+    }
+    if (ds1302_compact_to_clock_burst(compact, buf) != 0)               /* check compact */
+    {
+        parallel->debug_print("ds1302: compact is invalid.\n");         /* compact is invalid */
+        
+        return 4;                                                       /* return error */
+    }
+    
+    if (a_ds1302_parallel_read(parallel, DS1302_PARALLEL_COMMAND_CLOCK_BURST, buf, 8) != 0) /* read clocks and controls */
+    {
+        parallel->debug_print("ds1302: clock burst read failed.\n");    /* clock burst read failed */
+        
+        return 1;                                                       /* return error */
+    }
+    protect = 0;                                                        /* init 0 */
+    for (l = 0; l < parallel->lanes; l++)                               /* check all lanes */
+    {
+        control[l] = buf[l * 8 + 7] & (uint8_t)(~(1 << 7));             /* control without write protect */
+        protect |= buf[l * 8 + 7] & (1 << 7);                           /* any lane protected */
+    }
+    if (protect != 0)                                                   /* check write protect */
+    {
+        if (a_ds1302_parallel_write(parallel, DS1302_PARALLEL_COMMAND_CONTROL, control, 1) != 0) /* disable write protect */
+        {
+            parallel->debug_print("ds1302: disable write protect failed.\n"); /* disable write protect failed */
+            
+            return 1;                                                   /* return error */
+        }
+    }
+    for (l = 0; l < parallel->lanes; l++)                               /* encode all lanes */
+    {
+        (void)ds1302_compact_to_clock_burst(compact, &buf[l * 8]);      /* keep the lane control byte */
+    }
+    if (a_ds1302_parallel_write(parallel, DS1302_PARALLEL_COMMAND_CLOCK_BURST, buf, 8) != 0) /* write clocks and restore controls */
+    {
+        parallel->debug_print("ds1302: clock burst write failed.\n");   /* clock burst write failed */
+        if (protect != 0)                                               /* check write protect */
+        {
+            for (l = 0; l < parallel->lanes; l++)                       /* all lanes */
+            {
+                control[l] = buf[l * 8 + 7];                            /* saved control byte */
+            }
+            (void)a_ds1302_parallel_write(parallel, DS1302_PARALLEL_COMMAND_CONTROL, control, 1); /* restore write protect */
+        }
+        
+        return 1;                                                       /* return error */
+    }
+    
+    return 0;                                                           /* success return 0 */
+}
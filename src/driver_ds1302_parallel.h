@@ -0,0 +1,321 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1302_parallel.h
+ * @brief     driver ds1302 parallel header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_DS1302_PARALLEL_H
+#define DRIVER_DS1302_PARALLEL_H
+
+#include "driver_ds1302.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ds1302_parallel_driver ds1302 parallel driver function
+ * @brief    ds1302 parallel driver modules
+ * @ingroup  ds1302_driver
+ * @{
+ */
+
+/**
+ * @brief ds1302 parallel definition
+ */
+#ifndef DS1302_PARALLEL_MAX_LANES
+    #define DS1302_PARALLEL_MAX_LANES    32        /**< max lanes, one per pin of a 32 bits port */
+#endif
+#if (DS1302_PARALLEL_MAX_LANES > 32)
+    #error "DS1302_PARALLEL_MAX_LANES must not exceed 32"
+#endif
+
+/**
+ * @brief ds1302 parallel structure definition
+ */
+typedef struct ds1302_parallel_s
+{
+    uint8_t (*lane_init)(void *ctx);                                        /**< point to a lane_init function address */
+    uint8_t (*lane_deinit)(void *ctx);                                      /**< point to a lane_deinit function address */
+    uint8_t (*ce_write)(void *ctx, uint8_t value);                          /**< point to a ce_write function address */
+    uint8_t (*sclk_write)(void *ctx, uint8_t value);                        /**< point to an sclk_write function address */
+    uint8_t (*io_write)(void *ctx, uint32_t mask, uint32_t value);          /**< point to an io_write function address */
+    uint8_t (*io_read)(void *ctx, uint32_t *value);                         /**< point to an io_read function address */
+    uint8_t (*io_set_direction)(void *ctx, uint32_t mask, uint8_t output);  /**< point to an io_set_direction function address */
+    void (*debug_print)(const char *const fmt, ...);                        /**< point to a debug_print function address */
+    void (*delay_us)(uint32_t us);                                          /**< point to a delay_us function address */
+    void *ctx;                                                              /**< context passed to the lane functions */
+    uint8_t pin[DS1302_PARALLEL_MAX_LANES];                                 /**< port pin of every lane */
+    uint32_t mask;                                                          /**< port pins of all lanes */
+    uint8_t lanes;                                                          /**< lanes */
+    uint8_t io_direction;                                                   /**< io direction */
+    uint8_t inited;                                                         /**< inited flag */
+} ds1302_parallel_t;
+
+/**
+ * @brief     initialize ds1302_parallel_t structure
+ * @param[in] PARALLEL pointer to a ds1302 parallel structure
+ * @param[in] STRUCTURE ds1302_parallel_t
+ * @note      none
+ */
+#define DRIVER_DS1302_PARALLEL_LINK_INIT(PARALLEL, STRUCTURE)                memset(PARALLEL, 0, sizeof(STRUCTURE))
+
+/**
+ * @brief     link lane_init function
+ * @param[in] PARALLEL pointer to a ds1302 parallel structure
+ * @param[in] FUC pointer to a lane_init function address
+ * @note      none
+ */
+#define DRIVER_DS1302_PARALLEL_LINK_LANE_INIT(PARALLEL, FUC)                 (PARALLEL)->lane_init = FUC
+
+/**
+ * @brief     link lane_deinit function
+ * @param[in] PARALLEL pointer to a ds1302 parallel structure
+ * @param[in] FUC pointer to a lane_deinit function address
+ * @note      none
+ */
+#define DRIVER_DS1302_PARALLEL_LINK_LANE_DEINIT(PARALLEL, FUC)               (PARALLEL)->lane_deinit = FUC
+
+/**
+ * @brief     link ce_write function
+ * @param[in] PARALLEL pointer to a ds1302 parallel structure
+ * @param[in] FUC pointer to a ce_write function address
+ * @note      none
+ */
+#define DRIVER_DS1302_PARALLEL_LINK_CE_WRITE(PARALLEL, FUC)                  (PARALLEL)->ce_write = FUC
+
+/**
+ * @brief     link sclk_write function
+ * @param[in] PARALLEL pointer to a ds1302 parallel structure
+ * @param[in] FUC pointer to an sclk_write function address
+ * @note      none
+ */
+#define DRIVER_DS1302_PARALLEL_LINK_SCLK_WRITE(PARALLEL, FUC)                (PARALLEL)->sclk_write = FUC
+
+/**
+ * @brief     link io_write function
+ * @param[in] PARALLEL pointer to a ds1302 parallel structure
+ * @param[in] FUC pointer to an io_write function address
+ * @note      none
+ */
+#define DRIVER_DS1302_PARALLEL_LINK_IO_WRITE(PARALLEL, FUC)                  (PARALLEL)->io_write = FUC
+
+/**
+ * @brief     link io_read function
+ * @param[in] PARALLEL pointer to a ds1302 parallel structure
+ * @param[in] FUC pointer to an io_read function address
+ * @note      none
+ */
+#define DRIVER_DS1302_PARALLEL_LINK_IO_READ(PARALLEL, FUC)                   (PARALLEL)->io_read = FUC
+
+/**
+ * @brief     link io_set_direction function
+ * @param[in] PARALLEL pointer to a ds1302 parallel structure
+ * @param[in] FUC pointer to an io_set_direction function address
+ * @note      none
+ */
+#define DRIVER_DS1302_PARALLEL_LINK_IO_SET_DIRECTION(PARALLEL, FUC)          (PARALLEL)->io_set_direction = FUC
+
+/**
+ * @brief     link debug_print function
+ * @param[in] PARALLEL pointer to a ds1302 parallel structure
+ * @param[in] FUC pointer to a debug_print function address
+ * @note      none
+ */
+#define DRIVER_DS1302_PARALLEL_LINK_DEBUG_PRINT(PARALLEL, FUC)               (PARALLEL)->debug_print = FUC
+
+/**
+ * @brief     link delay_us function
+ * @param[in] PARALLEL pointer to a ds1302 parallel structure
+ * @param[in] FUC pointer to a delay_us function address
+ * @note      none
+ */
+#define DRIVER_DS1302_PARALLEL_LINK_DELAY_US(PARALLEL, FUC)                  (PARALLEL)->delay_us = FUC
+
+/**
+ * @brief     link the lane context
+ * @param[in] PARALLEL pointer to a ds1302 parallel structure
+ * @param[in] CTX pointer to a context
+ * @note      optional
+ */
+#define DRIVER_DS1302_PARALLEL_LINK_CONTEXT(PARALLEL, CTX)                   (PARALLEL)->ctx = CTX
+
+/**
+ * @brief     initialize the lanes
+ * @param[in] *parallel pointer to a ds1302 parallel structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 lane init failed
+ *            - 2 parallel is NULL
+ *            - 3 linked functions is NULL
+ * @note      none
+ */
+uint8_t ds1302_parallel_init(ds1302_parallel_t *parallel);
+
+/**
+ * @brief     close the lanes
+ * @param[in] *parallel pointer to a ds1302 parallel structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 lane deinit failed
+ *            - 2 parallel is NULL
+ *            - 3 parallel is not initialized
+ * @note      none
+ */
+uint8_t ds1302_parallel_deinit(ds1302_parallel_t *parallel);
+
+/**
+ * @brief     set the port pins of the lanes
+ * @param[in] *parallel pointer to a ds1302 parallel structure
+ * @param[in] *pin pointer to a port pin array, one entry per lane
+ * @param[in] lanes number of lanes
+ * @return    status code
+ *            - 0 success
+ *            - 2 parallel or pin is NULL
+ *            - 3 parallel is not initialized
+ *            - 4 lanes or pin is invalid
+ * @note      pins are bit positions of the port word and must be unique
+ */
+uint8_t ds1302_parallel_set_lanes(ds1302_parallel_t *parallel, const uint8_t *pin, uint8_t lanes);
+
+/**
+ * @brief      get the number of lanes
+ * @param[in]  *parallel pointer to a ds1302 parallel structure
+ * @param[out] *lanes pointer to a lanes buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 parallel is NULL
+ *             - 3 parallel is not initialized
+ * @note       none
+ */
+uint8_t ds1302_parallel_get_lanes(ds1302_parallel_t *parallel, uint8_t *lanes);
+
+/**
+ * @brief     clock burst write on all lanes
+ * @param[in] *parallel pointer to a ds1302 parallel structure
+ * @param[in] *buf pointer to a data buffer, len bytes per lane, lane after lane
+ * @param[in] len bytes per lane
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 parallel is NULL
+ *            - 3 parallel is not initialized
+ *            - 4 len > 8 or no lane is set
+ * @note      every lane gets its own bytes in the same bus time as one chip
+ */
+uint8_t ds1302_parallel_clock_burst_write(ds1302_parallel_t *parallel, uint8_t *buf, uint8_t len);
+
+/**
+ * @brief      clock burst read on all lanes
+ * @param[in]  *parallel pointer to a ds1302 parallel structure
+ * @param[out] *buf pointer to a data buffer, len bytes per lane, lane after lane
+ * @param[in]  len bytes per lane
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 parallel is NULL
+ *             - 3 parallel is not initialized
+ *             - 4 len > 8 or no lane is set
+ * @note       none
+ */
+uint8_t ds1302_parallel_clock_burst_read(ds1302_parallel_t *parallel, uint8_t *buf, uint8_t len);
+
+/**
+ * @brief     ram burst write on all lanes
+ * @param[in] *parallel pointer to a ds1302 parallel structure
+ * @param[in] *buf pointer to a data buffer, len bytes per lane, lane after lane
+ * @param[in] len bytes per lane
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 parallel is NULL
+ *            - 3 parallel is not initialized
+ *            - 4 len > 31 or no lane is set
+ * @note      none
+ */
+uint8_t ds1302_parallel_ram_burst_write(ds1302_parallel_t *parallel, uint8_t *buf, uint8_t len);
+
+/**
+ * @brief      ram burst read on all lanes
+ * @param[in]  *parallel pointer to a ds1302 parallel structure
+ * @param[out] *buf pointer to a data buffer, len bytes per lane, lane after lane
+ * @param[in]  len bytes per lane
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 parallel is NULL
+ *             - 3 parallel is not initialized
+ *             - 4 len > 31 or no lane is set
+ * @note       none
+ */
+uint8_t ds1302_parallel_ram_burst_read(ds1302_parallel_t *parallel, uint8_t *buf, uint8_t len);
+
+/**
+ * @brief      get the time of all lanes as compact timestamps
+ * @param[in]  *parallel pointer to a ds1302 parallel structure
+ * @param[out] *compact pointer to a compact timestamp array, one entry per lane
+ * @param[out] *failed pointer to a failed lane mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed or a lane holds an invalid time
+ *             - 2 parallel, compact or failed is NULL
+ *             - 3 parallel is not initialized
+ *             - 4 no lane is set
+ * @note       bit n of failed is set when lane n holds an invalid time, its compact entry is 0
+ */
+uint8_t ds1302_parallel_get_compact_time(ds1302_parallel_t *parallel, uint32_t *compact, uint32_t *failed);
+
+/**
+ * @brief     set the same compact timestamp on all lanes
+ * @param[in] *parallel pointer to a ds1302 parallel structure
+ * @param[in] compact seconds since 2000-01-01
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 parallel is NULL
+ *            - 3 parallel is not initialized
+ *            - 4 compact is invalid or no lane is set
+ * @note      write protect is lifted for the write and every lane keeps its own control byte,
+ *            a failed clock burst write puts the saved control bytes back
+ */
+uint8_t ds1302_parallel_set_compact_time(ds1302_parallel_t *parallel, uint32_t compact);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,606 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1302_benchmark.c
+ * @brief     driver ds1302 benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds1302_benchmark.h"
+
+/**
+ * @brief ds1302 benchmark counter structure definition
+ */
+typedef struct ds1302_benchmark_counter_s
+{
+    uint32_t edges;              /**< level changes on ce, sclk and io */
+    uint32_t ce_cycles;          /**< ce high periods */
+    uint32_t bits;               /**< sclk rising edges while ce is high */
+    uint32_t turnarounds;        /**< io direction changes */
+} ds1302_benchmark_counter_t;
+
+/**
+ * @brief ds1302 benchmark operation structure definition
+ */
+typedef struct ds1302_benchmark_op_s
+{
+    const char *name;            /**< operation name */
+    uint8_t (*run)(void);        /**< operation function */
+} ds1302_benchmark_op_t;
+
+static ds1302_handle_t gs_handle;                     /**< ds1302 handle */
+static ds1302_benchmark_counter_t gs_counter;         /**< bus counter */
+static uint8_t gs_ce;                                 /**< ce level */
+static uint8_t gs_sclk;                               /**< sclk level */
+static uint8_t gs_io;                                 /**< io level */
+static ds1302_time_t gs_time;                         /**< time buffer */
+static uint8_t gs_buf[31];                            /**< data buffer */
+
+/**
+ * @brief     count a level change
+ * @param[in] *level pointer to the last level
+ * @param[in] value new level
+ * @return    1 on a rising edge, else 0
+ * @note      none
+ */
+static uint8_t a_benchmark_edge(uint8_t *level, uint8_t value)
+{
+    uint8_t rising;
+    
+    value = (value != 0) ? 1 : 0;
+    rising = ((*level == 0) && (value != 0)) ? 1 : 0;
+    if (*level != value)
+    {
+        gs_counter.edges++;
+    }
+    *level = value;
+    
+    return rising;
+}
+
+/**
+ * @brief     counting ce gpio write
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] value set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 ce gpio write failed
+ * @note      none
+ */
+static uint8_t a_benchmark_ce_gpio_write(void *ctx, uint8_t value)
+{
+    if (a_benchmark_edge(&gs_ce, value) != 0)
+    {
+        gs_counter.ce_cycles++;
+    }
+    
+    return ds1302_interface_ce_gpio_write(ctx, value);
+}
+
+/**
+ * @brief     counting sclk gpio write
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] value set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 sclk gpio write failed
+ * @note      none
+ */
+static uint8_t a_benchmark_sclk_gpio_write(void *ctx, uint8_t value)
+{
+    if ((a_benchmark_edge(&gs_sclk, value) != 0) && (gs_ce != 0))
+    {
+        gs_counter.bits++;
+    }
+    
+    return ds1302_interface_sclk_gpio_write(ctx, value);
+}
+
+/**
+ * @brief     counting io gpio write
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] value set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 io gpio write failed
+ * @note      none
+ */
+static uint8_t a_benchmark_io_gpio_write(void *ctx, uint8_t value)
+{
+    (void)a_benchmark_edge(&gs_io, value);
+    
+    return ds1302_interface_io_gpio_write(ctx, value);
+}
+
+/**
+ * @brief     counting io gpio set direction
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] output direction, 0 is input and 1 is output
+ * @return    status code
+ *            - 0 success
+ *            - 1 io gpio set direction failed
+ * @note      none
+ */
+static uint8_t a_benchmark_io_gpio_set_direction(void *ctx, uint8_t output)
+{
+    gs_counter.turnarounds++;
+    
+    return ds1302_interface_io_gpio_set_direction(ctx, output);
+}
+
+/**
+ * @brief     counting transport begin
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] ce ce level
+ * @return    status code
+ *            - 0 success
+ *            - 1 transport begin failed
+ * @note      none
+ */
+static uint8_t a_benchmark_transport_begin(void *ctx, uint8_t ce)
+{
+    if (a_benchmark_edge(&gs_ce, ce) != 0)
+    {
+        gs_counter.ce_cycles++;
+    }
+    
+    return ds1302_interface_transport_begin(ctx, ce);
+}
+
+/**
+ * @brief     counting transport write bytes
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 transport write bytes failed
+ * @note      the edges inside the transport are derived from the data,
+ *            one sclk pulse per bit and one io change per differing bit
+ */
+static uint8_t a_benchmark_transport_write_bytes(void *ctx, uint8_t *buf, uint8_t len)
+{
+    uint8_t i;
+    uint8_t j;
+    
+    for (j = 0; j < len; j++)
+    {
+        for (i = 0; i < 8; i++)
+        {
+            (void)a_benchmark_edge(&gs_io, (buf[j] >> i) & 0x01);
+        }
+    }
+    gs_counter.edges += (uint32_t)len * 16;
+    gs_counter.bits += (uint32_t)len * 8;
+    
+    return ds1302_interface_transport_write_bytes(ctx, buf, len);
+}
+
+/**
+ * @brief      counting transport read bytes
+ * @param[in]  *ctx pointer to a chip context
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 transport read bytes failed
+ * @note       the edges inside the transport are derived, one sclk pulse per bit
+ */
+static uint8_t a_benchmark_transport_read_bytes(void *ctx, uint8_t *buf, uint8_t len)
+{
+    gs_counter.edges += (uint32_t)len * 16;
+    gs_counter.bits += (uint32_t)len * 8;
+    
+    return ds1302_interface_transport_read_bytes(ctx, buf, len);
+}
+
+/**
+ * @brief  get time operation
+ * @return status code
+ * @note   none
+ */
+static uint8_t a_benchmark_get_time(void)
+{
+    return ds1302_get_time(&gs_handle, &gs_time);
+}
+
+/**
+ * @brief  get compact time operation
+ * @return status code
+ * @note   none
+ */
+static uint8_t a_benchmark_get_compact_time(void)
+{
+    uint32_t compact;
+    
+    return ds1302_get_compact_time(&gs_handle, &compact);
+}
+
+/**
+ * @brief  set time operation
+ * @return status code
+ * @note   none
+ */
+static uint8_t a_benchmark_set_time(void)
+{
+    gs_time.format = DS1302_FORMAT_24H;
+    gs_time.am_pm = DS1302_AM;
+    gs_time.year = 2024;
+    gs_time.month = 2;
+    gs_time.date = 15;
+    gs_time.week = 4;
+    gs_time.hour = 12;
+    gs_time.minute = 0;
+    gs_time.second = 0;
+    
+    return ds1302_set_time(&gs_handle, &gs_time);
+}
+
+/**
+ * @brief  read ram operation
+ * @return status code
+ * @note   none
+ */
+static uint8_t a_benchmark_read_ram(void)
+{
+    return ds1302_read_ram(&gs_handle, 0x00, gs_buf, 31);
+}
+
+/**
+ * @brief  write ram operation
+ * @return status code
+ * @note   none
+ */
+static uint8_t a_benchmark_write_ram(void)
+{
+    return ds1302_write_ram(&gs_handle, 0x00, gs_buf, 31);
+}
+
+/**
+ * @brief  clock burst read operation
+ * @return status code
+ * @note   none
+ */
+static uint8_t a_benchmark_clock_burst_read(void)
+{
+    return ds1302_clock_burst_read(&gs_handle, gs_buf, 8);
+}
+
+/**
+ * @brief  clock burst write operation
+ * @return status code
+ * @note   writes back the clock burst read before, so the time keeps running
+ */
+static uint8_t a_benchmark_clock_burst_write(void)
+{
+    if (ds1302_clock_burst_read(&gs_handle, gs_buf, 8) != 0)
+    {
+        return 1;
+    }
+    
+    return ds1302_clock_burst_write(&gs_handle, gs_buf, 8);
+}
+
+/**
+ * @brief  ram burst read operation
+ * @return status code
+ * @note   none
+ */
+static uint8_t a_benchmark_ram_burst_read(void)
+{
+    return ds1302_ram_burst_read(&gs_handle, gs_buf, 31);
+}
+
+/**
+ * @brief  ram burst write operation
+ * @return status code
+ * @note   none
+ */
+static uint8_t a_benchmark_ram_burst_write(void)
+{
+    return ds1302_ram_burst_write(&gs_handle, gs_buf, 31);
+}
+
+/**
+ * @brief benchmark operation list
+ */
+static const ds1302_benchmark_op_t gsc_ops[] =
+{
+    {"get_time", a_benchmark_get_time},
+    {"get_compact_time", a_benchmark_get_compact_time},
+    {"set_time", a_benchmark_set_time},
+    {"read_ram", a_benchmark_read_ram},
+    {"write_ram", a_benchmark_write_ram},
+    {"clock_burst_read", a_benchmark_clock_burst_read},
+    {"clock_burst_write", a_benchmark_clock_burst_write},
+    {"ram_burst_read", a_benchmark_ram_burst_read},
+    {"ram_burst_write", a_benchmark_ram_burst_write},
+};
+
+/**
+ * @brief     benchmark
+ * @param[in] format output format
+ * @param[in] times calls per operation
+ * @return    status code
+ *            - 0 success
+ *            - 1 benchmark failed
+ * @note      every public transfer is run with the gpio and the byte transport,
+ *            the bus is counted by wrapping the interface callbacks, so any backend works,
+ *            only the csv or json text is printed, with DS1302_STATIC_PORT the gpio bit loops
+ *            bypass the wrapped callbacks and only the byte transport rows are counted
+ */
+uint8_t ds1302_benchmark(ds1302_benchmark_format_t format, uint32_t times)
+{
+    const ds1302_transport_t transports[2] = {DS1302_TRANSPORT_GPIO, DS1302_TRANSPORT_BYTE};
+    const char *transport_names[2] = {"gpio", "byte"};
+    uint8_t first;
+    uint8_t t;
+    uint8_t k;
+    uint32_t i;
+    
+    /* link functions */
+    DRIVER_DS1302_LINK_INIT(&gs_handle, ds1302_handle_t);
+    DRIVER_DS1302_LINK_CE_GPIO_INIT(&gs_handle, ds1302_interface_ce_gpio_init);
+    DRIVER_DS1302_LINK_CE_GPIO_DEINIT(&gs_handle, ds1302_interface_ce_gpio_deinit);
+    DRIVER_DS1302_LINK_CE_GPIO_WRITE(&gs_handle, a_benchmark_ce_gpio_write);
+    DRIVER_DS1302_LINK_SCLK_GPIO_INIT(&gs_handle, ds1302_interface_sclk_gpio_init);
+    DRIVER_DS1302_LINK_SCLK_GPIO_DEINIT(&gs_handle, ds1302_interface_sclk_gpio_deinit);
+    DRIVER_DS1302_LINK_SCLK_GPIO_WRITE(&gs_handle, a_benchmark_sclk_gpio_write);
+    DRIVER_DS1302_LINK_IO_GPIO_INIT(&gs_handle, ds1302_interface_io_gpio_init);
+    DRIVER_DS1302_LINK_IO_GPIO_DEINIT(&gs_handle, ds1302_interface_io_gpio_deinit);
+    DRIVER_DS1302_LINK_IO_GPIO_WRITE(&gs_handle, a_benchmark_io_gpio_write);
+    DRIVER_DS1302_LINK_IO_GPIO_READ(&gs_handle, ds1302_interface_io_gpio_read);
+    DRIVER_DS1302_LINK_IO_GPIO_SET_DIRECTION(&gs_handle, a_benchmark_io_gpio_set_direction);
+    DRIVER_DS1302_LINK_TRANSPORT_BEGIN(&gs_handle, a_benchmark_transport_begin);
+    DRIVER_DS1302_LINK_TRANSPORT_WRITE_BYTES(&gs_handle, a_benchmark_transport_write_bytes);
+    DRIVER_DS1302_LINK_TRANSPORT_READ_BYTES(&gs_handle, a_benchmark_transport_read_bytes);
+    DRIVER_DS1302_LINK_DELAY_US(&gs_handle, ds1302_interface_delay_us);
+    DRIVER_DS1302_LINK_DELAY_MS(&gs_handle, ds1302_interface_delay_ms);
+    DRIVER_DS1302_LINK_DEBUG_PRINT(&gs_handle, ds1302_interface_debug_print);
+    DRIVER_DS1302_LINK_TIMESTAMP_US(&gs_handle, ds1302_interface_timestamp_us);
+    
+    /* check the times */
+    if (times == 0)
+    {
+        times = 1;
+    }
+    
+    /* print the header */
+    if (format == DS1302_BENCHMARK_FORMAT_CSV)
+    {
+        ds1302_interface_debug_print("transport,operation,calls,edges,ce_cycles,bytes,turnarounds,latency_us,calls_per_second\n");
+    }
+    else
+    {
+        ds1302_interface_debug_print("[\n");
+    }
+    
+    first = 1;
+    for (t = 0; t < 2; t++)
+    {
+        /* set the transport */
+        if (ds1302_set_transport(&gs_handle, transports[t]) != 0)
+        {
+            return 1;
+        }
+        
+        /* init ds1302 */
+        if (ds1302_init(&gs_handle) != 0)
+        {
+            return 1;
+        }
+        gs_ce = 0;
+        gs_sclk = 0;
+        gs_io = 0;
+        
+        /* run the oscillator and disable write protect */
+        if ((ds1302_set_oscillator(&gs_handle, DS1302_BOOL_TRUE) != 0) ||
+            (ds1302_set_write_protect(&gs_handle, DS1302_BOOL_FALSE) != 0))
+        {
+            (void)ds1302_deinit(&gs_handle);
+            
+            return 1;
+        }
+        
+        for (k = 0; k < sizeof(gsc_ops) / sizeof(gsc_ops[0]); k++)
+        {
+            uint32_t start;
+            uint32_t stop;
+            double latency;
+            double rate;
+            
+            /* run the operation */
+            memset(&gs_counter, 0, sizeof(ds1302_benchmark_counter_t));
+            start = ds1302_interface_timestamp_us();
+            for (i = 0; i < times; i++)
+            {
+                if (gsc_ops[k].run() != 0)
+                {
+                    (void)ds1302_deinit(&gs_handle);
+                    
+                    return 1;
+                }
+            }
+            stop = ds1302_interface_timestamp_us();
+            
+            /* output the row */
+            latency = (double)(uint32_t)(stop - start) / (double)times;
+            rate = (latency > 0.0) ? (1000000.0 / latency) : 0.0;
+            if (format == DS1302_BENCHMARK_FORMAT_CSV)
+            {
+                ds1302_interface_debug_print("%s,%s,%u,%.1f,%.1f,%.1f,%.1f,%.2f,%.1f\n",
+                                             transport_names[t], gsc_ops[k].name, (unsigned int)times,
+                                             (double)gs_counter.edges / times, (double)gs_counter.ce_cycles / times,
+                                             (double)gs_counter.bits / 8.0 / times, (double)gs_counter.turnarounds / times,
+                                             latency, rate);
+            }
+            else
+            {
+                ds1302_interface_debug_print("%s  {\"transport\": \"%s\", \"operation\": \"%s\", \"calls\": %u, "
+                                             "\"edges\": %.1f, \"ce_cycles\": %.1f, \"bytes\": %.1f, \"turnarounds\": %.1f, "
+                                             "\"latency_us\": %.2f, \"calls_per_second\": %.1f}",
+                                             (first != 0) ? "" : ",\n",
+                                             transport_names[t], gsc_ops[k].name, (unsigned int)times,
+                                             (double)gs_counter.edges / times, (double)gs_counter.ce_cycles / times,
+                                             (double)gs_counter.bits / 8.0 / times, (double)gs_counter.turnarounds / times,
+                                             latency, rate);
+            }
+            first = 0;
+        }
+        
+        /* deinit ds1302 */
+        (void)ds1302_deinit(&gs_handle);
+    }
+    
+    /* print the tail */
+    if (format == DS1302_BENCHMARK_FORMAT_JSON)
+    {
+        ds1302_interface_debug_print("\n]\n");
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     benchmark cycles per byte
+ * @param[in] cpu_mhz core clock in MHz
+ * @param[in] times calls per operation
+ * @return    status code
+ *            - 0 success
+ *            - 1 benchmark failed
+ * @note      the bursts run on the real gpio hooks and the bus bytes include the command,
+ *            the overhead leaves out the 1us bit delays, build once with and once without
+ *            DS1302_STATIC_PORT to compare
+ */
+uint8_t ds1302_benchmark_cycles(uint32_t cpu_mhz, uint32_t times)
+{
+    const char *names[3] = {"clock_burst_read", "ram_burst_read", "ram_burst_write"};
+    const uint8_t lens[3] = {8, 31, 31};
+    const uint8_t delays[3] = {8, 8, 16};
+    uint8_t k;
+    uint32_t i;
+    
+    /* link functions */
+    DRIVER_DS1302_LINK_INIT(&gs_handle, ds1302_handle_t);
+    DRIVER_DS1302_LINK_CE_GPIO_INIT(&gs_handle, ds1302_interface_ce_gpio_init);
+    DRIVER_DS1302_LINK_CE_GPIO_DEINIT(&gs_handle, ds1302_interface_ce_gpio_deinit);
+    DRIVER_DS1302_LINK_CE_GPIO_WRITE(&gs_handle, ds1302_interface_ce_gpio_write);
+    DRIVER_DS1302_LINK_SCLK_GPIO_INIT(&gs_handle, ds1302_interface_sclk_gpio_init);
+    DRIVER_DS1302_LINK_SCLK_GPIO_DEINIT(&gs_handle, ds1302_interface_sclk_gpio_deinit);
+    DRIVER_DS1302_LINK_SCLK_GPIO_WRITE(&gs_handle, ds1302_interface_sclk_gpio_write);
+    DRIVER_DS1302_LINK_IO_GPIO_INIT(&gs_handle, ds1302_interface_io_gpio_init);
+    DRIVER_DS1302_LINK_IO_GPIO_DEINIT(&gs_handle, ds1302_interface_io_gpio_deinit);
+    DRIVER_DS1302_LINK_IO_GPIO_WRITE(&gs_handle, ds1302_interface_io_gpio_write);
+    DRIVER_DS1302_LINK_IO_GPIO_READ(&gs_handle, ds1302_interface_io_gpio_read);
+    DRIVER_DS1302_LINK_IO_GPIO_SET_DIRECTION(&gs_handle, ds1302_interface_io_gpio_set_direction);
+    DRIVER_DS1302_LINK_TRANSPORT_BEGIN(&gs_handle, ds1302_interface_transport_begin);
+    DRIVER_DS1302_LINK_TRANSPORT_WRITE_BYTES(&gs_handle, ds1302_interface_transport_write_bytes);
+    DRIVER_DS1302_LINK_TRANSPORT_READ_BYTES(&gs_handle, ds1302_interface_transport_read_bytes);
+    DRIVER_DS1302_LINK_DELAY_US(&gs_handle, ds1302_interface_delay_us);
+    DRIVER_DS1302_LINK_DELAY_MS(&gs_handle, ds1302_interface_delay_ms);
+    DRIVER_DS1302_LINK_DEBUG_PRINT(&gs_handle, ds1302_interface_debug_print);
+    DRIVER_DS1302_LINK_TIMESTAMP_US(&gs_handle, ds1302_interface_timestamp_us);
+    
+    /* check the times */
+    if (times == 0)
+    {
+        times = 1;
+    }
+    
+    /* the bit loops only run on the gpio transport */
+    if (ds1302_set_transport(&gs_handle, DS1302_TRANSPORT_GPIO) != 0)
+    {
+        return 1;
+    }
+    
+    /* init ds1302 */
+    if (ds1302_init(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    
+    /* run the oscillator and disable write protect */
+    if ((ds1302_set_oscillator(&gs_handle, DS1302_BOOL_TRUE) != 0) ||
+        (ds1302_set_write_protect(&gs_handle, DS1302_BOOL_FALSE) != 0))
+    {
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* print the header */
+    ds1302_interface_debug_print("static_port,operation,calls,bytes,cycles_per_byte,overhead_cycles_per_byte\n");
+    
+    for (k = 0; k < 3; k++)
+    {
+        uint32_t start;
+        uint32_t stop;
+        uint8_t res;
+        double cycles;
+        double overhead;
+        
+        /* run the operation */
+        start = ds1302_interface_timestamp_us();
+        for (i = 0; i < times; i++)
+        {
+            if (k == 0)
+            {
+                res = ds1302_clock_burst_read(&gs_handle, gs_buf, 8);
+            }
+            else if (k == 1)
+            {
+                res = ds1302_ram_burst_read(&gs_handle, gs_buf, 31);
+            }
+            else
+            {
+                res = ds1302_ram_burst_write(&gs_handle, gs_buf, 31);
+            }
+            if (res != 0)
+            {
+                (void)ds1302_deinit(&gs_handle);
+                
+                return 1;
+            }
+        }
+        stop = ds1302_interface_timestamp_us();
+        
+        /* the command byte has two delays per bit like any written byte */
+        cycles = (double)(uint32_t)(stop - start) * (double)cpu_mhz / (double)times / (double)(lens[k] + 1);
+        overhead = cycles - (double)(16 + delays[k] * lens[k]) * (double)cpu_mhz / (double)(lens[k] + 1);
+        ds1302_interface_debug_print("%d,%s,%u,%u,%.1f,%.1f\n", DS1302_STATIC_PORT, names[k], (unsigned int)times,
+                                     (unsigned int)(lens[k] + 1), cycles, overhead);
+    }
+    
+    /* deinit ds1302 */
+    (void)ds1302_deinit(&gs_handle);
+    
+    return 0;
+}
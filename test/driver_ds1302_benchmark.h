@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1302_benchmark.h
+ * @brief     driver ds1302 benchmark header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_DS1302_BENCHMARK_H
+#define DRIVER_DS1302_BENCHMARK_H
+
+#include "driver_ds1302_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup ds1302_test_driver
+ * @{
+ */
+
+/**
+ * @brief ds1302 benchmark format enumeration definition
+ */
+typedef enum
+{
+    DS1302_BENCHMARK_FORMAT_CSV  = 0x00,        /**< csv rows */
+    DS1302_BENCHMARK_FORMAT_JSON = 0x01,        /**< json array */
+} ds1302_benchmark_format_t;
+
+/**
+ * @brief     benchmark
+ * @param[in] format output format
+ * @param[in] times calls per operation
+ * @return    status code
+ *            - 0 success
+ *            - 1 benchmark failed
+ * @note      every public transfer is run with the gpio and the byte transport,
+ *            the bus is counted by wrapping the interface callbacks, so any backend works,
+ *            only the csv or json text is printed, with DS1302_STATIC_PORT the gpio bit loops
+ *            bypass the wrapped callbacks and only the byte transport rows are counted
+ */
+uint8_t ds1302_benchmark(ds1302_benchmark_format_t format, uint32_t times);
+
+/**
+ * @brief     benchmark cycles per byte
+ * @param[in] cpu_mhz core clock in MHz
+ * @param[in] times calls per operation
+ * @return    status code
+ *            - 0 success
+ *            - 1 benchmark failed
+ * @note      the bursts run on the real gpio hooks and the bus bytes include the command,
+ *            the overhead leaves out the 1us bit delays, build once with and once without
+ *            DS1302_STATIC_PORT to compare
+ */
+uint8_t ds1302_benchmark_cycles(uint32_t cpu_mhz, uint32_t times);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
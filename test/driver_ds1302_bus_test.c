@@ -0,0 +1,402 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1302_bus_test.c
+ * @brief     driver ds1302 bus test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds1302_bus_test.h"
+
+/**
+ * @brief bus test chips definition
+ */
+#ifndef DS1302_BUS_TEST_CHIPS
+    #define DS1302_BUS_TEST_CHIPS 3        /**< 3 chips */
+#endif
+
+/**
+ * @brief bus test ram address definition
+ */
+#define DS1302_BUS_TEST_RAM_ADDR 0        /**< scratch ram byte */
+
+static ds1302_bus_t gs_bus;                                   /**< ds1302 bus */
+static ds1302_handle_t gs_handle[DS1302_BUS_TEST_CHIPS];      /**< ds1302 handles */
+static uint8_t gs_index[DS1302_BUS_TEST_CHIPS];               /**< chip contexts */
+static uint32_t gs_turnarounds;                               /**< io direction changes */
+
+/**
+ * @brief     counting io gpio set direction
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] output direction, 0 is input and 1 is output
+ * @return    status code
+ *            - 0 success
+ *            - 1 io gpio set direction failed
+ * @note      none
+ */
+static uint8_t a_bus_test_io_gpio_set_direction(void *ctx, uint8_t output)
+{
+    gs_turnarounds++;
+    
+    return ds1302_interface_io_gpio_set_direction(ctx, output);
+}
+
+/**
+ * @brief     set time operation
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] index chip index
+ * @param[in] *arg pointer to a time structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 set time failed
+ * @note      none
+ */
+static uint8_t a_bus_test_set_time(ds1302_handle_t *handle, uint8_t index, void *arg)
+{
+    if (ds1302_set_write_protect(handle, DS1302_BOOL_FALSE) != 0)
+    {
+        return 1;
+    }
+    if (ds1302_set_oscillator(handle, DS1302_BOOL_TRUE) != 0)
+    {
+        return 1;
+    }
+    
+    return ds1302_set_time(handle, (ds1302_time_t *)arg);
+}
+
+/**
+ * @brief     get time operation
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] index chip index
+ * @param[in] *arg pointer to a time array
+ * @return    status code
+ *            - 0 success
+ *            - 1 get time failed
+ * @note      none
+ */
+static uint8_t a_bus_test_get_time(ds1302_handle_t *handle, uint8_t index, void *arg)
+{
+    return ds1302_get_time(handle, &((ds1302_time_t *)arg)[index]);
+}
+
+/**
+ * @brief     write ram operation
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] index chip index
+ * @param[in] *arg unused
+ * @return    status code
+ *            - 0 success
+ *            - 1 write ram failed
+ * @note      chip n gets 0xA0 + n
+ */
+static uint8_t a_bus_test_write_ram(ds1302_handle_t *handle, uint8_t index, void *arg)
+{
+    uint8_t data;
+    
+    data = (uint8_t)(0xA0 + index);
+    
+    return ds1302_write_ram(handle, DS1302_BUS_TEST_RAM_ADDR, &data, 1);
+}
+
+/**
+ * @brief     read ram operation
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] index chip index
+ * @param[in] *arg pointer to a data array
+ * @return    status code
+ *            - 0 success
+ *            - 1 read ram failed
+ * @note      none
+ */
+static uint8_t a_bus_test_read_ram(ds1302_handle_t *handle, uint8_t index, void *arg)
+{
+    return ds1302_read_ram(handle, DS1302_BUS_TEST_RAM_ADDR, &((uint8_t *)arg)[index], 1);
+}
+
+/**
+ * @brief  bus test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   chip n gets a context pointing to the index n, a port that wires
+ *         a single ce ignores the context and all handles reach the same chip
+ */
+uint8_t ds1302_bus_test(void)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t index;
+    uint8_t distinct;
+    uint8_t data[DS1302_BUS_TEST_CHIPS];
+    uint32_t failed;
+    uint32_t turnarounds;
+    uint32_t ref;
+    uint32_t now;
+    ds1302_time_t t;
+    ds1302_time_t get[DS1302_BUS_TEST_CHIPS];
+    ds1302_handle_t *handle;
+    
+    /* start bus test */
+    ds1302_interface_debug_print("ds1302: start bus test.\n");
+    
+    /* link the chips */
+    DRIVER_DS1302_BUS_LINK_INIT(&gs_bus, ds1302_bus_t);
+    for (i = 0; i < DS1302_BUS_TEST_CHIPS; i++)
+    {
+        gs_index[i] = i;
+        DRIVER_DS1302_LINK_INIT(&gs_handle[i], ds1302_handle_t);
+        DRIVER_DS1302_LINK_CE_GPIO_INIT(&gs_handle[i], ds1302_interface_ce_gpio_init);
+        DRIVER_DS1302_LINK_CE_GPIO_DEINIT(&gs_handle[i], ds1302_interface_ce_gpio_deinit);
+        DRIVER_DS1302_LINK_CE_GPIO_WRITE(&gs_handle[i], ds1302_interface_ce_gpio_write);
+        DRIVER_DS1302_LINK_SCLK_GPIO_INIT(&gs_handle[i], ds1302_interface_sclk_gpio_init);
+        DRIVER_DS1302_LINK_SCLK_GPIO_DEINIT(&gs_handle[i], ds1302_interface_sclk_gpio_deinit);
+        DRIVER_DS1302_LINK_SCLK_GPIO_WRITE(&gs_handle[i], ds1302_interface_sclk_gpio_write);
+        DRIVER_DS1302_LINK_IO_GPIO_INIT(&gs_handle[i], ds1302_interface_io_gpio_init);
+        DRIVER_DS1302_LINK_IO_GPIO_DEINIT(&gs_handle[i], ds1302_interface_io_gpio_deinit);
+        DRIVER_DS1302_LINK_IO_GPIO_WRITE(&gs_handle[i], ds1302_interface_io_gpio_write);
+        DRIVER_DS1302_LINK_IO_GPIO_READ(&gs_handle[i], ds1302_interface_io_gpio_read);
+        DRIVER_DS1302_LINK_IO_GPIO_SET_DIRECTION(&gs_handle[i], a_bus_test_io_gpio_set_direction);
+        DRIVER_DS1302_LINK_TRANSPORT_BEGIN(&gs_handle[i], ds1302_interface_transport_begin);
+        DRIVER_DS1302_LINK_TRANSPORT_WRITE_BYTES(&gs_handle[i], ds1302_interface_transport_write_bytes);
+        DRIVER_DS1302_LINK_TRANSPORT_READ_BYTES(&gs_handle[i], ds1302_interface_transport_read_bytes);
+        DRIVER_DS1302_LINK_DELAY_US(&gs_handle[i], ds1302_interface_delay_us);
+        DRIVER_DS1302_LINK_DELAY_MS(&gs_handle[i], ds1302_interface_delay_ms);
+        DRIVER_DS1302_LINK_DEBUG_PRINT(&gs_handle[i], ds1302_interface_debug_print);
+        DRIVER_DS1302_LINK_TIMESTAMP_US(&gs_handle[i], ds1302_interface_timestamp_us);
+        DRIVER_DS1302_LINK_CONTEXT(&gs_handle[i], &gs_index[i]);
+        
+        /* attach the chip */
+        res = ds1302_bus_attach(&gs_bus, &gs_handle[i], &index);
+        if ((res != 0) || (index != i))
+        {
+            ds1302_interface_debug_print("ds1302: bus attach failed.\n");
+            
+            return 1;
+        }
+    }
+    
+    /* init the bus */
+    res = ds1302_bus_init(&gs_bus);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: bus init failed.\n");
+        
+        return 1;
+    }
+    ds1302_interface_debug_print("ds1302: %d chips on the bus.\n", DS1302_BUS_TEST_CHIPS);
+    
+    /* bus sweep test */
+    ds1302_interface_debug_print("ds1302: bus sweep test.\n");
+    
+    /* set the same time on all chips */
+    t.year = 2024;
+    t.month = 2;
+    t.date = 15;
+    t.week = 4;
+    t.hour = 12;
+    t.minute = 30;
+    t.second = 0;
+    t.format = DS1302_FORMAT_24H;
+    t.am_pm = DS1302_AM;
+    res = ds1302_bus_sweep(&gs_bus, a_bus_test_set_time, &t, &failed);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: bus sweep set time failed 0x%08X.\n", (unsigned int)failed);
+        (void)ds1302_bus_deinit(&gs_bus);
+        
+        return 1;
+    }
+    ds1302_interface_delay_ms(1000);
+    
+    /* read all chips back */
+    res = ds1302_bus_sweep(&gs_bus, a_bus_test_get_time, get, &failed);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: bus sweep get time failed 0x%08X.\n", (unsigned int)failed);
+        (void)ds1302_bus_deinit(&gs_bus);
+        
+        return 1;
+    }
+    (void)ds1302_time_to_unix(&t, &ref);
+    for (i = 0; i < DS1302_BUS_TEST_CHIPS; i++)
+    {
+        (void)ds1302_time_to_unix(&get[i], &now);
+        ds1302_interface_debug_print("ds1302: chip %d time is %04d-%02d-%02d %02d:%02d:%02d.\n", i,
+                                     get[i].year, get[i].month, get[i].date,
+                                     get[i].hour, get[i].minute, get[i].second);
+        if ((now < ref) || (now - ref > 2))
+        {
+            ds1302_interface_debug_print("ds1302: check time error.\n");
+            (void)ds1302_bus_deinit(&gs_bus);
+            
+            return 1;
+        }
+    }
+    ds1302_interface_debug_print("ds1302: check time ok.\n");
+    
+    /* ce selection test */
+    ds1302_interface_debug_print("ds1302: bus ce selection test.\n");
+    
+    /* give every chip its own ram byte */
+    res = ds1302_bus_sweep(&gs_bus, a_bus_test_write_ram, NULL, &failed);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: bus sweep write ram failed 0x%08X.\n", (unsigned int)failed);
+        (void)ds1302_bus_deinit(&gs_bus);
+        
+        return 1;
+    }
+    res = ds1302_bus_sweep(&gs_bus, a_bus_test_read_ram, data, &failed);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: bus sweep read ram failed 0x%08X.\n", (unsigned int)failed);
+        (void)ds1302_bus_deinit(&gs_bus);
+        
+        return 1;
+    }
+    distinct = 0;
+    for (i = 0; i < DS1302_BUS_TEST_CHIPS; i++)
+    {
+        if (data[i] == (uint8_t)(0xA0 + i))
+        {
+            distinct++;
+        }
+        else if (data[i] != (uint8_t)(0xA0 + DS1302_BUS_TEST_CHIPS - 1))
+        {
+            /* neither its own byte nor the last one written to a shared chip */
+            ds1302_interface_debug_print("ds1302: check ram error.\n");
+            (void)ds1302_bus_deinit(&gs_bus);
+            
+            return 1;
+        }
+    }
+    ds1302_interface_debug_print("ds1302: %d chips kept their own ram byte.\n", distinct);
+    
+    /* alternate writes and reads across the chips, a chip switch never costs an extra turnaround */
+    for (i = 0; i < 2 * DS1302_BUS_TEST_CHIPS; i++)
+    {
+        index = (uint8_t)(i % DS1302_BUS_TEST_CHIPS);
+        res = ds1302_bus_acquire(&gs_bus, index, &handle);
+        if (res != 0)
+        {
+            ds1302_interface_debug_print("ds1302: bus acquire failed.\n");
+            (void)ds1302_bus_deinit(&gs_bus);
+            
+            return 1;
+        }
+        gs_turnarounds = 0;
+        if ((i % 2) == 0)
+        {
+            res = a_bus_test_write_ram(handle, index, NULL);
+        }
+        else
+        {
+            res = a_bus_test_read_ram(handle, index, data);
+        }
+        turnarounds = gs_turnarounds;
+        (void)ds1302_bus_release(&gs_bus);
+        if (res != 0)
+        {
+            ds1302_interface_debug_print("ds1302: %s ram failed.\n", ((i % 2) == 0) ? "write" : "read");
+            (void)ds1302_bus_deinit(&gs_bus);
+            
+            return 1;
+        }
+        if ((handle->transport == DS1302_TRANSPORT_GPIO) && (turnarounds != 1))
+        {
+            ds1302_interface_debug_print("ds1302: chip %d needs %d io turnarounds.\n", index, (int)turnarounds);
+            ds1302_interface_debug_print("ds1302: check turnarounds error.\n");
+            (void)ds1302_bus_deinit(&gs_bus);
+            
+            return 1;
+        }
+    }
+    ds1302_interface_debug_print("ds1302: check turnarounds ok.\n");
+    
+    /* arbitration test */
+    ds1302_interface_debug_print("ds1302: bus arbitration test.\n");
+    
+    /* acquire the last chip */
+    res = ds1302_bus_acquire(&gs_bus, DS1302_BUS_TEST_CHIPS - 1, &handle);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: bus acquire failed.\n");
+        (void)ds1302_bus_deinit(&gs_bus);
+        
+        return 1;
+    }
+    res = ds1302_get_time(handle, &t);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: get time failed.\n");
+        (void)ds1302_bus_release(&gs_bus);
+        (void)ds1302_bus_deinit(&gs_bus);
+        
+        return 1;
+    }
+    
+    /* a held bus refuses other chips, sweeps and deinit */
+    if ((ds1302_bus_acquire(&gs_bus, 0, &handle) != 1) ||
+        (ds1302_bus_sweep(&gs_bus, a_bus_test_get_time, get, &failed) != 4) ||
+        (ds1302_bus_deinit(&gs_bus) != 4))
+    {
+        ds1302_interface_debug_print("ds1302: check arbitration error.\n");
+        (void)ds1302_bus_release(&gs_bus);
+        (void)ds1302_bus_deinit(&gs_bus);
+        
+        return 1;
+    }
+    
+    /* release the bus */
+    res = ds1302_bus_release(&gs_bus);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: bus release failed.\n");
+        (void)ds1302_bus_deinit(&gs_bus);
+        
+        return 1;
+    }
+    if (ds1302_bus_release(&gs_bus) != 4)
+    {
+        ds1302_interface_debug_print("ds1302: check arbitration error.\n");
+        (void)ds1302_bus_deinit(&gs_bus);
+        
+        return 1;
+    }
+    ds1302_interface_debug_print("ds1302: check arbitration ok.\n");
+    
+    /* finish bus test */
+    ds1302_interface_debug_print("ds1302: finish bus test.\n");
+    (void)ds1302_bus_deinit(&gs_bus);
+    
+    return 0;
+}
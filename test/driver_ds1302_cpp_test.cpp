@@ -0,0 +1,273 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1302_cpp_test.cpp
+ * @brief     driver ds1302 c++ test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds1302_cpp_test.h"
+#include "driver_ds1302.hpp"
+#include <cstdlib>
+
+namespace
+{
+
+constexpr ds1302_time_t gk_time = {2024, 2, 4, 15, 11, 59, 58, DS1302_FORMAT_12H, DS1302_PM};        /**< test time */
+
+static_assert(ds1302::check_time(gk_time), "test time is valid");
+static_assert(ds1302::encode_time(gk_time)[2] == ((1 << 7) | (1 << 5) | 0x11), "12h hour register");
+static_assert(ds1302::decode_time(ds1302::encode_time(gk_time)).hour == 11, "hour round trip");
+
+/**
+ * @brief     compare two times
+ * @param[in] a time
+ * @param[in] b time
+ * @return    true if equal
+ * @note      none
+ */
+bool a_cpp_test_time_equal(const ds1302_time_t &a, const ds1302_time_t &b)
+{
+    return (a.year == b.year) && (a.month == b.month) && (a.week == b.week) && (a.date == b.date) &&
+           (a.hour == b.hour) && (a.minute == b.minute) && (a.second == b.second) &&
+           (a.format == b.format) && ((a.format == DS1302_FORMAT_24H) || (a.am_pm == b.am_pm));
+}
+
+/**
+ * @brief     run the checks on one driver
+ * @param[in] &chip ds1302 driver
+ * @param[in] *name transport name
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      none
+ */
+template <class Transport>
+uint8_t a_cpp_test_run(ds1302::Ds1302<Transport> &chip, const char *name)
+{
+    ds1302_time_t time_in;
+    ds1302_time_t time_out;
+    std::array<uint8_t, ds1302::ram_len> ram;
+    std::array<uint8_t, ds1302::ram_len> ram_check;
+    std::array<uint8_t, 4> part;
+    bool enable;
+    uint8_t charge;
+    
+    ds1302_interface_debug_print("ds1302: %s transport.\n", name);
+    
+    /* not inited */
+    if (chip.get_time(time_out) != 3)
+    {
+        ds1302_interface_debug_print("ds1302: not inited check failed.\n");
+        
+        return 1;
+    }
+    
+    /* init */
+    if (chip.init() != 0)
+    {
+        ds1302_interface_debug_print("ds1302: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* start the oscillator and clear write protect */
+    if ((chip.set_write_protect(false) != 0) || (chip.set_oscillator(true) != 0))
+    {
+        ds1302_interface_debug_print("ds1302: set oscillator failed.\n");
+        (void)chip.deinit();
+        
+        return 1;
+    }
+    if ((chip.get_oscillator(enable) != 0) || !enable)
+    {
+        ds1302_interface_debug_print("ds1302: check oscillator error.\n");
+        (void)chip.deinit();
+        
+        return 1;
+    }
+    
+    /* 12h time */
+    time_in = gk_time;
+    if (chip.set_time(time_in) != 0)
+    {
+        ds1302_interface_debug_print("ds1302: set time failed.\n");
+        (void)chip.deinit();
+        
+        return 1;
+    }
+    if (chip.get_time(time_out) != 0)
+    {
+        ds1302_interface_debug_print("ds1302: get time failed.\n");
+        (void)chip.deinit();
+        
+        return 1;
+    }
+    time_in.second = time_out.second;
+    if (!a_cpp_test_time_equal(time_in, time_out))
+    {
+        ds1302_interface_debug_print("ds1302: check 12h time error.\n");
+        (void)chip.deinit();
+        
+        return 1;
+    }
+    
+    /* 24h time under write protect */
+    time_in = {2099, 12, 7, 31, 23, 30, 0, DS1302_FORMAT_24H, DS1302_AM};
+    if (chip.set_write_protect(true) != 0)
+    {
+        ds1302_interface_debug_print("ds1302: set write protect failed.\n");
+        (void)chip.deinit();
+        
+        return 1;
+    }
+    if ((chip.set_time(time_in) != 0) || (chip.get_time(time_out) != 0))
+    {
+        ds1302_interface_debug_print("ds1302: set time failed.\n");
+        (void)chip.deinit();
+        
+        return 1;
+    }
+    time_in.second = time_out.second;
+    if (!a_cpp_test_time_equal(time_in, time_out) || (chip.get_write_protect(enable) != 0) || !enable)
+    {
+        ds1302_interface_debug_print("ds1302: check 24h time error.\n");
+        (void)chip.deinit();
+        
+        return 1;
+    }
+    if (chip.set_write_protect(false) != 0)
+    {
+        ds1302_interface_debug_print("ds1302: set write protect failed.\n");
+        (void)chip.deinit();
+        
+        return 1;
+    }
+    
+    /* invalid time */
+    time_in.hour = 24;
+    if (chip.set_time(time_in) != 4)
+    {
+        ds1302_interface_debug_print("ds1302: check invalid time error.\n");
+        (void)chip.deinit();
+        
+        return 1;
+    }
+    
+    /* charge */
+    if ((chip.set_charge(DS1302_CHARGE_ENABLE | DS1302_CHARGE_1_DIODE | DS1302_CHARGE_2K) != 0) ||
+        (chip.get_charge(charge) != 0) ||
+        (charge != (DS1302_CHARGE_ENABLE | DS1302_CHARGE_1_DIODE | DS1302_CHARGE_2K)))
+    {
+        ds1302_interface_debug_print("ds1302: check charge error.\n");
+        (void)chip.deinit();
+        
+        return 1;
+    }
+    (void)chip.set_charge(DS1302_CHARGE_DISABLE);
+    
+    /* ram burst */
+    for (uint8_t i = 0; i < ds1302::ram_len; i++)
+    {
+        ram[i] = static_cast<uint8_t>(std::rand() % 256);
+    }
+    if ((chip.ram_burst_write(ram) != 0) || (chip.ram_burst_read(ram_check) != 0) || (ram != ram_check))
+    {
+        ds1302_interface_debug_print("ds1302: check ram burst error.\n");
+        (void)chip.deinit();
+        
+        return 1;
+    }
+    
+    /* ram bytes */
+    part = {0x5A, 0xA5, 0x00, 0xFF};
+    if ((chip.write_ram(27, part) != 0) || (chip.read_ram(0, ram_check) != 0) ||
+        !std::equal(part.begin(), part.end(), ram_check.begin() + 27) ||
+        !std::equal(ram.begin(), ram.begin() + 27, ram_check.begin()))
+    {
+        ds1302_interface_debug_print("ds1302: check ram error.\n");
+        (void)chip.deinit();
+        
+        return 1;
+    }
+    if ((chip.read_ram(31, part) != 4) || (chip.read_ram(28, part) != 5))
+    {
+        ds1302_interface_debug_print("ds1302: check ram range error.\n");
+        (void)chip.deinit();
+        
+        return 1;
+    }
+    
+    /* deinit */
+    if (chip.deinit() != 0)
+    {
+        ds1302_interface_debug_print("ds1302: deinit failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+}
+
+/**
+ * @brief  c++ driver test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   runs the template driver over the gpio and the byte transport
+ */
+uint8_t ds1302_cpp_test(void)
+{
+    ds1302::Ds1302<ds1302::gpio_transport<ds1302::interface_pins>> gpio_chip;
+    ds1302::Ds1302<ds1302::byte_transport> byte_chip;
+    
+    /* start c++ test */
+    ds1302_interface_debug_print("ds1302: start c++ test.\n");
+    
+    /* gpio transport */
+    if (a_cpp_test_run(gpio_chip, "gpio") != 0)
+    {
+        return 1;
+    }
+    
+    /* byte transport */
+    if (a_cpp_test_run(byte_chip, "byte") != 0)
+    {
+        return 1;
+    }
+    
+    /* finish c++ test */
+    ds1302_interface_debug_print("ds1302: finish c++ test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,360 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1302_drift_test.c
+ * @brief     driver ds1302 drift test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds1302_drift_test.h"
+
+/**
+ * @brief drift test definition
+ */
+#define DRIFT_TEST_START         761270400U        /**< 2024-02-15 00:00:00 */
+#define DRIFT_TEST_RESTART       763862400U        /**< 2024-03-16 00:00:00 */
+#define DRIFT_TEST_ELAPSED_S     100000U           /**< 1 day 3:46:40 */
+#define DRIFT_TEST_WINDOW_S      3000U             /**< measure window */
+#define DRIFT_TEST_MEASURE_PPB   1000              /**< measure bound */
+
+static ds1302_handle_t gs_handle;        /**< ds1302 handle */
+
+/**
+ * @brief  link and init the handle
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   the handle state is lost like after a reboot
+ */
+static uint8_t a_drift_test_init(void)
+{
+    /* link functions */
+    DRIVER_DS1302_LINK_INIT(&gs_handle, ds1302_handle_t);
+    DRIVER_DS1302_LINK_CE_GPIO_INIT(&gs_handle, ds1302_interface_ce_gpio_init);
+    DRIVER_DS1302_LINK_CE_GPIO_DEINIT(&gs_handle, ds1302_interface_ce_gpio_deinit);
+    DRIVER_DS1302_LINK_CE_GPIO_WRITE(&gs_handle, ds1302_interface_ce_gpio_write);
+    DRIVER_DS1302_LINK_SCLK_GPIO_INIT(&gs_handle, ds1302_interface_sclk_gpio_init);
+    DRIVER_DS1302_LINK_SCLK_GPIO_DEINIT(&gs_handle, ds1302_interface_sclk_gpio_deinit);
+    DRIVER_DS1302_LINK_SCLK_GPIO_WRITE(&gs_handle, ds1302_interface_sclk_gpio_write);
+    DRIVER_DS1302_LINK_IO_GPIO_INIT(&gs_handle, ds1302_interface_io_gpio_init);
+    DRIVER_DS1302_LINK_IO_GPIO_DEINIT(&gs_handle, ds1302_interface_io_gpio_deinit);
+    DRIVER_DS1302_LINK_IO_GPIO_WRITE(&gs_handle, ds1302_interface_io_gpio_write);
+    DRIVER_DS1302_LINK_IO_GPIO_READ(&gs_handle, ds1302_interface_io_gpio_read);
+    DRIVER_DS1302_LINK_IO_GPIO_SET_DIRECTION(&gs_handle, ds1302_interface_io_gpio_set_direction);
+    DRIVER_DS1302_LINK_TRANSPORT_BEGIN(&gs_handle, ds1302_interface_transport_begin);
+    DRIVER_DS1302_LINK_TRANSPORT_WRITE_BYTES(&gs_handle, ds1302_interface_transport_write_bytes);
+    DRIVER_DS1302_LINK_TRANSPORT_READ_BYTES(&gs_handle, ds1302_interface_transport_read_bytes);
+    DRIVER_DS1302_LINK_DELAY_US(&gs_handle, ds1302_interface_delay_us);
+    DRIVER_DS1302_LINK_DELAY_MS(&gs_handle, ds1302_interface_delay_ms);
+    DRIVER_DS1302_LINK_DEBUG_PRINT(&gs_handle, ds1302_interface_debug_print);
+    DRIVER_DS1302_LINK_TIMESTAMP_US(&gs_handle, ds1302_interface_timestamp_us);
+    
+    /* init ds1302 */
+    if (ds1302_init(&gs_handle) != 0)
+    {
+        ds1302_interface_debug_print("ds1302: init failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     let the given seconds pass
+ * @param[in] s elapsed seconds
+ * @note      none
+ */
+static void a_drift_test_elapse(uint32_t s)
+{
+    ds1302_interface_delay_ms(s * 1000);
+}
+
+/**
+ * @brief     drift test
+ * @param[in] ppb known crystal skew in ppb, positive runs fast
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the test lets about 56 hours pass, so it is meant for a simulated chip
+ */
+uint8_t ds1302_drift_test(int32_t ppb)
+{
+    uint8_t res;
+    uint32_t s;
+    uint32_t s_check;
+    uint32_t day_s;
+    int32_t ppb_check;
+    int64_t error;
+    ds1302_time_t t;
+    ds1302_bool_t enable;
+    ds1302_bool_t rollover;
+    
+    /* start drift test */
+    ds1302_interface_debug_print("ds1302: start drift test.\n");
+    ds1302_interface_debug_print("ds1302: crystal skew is %d ppb.\n", ppb);
+    
+    /* init */
+    if (a_drift_test_init() != 0)
+    {
+        return 1;
+    }
+    res = ds1302_set_write_protect(&gs_handle, DS1302_BOOL_FALSE);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: set write protect failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1302_set_oscillator(&gs_handle, DS1302_BOOL_TRUE);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: set oscillator failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* ds1302_set_drift without a reference test */
+    ds1302_interface_debug_print("ds1302: ds1302_set_drift without a reference test.\n");
+    
+    /* set the time and reboot */
+    res = ds1302_set_compact_time(&gs_handle, DRIFT_TEST_START);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: set compact time failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    (void)ds1302_deinit(&gs_handle);
+    if (a_drift_test_init() != 0)
+    {
+        return 1;
+    }
+    
+    /* no correction before a reference */
+    res = ds1302_set_drift(&gs_handle, ppb);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: set drift failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1302_get_compact_time(&gs_handle, &s);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: get compact time failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1302_interface_debug_print("ds1302: check no reference %s.\n", (s == DRIFT_TEST_START) ? "ok" : "error");
+    
+    /* ds1302_get_drift_measure test */
+    ds1302_interface_debug_print("ds1302: ds1302_get_drift_measure test.\n");
+    
+    /* measure over the window */
+    res = ds1302_start_drift_measure(&gs_handle);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: start drift measure failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    a_drift_test_elapse(DRIFT_TEST_WINDOW_S);
+    res = ds1302_get_drift_measure(&gs_handle, &ppb_check);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: get drift measure failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1302_interface_debug_print("ds1302: measured drift %d ppb.\n", ppb_check);
+    ds1302_interface_debug_print("ds1302: check drift measure %s.\n", 
+                                 ((ppb_check - ppb < DRIFT_TEST_MEASURE_PPB) && 
+                                  (ppb - ppb_check < DRIFT_TEST_MEASURE_PPB)) ? "ok" : "error");
+    
+    /* corrected time test */
+    ds1302_interface_debug_print("ds1302: corrected time test.\n");
+    
+    /* set the time and let it run */
+    res = ds1302_set_compact_time(&gs_handle, DRIFT_TEST_START);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: set compact time failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    a_drift_test_elapse(DRIFT_TEST_ELAPSED_S);
+    
+    /* raw time */
+    res = ds1302_set_drift(&gs_handle, 0);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: set drift failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1302_get_compact_time(&gs_handle, &s);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: get compact time failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    error = (int64_t)s - (int64_t)(DRIFT_TEST_START + DRIFT_TEST_ELAPSED_S);
+    ds1302_interface_debug_print("ds1302: raw time is %d s off.\n", (int32_t)error);
+    
+    /* corrected time */
+    res = ds1302_set_drift(&gs_handle, ppb);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: set drift failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1302_get_compact_time(&gs_handle, &s);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: get compact time failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    s_check = DRIFT_TEST_START + DRIFT_TEST_ELAPSED_S;
+    ds1302_interface_debug_print("ds1302: check corrected compact time %s.\n", 
+                                 ((s + 1 >= s_check) && (s <= s_check + 1)) ? "ok" : "error");
+    res = ds1302_get_time(&gs_handle, &t);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: get time failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    day_s = (uint32_t)t.hour * 3600 + (uint32_t)t.minute * 60 + t.second;
+    ds1302_interface_debug_print("ds1302: time is %04d-%02d-%02d %02d:%02d:%02d.\n", 
+                                 t.year, t.month, t.date, t.hour, t.minute, t.second);
+    ds1302_interface_debug_print("ds1302: check corrected time %s.\n", 
+                                 ((t.date == 16) && (day_s + 1 >= 13600) && (day_s <= 13600 + 1)) ? "ok" : "error");
+    res = ds1302_get_time_snapshot(&gs_handle, &t, &rollover);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: get time snapshot failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    day_s = (uint32_t)t.hour * 3600 + (uint32_t)t.minute * 60 + t.second;
+    ds1302_interface_debug_print("ds1302: check corrected snapshot %s.\n", 
+                                 ((t.date == 16) && (day_s + 1 >= 13600) && (day_s <= 13600 + 1)) ? "ok" : "error");
+    
+    /* ds1302_save_drift/ds1302_load_drift across ds1302_set_compact_time test */
+    ds1302_interface_debug_print("ds1302: ds1302_save_drift/ds1302_load_drift across ds1302_set_compact_time test.\n");
+    
+    /* save, set the time under write protect and reboot */
+    res = ds1302_save_drift(&gs_handle);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: save drift failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1302_set_write_protect(&gs_handle, DS1302_BOOL_TRUE);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: set write protect failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1302_set_compact_time(&gs_handle, DRIFT_TEST_RESTART);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: set compact time failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    (void)ds1302_deinit(&gs_handle);
+    if (a_drift_test_init() != 0)
+    {
+        return 1;
+    }
+    res = ds1302_get_write_protect(&gs_handle, &enable);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: get write protect failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1302_interface_debug_print("ds1302: check write protect %s.\n", (enable == DS1302_BOOL_TRUE) ? "ok" : "error");
+    
+    /* load and let it run */
+    res = ds1302_load_drift(&gs_handle);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: load drift failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    a_drift_test_elapse(DRIFT_TEST_ELAPSED_S);
+    res = ds1302_get_compact_time(&gs_handle, &s);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: get compact time failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    s_check = DRIFT_TEST_RESTART + DRIFT_TEST_ELAPSED_S;
+    ds1302_interface_debug_print("ds1302: check reloaded reference %s.\n", 
+                                 ((s + 1 >= s_check) && (s <= s_check + 1)) ? "ok" : "error");
+    
+    /* finish drift test */
+    ds1302_interface_debug_print("ds1302: finish drift test.\n");
+    (void)ds1302_set_write_protect(&gs_handle, DS1302_BOOL_FALSE);
+    (void)ds1302_deinit(&gs_handle);
+    
+    return 0;
+}
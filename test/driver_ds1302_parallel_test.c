@@ -0,0 +1,258 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1302_parallel_test.c
+ * @brief     driver ds1302 parallel test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds1302_parallel_test.h"
+
+/**
+ * @brief parallel test lanes definition
+ */
+#ifndef DS1302_PARALLEL_TEST_LANES
+    #define DS1302_PARALLEL_TEST_LANES 4        /**< 4 lanes */
+#endif
+#ifndef DS1302_PARALLEL_TEST_PIN
+    #define DS1302_PARALLEL_TEST_PIN 0          /**< port pin of lane 0 */
+#endif
+
+static ds1302_parallel_t gs_parallel;                                       /**< ds1302 parallel */
+static uint8_t gs_buf[DS1302_PARALLEL_TEST_LANES * 31];                     /**< lane buffers */
+static uint8_t gs_check[DS1302_PARALLEL_TEST_LANES * 31];                   /**< lane check buffers */
+
+/**
+ * @brief  parallel test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   lane n is wired to port pin DS1302_PARALLEL_TEST_PIN + n
+ */
+uint8_t ds1302_parallel_test(void)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t l;
+    uint8_t pin[DS1302_PARALLEL_TEST_LANES];
+    uint32_t ref;
+    uint32_t failed;
+    uint32_t start;
+    uint32_t all_us;
+    uint32_t one_us;
+    uint32_t compact[DS1302_PARALLEL_TEST_LANES];
+    ds1302_time_t t;
+    
+    /* start parallel test */
+    ds1302_interface_debug_print("ds1302: start parallel test.\n");
+    
+    /* link the lanes */
+    DRIVER_DS1302_PARALLEL_LINK_INIT(&gs_parallel, ds1302_parallel_t);
+    DRIVER_DS1302_PARALLEL_LINK_LANE_INIT(&gs_parallel, ds1302_interface_lane_init);
+    DRIVER_DS1302_PARALLEL_LINK_LANE_DEINIT(&gs_parallel, ds1302_interface_lane_deinit);
+    DRIVER_DS1302_PARALLEL_LINK_CE_WRITE(&gs_parallel, ds1302_interface_lane_ce_write);
+    DRIVER_DS1302_PARALLEL_LINK_SCLK_WRITE(&gs_parallel, ds1302_interface_lane_sclk_write);
+    DRIVER_DS1302_PARALLEL_LINK_IO_WRITE(&gs_parallel, ds1302_interface_lane_io_write);
+    DRIVER_DS1302_PARALLEL_LINK_IO_READ(&gs_parallel, ds1302_interface_lane_io_read);
+    DRIVER_DS1302_PARALLEL_LINK_IO_SET_DIRECTION(&gs_parallel, ds1302_interface_lane_io_set_direction);
+    DRIVER_DS1302_PARALLEL_LINK_DEBUG_PRINT(&gs_parallel, ds1302_interface_debug_print);
+    DRIVER_DS1302_PARALLEL_LINK_DELAY_US(&gs_parallel, ds1302_interface_delay_us);
+    
+    /* init the lanes */
+    res = ds1302_parallel_init(&gs_parallel);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: parallel init failed.\n");
+        
+        return 1;
+    }
+    for (l = 0; l < DS1302_PARALLEL_TEST_LANES; l++)
+    {
+        pin[l] = DS1302_PARALLEL_TEST_PIN + l;
+    }
+    res = ds1302_parallel_set_lanes(&gs_parallel, pin, DS1302_PARALLEL_TEST_LANES);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: parallel set lanes failed.\n");
+        (void)ds1302_parallel_deinit(&gs_parallel);
+        
+        return 1;
+    }
+    ds1302_interface_debug_print("ds1302: %d lanes on the port.\n", DS1302_PARALLEL_TEST_LANES);
+    
+    /* a pin used twice is refused */
+    pin[1] = pin[0];
+    if (ds1302_parallel_set_lanes(&gs_parallel, pin, DS1302_PARALLEL_TEST_LANES) != 4)
+    {
+        ds1302_interface_debug_print("ds1302: check lanes error.\n");
+        (void)ds1302_parallel_deinit(&gs_parallel);
+        
+        return 1;
+    }
+    pin[1] = DS1302_PARALLEL_TEST_PIN + 1;
+    
+    /* parallel time test */
+    ds1302_interface_debug_print("ds1302: parallel time test.\n");
+    
+    /* start the oscillators and clear write protect on every lane */
+    res = ds1302_parallel_clock_burst_read(&gs_parallel, gs_buf, 8);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: parallel clock burst read failed.\n");
+        (void)ds1302_parallel_deinit(&gs_parallel);
+        
+        return 1;
+    }
+    for (l = 0; l < DS1302_PARALLEL_TEST_LANES; l++)
+    {
+        gs_buf[l * 8 + 0] &= 0x7F;
+        gs_buf[l * 8 + 7] = 0x00;
+    }
+    res = ds1302_parallel_clock_burst_write(&gs_parallel, gs_buf, 8);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: parallel clock burst write failed.\n");
+        (void)ds1302_parallel_deinit(&gs_parallel);
+        
+        return 1;
+    }
+    
+    /* set the same time on all lanes */
+    t.year = 2024;
+    t.month = 2;
+    t.date = 15;
+    t.week = 4;
+    t.hour = 12;
+    t.minute = 30;
+    t.second = 0;
+    t.format = DS1302_FORMAT_24H;
+    t.am_pm = DS1302_AM;
+    (void)ds1302_time_to_unix(&t, &ref);
+    ref -= 946684800U;
+    res = ds1302_parallel_set_compact_time(&gs_parallel, ref);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: parallel set compact time failed.\n");
+        (void)ds1302_parallel_deinit(&gs_parallel);
+        
+        return 1;
+    }
+    ds1302_interface_delay_ms(1000);
+    
+    /* read all lanes back */
+    res = ds1302_parallel_get_compact_time(&gs_parallel, compact, &failed);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: parallel get compact time failed 0x%08X.\n", (unsigned int)failed);
+        (void)ds1302_parallel_deinit(&gs_parallel);
+        
+        return 1;
+    }
+    for (l = 0; l < DS1302_PARALLEL_TEST_LANES; l++)
+    {
+        ds1302_interface_debug_print("ds1302: lane %d compact time is %u.\n", l, (unsigned int)compact[l]);
+        if ((compact[l] < ref) || (compact[l] - ref > 2))
+        {
+            ds1302_interface_debug_print("ds1302: check time error.\n");
+            (void)ds1302_parallel_deinit(&gs_parallel);
+            
+            return 1;
+        }
+    }
+    ds1302_interface_debug_print("ds1302: check time ok.\n");
+    
+    /* parallel ram test */
+    ds1302_interface_debug_print("ds1302: parallel ram test.\n");
+    
+    /* give every lane its own pattern */
+    for (l = 0; l < DS1302_PARALLEL_TEST_LANES; l++)
+    {
+        for (i = 0; i < 31; i++)
+        {
+            gs_buf[l * 31 + i] = (uint8_t)((l * 0x3B) ^ (i * 0x11) ^ (1 << (i & 0x07)));
+        }
+    }
+    res = ds1302_parallel_ram_burst_write(&gs_parallel, gs_buf, 31);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: parallel ram burst write failed.\n");
+        (void)ds1302_parallel_deinit(&gs_parallel);
+        
+        return 1;
+    }
+    memset(gs_check, 0, sizeof(gs_check));
+    start = ds1302_interface_timestamp_us();
+    res = ds1302_parallel_ram_burst_read(&gs_parallel, gs_check, 31);
+    all_us = ds1302_interface_timestamp_us() - start;
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: parallel ram burst read failed.\n");
+        (void)ds1302_parallel_deinit(&gs_parallel);
+        
+        return 1;
+    }
+    if (memcmp(gs_buf, gs_check, sizeof(gs_buf)) != 0)
+    {
+        ds1302_interface_debug_print("ds1302: check ram error.\n");
+        (void)ds1302_parallel_deinit(&gs_parallel);
+        
+        return 1;
+    }
+    ds1302_interface_debug_print("ds1302: check ram ok.\n");
+    
+    /* the same read on a single lane */
+    res = ds1302_parallel_set_lanes(&gs_parallel, pin, 1);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: parallel set lanes failed.\n");
+        (void)ds1302_parallel_deinit(&gs_parallel);
+        
+        return 1;
+    }
+    start = ds1302_interface_timestamp_us();
+    res = ds1302_parallel_ram_burst_read(&gs_parallel, gs_check, 31);
+    one_us = ds1302_interface_timestamp_us() - start;
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: parallel ram burst read failed.\n");
+        (void)ds1302_parallel_deinit(&gs_parallel);
+        
+        return 1;
+    }
+    ds1302_interface_debug_print("ds1302: %d lanes read in %d us, one lane in %d us.\n",
+                                 DS1302_PARALLEL_TEST_LANES, (int)all_us, (int)one_us);
+    
+    /* finish parallel test */
+    ds1302_interface_debug_print("ds1302: finish parallel test.\n");
+    (void)ds1302_parallel_deinit(&gs_parallel);
+    
+    return 0;
+}
@@ -38,6 +38,53 @@
 #include <stdlib.h>
 
 static ds1302_handle_t gs_handle;        /**< ds1302 handle */
+static uint8_t gs_xfer_res;              /**< xfer result */
+static uint8_t gs_xfer_done;             /**< xfer done flag */
+
+/**
+ * @brief     xfer done callback
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] res transfer result
+ * @note      none
+ */
+static void a_register_test_xfer_done(ds1302_handle_t *handle, uint8_t res)
+{
+    gs_xfer_res = res;
+    gs_xfer_done = 1;
+}
+
+/**
+ * @brief      run one xfer to completion
+ * @param[in]  op transfer operation
+ * @param[in]  *buf pointer to a data buffer
+ * @param[in]  len data buffer length
+ * @param[out] *steps pointer to a steps buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       a main loop that steps until done runs
+ */
+static uint8_t a_register_test_xfer_run(ds1302_xfer_op_t op, uint8_t *buf, uint8_t len, uint32_t *steps)
+{
+    gs_xfer_done = 0;
+    gs_xfer_res = 1;
+    if (ds1302_xfer_submit(&gs_handle, op, buf, len, a_register_test_xfer_done) != 0)
+    {
+        return 1;
+    }
+    *steps = 0;
+    while (gs_xfer_done == 0)
+    {
+        if (ds1302_xfer_step(&gs_handle) != 0)
+        {
+            return 1;
+        }
+        ds1302_interface_delay_us(1);
+        (*steps)++;
+    }
+    
+    return gs_xfer_res;
+}
 
 /**
  * @brief  register test
@@ -57,6 +104,11 @@ uint8_t ds1302_register_test(void)
     ds1302_time_t time_in;
     ds1302_time_t time_out;
     ds1302_bool_t enable;
+    uint32_t ms;
+    uint32_t ms_check;
+    int32_t ppb;
+    int32_t ppb_check;
+    uint32_t steps;
     
     /* link functions */
     DRIVER_DS1302_LINK_INIT(&gs_handle, ds1302_handle_t);
@@ -70,9 +122,14 @@ uint8_t ds1302_register_test(void)
     DRIVER_DS1302_LINK_IO_GPIO_DEINIT(&gs_handle, ds1302_interface_io_gpio_deinit);
     DRIVER_DS1302_LINK_IO_GPIO_WRITE(&gs_handle, ds1302_interface_io_gpio_write);
     DRIVER_DS1302_LINK_IO_GPIO_READ(&gs_handle, ds1302_interface_io_gpio_read);
+    DRIVER_DS1302_LINK_IO_GPIO_SET_DIRECTION(&gs_handle, ds1302_interface_io_gpio_set_direction);
+    DRIVER_DS1302_LINK_TRANSPORT_BEGIN(&gs_handle, ds1302_interface_transport_begin);
+    DRIVER_DS1302_LINK_TRANSPORT_WRITE_BYTES(&gs_handle, ds1302_interface_transport_write_bytes);
+    DRIVER_DS1302_LINK_TRANSPORT_READ_BYTES(&gs_handle, ds1302_interface_transport_read_bytes);
     DRIVER_DS1302_LINK_DELAY_US(&gs_handle, ds1302_interface_delay_us);
     DRIVER_DS1302_LINK_DELAY_MS(&gs_handle, ds1302_interface_delay_ms);
     DRIVER_DS1302_LINK_DEBUG_PRINT(&gs_handle, ds1302_interface_debug_print);
+    DRIVER_DS1302_LINK_TIMESTAMP_US(&gs_handle, ds1302_interface_timestamp_us);
     
     /* get ds1302 info */
     res = ds1302_info(&info);
@@ -195,6 +252,30 @@ uint8_t ds1302_register_test(void)
     }
     ds1302_interface_debug_print("ds1302: check time %s.\n", (memcmp((uint8_t *)&time_in, (uint8_t *)&time_out, sizeof(ds1302_time_t)) == 0) ? "ok" : "error");
     
+    /* ds1302_set_compact_time/ds1302_get_compact_time test */
+    ds1302_interface_debug_print("ds1302: ds1302_set_compact_time/ds1302_get_compact_time test.\n");
+    
+    /* set compact time */
+    ms = (uint32_t)(rand() % 100) * 31536000U + (uint32_t)(rand() % 31536000);
+    ds1302_interface_debug_print("ds1302: set compact time %u.\n", ms);
+    res = ds1302_set_compact_time(&gs_handle, ms);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: set compact time failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1302_get_compact_time(&gs_handle, &ms_check);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: get compact time failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1302_interface_debug_print("ds1302: check compact time %s.\n", (ms == ms_check) ? "ok" : "error");
+    
     /* ds1302_set_charge/ds1302_get_charge test */
     ds1302_interface_debug_print("ds1302: ds1302_set_charge/ds1302_get_charge test.\n");
     
@@ -272,6 +353,93 @@ uint8_t ds1302_register_test(void)
     ds1302_interface_debug_print("ds1302: check clock burst %s.\n", 
                                 (memcmp((uint8_t *)buf, (uint8_t *)buf_check, sizeof(uint8_t) * 8) == 0) ? "ok" : "error");
     
+    /* ds1302_xfer_submit/ds1302_xfer_step test */
+    ds1302_interface_debug_print("ds1302: ds1302_xfer_submit/ds1302_xfer_step test.\n");
+    
+    buf[0] = 0x11;
+    buf[1] = 0x12;
+    buf[2] = 0x13;
+    buf[3] = 0x14;
+    buf[4] = 0x05;
+    buf[5] = 0x06;
+    buf[6] = 0x17;
+    buf[7] = 0x00;
+    res = a_register_test_xfer_run(DS1302_XFER_OP_CLOCK_BURST_WRITE, buf, 8, &steps);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: xfer clock burst write failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1302_interface_debug_print("ds1302: xfer clock burst write took %d steps.\n", (int)steps);
+    memset(buf_check, 0, sizeof(buf_check));
+    res = a_register_test_xfer_run(DS1302_XFER_OP_CLOCK_BURST_READ, buf_check, 8, &steps);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: xfer clock burst read failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1302_interface_debug_print("ds1302: xfer clock burst read took %d steps.\n", (int)steps);
+    ds1302_interface_debug_print("ds1302: check xfer %s.\n", 
+                                (memcmp((uint8_t *)buf, (uint8_t *)buf_check, sizeof(uint8_t) * 8) == 0) ? "ok" : "error");
+    
+    /* a pending transfer refuses the blocking calls and still completes */
+    memset(buf_check, 0, sizeof(uint8_t) * 8);
+    gs_xfer_done = 0;
+    gs_xfer_res = 1;
+    res = ds1302_xfer_submit(&gs_handle, DS1302_XFER_OP_CLOCK_BURST_READ, buf_check, 8, a_register_test_xfer_done);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: xfer submit failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    (void)ds1302_xfer_step(&gs_handle);
+    (void)ds1302_xfer_step(&gs_handle);
+    (void)ds1302_xfer_step(&gs_handle);
+    ds1302_interface_debug_print("ds1302: check xfer busy %s.\n",
+                                 ((ds1302_get_time(&gs_handle, &time_out) == 6) &&
+                                  (ds1302_set_time(&gs_handle, &time_out) == 6) &&
+                                  (ds1302_clock_burst_read(&gs_handle, buf_check, 8) == 6) &&
+                                  (ds1302_read_ram(&gs_handle, 0, &reg, 1) == 6) &&
+                                  (ds1302_write_ram(&gs_handle, 0, &reg, 1) == 6) &&
+                                  (ds1302_deinit(&gs_handle) == 6)) ? "ok" : "error");
+    while (gs_xfer_done == 0)
+    {
+        if (ds1302_xfer_step(&gs_handle) != 0)
+        {
+            ds1302_interface_debug_print("ds1302: xfer step failed.\n");
+            (void)ds1302_deinit(&gs_handle);
+            
+            return 1;
+        }
+        ds1302_interface_delay_us(1);
+    }
+    ds1302_interface_debug_print("ds1302: check xfer after busy %s.\n",
+                                 ((gs_xfer_res == 0) &&
+                                  (memcmp((uint8_t *)buf, (uint8_t *)buf_check, sizeof(uint8_t) * 8) == 0)) ? "ok" : "error");
+    
+    /* a pending transfer refuses the next one and abort runs done */
+    res = ds1302_xfer_submit(&gs_handle, DS1302_XFER_OP_CLOCK_BURST_READ, buf_check, 8, a_register_test_xfer_done);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: xfer submit failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    gs_xfer_done = 0;
+    (void)ds1302_xfer_step(&gs_handle);
+    (void)ds1302_xfer_step(&gs_handle);
+    ds1302_interface_debug_print("ds1302: check xfer abort %s.\n", 
+                                 ((ds1302_xfer_submit(&gs_handle, DS1302_XFER_OP_CLOCK_BURST_READ, buf_check, 8, NULL) == 4) &&
+                                  (ds1302_xfer_abort(&gs_handle) == 0) && (gs_xfer_done == 1) && (gs_xfer_res == 1) &&
+                                  (ds1302_xfer_step(&gs_handle) == 4)) ? "ok" : "error");
+    
     /* ds1302_set_write_protect/ds1302_get_write_protect test */
     ds1302_interface_debug_print("ds1302: ds1302_set_write_protect/ds1302_get_write_protect test.\n");
     
@@ -338,6 +506,246 @@ uint8_t ds1302_register_test(void)
     }
     ds1302_interface_debug_print("ds1302: check oscillator %s.\n", (enable == DS1302_BOOL_TRUE) ? "ok" : "error");
     
+    /* ds1302_set_time_cache/ds1302_get_time_cache test */
+    ds1302_interface_debug_print("ds1302: ds1302_set_time_cache/ds1302_get_time_cache test.\n");
+    
+    /* enable */
+    res = ds1302_set_time_cache(&gs_handle, DS1302_BOOL_TRUE);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: set time cache failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1302_interface_debug_print("ds1302: enable time cache.\n");
+    res = ds1302_get_time_cache(&gs_handle, &enable);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: get time cache failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1302_interface_debug_print("ds1302: check time cache %s.\n", (enable == DS1302_BOOL_TRUE) ? "ok" : "error");
+    
+    /* ds1302_set_time_cache_interval/ds1302_get_time_cache_interval test */
+    ds1302_interface_debug_print("ds1302: ds1302_set_time_cache_interval/ds1302_get_time_cache_interval test.\n");
+    
+    /* set interval */
+    ms = 3000;
+    res = ds1302_set_time_cache_interval(&gs_handle, ms);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: set time cache interval failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1302_interface_debug_print("ds1302: set time cache interval %d ms.\n", ms);
+    res = ds1302_get_time_cache_interval(&gs_handle, &ms_check);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: get time cache interval failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1302_interface_debug_print("ds1302: check time cache interval %s.\n", (ms == ms_check) ? "ok" : "error");
+    
+    /* ds1302_sync_time_cache test */
+    ds1302_interface_debug_print("ds1302: ds1302_sync_time_cache test.\n");
+    
+    /* anchor, extrapolate and compare with the chip */
+    res = ds1302_sync_time_cache(&gs_handle);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: sync time cache failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1302_interface_delay_ms(2000);
+    res = ds1302_get_time(&gs_handle, &time_out);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: get time failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1302_sync_time_cache(&gs_handle);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: sync time cache failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1302_get_time(&gs_handle, &time_in);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: get time failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ms_check = (uint32_t)((time_in.minute * 60 + time_in.second) - (time_out.minute * 60 + time_out.second) + 3600) % 3600;
+    ds1302_interface_debug_print("ds1302: cached time is %d s behind the chip.\n", ms_check);
+    ds1302_interface_debug_print("ds1302: check time cache %s.\n", (ms_check <= 1) ? "ok" : "error");
+    
+    /* ds1302_get_second_edge test */
+    ds1302_interface_debug_print("ds1302: ds1302_get_second_edge test.\n");
+    
+    /* find the edge */
+    res = ds1302_get_second_edge(&gs_handle, &ms, &ms_check);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: get second edge failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1302_interface_debug_print("ds1302: second edge at %u us with %u us resolution.\n", ms, ms_check);
+    ds1302_interface_debug_print("ds1302: check second edge %s.\n", (ms_check <= 2000) ? "ok" : "error");
+    
+    /* ds1302_set_drift/ds1302_get_drift test */
+    ds1302_interface_debug_print("ds1302: ds1302_set_drift/ds1302_get_drift test.\n");
+    
+    /* set drift */
+    ppb = rand() % 200001 - 100000;
+    res = ds1302_set_drift(&gs_handle, ppb);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: set drift failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1302_interface_debug_print("ds1302: set drift %d ppb.\n", ppb);
+    res = ds1302_get_drift(&gs_handle, &ppb_check);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: get drift failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1302_interface_debug_print("ds1302: check drift %s.\n", (ppb == ppb_check) ? "ok" : "error");
+    
+    /* ds1302_save_drift/ds1302_load_drift test */
+    ds1302_interface_debug_print("ds1302: ds1302_save_drift/ds1302_load_drift test.\n");
+    
+    /* save and load */
+    res = ds1302_set_write_protect(&gs_handle, DS1302_BOOL_FALSE);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: set write protect failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1302_save_drift(&gs_handle);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: save drift failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1302_set_drift(&gs_handle, 0);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: set drift failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1302_load_drift(&gs_handle);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: load drift failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1302_get_drift(&gs_handle, &ppb_check);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: get drift failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1302_interface_debug_print("ds1302: check drift %s.\n", (ppb == ppb_check) ? "ok" : "error");
+    
+    /* ds1302_start_drift_measure/ds1302_get_drift_measure test */
+    ds1302_interface_debug_print("ds1302: ds1302_start_drift_measure/ds1302_get_drift_measure test.\n");
+    
+    /* measure over 3s */
+    res = ds1302_start_drift_measure(&gs_handle);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: start drift measure failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1302_interface_delay_ms(3000);
+    res = ds1302_get_drift_measure(&gs_handle, &ppb);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: get drift measure failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1302_interface_debug_print("ds1302: measured drift %d ppb.\n", ppb);
+    ds1302_interface_debug_print("ds1302: check drift measure %s.\n", ((ppb < 1000000) && (ppb > -1000000)) ? "ok" : "error");
+    res = ds1302_set_drift(&gs_handle, 0);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: set drift failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* disable */
+    res = ds1302_set_time_cache(&gs_handle, DS1302_BOOL_FALSE);
+    if (res != 0)
+    {
+        ds1302_interface_debug_print("ds1302: set time cache failed.\n");
+        (void)ds1302_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1302_interface_debug_print("ds1302: disable time cache.\n");
+    
+    /* ds1302_time_to_unix test */
+    ds1302_interface_debug_print("ds1302: ds1302_time_to_unix test.\n");
+    
+    /* leap day, 2024-02-29 00:00:00 */
+    time_in.format = DS1302_FORMAT_24H;
+    time_in.am_pm = DS1302_AM;
+    time_in.year = 2024;
+    time_in.month = 2;
+    time_in.date = 29;
+    time_in.week = 4;
+    time_in.hour = 0;
+    time_in.minute = 0;
+    time_in.second = 0;
+    res = ds1302_time_to_unix(&time_in, &ms);
+    ds1302_interface_debug_print("ds1302: check leap day %s.\n", ((res == 0) && (ms == 1709164800U)) ? "ok" : "error");
+    
+    /* days past the end of the month */
+    time_in.year = 2023;
+    res = ds1302_time_to_unix(&time_in, &ms);
+    time_in.month = 4;
+    time_in.date = 31;
+    ds1302_interface_debug_print("ds1302: check invalid date %s.\n",
+                                 ((res == 4) && (ds1302_time_to_unix(&time_in, &ms) == 4)) ? "ok" : "error");
+    
     /* finish register test */
     ds1302_interface_debug_print("ds1302: finish register test.\n");
     (void)ds1302_deinit(&gs_handle);
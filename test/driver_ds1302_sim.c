@@ -0,0 +1,513 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1302_sim.c
+ * @brief     driver ds1302 sim source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds1302_sim.h"
+#include <string.h>
+
+/**
+ * @brief chip register definition
+ */
+#define SIM_REG_SECOND          0              /**< second register */
+#define SIM_REG_MINUTE          1              /**< minute register */
+#define SIM_REG_HOUR            2              /**< hour register */
+#define SIM_REG_DATE            3              /**< date register */
+#define SIM_REG_MONTH           4              /**< month register */
+#define SIM_REG_WEEK            5              /**< week register */
+#define SIM_REG_YEAR            6              /**< year register */
+#define SIM_REG_CONTROL         7              /**< control register */
+#define SIM_REG_CHARGE          8              /**< charge register */
+#define SIM_ADDR_BURST          31             /**< burst address */
+
+/**
+ * @brief chip timing definition
+ */
+#define SIM_SECOND_NS           1000000000ULL  /**< one second in ns */
+
+/**
+ * @brief     bcd to decimal
+ * @param[in] val bcd value
+ * @return    decimal value
+ * @note      none
+ */
+static uint8_t a_sim_bcd2dec(uint8_t val)
+{
+    return (uint8_t)((val >> 4) * 10 + (val & 0x0F));
+}
+
+/**
+ * @brief     decimal to bcd
+ * @param[in] val decimal value
+ * @return    bcd value
+ * @note      none
+ */
+static uint8_t a_sim_dec2bcd(uint8_t val)
+{
+    return (uint8_t)(((val / 10) << 4) | (val % 10));
+}
+
+/**
+ * @brief     get the days of a month
+ * @param[in] month month 1 - 12
+ * @param[in] year year 0 - 99
+ * @return    days
+ * @note      2000 - 2099 leap years are the multiples of four
+ */
+static uint8_t a_sim_days(uint8_t month, uint8_t year)
+{
+    const uint8_t days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    
+    if ((month == 2) && ((year % 4) == 0))
+    {
+        return 29;
+    }
+    if ((month < 1) || (month > 12))
+    {
+        return 31;
+    }
+    
+    return days[month - 1];
+}
+
+/**
+ * @brief     advance the calendar to the next day
+ * @param[in] *sim pointer to a ds1302 sim structure
+ * @note      none
+ */
+static void a_sim_next_day(ds1302_sim_t *sim)
+{
+    uint8_t date;
+    uint8_t month;
+    uint8_t year;
+    
+    sim->reg[SIM_REG_WEEK] = (uint8_t)((sim->reg[SIM_REG_WEEK] % 7) + 1);
+    date = a_sim_bcd2dec(sim->reg[SIM_REG_DATE] & 0x3F);
+    month = a_sim_bcd2dec(sim->reg[SIM_REG_MONTH] & 0x1F);
+    year = a_sim_bcd2dec(sim->reg[SIM_REG_YEAR]);
+    date++;
+    if (date > a_sim_days(month, year))
+    {
+        date = 1;
+        month++;
+        if (month > 12)
+        {
+            month = 1;
+            year = (uint8_t)((year + 1) % 100);
+        }
+    }
+    sim->reg[SIM_REG_DATE] = a_sim_dec2bcd(date);
+    sim->reg[SIM_REG_MONTH] = a_sim_dec2bcd(month);
+    sim->reg[SIM_REG_YEAR] = a_sim_dec2bcd(year);
+}
+
+/**
+ * @brief     advance the calendar by one second
+ * @param[in] *sim pointer to a ds1302 sim structure
+ * @note      handles both the 12 hour and the 24 hour format
+ */
+static void a_sim_tick(ds1302_sim_t *sim)
+{
+    uint8_t second;
+    uint8_t minute;
+    uint8_t hour;
+    uint8_t pm;
+    
+    second = (uint8_t)(a_sim_bcd2dec(sim->reg[SIM_REG_SECOND] & 0x7F) + 1);
+    if (second < 60)
+    {
+        sim->reg[SIM_REG_SECOND] = a_sim_dec2bcd(second);
+        
+        return;
+    }
+    sim->reg[SIM_REG_SECOND] = 0x00;
+    minute = (uint8_t)(a_sim_bcd2dec(sim->reg[SIM_REG_MINUTE] & 0x7F) + 1);
+    if (minute < 60)
+    {
+        sim->reg[SIM_REG_MINUTE] = a_sim_dec2bcd(minute);
+        
+        return;
+    }
+    sim->reg[SIM_REG_MINUTE] = 0x00;
+    if ((sim->reg[SIM_REG_HOUR] & 0x80) != 0)
+    {
+        hour = (uint8_t)(a_sim_bcd2dec(sim->reg[SIM_REG_HOUR] & 0x1F) + 1);
+        pm = sim->reg[SIM_REG_HOUR] & 0x20;
+        if (hour == 12)
+        {
+            pm ^= 0x20;
+            if (pm == 0)
+            {
+                a_sim_next_day(sim);
+            }
+        }
+        else if (hour == 13)
+        {
+            hour = 1;
+        }
+        sim->reg[SIM_REG_HOUR] = (uint8_t)(0x80 | pm | a_sim_dec2bcd(hour));
+    }
+    else
+    {
+        hour = (uint8_t)(a_sim_bcd2dec(sim->reg[SIM_REG_HOUR] & 0x3F) + 1);
+        if (hour >= 24)
+        {
+            hour = 0;
+            a_sim_next_day(sim);
+        }
+        sim->reg[SIM_REG_HOUR] = a_sim_dec2bcd(hour);
+    }
+}
+
+/**
+ * @brief     get the next byte to shift out
+ * @param[in] *sim pointer to a ds1302 sim structure
+ * @return    data byte
+ * @note      burst reads wrap, single reads repeat the same byte
+ */
+static uint8_t a_sim_read_byte(ds1302_sim_t *sim)
+{
+    uint8_t addr;
+    
+    addr = (sim->command >> 1) & 0x1F;
+    if ((sim->command & 0x40) != 0)
+    {
+        if (addr == SIM_ADDR_BURST)
+        {
+            return sim->ram[sim->index % 31];
+        }
+        
+        return sim->ram[addr];
+    }
+    if (addr == SIM_ADDR_BURST)
+    {
+        return sim->latch[sim->index % 8];
+    }
+    if (addr <= SIM_REG_CHARGE)
+    {
+        return sim->reg[addr];
+    }
+    
+    return 0x00;
+}
+
+/**
+ * @brief     store one shifted in byte
+ * @param[in] *sim pointer to a ds1302 sim structure
+ * @param[in] data data byte
+ * @note      write protect blocks every register but control, a clock burst
+ *            only takes effect once all eight bytes are shifted in
+ */
+static void a_sim_write_byte(ds1302_sim_t *sim, uint8_t data)
+{
+    uint8_t addr;
+    uint8_t wp;
+    uint8_t i;
+    
+    addr = (sim->command >> 1) & 0x1F;
+    wp = sim->reg[SIM_REG_CONTROL] & 0x80;
+    if ((sim->command & 0x40) != 0)
+    {
+        if (wp != 0)
+        {
+            return;
+        }
+        if (addr == SIM_ADDR_BURST)
+        {
+            if (sim->index < 31)
+            {
+                sim->ram[sim->index] = data;
+            }
+        }
+        else
+        {
+            sim->ram[addr] = data;
+        }
+        
+        return;
+    }
+    if (addr == SIM_ADDR_BURST)
+    {
+        if (sim->index < 8)
+        {
+            sim->latch[sim->index] = data;
+        }
+        if (sim->index == 7)
+        {
+            if (wp == 0)
+            {
+                for (i = 0; i < 7; i++)
+                {
+                    sim->reg[i] = sim->latch[i];
+                }
+                sim->phase_ns = 0;
+            }
+            sim->reg[SIM_REG_CONTROL] = sim->latch[7] & 0x80;
+        }
+        
+        return;
+    }
+    if (addr == SIM_REG_CONTROL)
+    {
+        sim->reg[SIM_REG_CONTROL] = data & 0x80;
+        
+        return;
+    }
+    if ((wp != 0) || (addr > SIM_REG_CHARGE))
+    {
+        return;
+    }
+    sim->reg[addr] = data;
+    if (addr == SIM_REG_SECOND)
+    {
+        sim->phase_ns = 0;
+    }
+}
+
+/**
+ * @brief     check whether the chip drives io
+ * @param[in] *sim pointer to a ds1302 sim structure
+ * @return    1 if driving, else 0
+ * @note      the chip starts driving on the first falling edge after a read command
+ */
+static uint8_t a_sim_chip_driving(ds1302_sim_t *sim)
+{
+    return ((sim->state == DS1302_SIM_STATE_READ) && ((sim->bit != 0) || (sim->index != 0))) ? 1 : 0;
+}
+
+/**
+ * @brief     power on the simulated chip
+ * @param[in] *sim pointer to a ds1302 sim structure
+ * @note      the oscillator starts halted, write protect starts cleared,
+ *            the trickle charger starts disabled
+ */
+void ds1302_sim_init(ds1302_sim_t *sim)
+{
+    memset(sim, 0, sizeof(ds1302_sim_t));
+    sim->reg[SIM_REG_SECOND] = 0x80;
+    sim->reg[SIM_REG_DATE] = 0x01;
+    sim->reg[SIM_REG_MONTH] = 0x01;
+    sim->reg[SIM_REG_WEEK] = 0x01;
+    sim->reg[SIM_REG_CHARGE] = 0x5C;
+    sim->second_ns = SIM_SECOND_NS;
+    sim->state = DS1302_SIM_STATE_IDLE;
+}
+
+/**
+ * @brief     advance the virtual clock
+ * @param[in] *sim pointer to a ds1302 sim structure
+ * @param[in] ns elapsed time in ns
+ * @note      the calendar only runs while the oscillator is not halted
+ */
+void ds1302_sim_advance(ds1302_sim_t *sim, uint64_t ns)
+{
+    sim->now_ns += ns;
+    if ((sim->reg[SIM_REG_SECOND] & 0x80) != 0)
+    {
+        return;
+    }
+    sim->phase_ns += ns;
+    while (sim->phase_ns >= sim->second_ns)
+    {
+        sim->phase_ns -= sim->second_ns;
+        a_sim_tick(sim);
+    }
+}
+
+/**
+ * @brief     set the crystal skew
+ * @param[in] *sim pointer to a ds1302 sim structure
+ * @param[in] ppb crystal skew in ppb, positive runs fast
+ * @note      none
+ */
+void ds1302_sim_set_skew(ds1302_sim_t *sim, int32_t ppb)
+{
+    sim->second_ns = (uint64_t)(((int64_t)SIM_SECOND_NS * (int64_t)SIM_SECOND_NS) / 
+                                ((int64_t)SIM_SECOND_NS + ppb));
+}
+
+/**
+ * @brief     drive the ce pin
+ * @param[in] *sim pointer to a ds1302 sim structure
+ * @param[in] value ce level
+ * @note      a rising edge starts a new command, a falling edge ends the transfer
+ */
+void ds1302_sim_ce_write(ds1302_sim_t *sim, uint8_t value)
+{
+    value = (value != 0) ? 1 : 0;
+    if ((value != 0) && (sim->ce == 0))
+    {
+        sim->state = DS1302_SIM_STATE_COMMAND;
+        sim->shift = 0;
+        sim->bit = 0;
+        sim->index = 0;
+        sim->transfers++;
+    }
+    else if (value == 0)
+    {
+        sim->state = DS1302_SIM_STATE_IDLE;
+    }
+    sim->ce = value;
+}
+
+/**
+ * @brief     drive the sclk pin
+ * @param[in] *sim pointer to a ds1302 sim structure
+ * @param[in] value sclk level
+ * @note      input bits are latched on rising edges, output bits change on falling edges
+ */
+void ds1302_sim_sclk_write(ds1302_sim_t *sim, uint8_t value)
+{
+    value = (value != 0) ? 1 : 0;
+    if (value == sim->sclk)
+    {
+        return;
+    }
+    sim->sclk = value;
+    if ((sim->ce == 0) || (sim->state == DS1302_SIM_STATE_IDLE))
+    {
+        return;
+    }
+    sim->edges++;
+    
+    /* rising edge */
+    if (value != 0)
+    {
+        if ((sim->state != DS1302_SIM_STATE_COMMAND) && (sim->state != DS1302_SIM_STATE_WRITE))
+        {
+            return;
+        }
+        sim->shift |= (uint8_t)(sim->io_host << sim->bit);
+        sim->bit++;
+        if (sim->bit < 8)
+        {
+            return;
+        }
+        if (sim->state == DS1302_SIM_STATE_COMMAND)
+        {
+            sim->command = sim->shift;
+            if ((sim->command & 0x80) == 0)
+            {
+                sim->state = DS1302_SIM_STATE_IDLE;
+            }
+            else if ((sim->command & 0x01) != 0)
+            {
+                if ((sim->command & 0x40) == 0)
+                {
+                    memcpy(sim->latch, sim->reg, 8);
+                }
+                sim->state = DS1302_SIM_STATE_READ;
+            }
+            else
+            {
+                sim->state = DS1302_SIM_STATE_WRITE;
+            }
+        }
+        else
+        {
+            a_sim_write_byte(sim, sim->shift);
+            sim->index++;
+        }
+        sim->shift = 0;
+        sim->bit = 0;
+        
+        return;
+    }
+    
+    /* falling edge */
+    if (sim->state == DS1302_SIM_STATE_READ)
+    {
+        if (sim->bit == 0)
+        {
+            sim->shift = a_sim_read_byte(sim);
+        }
+        sim->io_chip = (sim->shift >> sim->bit) & 0x01;
+        sim->bit++;
+        if (sim->bit >= 8)
+        {
+            sim->bit = 0;
+            sim->index++;
+        }
+    }
+}
+
+/**
+ * @brief     drive the io pin from the host side
+ * @param[in] *sim pointer to a ds1302 sim structure
+ * @param[in] value io level
+ * @note      none
+ */
+void ds1302_sim_io_write(ds1302_sim_t *sim, uint8_t value)
+{
+    sim->io_host = (value != 0) ? 1 : 0;
+    if ((sim->host_output != 0) && (a_sim_chip_driving(sim) != 0))
+    {
+        sim->contentions++;
+    }
+}
+
+/**
+ * @brief     set the host io direction
+ * @param[in] *sim pointer to a ds1302 sim structure
+ * @param[in] output 0 is input and 1 is output
+ * @note      none
+ */
+void ds1302_sim_io_set_direction(ds1302_sim_t *sim, uint8_t output)
+{
+    sim->host_output = (output != 0) ? 1 : 0;
+    if ((sim->host_output != 0) && (a_sim_chip_driving(sim) != 0))
+    {
+        sim->contentions++;
+    }
+}
+
+/**
+ * @brief     sample the io pin from the host side
+ * @param[in] *sim pointer to a ds1302 sim structure
+ * @return    io level
+ * @note      the chip drives io only during a read transfer
+ */
+uint8_t ds1302_sim_io_read(ds1302_sim_t *sim)
+{
+    if (a_sim_chip_driving(sim) != 0)
+    {
+        return sim->io_chip;
+    }
+    if (sim->host_output != 0)
+    {
+        return sim->io_host;
+    }
+    
+    return 0;
+}
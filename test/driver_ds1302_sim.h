@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1302_sim.h
+ * @brief     driver ds1302 sim header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_DS1302_SIM_H
+#define DRIVER_DS1302_SIM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ds1302_sim_driver ds1302 sim driver function
+ * @brief    ds1302 sim driver modules
+ * @ingroup  ds1302_driver
+ * @{
+ */
+
+/**
+ * @brief ds1302 sim state enumeration definition
+ */
+typedef enum
+{
+    DS1302_SIM_STATE_IDLE    = 0x00,        /**< ce is low or the command is invalid */
+    DS1302_SIM_STATE_COMMAND = 0x01,        /**< shifting in the command byte */
+    DS1302_SIM_STATE_WRITE   = 0x02,        /**< shifting in data bytes */
+    DS1302_SIM_STATE_READ    = 0x03,        /**< shifting out data bytes */
+} ds1302_sim_state_t;
+
+/**
+ * @brief ds1302 sim structure definition
+ */
+typedef struct ds1302_sim_s
+{
+    uint8_t reg[9];                   /**< second, minute, hour, date, month, week, year, control, charge */
+    uint8_t ram[31];                  /**< ram */
+    uint8_t latch[8];                 /**< clock burst buffer */
+    uint8_t ce;                       /**< ce level */
+    uint8_t sclk;                     /**< sclk level */
+    uint8_t io_host;                  /**< io level driven by the host */
+    uint8_t io_chip;                  /**< io level driven by the chip */
+    uint8_t host_output;              /**< host drives io */
+    uint8_t state;                    /**< bus state */
+    uint8_t command;                  /**< command byte */
+    uint8_t shift;                    /**< shift register */
+    uint8_t bit;                      /**< bit counter */
+    uint8_t index;                    /**< byte index inside the transfer */
+    uint64_t now_ns;                  /**< virtual time */
+    uint64_t phase_ns;                /**< time since the last second tick */
+    uint64_t second_ns;               /**< crystal second length */
+    uint32_t edges;                   /**< sclk edges seen while ce is high */
+    uint32_t transfers;               /**< ce high periods */
+    uint32_t contentions;             /**< host drove io while the chip drove it */
+} ds1302_sim_t;
+
+/**
+ * @brief     power on the simulated chip
+ * @param[in] *sim pointer to a ds1302 sim structure
+ * @note      the oscillator starts halted, write protect starts cleared,
+ *            the trickle charger starts disabled
+ */
+void ds1302_sim_init(ds1302_sim_t *sim);
+
+/**
+ * @brief     advance the virtual clock
+ * @param[in] *sim pointer to a ds1302 sim structure
+ * @param[in] ns elapsed time in ns
+ * @note      the calendar only runs while the oscillator is not halted
+ */
+void ds1302_sim_advance(ds1302_sim_t *sim, uint64_t ns);
+
+/**
+ * @brief     set the crystal skew
+ * @param[in] *sim pointer to a ds1302 sim structure
+ * @param[in] ppb crystal skew in ppb, positive runs fast
+ * @note      none
+ */
+void ds1302_sim_set_skew(ds1302_sim_t *sim, int32_t ppb);
+
+/**
+ * @brief     drive the ce pin
+ * @param[in] *sim pointer to a ds1302 sim structure
+ * @param[in] value ce level
+ * @note      a rising edge starts a new command, a falling edge ends the transfer
+ */
+void ds1302_sim_ce_write(ds1302_sim_t *sim, uint8_t value);
+
+/**
+ * @brief     drive the sclk pin
+ * @param[in] *sim pointer to a ds1302 sim structure
+ * @param[in] value sclk level
+ * @note      input bits are latched on rising edges, output bits change on falling edges
+ */
+void ds1302_sim_sclk_write(ds1302_sim_t *sim, uint8_t value);
+
+/**
+ * @brief     drive the io pin from the host side
+ * @param[in] *sim pointer to a ds1302 sim structure
+ * @param[in] value io level
+ * @note      none
+ */
+void ds1302_sim_io_write(ds1302_sim_t *sim, uint8_t value);
+
+/**
+ * @brief     set the host io direction
+ * @param[in] *sim pointer to a ds1302 sim structure
+ * @param[in] output 0 is input and 1 is output
+ * @note      none
+ */
+void ds1302_sim_io_set_direction(ds1302_sim_t *sim, uint8_t output);
+
+/**
+ * @brief     sample the io pin from the host side
+ * @param[in] *sim pointer to a ds1302 sim structure
+ * @return    io level
+ * @note      the chip drives io only during a read transfer
+ */
+uint8_t ds1302_sim_io_read(ds1302_sim_t *sim);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,676 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1302_trace.c
+ * @brief     driver ds1302 trace source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds1302_trace.h"
+
+/**
+ * @brief trace capture events definition
+ */
+#ifndef DS1302_TRACE_CAPTURE_EVENTS
+    #define DS1302_TRACE_CAPTURE_EVENTS 2048        /**< 2048 events */
+#endif
+
+/**
+ * @brief ds1302 trace mode enumeration definition
+ */
+typedef enum
+{
+    DS1302_TRACE_MODE_NONE   = 0x00,        /**< not attached */
+    DS1302_TRACE_MODE_RECORD = 0x01,        /**< recorder attached */
+    DS1302_TRACE_MODE_REPLAY = 0x02,        /**< replay stub attached */
+} ds1302_trace_mode_t;
+
+/**
+ * @brief ds1302 trace structure definition
+ */
+typedef struct ds1302_trace_s
+{
+    uint8_t mode;                                                   /**< trace mode */
+    ds1302_handle_t *handle;                                        /**< attached handle */
+    ds1302_trace_event_t *event;                                    /**< ring buffer */
+    uint32_t size;                                                  /**< ring buffer size */
+    uint32_t head;                                                  /**< next write position */
+    uint32_t count;                                                 /**< events in the ring */
+    uint32_t dropped;                                               /**< overwritten events */
+    uint32_t sequence;                                              /**< event sequence */
+    const ds1302_trace_event_t *replay;                             /**< replayed events */
+    uint32_t replay_count;                                          /**< replayed events count */
+    uint32_t replay_index;                                          /**< next replayed event */
+    uint8_t diverged;                                               /**< replay diverged flag */
+    uint8_t (*ce_gpio_write)(void *ctx, uint8_t value);             /**< original ce gpio write */
+    uint8_t (*sclk_gpio_write)(void *ctx, uint8_t value);           /**< original sclk gpio write */
+    uint8_t (*io_gpio_write)(void *ctx, uint8_t value);             /**< original io gpio write */
+    uint8_t (*io_gpio_read)(void *ctx, uint8_t *value);             /**< original io gpio read */
+    uint8_t (*io_gpio_set_direction)(void *ctx, uint8_t output);    /**< original io gpio set direction */
+} ds1302_trace_t;
+
+static ds1302_trace_t gs_trace;                                          /**< trace state */
+static ds1302_handle_t gs_handle;                                        /**< ds1302 handle */
+static ds1302_trace_event_t gs_record[DS1302_TRACE_CAPTURE_EVENTS];      /**< recorded events */
+static ds1302_trace_event_t gs_replay[DS1302_TRACE_CAPTURE_EVENTS];      /**< replayed events */
+
+/**
+ * @brief     record one event
+ * @param[in] signal recorded signal
+ * @param[in] value recorded level
+ * @param[in] res callback result
+ * @note      no allocation, the oldest event is overwritten when the ring is full
+ */
+static void a_trace_record(uint8_t signal, uint8_t value, uint8_t res)
+{
+    ds1302_trace_event_t *e;
+    
+    e = &gs_trace.event[gs_trace.head];
+    if (gs_trace.handle->timestamp_us != NULL)
+    {
+        e->timestamp_us = gs_trace.handle->timestamp_us();
+    }
+    else
+    {
+        e->timestamp_us = gs_trace.sequence;
+    }
+    e->signal = signal;
+    e->value = (value != 0) ? 1 : 0;
+    e->res = res;
+    gs_trace.sequence++;
+    gs_trace.head++;
+    if (gs_trace.head == gs_trace.size)
+    {
+        gs_trace.head = 0;
+    }
+    if (gs_trace.count < gs_trace.size)
+    {
+        gs_trace.count++;
+    }
+    else
+    {
+        gs_trace.dropped++;
+    }
+}
+
+/**
+ * @brief     tracing ce gpio write
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] value set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 ce gpio write failed
+ * @note      none
+ */
+static uint8_t a_trace_ce_gpio_write(void *ctx, uint8_t value)
+{
+    uint8_t res;
+    
+    res = gs_trace.ce_gpio_write(ctx, value);
+    a_trace_record(DS1302_TRACE_SIGNAL_CE, value, res);
+    
+    return res;
+}
+
+/**
+ * @brief     tracing sclk gpio write
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] value set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 sclk gpio write failed
+ * @note      none
+ */
+static uint8_t a_trace_sclk_gpio_write(void *ctx, uint8_t value)
+{
+    uint8_t res;
+    
+    res = gs_trace.sclk_gpio_write(ctx, value);
+    a_trace_record(DS1302_TRACE_SIGNAL_SCLK, value, res);
+    
+    return res;
+}
+
+/**
+ * @brief     tracing io gpio write
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] value set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 io gpio write failed
+ * @note      none
+ */
+static uint8_t a_trace_io_gpio_write(void *ctx, uint8_t value)
+{
+    uint8_t res;
+    
+    res = gs_trace.io_gpio_write(ctx, value);
+    a_trace_record(DS1302_TRACE_SIGNAL_IO_WRITE, value, res);
+    
+    return res;
+}
+
+/**
+ * @brief      tracing io gpio read
+ * @param[in]  *ctx pointer to a chip context
+ * @param[out] *value pointer to a value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 io gpio read failed
+ * @note       none
+ */
+static uint8_t a_trace_io_gpio_read(void *ctx, uint8_t *value)
+{
+    uint8_t res;
+    
+    res = gs_trace.io_gpio_read(ctx, value);
+    a_trace_record(DS1302_TRACE_SIGNAL_IO_READ, (res == 0) ? *value : 0, res);
+    
+    return res;
+}
+
+/**
+ * @brief     replay one write
+ * @param[in] signal written signal
+ * @param[in] value written level
+ * @return    recorded result or 1 on divergence
+ * @note      none
+ */
+static uint8_t a_trace_replay_write(uint8_t signal, uint8_t value)
+{
+    const ds1302_trace_event_t *e;
+    
+    if ((gs_trace.diverged != 0) || (gs_trace.replay_index >= gs_trace.replay_count))
+    {
+        gs_trace.diverged = 1;
+        
+        return 1;
+    }
+    e = &gs_trace.replay[gs_trace.replay_index];
+    if ((e->signal != signal) || (e->value != ((value != 0) ? 1 : 0)))
+    {
+        gs_trace.diverged = 1;
+        
+        return 1;
+    }
+    gs_trace.replay_index++;
+    
+    return e->res;
+}
+
+/**
+ * @brief     replayed ce gpio write
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] value set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 ce gpio write failed
+ * @note      none
+ */
+static uint8_t a_trace_replay_ce_gpio_write(void *ctx, uint8_t value)
+{
+    return a_trace_replay_write(DS1302_TRACE_SIGNAL_CE, value);
+}
+
+/**
+ * @brief     replayed sclk gpio write
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] value set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 sclk gpio write failed
+ * @note      none
+ */
+static uint8_t a_trace_replay_sclk_gpio_write(void *ctx, uint8_t value)
+{
+    return a_trace_replay_write(DS1302_TRACE_SIGNAL_SCLK, value);
+}
+
+/**
+ * @brief     replayed io gpio write
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] value set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 io gpio write failed
+ * @note      none
+ */
+static uint8_t a_trace_replay_io_gpio_write(void *ctx, uint8_t value)
+{
+    return a_trace_replay_write(DS1302_TRACE_SIGNAL_IO_WRITE, value);
+}
+
+/**
+ * @brief      replayed io gpio read
+ * @param[in]  *ctx pointer to a chip context
+ * @param[out] *value pointer to a value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 io gpio read failed
+ * @note       none
+ */
+static uint8_t a_trace_replay_io_gpio_read(void *ctx, uint8_t *value)
+{
+    const ds1302_trace_event_t *e;
+    
+    if ((gs_trace.diverged != 0) || (gs_trace.replay_index >= gs_trace.replay_count))
+    {
+        gs_trace.diverged = 1;
+        
+        return 1;
+    }
+    e = &gs_trace.replay[gs_trace.replay_index];
+    if (e->signal != DS1302_TRACE_SIGNAL_IO_READ)
+    {
+        gs_trace.diverged = 1;
+        
+        return 1;
+    }
+    gs_trace.replay_index++;
+    *value = e->value;
+    
+    return e->res;
+}
+
+/**
+ * @brief     replayed io gpio set direction
+ * @param[in] *ctx pointer to a chip context
+ * @param[in] output direction, 0 is input and 1 is output
+ * @return    status code
+ *            - 0 success
+ * @note      the direction is not recorded, so the stub keeps the pin untouched
+ */
+static uint8_t a_trace_replay_io_gpio_set_direction(void *ctx, uint8_t output)
+{
+    (void)output;
+    
+    return 0;
+}
+
+/**
+ * @brief     save the handle callbacks
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @note      none
+ */
+static void a_trace_save(ds1302_handle_t *handle)
+{
+    gs_trace.handle = handle;
+    gs_trace.ce_gpio_write = handle->ce_gpio_write;
+    gs_trace.sclk_gpio_write = handle->sclk_gpio_write;
+    gs_trace.io_gpio_write = handle->io_gpio_write;
+    gs_trace.io_gpio_read = handle->io_gpio_read;
+    gs_trace.io_gpio_set_direction = handle->io_gpio_set_direction;
+}
+
+/**
+ * @brief     attach the trace recorder to a handle
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] *event pointer to a preallocated event buffer
+ * @param[in] size event buffer size
+ * @return    status code
+ *            - 0 success
+ *            - 1 already attached
+ *            - 2 handle is NULL
+ *            - 4 size is invalid
+ * @note      the ce, sclk and io callbacks of the handle are wrapped,
+ *            the buffer is a ring and the oldest events are dropped when it is full,
+ *            timestamps come from the handle timestamp_us or count events when it is not linked,
+ *            only the gpio transport is traced
+ */
+uint8_t ds1302_trace_attach(ds1302_handle_t *handle, ds1302_trace_event_t *event, uint32_t size)
+{
+    if (handle == NULL)
+    {
+        return 2;
+    }
+    if ((event == NULL) || (size == 0))
+    {
+        return 4;
+    }
+    if (gs_trace.mode != DS1302_TRACE_MODE_NONE)
+    {
+        return 1;
+    }
+    
+    /* save the callbacks and reset the ring */
+    a_trace_save(handle);
+    gs_trace.event = event;
+    gs_trace.size = size;
+    gs_trace.head = 0;
+    gs_trace.count = 0;
+    gs_trace.dropped = 0;
+    gs_trace.sequence = 0;
+    gs_trace.mode = DS1302_TRACE_MODE_RECORD;
+    
+    /* wrap the callbacks */
+    DRIVER_DS1302_LINK_CE_GPIO_WRITE(handle, a_trace_ce_gpio_write);
+    DRIVER_DS1302_LINK_SCLK_GPIO_WRITE(handle, a_trace_sclk_gpio_write);
+    DRIVER_DS1302_LINK_IO_GPIO_WRITE(handle, a_trace_io_gpio_write);
+    DRIVER_DS1302_LINK_IO_GPIO_READ(handle, a_trace_io_gpio_read);
+    
+    return 0;
+}
+
+/**
+ * @brief     detach the trace recorder or the replay stub
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 not attached
+ *            - 2 handle is NULL
+ * @note      the recorded events are kept
+ */
+uint8_t ds1302_trace_detach(ds1302_handle_t *handle)
+{
+    if (handle == NULL)
+    {
+        return 2;
+    }
+    if ((gs_trace.mode == DS1302_TRACE_MODE_NONE) || (gs_trace.handle != handle))
+    {
+        return 1;
+    }
+    
+    /* restore the callbacks */
+    DRIVER_DS1302_LINK_CE_GPIO_WRITE(handle, gs_trace.ce_gpio_write);
+    DRIVER_DS1302_LINK_SCLK_GPIO_WRITE(handle, gs_trace.sclk_gpio_write);
+    DRIVER_DS1302_LINK_IO_GPIO_WRITE(handle, gs_trace.io_gpio_write);
+    DRIVER_DS1302_LINK_IO_GPIO_READ(handle, gs_trace.io_gpio_read);
+    DRIVER_DS1302_LINK_IO_GPIO_SET_DIRECTION(handle, gs_trace.io_gpio_set_direction);
+    gs_trace.mode = DS1302_TRACE_MODE_NONE;
+    gs_trace.handle = NULL;
+    
+    return 0;
+}
+
+/**
+ * @brief      get the recorded events
+ * @param[out] *event pointer to an event buffer
+ * @param[in]  len event buffer length
+ * @param[out] *count pointer to a count buffer
+ * @param[out] *dropped pointer to a dropped buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the events are copied from the oldest to the newest
+ */
+uint8_t ds1302_trace_get_events(ds1302_trace_event_t *event, uint32_t len, uint32_t *count, uint32_t *dropped)
+{
+    uint32_t first;
+    uint32_t i;
+    
+    /* copy from the oldest */
+    first = (gs_trace.count < gs_trace.size) ? 0 : gs_trace.head;
+    for (i = 0; (i < gs_trace.count) && (i < len); i++)
+    {
+        event[i] = gs_trace.event[(first + i) % gs_trace.size];
+    }
+    *count = i;
+    *dropped = gs_trace.dropped;
+    
+    return 0;
+}
+
+/**
+ * @brief     export the recorded events as vcd
+ * @param[in] *print pointer to a print function
+ * @return    status code
+ *            - 0 success
+ *            - 1 no events
+ * @note      the file declares ce, sclk and io with a 1us timescale,
+ *            io shows both the written and the sampled levels
+ */
+uint8_t ds1302_trace_export_vcd(void (*print)(const char *const fmt, ...))
+{
+    const char ids[3] = {'c', 's', 'd'};
+    uint32_t first;
+    uint32_t start;
+    uint32_t now;
+    uint32_t last;
+    uint32_t i;
+    
+    if (gs_trace.count == 0)
+    {
+        return 1;
+    }
+    
+    /* print the header */
+    print("$version libdriver ds1302 trace $end\n");
+    print("$comment %u events, %u dropped $end\n", (unsigned int)gs_trace.count, (unsigned int)gs_trace.dropped);
+    print("$timescale 1us $end\n");
+    print("$scope module ds1302 $end\n");
+    print("$var wire 1 c ce $end\n");
+    print("$var wire 1 s sclk $end\n");
+    print("$var wire 1 d io $end\n");
+    print("$upscope $end\n");
+    print("$enddefinitions $end\n");
+    print("#0\n");
+    print("$dumpvars\nxc\nxs\nxd\n$end\n");
+    
+    /* print the changes, the time never goes back */
+    first = (gs_trace.count < gs_trace.size) ? 0 : gs_trace.head;
+    start = gs_trace.event[first].timestamp_us;
+    last = 0;
+    for (i = 0; i < gs_trace.count; i++)
+    {
+        const ds1302_trace_event_t *e;
+        uint8_t id;
+        
+        e = &gs_trace.event[(first + i) % gs_trace.size];
+        now = e->timestamp_us - start;
+        if (now < last)
+        {
+            now = last;
+        }
+        if (now != last)
+        {
+            print("#%u\n", (unsigned int)now);
+        }
+        last = now;
+        id = (e->signal == DS1302_TRACE_SIGNAL_IO_READ) ? DS1302_TRACE_SIGNAL_IO_WRITE : e->signal;
+        print("%u%c\n", e->value, ids[id]);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     attach the replay stub to a handle
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] *event pointer to the recorded events
+ * @param[in] count recorded events count
+ * @return    status code
+ *            - 0 success
+ *            - 1 already attached
+ *            - 2 handle is NULL
+ *            - 4 count is invalid
+ * @note      every write is checked against the next recorded event and
+ *            every read returns the recorded level and result,
+ *            the first divergence fails the callback and every call after it
+ */
+uint8_t ds1302_trace_replay_attach(ds1302_handle_t *handle, const ds1302_trace_event_t *event, uint32_t count)
+{
+    if (handle == NULL)
+    {
+        return 2;
+    }
+    if ((event == NULL) || (count == 0))
+    {
+        return 4;
+    }
+    if (gs_trace.mode != DS1302_TRACE_MODE_NONE)
+    {
+        return 1;
+    }
+    
+    /* save the callbacks and rewind */
+    a_trace_save(handle);
+    gs_trace.replay = event;
+    gs_trace.replay_count = count;
+    gs_trace.replay_index = 0;
+    gs_trace.diverged = 0;
+    gs_trace.mode = DS1302_TRACE_MODE_REPLAY;
+    
+    /* link the stub */
+    DRIVER_DS1302_LINK_CE_GPIO_WRITE(handle, a_trace_replay_ce_gpio_write);
+    DRIVER_DS1302_LINK_SCLK_GPIO_WRITE(handle, a_trace_replay_sclk_gpio_write);
+    DRIVER_DS1302_LINK_IO_GPIO_WRITE(handle, a_trace_replay_io_gpio_write);
+    DRIVER_DS1302_LINK_IO_GPIO_READ(handle, a_trace_replay_io_gpio_read);
+    DRIVER_DS1302_LINK_IO_GPIO_SET_DIRECTION(handle, a_trace_replay_io_gpio_set_direction);
+    
+    return 0;
+}
+
+/**
+ * @brief      check the replay
+ * @param[out] *index pointer to an index buffer
+ * @return     status code
+ *             - 0 every event is replayed
+ *             - 1 replay diverged or stopped early
+ * @note       index is the first divergent or missing event
+ */
+uint8_t ds1302_trace_replay_check(uint32_t *index)
+{
+    *index = gs_trace.replay_index;
+    if ((gs_trace.diverged != 0) || (gs_trace.replay_index != gs_trace.replay_count))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  trace capture
+ * @return status code
+ *         - 0 success
+ *         - 1 trace capture failed
+ * @note   a time read and a ram read are recorded, replayed against the stub and
+ *         compared, then only the vcd text is printed
+ */
+uint8_t ds1302_trace_capture(void)
+{
+    ds1302_time_t t[2];
+    uint8_t buf[2][8];
+    uint32_t count;
+    uint32_t dropped;
+    uint32_t index;
+    uint8_t i;
+    
+    /* init 0 */
+    count = 0;
+    dropped = 0;
+    index = 0;
+    
+    /* link functions */
+    DRIVER_DS1302_LINK_INIT(&gs_handle, ds1302_handle_t);
+    DRIVER_DS1302_LINK_CE_GPIO_INIT(&gs_handle, ds1302_interface_ce_gpio_init);
+    DRIVER_DS1302_LINK_CE_GPIO_DEINIT(&gs_handle, ds1302_interface_ce_gpio_deinit);
+    DRIVER_DS1302_LINK_CE_GPIO_WRITE(&gs_handle, ds1302_interface_ce_gpio_write);
+    DRIVER_DS1302_LINK_SCLK_GPIO_INIT(&gs_handle, ds1302_interface_sclk_gpio_init);
+    DRIVER_DS1302_LINK_SCLK_GPIO_DEINIT(&gs_handle, ds1302_interface_sclk_gpio_deinit);
+    DRIVER_DS1302_LINK_SCLK_GPIO_WRITE(&gs_handle, ds1302_interface_sclk_gpio_write);
+    DRIVER_DS1302_LINK_IO_GPIO_INIT(&gs_handle, ds1302_interface_io_gpio_init);
+    DRIVER_DS1302_LINK_IO_GPIO_DEINIT(&gs_handle, ds1302_interface_io_gpio_deinit);
+    DRIVER_DS1302_LINK_IO_GPIO_WRITE(&gs_handle, ds1302_interface_io_gpio_write);
+    DRIVER_DS1302_LINK_IO_GPIO_READ(&gs_handle, ds1302_interface_io_gpio_read);
+    DRIVER_DS1302_LINK_IO_GPIO_SET_DIRECTION(&gs_handle, ds1302_interface_io_gpio_set_direction);
+    DRIVER_DS1302_LINK_TRANSPORT_BEGIN(&gs_handle, ds1302_interface_transport_begin);
+    DRIVER_DS1302_LINK_TRANSPORT_WRITE_BYTES(&gs_handle, ds1302_interface_transport_write_bytes);
+    DRIVER_DS1302_LINK_TRANSPORT_READ_BYTES(&gs_handle, ds1302_interface_transport_read_bytes);
+    DRIVER_DS1302_LINK_DELAY_US(&gs_handle, ds1302_interface_delay_us);
+    DRIVER_DS1302_LINK_DELAY_MS(&gs_handle, ds1302_interface_delay_ms);
+    DRIVER_DS1302_LINK_DEBUG_PRINT(&gs_handle, ds1302_interface_debug_print);
+    DRIVER_DS1302_LINK_TIMESTAMP_US(&gs_handle, ds1302_interface_timestamp_us);
+    
+    /* init ds1302 with the gpio transport */
+    if (ds1302_set_transport(&gs_handle, DS1302_TRANSPORT_GPIO) != 0)
+    {
+        ds1302_interface_debug_print("ds1302: set transport failed.\n");
+        
+        return 1;
+    }
+    if (ds1302_init(&gs_handle) != 0)
+    {
+        ds1302_interface_debug_print("ds1302: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* record, then replay the same calls */
+    for (i = 0; i < 2; i++)
+    {
+        uint8_t res;
+        
+        if (i == 0)
+        {
+            res = ds1302_trace_attach(&gs_handle, gs_record, DS1302_TRACE_CAPTURE_EVENTS);
+        }
+        else
+        {
+            (void)ds1302_trace_get_events(gs_replay, DS1302_TRACE_CAPTURE_EVENTS, &count, &dropped);
+            res = ds1302_trace_replay_attach(&gs_handle, gs_replay, count);
+        }
+        if (res != 0)
+        {
+            ds1302_interface_debug_print("ds1302: trace attach failed.\n");
+            (void)ds1302_deinit(&gs_handle);
+            
+            return 1;
+        }
+        if ((ds1302_get_time(&gs_handle, &t[i]) != 0) || (ds1302_read_ram(&gs_handle, 0x00, buf[i], 8) != 0))
+        {
+            ds1302_interface_debug_print("ds1302: trace %s failed.\n", (i == 0) ? "record" : "replay");
+            (void)ds1302_trace_detach(&gs_handle);
+            (void)ds1302_deinit(&gs_handle);
+            
+            return 1;
+        }
+        (void)ds1302_trace_detach(&gs_handle);
+    }
+    (void)ds1302_deinit(&gs_handle);
+    
+    /* check the replay */
+    if ((dropped != 0) || (ds1302_trace_replay_check(&index) != 0))
+    {
+        ds1302_interface_debug_print("ds1302: trace replay failed at event %u.\n", (unsigned int)index);
+        
+        return 1;
+    }
+    if ((memcmp(&t[0], &t[1], sizeof(ds1302_time_t)) != 0) || (memcmp(buf[0], buf[1], 8) != 0))
+    {
+        ds1302_interface_debug_print("ds1302: trace replay check failed.\n");
+        
+        return 1;
+    }
+    
+    /* output the vcd */
+    return ds1302_trace_export_vcd(ds1302_interface_debug_print);
+}
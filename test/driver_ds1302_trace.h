@@ -0,0 +1,168 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1302_trace.h
+ * @brief     driver ds1302 trace header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2024-02-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2024/02/15  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_DS1302_TRACE_H
+#define DRIVER_DS1302_TRACE_H
+
+#include "driver_ds1302_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup ds1302_test_driver
+ * @{
+ */
+
+/**
+ * @brief ds1302 trace signal enumeration definition
+ */
+typedef enum
+{
+    DS1302_TRACE_SIGNAL_CE       = 0x00,        /**< ce write */
+    DS1302_TRACE_SIGNAL_SCLK     = 0x01,        /**< sclk write */
+    DS1302_TRACE_SIGNAL_IO_WRITE = 0x02,        /**< io write */
+    DS1302_TRACE_SIGNAL_IO_READ  = 0x03,        /**< io read */
+} ds1302_trace_signal_t;
+
+/**
+ * @brief ds1302 trace event structure definition
+ */
+typedef struct ds1302_trace_event_s
+{
+    uint32_t timestamp_us;        /**< timestamp in us */
+    uint8_t signal;               /**< signal */
+    uint8_t value;                /**< written or read level */
+    uint8_t res;                  /**< callback result */
+} ds1302_trace_event_t;
+
+/**
+ * @brief     attach the trace recorder to a handle
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] *event pointer to a preallocated event buffer
+ * @param[in] size event buffer size
+ * @return    status code
+ *            - 0 success
+ *            - 1 already attached
+ *            - 2 handle is NULL
+ *            - 4 size is invalid
+ * @note      the ce, sclk and io callbacks of the handle are wrapped,
+ *            the buffer is a ring and the oldest events are dropped when it is full,
+ *            timestamps come from the handle timestamp_us or count events when it is not linked,
+ *            only the gpio transport is traced
+ */
+uint8_t ds1302_trace_attach(ds1302_handle_t *handle, ds1302_trace_event_t *event, uint32_t size);
+
+/**
+ * @brief     detach the trace recorder or the replay stub
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 not attached
+ *            - 2 handle is NULL
+ * @note      the recorded events are kept
+ */
+uint8_t ds1302_trace_detach(ds1302_handle_t *handle);
+
+/**
+ * @brief      get the recorded events
+ * @param[out] *event pointer to an event buffer
+ * @param[in]  len event buffer length
+ * @param[out] *count pointer to a count buffer
+ * @param[out] *dropped pointer to a dropped buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the events are copied from the oldest to the newest
+ */
+uint8_t ds1302_trace_get_events(ds1302_trace_event_t *event, uint32_t len, uint32_t *count, uint32_t *dropped);
+
+/**
+ * @brief     export the recorded events as vcd
+ * @param[in] *print pointer to a print function
+ * @return    status code
+ *            - 0 success
+ *            - 1 no events
+ * @note      the file declares ce, sclk and io with a 1us timescale,
+ *            io shows both the written and the sampled levels
+ */
+uint8_t ds1302_trace_export_vcd(void (*print)(const char *const fmt, ...));
+
+/**
+ * @brief     attach the replay stub to a handle
+ * @param[in] *handle pointer to a ds1302 handle structure
+ * @param[in] *event pointer to the recorded events
+ * @param[in] count recorded events count
+ * @return    status code
+ *            - 0 success
+ *            - 1 already attached
+ *            - 2 handle is NULL
+ *            - 4 count is invalid
+ * @note      every write is checked against the next recorded event and
+ *            every read returns the recorded level and result,
+ *            the first divergence fails the callback and every call after it
+ */
+uint8_t ds1302_trace_replay_attach(ds1302_handle_t *handle, const ds1302_trace_event_t *event, uint32_t count);
+
+/**
+ * @brief      check the replay
+ * @param[out] *index pointer to an index buffer
+ * @return     status code
+ *             - 0 every event is replayed
+ *             - 1 replay diverged or stopped early
+ * @note       index is the first divergent or missing event
+ */
+uint8_t ds1302_trace_replay_check(uint32_t *index);
+
+/**
+ * @brief  trace capture
+ * @return status code
+ *         - 0 success
+ *         - 1 trace capture failed
+ * @note   a time read and a ram read are recorded, replayed against the stub and
+ *         compared, then only the vcd text is printed
+ */
+uint8_t ds1302_trace_capture(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif